@@ -5,6 +5,7 @@
 #include "AI/PathFinding/Headers/DivideCrowd.h"
 #include "AI/PathFinding/NavMeshes/Headers/NavMesh.h"
 #include "AI/ActionInterface/Headers/AITeam.h"
+#include "AI/Headers/AIManager.h"
 #include "AI/ActionInterface/Headers/AIProcessor.h"
 
 #include "Dynamics/Entities/Units/Headers/NPC.h"
@@ -70,6 +71,8 @@ void AIEntity::load( const float3& currentPosition )
 }
 
 void AIEntity::unload() {
+    cancelPendingDestination();
+
     if (!isAgentLoaded()) {
         return;
     }
@@ -173,6 +176,8 @@ bool AIEntity::processData(const U64 deltaTimeUS) {
 }
 
 bool AIEntity::update(const U64 deltaTimeUS) {
+    pollPendingDestination();
+
     if (_processor) {
         _processor->update(deltaTimeUS, _unitRef);
     }
@@ -197,6 +202,8 @@ U32 AIEntity::getTeamID() const
 }
 
 void AIEntity::setTeamPtr(AITeam* const teamPtr) {
+    cancelPendingDestination();
+
     if (_teamPtr) {
         _teamPtr->removeTeamMember(this);
     }
@@ -318,34 +325,92 @@ bool AIEntity::updateDestination(const float3& destination, const bool updatePre
         return false;
     }
 
+    const bool sameAsRequested = _requestedDestination.distanceSquared(destination) <= DESTINATION_RADIUS_SQ;
+
+    // The lookup is asynchronous, so a failure can only be reported by the next call. Anyone still asking for the same spot gets it
+    if (_destinationLookupFailed) {
+        _destinationLookupFailed = false;
+        if (sameAsRequested) {
+            return false;
+        }
+    }
+
     // Skip very small updates
     if (_destination.distanceSquared(destination) <= DESTINATION_RADIUS_SQ) {
         return true;
     }
 
-    // Find position on navmesh
-    float3 result;
-    bool isPointOnNavMesh =
-        _detourCrowd->getNavMesh().getRandomPositionInCircle(destination,
-                                                             DESTINATION_RADIUS_F,
-                                                             float3(5),
-                                                             result,
-                                                             10);
-    if (!isPointOnNavMesh) {
-        isPointOnNavMesh =
-            _detourCrowd->getNavMesh().getClosestPosition(destination,
-                                                          float3(5),
-                                                          DESTINATION_RADIUS_F,
-                                                          result);
-    }
-
-    if (isPointOnNavMesh) {
-        _detourCrowd->setMoveTarget(_agentID, result, updatePreviousPath);
-        _destination = result;
+    // Already waiting on a lookup for (roughly) the same spot
+    if (_pendingDestination != Navigation::INVALID_PATH_QUERY && sameAsRequested) {
+        return true;
+    }
+
+    if (_teamPtr == nullptr || _detourCrowd->getNavMesh().getNavMesh() == nullptr) {
+        return false;
+    }
+
+    cancelPendingDestination();
+
+    _requestedDestination = destination;
+    _pendingUpdatePreviousPath = updatePreviousPath;
+
+    // Spread agents sent to the same spot around it instead of stacking them on one point
+    const F32 angle = Random(0.f, to_F32(M_PI_MUL_2));
+    const F32 distance = DESTINATION_RADIUS * Sqrt<F32>(Random(0.f, 1.f));
+    return requestDestination(destination + float3(std::cos(angle) * distance, 0.f, std::sin(angle) * distance), true);
+}
+
+bool AIEntity::requestDestination(const float3& target, const bool jittered) {
+    const dtNavMesh* navMesh = _detourCrowd->getNavMesh().getNavMesh();
+    if (navMesh == nullptr) {
+        return false;
+    }
+
+    _pendingDestination = _teamPtr->parentManager().pathQueries().requestClosestPoint(*navMesh, target, float3(5));
+    _pendingJittered = jittered;
+    return _pendingDestination != Navigation::INVALID_PATH_QUERY;
+}
+
+void AIEntity::pollPendingDestination() {
+    if (_pendingDestination == Navigation::INVALID_PATH_QUERY) {
+        return;
+    }
+
+    Navigation::PathQueryResult result;
+    if (!_teamPtr->parentManager().pathQueries().poll(_pendingDestination, result)) {
+        return;
+    }
+
+    _pendingDestination = Navigation::INVALID_PATH_QUERY;
+
+    if (!isAgentLoaded()) {
+        return;
+    }
+
+    if (result._success) {
+        const float3& target = result._points.front();
+        _detourCrowd->setMoveTarget(_agentID, target, _pendingUpdatePreviousPath);
+        _destination = target;
         _stopped = false;
+        return;
+    }
+
+    // The jittered spot may have landed off the mesh. Fall back to the closest point to the requested one
+    if (!_pendingJittered || !requestDestination(_requestedDestination, false)) {
+        _destinationLookupFailed = true;
+    }
+}
+
+void AIEntity::cancelPendingDestination() {
+    if (_pendingDestination == Navigation::INVALID_PATH_QUERY) {
+        return;
+    }
+
+    if (_teamPtr != nullptr) {
+        _teamPtr->parentManager().pathQueries().cancel(_pendingDestination);
     }
 
-    return isPointOnNavMesh;
+    _pendingDestination = Navigation::INVALID_PATH_QUERY;
 }
 
 const float3& AIEntity::getPosition() const noexcept {
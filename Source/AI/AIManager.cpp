@@ -3,11 +3,19 @@
 
 #include "AI/ActionInterface/Headers/AITeam.h"
 #include "AI/PathFinding/NavMeshes/Headers/NavMesh.h"
+#include "Graphs/Headers/SceneGraphNode.h"
+#include "Dynamics/Entities/Units/Headers/NPC.h"
+#include "ECS/Components/Headers/TransformComponent.h"
 
 namespace Divide {
 
 using namespace AI;
 
+namespace {
+    /// Per AI tick time slice for path queries. Anything left over runs on the next tick
+    constexpr U64 g_pathQueryBudgetUS = 2000u;
+}
+
 AIManager::AIManager(Scene& parentScene, TaskPool& pool)
     : SceneComponent(parentScene),
       _parentPool(pool),
@@ -16,7 +24,8 @@ AIManager::AIManager(Scene& parentScene, TaskPool& pool)
       _previousTimeUS(0ULL),
       _navMeshDebugDraw(false),
       _pauseUpdate(true),
-      _updating(false)
+      _updating(false),
+      _pathQueries(pool)
 {
     _shouldStop = false;
     _running = false;
@@ -34,10 +43,16 @@ void AIManager::destroy()
         LockGuard<Mutex> w_lock(_updateMutex);
         _aiTeams.clear();
     }
+    NavMeshMap navMeshes;
     {
         LockGuard<SharedMutex> w_lock(_navMeshMutex);
+        navMeshes = MOV(_navMeshes);
         _navMeshes.clear();
     }
+    // Outside of the lock: unloading waits on pending builds and then purges their queries under it
+    for (NavMeshMap::value_type& navMesh : navMeshes) {
+        navMesh.second->unload();
+    }
 }
 
 void AIManager::update(const U64 deltaTimeUS) {
@@ -48,6 +63,13 @@ void AIManager::update(const U64 deltaTimeUS) {
         _running = true;
         /// use internal delta time calculations
         _deltaTimeUS = _currentTimeUS - _previousTimeUS;
+        {
+            // Rebuild navmesh tiles touched by temporary obstacles before agents query them
+            SharedLock<SharedMutex> r_lock(_navMeshMutex);
+            for (const NavMeshMap::value_type& navMesh : _navMeshes) {
+                navMesh.second->update(_deltaTimeUS);
+            }
+        }
         {
             /// Lock the entities during update() adding or deleting entities is
             /// suspended until this returns
@@ -58,8 +80,15 @@ void AIManager::update(const U64 deltaTimeUS) {
                     _sceneCallback();
                 }
 
+                rebuildSensorGrid();
+
                 if (processInput(deltaTimeUS)) {  // sensors
                     if (processData(deltaTimeUS)) {  // think
+                        {
+                            // Resolve the queries issued while thinking so entities can react to them right away
+                            SharedLock<SharedMutex> r_lock(_navMeshMutex);
+                            _pathQueries.update(g_pathQueryBudgetUS);
+                        }
                         updateEntities(deltaTimeUS);  // react
                     }
                 }
@@ -72,6 +101,22 @@ void AIManager::update(const U64 deltaTimeUS) {
     }
 }
 
+void AIManager::rebuildSensorGrid() {
+    PROFILE_SCOPE_AUTO( Profiler::Category::GameLogic );
+
+    _sensorGrid.clear();
+    for (const AITeamMap::value_type& team : _aiTeams) {
+        for (const AITeam::TeamMap::value_type& member : team.second->getTeamMembers()) {
+            const NPC* unit = member.second->getUnitRef();
+            SceneGraphNode* node = unit != nullptr ? unit->getBoundNode() : nullptr;
+            if (node != nullptr) {
+                _sensorGrid.insert(node->getGUID(), node, node->get<TransformComponent>()->getWorldPosition());
+            }
+        }
+    }
+    _sensorGrid.build();
+}
+
 bool AIManager::processInput(const U64 deltaTimeUS) {  // sensors
     for (AITeamMap::value_type& team : _aiTeams) {
         if (!team.second->processInput(_parentPool, deltaTimeUS)) {
@@ -130,7 +175,7 @@ Navigation::NavigationMesh* AIManager::addNavMesh( PlatformContext& context, Nav
     std::unique_ptr<Navigation::NavigationMesh>& navMesh = _navMeshes[radius];
     if (navMesh == nullptr)
     {
-        navMesh = std::make_unique<Navigation::NavigationMesh>(context, recastInterface, parentScene);
+        navMesh = std::make_unique<Navigation::NavigationMesh>(context, recastInterface, parentScene, _pathQueries, _navMeshMutex);
         navMesh->debugDraw(_navMeshDebugDraw);
     }
     _navMeshMutex.unlock();
@@ -148,6 +193,7 @@ Navigation::NavigationMesh* AIManager::addNavMesh( PlatformContext& context, Nav
 
 bool AIManager::destroyNavMesh(const AIEntity::PresetAgentRadius radius)
 {
+    std::unique_ptr<Navigation::NavigationMesh> navMesh;
     {
         LockGuard<SharedMutex> w_lock(_navMeshMutex);
         const NavMeshMap::iterator it = _navMeshes.find(radius);
@@ -156,8 +202,11 @@ bool AIManager::destroyNavMesh(const AIEntity::PresetAgentRadius radius)
             return false;
         }
 
+        navMesh = MOV(it->second);
         _navMeshes.erase( it );
     }
+    // Outside of the lock: unloading waits on a pending build and then purges its queries under it
+    navMesh->unload();
 
     {
         LockGuard<Mutex> w_lock(_updateMutex);
@@ -18,29 +18,39 @@ Action::Action(const string& name, I32 cost) : Action()
     cost_ = cost;
 }
 
+void Action::setPrecondition(const I32 key, const bool value) {
+    DIVIDE_ASSERT(key >= 0 && key < WorldState::MAX_FACTS, "Action::setPrecondition: variable ID out of range!");
+
+    preconditions_[key] = value;
+
+    const U64 bit = 1ull << key;
+    preconditionMask_ |= bit;
+    preconditionValues_ = value ? (preconditionValues_ | bit) : (preconditionValues_ & ~bit);
+}
+
+void Action::setEffect(const I32 key, const bool value) {
+    DIVIDE_ASSERT(key >= 0 && key < WorldState::MAX_FACTS, "Action::setEffect: variable ID out of range!");
+
+    effects_[key] = value;
+
+    const U64 bit = 1ull << key;
+    effectMask_ |= bit;
+    effectValues_ = value ? (effectValues_ | bit) : (effectValues_ & ~bit);
+}
+
 bool Action::eligibleFor(const WorldState& ws) const {
     if (!checkImplDependentCondition()) {
         return false;
     }
 
-    for (const auto& precond : preconditions_) {
-        try {
-            if (ws.vars_.at(precond.first) != precond.second) {
-                return false;
-            }
-        }
-        catch (const std::out_of_range&) {
-            return false;
-        }
-    }
-    return true;
+    // Every precondition must be set on the worldstate and hold the required value
+    return (ws.care_ & preconditionMask_) == preconditionMask_ &&
+           ((ws.values_ ^ preconditionValues_) & preconditionMask_) == 0u;
 }
 
 WorldState Action::actOn(const WorldState& ws) const {
     WorldState tmp(ws);
-    for (const auto& effect : effects_) {
-        tmp.setVariable(effect.first, effect.second);
-    }
+    tmp.apply(effectValues_, effectMask_);
     return tmp;
 }
 
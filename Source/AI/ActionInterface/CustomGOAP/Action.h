@@ -32,6 +32,13 @@ namespace goap {
         // Effects are things that happen when this action takes place.
         operations effects_;
 
+        // The same preconditions and effects packed as WorldState bitmasks (value + mask),
+        // so the planner can test and apply them without walking the maps above.
+        U64 preconditionValues_ = 0u;
+        U64 preconditionMask_ = 0u;
+        U64 effectValues_ = 0u;
+        U64 effectMask_ = 0u;
+
     public:
         Action() noexcept;
         Action(const string& name, I32 cost);
@@ -56,14 +63,14 @@ namespace goap {
          @param key the name of the precondition
          @param value the value the precondition must hold
          */
-        inline void setPrecondition(const I32 key, const bool value) { preconditions_[key] = value; }
+        void setPrecondition(I32 key, bool value);
 
         /**
          Set the given effect of this action, in terms of variable and new value.
          @param key the name of the effect
          @param value the value that will result
          */
-        inline void setEffect(const I32 key, const bool value) { effects_[key] = value; }
+        void setEffect(I32 key, bool value);
 
         inline const operations& effects() const noexcept { return effects_; }
 
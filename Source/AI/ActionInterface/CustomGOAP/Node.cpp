@@ -5,21 +5,17 @@
 namespace Divide::goap
 {
 
-    I32 Node::last_id_ = 0;
-
-Node::Node() noexcept :  parent_id_(-1), g_(0), h_(0), action_(nullptr)
+Node::Node() noexcept :  parent_(NO_PARENT), g_(0), h_(0), action_(nullptr)
 {
-    id_ = ++last_id_;
 }
 
-Node::Node(const WorldState& state, I32 g, I32 h, I32 parent_id, const Action* action)
+Node::Node(const WorldState& state, I32 g, I32 h, U32 parent, const Action* action)
     : ws_(state)
-    , parent_id_(parent_id)
+    , parent_(parent)
     , g_(g)
     , h_(h)
     , action_(action)
 {
-    id_ = ++last_id_;
 }
 
 bool operator<(const Node& lhs, const Node& rhs) noexcept {
@@ -32,7 +28,7 @@ bool operator<(const Node& lhs, const Node& rhs) noexcept {
 
 string Node::toString() const
 {
-    return Util::StringFormat("Node { id: {} parent: {} F: {} G: {} H: {}, {}\n", id_, parent_id_, f(), g_, h_, ws_.toString());
+    return Util::StringFormat("Node { parent: {} F: {} G: {} H: {}, {}\n", parent_, f(), g_, h_, ws_.toString());
 }
 
 } //namespace Divide::goap
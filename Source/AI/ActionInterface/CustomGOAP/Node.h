@@ -15,17 +15,16 @@ namespace Divide {
 
 namespace goap {
     struct Node {
-        static I32 last_id_; // a static that lets us assign incrementing, unique IDs to nodes
+        static constexpr U32 NO_PARENT = U32_MAX;
 
         WorldState ws_;      // The state of the world at this node.
-        I32 id_;             // the unique ID of this node
-        I32 parent_id_;      // the ID of this node's immediate predecessor
+        U32 parent_;         // the planner's index of this node's immediate predecessor, or NO_PARENT
         I32 g_;              // The A* cost from 'start' to 'here'
         I32 h_;              // The estimated remaining cost to 'goal' form 'here'
         const Action* action_;     // The action that got us here (for replay purposes)
 
         Node() noexcept;
-        Node(const WorldState& state, I32 g, I32 h, I32 parent_id, const Action* action);
+        Node(const WorldState& state, I32 g, I32 h, U32 parent, const Action* action);
 
         // F -- which is simply G+H -- is autocalculated
         inline I32 f() const noexcept { return g_ + h_; }
@@ -9,47 +9,96 @@ int Planner::calculateHeuristic(const WorldState& now, const WorldState& goal) c
     return now.distanceTo(goal);
 }
 
-void Planner::addToOpenList(Node&& n) {
-    // insert maintaining sort order
-    auto it = eastl::lower_bound(begin(open_),
-                                 end(open_),
-                                 n);
-    open_.emplace(it, MOV(n));
+bool Planner::openBefore(const U32 lhs, const U32 rhs) const noexcept {
+    const Node& a = nodes_[lhs];
+    const Node& b = nodes_[rhs];
+    if (a.f() != b.f()) {
+        return a.f() < b.f();
+    }
+    // Newer nodes used to be inserted in front of existing ones with the same F
+    return lhs > rhs;
 }
 
-Node& Planner::popAndClose() {
-    assert(!open_.empty());
-    closed_.push_back( MOV(open_.front()));
-    open_.erase(std::begin(open_));
-
-    return closed_.back();
+void Planner::siftUp(U32 slot) noexcept {
+    const U32 entry = open_[slot];
+    while (slot > 0u) {
+        const U32 parent = (slot - 1u) / 2u;
+        if (!openBefore(entry, open_[parent])) {
+            break;
+        }
+        open_[slot] = open_[parent];
+        heap_slot_[open_[slot]] = slot;
+        slot = parent;
+    }
+    open_[slot] = entry;
+    heap_slot_[entry] = slot;
 }
 
-bool Planner::memberOfClosed(const WorldState& ws) const {
-    if (std::find_if(std::begin(closed_), std::end(closed_), [&](const Node& n) { return n.ws_ == ws; }) == std::end(closed_)) {
-        return false;
+void Planner::siftDown(U32 slot) noexcept {
+    const U32 count = to_U32(open_.size());
+    const U32 entry = open_[slot];
+    while (true) {
+        U32 child = slot * 2u + 1u;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1u < count && openBefore(open_[child + 1u], open_[child])) {
+            ++child;
+        }
+        if (!openBefore(open_[child], entry)) {
+            break;
+        }
+        open_[slot] = open_[child];
+        heap_slot_[open_[slot]] = slot;
+        slot = child;
     }
-    return true;
+    open_[slot] = entry;
+    heap_slot_[entry] = slot;
 }
 
-vector<Node>::iterator Planner::memberOfOpen(const WorldState& ws) {
-    return std::find_if(std::begin(open_), std::end(open_), [&](const Node& n) { return n.ws_ == ws; });
+void Planner::addToOpenList(Node&& n) {
+    const U32 index = to_U32(nodes_.size());
+    visited_[n.ws_] = index;
+    nodes_.push_back(MOV(n));
+    heap_slot_.push_back(to_U32(open_.size()));
+    open_.push_back(index);
+    siftUp(heap_slot_[index]);
+}
+
+U32 Planner::popAndClose() {
+    assert(!open_.empty());
+
+    const U32 index = open_.front();
+    open_.front() = open_.back();
+    open_.pop_back();
+    if (!open_.empty()) {
+        heap_slot_[open_.front()] = 0u;
+        siftDown(0u);
+    }
+
+    heap_slot_[index] = CLOSED_SLOT;
+    closed_.push_back(index);
+    return index;
 }
 
 void Planner::printOpenList(string& output) const
 {
-    for (const auto& n : open_)
+    // The heap only keeps the best node at the front, so sort a copy to print in expansion order
+    vector<U32> sorted(open_);
+    eastl::sort(begin(sorted), end(sorted), [this](const U32 lhs, const U32 rhs) { return openBefore(lhs, rhs); });
+
+    for (const U32 index : sorted)
     {
-        output.append(n.toString());
+        output.append(nodes_[index].toString());
         output.append("\n");
     }
 }
 
 void Planner::printClosedList(string& output) const
 {
-    for (const auto& n : closed_)
+    for (const U32 index : closed_)
     {
-        output.append( n.toString() );
+        output.append( nodes_[index].toString() );
         output.append( "\n" );
     }
 }
@@ -61,73 +110,59 @@ vector<const Action*> Planner::plan(const WorldState& start, const WorldState& g
     }
 
     // Feasible we'd re-use a planner, so clear out the prior results
+    nodes_.clear();
+    heap_slot_.clear();
+    visited_.clear();
     open_.clear();
     closed_.clear();
-    known_nodes_.clear();
-
-    Node starting_node(start, 0, calculateHeuristic(start, goal), 0, nullptr);
 
-    // TODO figure out a more memory-friendly way of doing this...
-    known_nodes_[starting_node.id_] = starting_node;
-    open_.push_back( MOV(starting_node));
-
-    //int iters = 0;
-    while (open_.size() > 0) {
-        //++iters;
-        //std::cout << "\n-----------------------\n";
-        //std::cout << "Iteration " << iters << std::endl;
+    addToOpenList(Node(start, 0, calculateHeuristic(start, goal), Node::NO_PARENT, nullptr));
 
+    while (!open_.empty()) {
         // Look for Node with the lowest-F-score on the open list. Switch it to closed,
         // and hang onto it -- this is our latest node.
-        Node& current(popAndClose());
-
-        //std::cout << "Open list\n";
-        //printOpenList();
-        //std::cout << "Closed list\n";
-        //printClosedList();
-        //std::cout << "\nCurrent is " << current << std::endl;
+        const U32 current = popAndClose();
 
         // Is our current state the goal state? If so, we've found a path, yay.
-        if (current.ws_.meetsGoal(goal)) {
+        if (nodes_[current].ws_.meetsGoal(goal)) {
             vector<const Action*> the_plan;
-            do {
-                the_plan.push_back(current.action_);
-                current = known_nodes_.at(current.parent_id_);
-            } while (current.parent_id_ != 0);
+            for (U32 index = current; nodes_[index].parent_ != Node::NO_PARENT; index = nodes_[index].parent_) {
+                the_plan.push_back(nodes_[index].action_);
+            }
             return the_plan;
         }
 
-        // Check each node REACHABLE from current
+        // Check each node REACHABLE from current. nodes_ may grow while we do this, so only hold on to indices
+        const I32 current_g = nodes_[current].g_;
         for (const auto& action : actions) {
-            if (action->eligibleFor(current.ws_)) {
-                WorldState possibility = action->actOn(current.ws_);
-                //std::cout << "Hmm, " << action.name() << " could work..." << "resulting in " << possibility << std::endl;
-
-                // Skip if already closed
-                if (memberOfClosed(possibility)) {
-                    //std::cout << "...but that one's closed out.\n";
-                    continue;
-                }
-
-                auto needle = memberOfOpen(possibility);
-                if (needle==end(open_)) { // not a member of open list
-                    // Make a new node, with current as its parent, recording G & H
-                    Node found(possibility, current.g_ + action->cost(), calculateHeuristic(possibility, goal), current.id_, action);
-                    known_nodes_[found.id_] = found;
-
-                    // Add it to the open list (maintaining sort-order therein)
-                    addToOpenList( MOV(found));
-                } else { // already a member of the open list
-                    // check if the current G is better than the recorded G
-                    if ((current.g_ + action->cost()) < needle->g_) {
-                        //std::cout << "My path is better\n";
-                        needle->parent_id_ = current.id_;                     // make current its parent
-                        needle->g_ = current.g_ + action->cost();              // recalc G & H
-                        needle->h_ = calculateHeuristic(possibility, goal);
-                        eastl::sort(begin(open_), end(open_));                // resort open list to account for the new F
-                        // sorting likely invalidates the iterator, but we don't need it anymore
-                    }
-                }
+            if (!action->eligibleFor(nodes_[current].ws_)) {
+                continue;
+            }
+
+            WorldState possibility = action->actOn(nodes_[current].ws_);
+            const I32 g = current_g + action->cost();
+
+            const auto needle = visited_.find(possibility);
+            if (needle == end(visited_)) { // neither open nor closed
+                // Make a new node, with current as its parent, recording G & H
+                const I32 h = calculateHeuristic(possibility, goal);
+                addToOpenList(Node(possibility, g, h, current, action));
+                continue;
+            }
+
+            // Skip if already closed
+            const U32 index = needle->second;
+            if (heap_slot_[index] == CLOSED_SLOT) {
+                continue;
+            }
+
+            // Already a member of the open list: check if the current G is better than the recorded G
+            Node& node = nodes_[index];
+            if (g < node.g_) {
+                node.parent_ = current;                              // make current its parent
+                node.g_ = g;                                         // recalc G & H
+                node.h_ = calculateHeuristic(possibility, goal);
+                siftUp(heap_slot_[index]);                           // F only ever decreases here
             }
         }
     }
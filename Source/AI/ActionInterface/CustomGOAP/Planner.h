@@ -16,35 +16,38 @@ namespace Divide {
 namespace goap {
     class Planner {
     private:
-        /// A master lookup table of ID-to-Node; useful during the action replay
-        hashMap<I32, Node> known_nodes_;
+        static constexpr U32 CLOSED_SLOT = U32_MAX;
 
-        vector<Node> open_;   // The A* open list
-        vector<Node> closed_; // The A* closed list
+        /// Every node created by the current search, in creation order. Nodes link to their parents by index, for the action replay
+        vector<Node> nodes_;
+        /// The open list position of every node in nodes_ (same index), or CLOSED_SLOT once it has been expanded
+        vector<U32> heap_slot_;
+        /// Every worldstate reached so far, mapped to the index of its node. Doubles as the A* closed set
+        hashMap<WorldState, U32, WorldStateHash> visited_;
 
-        /**
-         Is the given worldstate a member of the closed list? (And by that we mean,
-         does any node on the closed list contain an equal worldstate.)
-         @param ws the worldstate in question
-         @return true if it's been closed, false if not
-         */
-        bool memberOfClosed(const WorldState& ws) const;
+        vector<U32> open_;   // The A* open list: a binary min-heap of indices into nodes_
+        vector<U32> closed_; // The A* closed list: indices into nodes_, in the order they were closed
 
         /**
-         Is the given worldstate a member of the open list? (And by that we mean,
-         does any node on the open list contain an equal worldstate.)
-         @param ws the worldstate in question
-         @return a pointer to the note if found, end(open_) if not
+         Heap ordering for the open list: lowest F first. Ties go to the most recently
+         created node, which is the order the old sorted-vector open list produced.
+         @param lhs index of the first node
+         @param rhs index of the second node
+         @return true if lhs should be expanded before rhs
          */
-        vector<goap::Node>::iterator memberOfOpen(const WorldState& ws);
+        bool openBefore(U32 lhs, U32 rhs) const noexcept;
+
+        /// Restore the heap property by moving the entry at the given open list position towards the root
+        void siftUp(U32 slot) noexcept;
+        /// Restore the heap property by moving the entry at the given open list position towards the leaves
+        void siftDown(U32 slot) noexcept;
 
         /**
-         Pops the first Node from the 'open' list, moves it to the 'closed' list, and
-         returns a reference to this newly-closed Node. Its behavior is undefined if
-         you call on an empty list.
-         @return a reference to the newly closed Node
+         Pops the best Node from the 'open' list, moves it to the 'closed' list, and
+         returns its index. Its behavior is undefined if you call on an empty list.
+         @return the index of the newly closed Node
          */
-        Node& popAndClose();
+        U32 popAndClose();
 
         /**
          Moves the given Node (an rvalue reference) into the 'open' list.
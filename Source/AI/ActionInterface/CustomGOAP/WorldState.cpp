@@ -8,62 +8,67 @@ namespace Divide::goap
 WorldState::WorldState(const string& name)  noexcept 
     : priority_( 0 )
     , name_( name )
+    , values_( 0u )
+    , care_( 0u )
 {
-    //nop
+    updateHash();
 }
 
 void WorldState::setVariable(const I32 var_id, const bool value) 
 {
-    vars_[var_id] = value;
+    DIVIDE_ASSERT(var_id >= 0 && var_id < MAX_FACTS, "WorldState::setVariable: variable ID out of range!");
+
+    const U64 bit = 1ull << var_id;
+    apply(value ? bit : 0u, bit);
 }
 
 bool WorldState::getVariable(const I32 var_id) const {
-    return vars_.at(var_id);
+    DIVIDE_ASSERT(hasVariable(var_id), "WorldState::getVariable: variable not set!");
+
+    return (values_ & (1ull << var_id)) != 0u;
 }
 
+bool WorldState::hasVariable(const I32 var_id) const noexcept {
+    return var_id >= 0 && var_id < MAX_FACTS && (care_ & (1ull << var_id)) != 0u;
+}
 
-bool WorldState::operator==(const WorldState& other) const {
-    return (vars_ == other.vars_);
+void WorldState::apply(const U64 values, const U64 mask) noexcept {
+    values_ = (values_ & ~mask) | (values & mask);
+    care_ |= mask;
+    updateHash();
 }
 
-bool WorldState::meetsGoal(const WorldState& goal_state) const
-{
-    for (const auto& kv : goal_state.vars_) {
-        try {
-            if (vars_.at(kv.first) != kv.second) {
-                return false;
-            }
-        }
-        catch (const std::out_of_range&) {
-            return false;
-        }
-    }
-    return true;
+void WorldState::updateHash() noexcept {
+    hash_ = 17;
+    Util::Hash_combine(hash_, values_, care_);
 }
 
-I32 WorldState::distanceTo(const WorldState& goal_state) const
-{
-    I32 result = 0;
+bool WorldState::operator==(const WorldState& other) const noexcept {
+    return values_ == other.values_ && care_ == other.care_;
+}
 
-    for (const auto& kv : goal_state.vars_) {
-        auto itr = vars_.find(kv.first);
-        if (itr == end(vars_) || itr->second != kv.second) {
-            ++result;
-        }
-    }
+bool WorldState::meetsGoal(const WorldState& goal_state) const noexcept
+{
+    // Every variable the goal cares about must be set here and hold the same value
+    return (care_ & goal_state.care_) == goal_state.care_ &&
+           ((values_ ^ goal_state.values_) & goal_state.care_) == 0u;
+}
 
-    return result;
+I32 WorldState::distanceTo(const WorldState& goal_state) const noexcept
+{
+    const U64 missing = goal_state.care_ & ~care_;
+    const U64 different = (values_ ^ goal_state.values_) & goal_state.care_ & care_;
+    return std::popcount(missing | different);
 }
 
 string WorldState::toString() const
 {
     string ret = "WorldState { ";
-    for ( const auto& kv : vars_ )
+    forEachVariable([&ret]([[maybe_unused]] const I32 var_id, const bool value)
     {
-        ret.append(kv.second ? "TRUE " : "FALSE ");
-    }
+        ret.append(value ? "TRUE " : "FALSE ");
+    });
     ret.append("}");
-
     return ret;
 }
 
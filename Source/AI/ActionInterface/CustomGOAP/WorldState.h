@@ -8,12 +8,19 @@
 
 #pragma once
 
+#include <bit>
+
 namespace Divide {
 namespace goap {
     struct WorldState {
+        /// Facts are stored as bits, so valid variable IDs are in the [0, MAX_FACTS) range
+        static constexpr I32 MAX_FACTS = 64;
+
         F32 priority_; // useful if this is a goal state, to distinguish from other possible goals
         string name_; // the human-readable name of the state
-        hashMap<I32, bool> vars_; // the variables that in aggregate describe a worldstate
+
+        U64 values_; // the value of every variable that in aggregate describes a worldstate (0 if not set)
+        U64 care_;   // which of the variables above are actually set (i.e. matter to this state)
 
         explicit WorldState(const Divide::string& name="") noexcept;
 
@@ -31,6 +38,23 @@ namespace goap {
         */
         bool getVariable(const int var_id) const;
 
+        /**
+         Has the given variable been set on this state?
+         @param var_id the unique ID of the state variable
+         @return true if the variable matters to this state
+        */
+        bool hasVariable(const int var_id) const noexcept;
+
+        /// @return true if no variable has been set on this state
+        [[nodiscard]] bool empty() const noexcept { return care_ == 0u; }
+
+        /**
+         Apply a set of variables (e.g. an action's effects) to this state.
+         @param values the new values of the variables. Ignored for bits not set in 'mask'
+         @param mask the variables to overwrite
+        */
+        void apply(U64 values, U64 mask) noexcept;
+
         /**
          Useful if this state is a goal state. It asks, does state 'other'
          meet the requirements of this goal? Takes into account not only this goal's
@@ -38,7 +62,7 @@ namespace goap {
          @param goal_state the state you are testing as having met this goal state
          @return true if it meets this goal state, false otherwise
          */
-        bool meetsGoal(const WorldState& goal_state) const;
+        bool meetsGoal(const WorldState& goal_state) const noexcept;
 
         /**
          Given the other state -- and what 'matters' to the other state -- how many
@@ -46,16 +70,41 @@ namespace goap {
          @param goal_state the goal state to compare against
          @return the number of state-var differences between us and them
          */
-        int distanceTo(const WorldState& goal_state) const;
+        int distanceTo(const WorldState& goal_state) const noexcept;
 
         /**
          Equality operator
          @param other the other worldstate to compare to
          @return true if they are equal, false if not
          */
-        bool operator==(const WorldState& other) const;
+        bool operator==(const WorldState& other) const noexcept;
+
+        /// Precomputed from the variables, so hashed containers of worldstates are cheap to probe
+        [[nodiscard]] size_t hash() const noexcept { return hash_; }
+
+        /// Calls 'cbk(var_id, value)' for every variable set on this state, in ascending ID order
+        template<typename Callback>
+        void forEachVariable(Callback&& cbk) const
+        {
+            for (U64 remaining = care_; remaining != 0u; remaining &= remaining - 1u)
+            {
+                const I32 var_id = std::countr_zero(remaining);
+                cbk(var_id, (values_ & (1ull << var_id)) != 0u);
+            }
+        }
 
         [[nodiscard]] string toString() const;
+
+    private:
+        void updateHash() noexcept;
+
+    private:
+        size_t hash_;
+    };
+
+    struct WorldStateHash {
+        size_t operator()(const WorldState& ws) const noexcept { return ws.hash(); }
     };
+
 } //namespace goap
 } //namespace Divide
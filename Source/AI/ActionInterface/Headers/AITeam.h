@@ -100,6 +100,7 @@ class AITeam final : public GUIDWrapper {
     }
 
     const TeamMap& getTeamMembers() const { return _team; }
+    AIManager& parentManager() const noexcept { return _parentManager; }
     MemberVariable& getMemberVariable() { return _memberVariable; }
 
     void clearOrders() {
@@ -33,6 +33,7 @@
 #define DVD_AI_ENTITY_H_
 
 #include "AI/Sensors/Headers/VisualSensor.h"
+#include "AI/PathFinding/Headers/PathQueryService.h"
 #include <any>
 
 struct dtCrowdAgent;
@@ -109,6 +110,11 @@ class AIEntity final : public GUIDWrapper {
       * If updatePreviousPath is set to true the previous path will be reused instead
       * of calculating a completely new path, but this can only be used if the new
       * destination is close to the previous (eg. when chasing a moving entity).
+      * The navmesh lookup is queued on the AIManager's path query service and the
+      * agent starts moving once the result arrives (usually later in the same AI tick).
+      * Agents are spread within DESTINATION_RADIUS of the destination.
+      * Returns false if the agent can't accept destinations or if the previous lookup
+      * for (roughly) the same destination found no point on the navmesh.
      **/
     [[nodiscard]] bool updateDestination(const float3& destination, bool updatePreviousPath = false);
     /// The destination set for this agent.
@@ -169,6 +175,11 @@ class AIEntity final : public GUIDWrapper {
     void setDestination(const float3& destination) noexcept;
 
     void setTeamPtr(AITeam* teamPtr);
+    /// Queue a closest point lookup for target. Returns false if there is nothing to query against
+    [[nodiscard]] bool requestDestination(const float3& target, bool jittered);
+    /// Apply the result of a queued destination lookup, if it completed
+    void pollPendingDestination();
+    void cancelPendingDestination();
     [[nodiscard]] bool processInput(U64 deltaTimeUS);
     [[nodiscard]] bool processData(U64 deltaTimeUS);
     [[nodiscard]] bool update(U64 deltaTimeUS);
@@ -207,6 +218,14 @@ class AIEntity final : public GUIDWrapper {
     U64 _moveWaitTimer;
     /// True if this character is stopped.
     bool _stopped;
+    /// Queued destination lookup (INVALID_PATH_QUERY if none)
+    Navigation::PathQueryHandle _pendingDestination = Navigation::INVALID_PATH_QUERY;
+    float3 _requestedDestination;
+    bool _pendingUpdatePreviousPath = false;
+    /// The pending lookup is for a point spread around _requestedDestination, not for the point itself
+    bool _pendingJittered = false;
+    /// Set when no navmesh point was found for _requestedDestination. Reported by the next updateDestination() call
+    bool _destinationLookupFailed = false;
 };
 
 namespace Attorney {
@@ -34,6 +34,8 @@
 #define DVD_AI_MANAGER_H_
 
 #include "AI/Headers/AIEntity.h"
+#include "AI/PathFinding/Headers/PathQueryService.h"
+#include "AI/Sensors/Headers/SensorGrid.h"
 #include "Scenes/Headers/SceneComponent.h"
 
 namespace Divide {
@@ -126,6 +128,11 @@ class AIManager final : public SceneComponent
 
     bool running() const noexcept { return _running; }
 
+    /// Batched navmesh queries (paths, closest points, raycasts). Safe to use from any AI task
+    Navigation::PathQueryService& pathQueries() noexcept { return _pathQueries; }
+    /// Positions of every team member, rebuilt at the start of each AI tick. Read-only while entities update
+    const SensorGrid& sensorGrid() const noexcept { return _sensorGrid; }
+
     /// Register an AI Team
     AITeam* registerTeam( U32 id );
     /// Unregister an AI Team
@@ -137,6 +144,7 @@ class AIManager final : public SceneComponent
     bool shouldStop() const noexcept;
 
   private:
+    void rebuildSensorGrid();
     bool processInput(U64 deltaTimeUS);    ///< sensors
     bool processData(U64 deltaTimeUS);     ///< think
     bool updateEntities(U64 deltaTimeUS);  ///< react
@@ -151,6 +159,8 @@ class AIManager final : public SceneComponent
     std::atomic_bool _running;
     NavMeshMap _navMeshes;
     AITeamMap _aiTeams;
+    Navigation::PathQueryService _pathQueries;
+    SensorGrid _sensorGrid;
     mutable Mutex _updateMutex;
     mutable SharedMutex _navMeshMutex;
     DELEGATE<void> _sceneCallback;
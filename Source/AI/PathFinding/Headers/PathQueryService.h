@@ -0,0 +1,140 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_AI_PATH_QUERY_SERVICE_H_
+#define DVD_AI_PATH_QUERY_SERVICE_H_
+
+#include "AI/PathFinding/NavMeshes/Headers/NavMeshDefines.h"
+
+namespace Divide
+{
+
+class TaskPool;
+
+namespace AI::Navigation
+{
+
+enum class PathQueryType : U8
+{
+    PATH = 0,
+    CLOSEST_POINT,
+    RAYCAST,
+    COUNT
+};
+
+/// Ticket returned by PathQueryService requests. Identical pending requests share the same handle.
+using PathQueryHandle = U32;
+constexpr PathQueryHandle INVALID_PATH_QUERY = 0u;
+
+struct PathQueryResult
+{
+    /// PATH: straight path corners. CLOSEST_POINT: the point found. RAYCAST: the ray start and the hit (or end) point.
+    vector<float3> _points;
+    /// RAYCAST only: wall normal at the hit point
+    float3 _hitNormal;
+    /// Poly the closest point or the ray start lies on
+    dtPolyRef _poly = 0u;
+    /// RAYCAST only: hit parameter along [start, end]. FLT_MAX if the ray reached its end unobstructed.
+    F32 _hitT = 0.f;
+    PathErrorCode _error = PathErrorCode::PATH_ERROR_NONE;
+    bool _success = false;
+};
+
+/// Queues path, closest point and raycast queries from any thread and runs them in batches on a task pool.
+/// Every worker batch uses its own dtNavMeshQuery so agents never share query state, and update() stops starting new
+/// queries once its per-frame budget is spent. Whatever is left over keeps its place at the front of the queue for the next update() call.
+class PathQueryService final : NonCopyable
+{
+   public:
+    explicit PathQueryService( TaskPool& pool, U32 maxSearchNodes = 2048u, U32 batchSize = 16u );
+    ~PathQueryService();
+
+    [[nodiscard]] PathQueryHandle requestPath( const dtNavMesh& navMesh, const float3& start, const float3& end, const float3& extents );
+    [[nodiscard]] PathQueryHandle requestClosestPoint( const dtNavMesh& navMesh, const float3& position, const float3& extents );
+    [[nodiscard]] PathQueryHandle requestRaycast( const dtNavMesh& navMesh, const float3& start, const float3& end, const float3& extents );
+
+    /// Returns true once the query has completed and copies its result out. Every request must be matched by exactly
+    /// one successful poll() or one cancel() call on the returned handle, so that shared handles can be released.
+    [[nodiscard]] bool poll( PathQueryHandle handle, PathQueryResult& resultOut );
+    void cancel( PathQueryHandle handle );
+    /// Drop every pending or completed query that targets navMesh. Must be called before navMesh is destroyed.
+    void purge( const dtNavMesh& navMesh );
+
+    /// Run pending queries until the queue is empty or budgetUS microseconds have elapsed. Returns the number of executed queries.
+    U32 update( U64 budgetUS );
+
+    [[nodiscard]] size_t pendingCount() const;
+
+   private:
+    struct Query
+    {
+        float3 _start;
+        float3 _end;
+        float3 _extents;
+        const dtNavMesh* _navMesh = nullptr;
+        size_t _key = 0u;
+        PathQueryType _type = PathQueryType::COUNT;
+    };
+
+    struct Entry
+    {
+        Query _query;
+        PathQueryResult _result;
+        U32 _refCount = 1u;
+        bool _completed = false;
+    };
+
+    [[nodiscard]] PathQueryHandle request( PathQueryType type, const dtNavMesh& navMesh, const float3& start, const float3& end, const float3& extents );
+    void execute( dtNavMeshQuery& navQuery, const Query& query, PathQueryResult& resultOut ) const;
+    void release( hashMap<PathQueryHandle, Entry>::iterator it );
+
+   private:
+    TaskPool& _pool;
+    dtQueryFilter _filter;
+    const U32 _maxSearchNodes;
+    const U32 _batchSize;
+    /// One query object per concurrent batch. Only touched from update()
+    vector<dtNavMeshQuery*> _navQueries;
+
+    mutable Mutex _lock;
+    /// FIFO of handles that still need to run
+    vector<PathQueryHandle> _pending;
+    hashMap<size_t, PathQueryHandle> _pendingByKey;
+    hashMap<PathQueryHandle, Entry> _entries;
+    PathQueryHandle _nextHandle = INVALID_PATH_QUERY + 1u;
+};
+
+} //namespace AI::Navigation
+} //namespace Divide
+
+#endif //DVD_AI_PATH_QUERY_SERVICE_H_
@@ -0,0 +1,556 @@
+
+
+#include "Headers/DivideTileCache.h"
+
+#include "AI/PathFinding/NavMeshes/Headers/NavMeshLoader.h"
+#include "AI/PathFinding/NavMeshes/Headers/NavMeshContext.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+#include "Utility/Headers/Localization.h"
+
+#include <zlib.h>
+
+namespace Divide::AI::Navigation
+{
+    namespace
+    {
+        /// Temporary data used while rasterizing a single tile column
+        struct RasterizationContext
+        {
+            ~RasterizationContext()
+            {
+                rcFreeHeightField( _solid );
+                rcFreeCompactHeightfield( _chf );
+                rcFreeHeightfieldLayerSet( _lset );
+            }
+
+            rcHeightfield* _solid = nullptr;
+            rcCompactHeightfield* _chf = nullptr;
+            rcHeightfieldLayerSet* _lset = nullptr;
+        };
+
+        /// Precedes the compressed layers in a saved cache
+        struct TileCacheSetHeader
+        {
+            dtTileCacheParams _params;
+            I32 _layerCount = 0;
+        };
+
+        struct TileCacheLayerHeader
+        {
+            dtCompressedTileRef _ref = 0u;
+            I32 _dataSize = 0;
+        };
+    }
+
+    I32 TileCacheCompressor::maxCompressedSize( const I32 bufferSize )
+    {
+        return to_I32( compressBound( to_U32( bufferSize ) ) );
+    }
+
+    dtStatus TileCacheCompressor::compress( const U8* buffer, const I32 bufferSize, U8* compressed, const I32 maxCompressedSize, I32* compressedSize )
+    {
+        uLongf destLength = to_U32( maxCompressedSize );
+        if ( compress2( compressed, &destLength, buffer, to_U32( bufferSize ), Z_BEST_SPEED ) != Z_OK )
+        {
+            return DT_FAILURE;
+        }
+
+        *compressedSize = to_I32( destLength );
+        return DT_SUCCESS;
+    }
+
+    dtStatus TileCacheCompressor::decompress( const U8* compressed, const I32 compressedSize, U8* buffer, const I32 maxBufferSize, I32* bufferSize )
+    {
+        uLongf destLength = to_U32( maxBufferSize );
+        if ( uncompress( buffer, &destLength, compressed, to_U32( compressedSize ) ) != Z_OK )
+        {
+            return DT_FAILURE;
+        }
+
+        *bufferSize = to_I32( destLength );
+        return DT_SUCCESS;
+    }
+
+    void TileCacheMeshProcess::process( dtNavMeshCreateParams* params, U8* polyAreas, U16* polyFlags )
+    {
+        for ( I32 i = 0; i < params->polyCount; ++i )
+        {
+            if ( polyAreas[i] == DT_TILECACHE_WALKABLE_AREA )
+            {
+                polyAreas[i] = to_base( SamplePolyAreas::SAMPLE_POLYAREA_GROUND );
+            }
+
+            if ( polyAreas[i] == to_base( SamplePolyAreas::SAMPLE_POLYAREA_GROUND ) )
+            {
+                polyFlags[i] = to_base( SamplePolyFlags::SAMPLE_POLYFLAGS_WALK );
+            }
+        }
+    }
+
+    DivideTileCache::DivideTileCache( const NavigationMeshConfig& config )
+        : _config( config )
+    {
+    }
+
+    DivideTileCache::~DivideTileCache()
+    {
+        dtFreeTileCache( _tileCache );
+    }
+
+    bool DivideTileCache::build( const NavModelData& data, TaskPool& pool, dtNavMesh*& navMeshOut )
+    {
+        PROFILE_SCOPE_AUTO( Divide::Profiler::Category::Streaming );
+
+        navMeshOut = nullptr;
+
+        rcConfig cfg;
+        memset( &cfg, 0, sizeof cfg );
+
+        cfg.cs = _config.getCellSize();
+        cfg.ch = _config.getCellHeight();
+        cfg.walkableSlopeAngle = _config.getAgentMaxSlope();
+        cfg.walkableHeight = _config.base_getWalkableHeight();
+        cfg.walkableClimb = _config.base_getWalkableClimb();
+        cfg.walkableRadius = _config.base_getWalkableRadius();
+        cfg.maxEdgeLen = _config.getEdgeMaxLen();
+        cfg.maxSimplificationError = _config.getEdgeMaxError();
+        cfg.minRegionArea = _config.getRegionMinSize();
+        cfg.mergeRegionArea = _config.getRegionMergeSize();
+        cfg.maxVertsPerPoly = _config.getVertsPerPoly();
+        cfg.tileSize = _config.getTileSize();
+        // Neighbouring tiles must overlap by at least the agent radius so that erosion produces matching edges
+        cfg.borderSize = cfg.walkableRadius + 3;
+        cfg.width = cfg.tileSize + cfg.borderSize * 2;
+        cfg.height = cfg.tileSize + cfg.borderSize * 2;
+        cfg.detailSampleDist = _config.getDetailSampleDist();
+        cfg.detailSampleMaxError = _config.getDetailSampleMaxError();
+
+        rcCalcBounds( data.getVerts(), to_I32( data.getVertCount() ), cfg.bmin, cfg.bmax );
+
+        I32 gridWidth = 0, gridHeight = 0;
+        rcCalcGridSize( cfg.bmin, cfg.bmax, cfg.cs, &gridWidth, &gridHeight );
+        _tileCountX = (gridWidth + cfg.tileSize - 1) / cfg.tileSize;
+        _tileCountY = (gridHeight + cfg.tileSize - 1) / cfg.tileSize;
+
+        Console::printfn( LOCALE_STR( "NAV_MESH_TILE_GRID" ), _tileCountX, _tileCountY, cfg.tileSize );
+
+        dtTileCacheParams tcParams;
+        memset( &tcParams, 0, sizeof tcParams );
+        rcVcopy( tcParams.orig, cfg.bmin );
+        tcParams.cs = cfg.cs;
+        tcParams.ch = cfg.ch;
+        tcParams.width = cfg.tileSize;
+        tcParams.height = cfg.tileSize;
+        tcParams.walkableHeight = _config.getAgentHeight();
+        tcParams.walkableRadius = _config.getAgentRadius();
+        tcParams.walkableClimb = _config.getAgentMaxClimb();
+        tcParams.maxSimplificationError = cfg.maxSimplificationError;
+        tcParams.maxTiles = _tileCountX * _tileCountY * EXPECTED_LAYERS_PER_TILE;
+        tcParams.maxObstacles = MAX_TILE_CACHE_OBSTACLES;
+
+        // Tile references pack the tile and poly indices into 22 bits
+        const I32 tileBits = std::min( to_I32( dtIlog2( dtNextPow2( to_U32( tcParams.maxTiles ) ) ) ), 14 );
+
+        dtNavMeshParams params;
+        memset( &params, 0, sizeof params );
+        rcVcopy( params.orig, cfg.bmin );
+        params.tileWidth = cfg.tileSize * cfg.cs;
+        params.tileHeight = cfg.tileSize * cfg.cs;
+        params.maxTiles = 1 << tileBits;
+        params.maxPolys = 1 << (22 - tileBits);
+
+        dtNavMesh* navMesh = nullptr;
+        if ( !init( tcParams, params, navMesh ) )
+        {
+            return false;
+        }
+
+        // Bucket triangles per tile (tile bounds include the border) so that every tile only rasterizes what it overlaps
+        const F32 tileWorldSize = cfg.tileSize * cfg.cs;
+        const F32 borderWorldSize = cfg.borderSize * cfg.cs;
+        const F32* verts = data.getVerts();
+        const I32* tris = data.getTris();
+
+        vector<vector<I32>> tileTriangles( to_size( _tileCountX * _tileCountY ) );
+        for ( I32 t = 0; t < to_I32( data.getTriCount() ); ++t )
+        {
+            const F32* v0 = &verts[tris[t * 3 + 0] * 3];
+            const F32* v1 = &verts[tris[t * 3 + 1] * 3];
+            const F32* v2 = &verts[tris[t * 3 + 2] * 3];
+
+            const F32 minX = std::min( { v0[0], v1[0], v2[0] } ) - borderWorldSize;
+            const F32 maxX = std::max( { v0[0], v1[0], v2[0] } ) + borderWorldSize;
+            const F32 minZ = std::min( { v0[2], v1[2], v2[2] } ) - borderWorldSize;
+            const F32 maxZ = std::max( { v0[2], v1[2], v2[2] } ) + borderWorldSize;
+
+            const I32 tx0 = to_I32( std::floor( (minX - cfg.bmin[0]) / tileWorldSize ) );
+            const I32 tx1 = to_I32( std::floor( (maxX - cfg.bmin[0]) / tileWorldSize ) );
+            const I32 ty0 = to_I32( std::floor( (minZ - cfg.bmin[2]) / tileWorldSize ) );
+            const I32 ty1 = to_I32( std::floor( (maxZ - cfg.bmin[2]) / tileWorldSize ) );
+
+            for ( I32 ty = std::max( ty0, 0 ); ty <= std::min( ty1, _tileCountY - 1 ); ++ty )
+            {
+                for ( I32 tx = std::max( tx0, 0 ); tx <= std::min( tx1, _tileCountX - 1 ); ++tx )
+                {
+                    tileTriangles[ty * _tileCountX + tx].push_back( t );
+                }
+            }
+        }
+
+        vector<TileLayers> tiles( tileTriangles.size() );
+        std::atomic_bool failed = false;
+
+        ParallelForDescriptor descriptor = {};
+        descriptor._iterCount = to_U32( tiles.size() );
+        descriptor._partitionSize = 1u;
+        descriptor._priority = TaskPriority::HIGH;
+        Parallel_For( pool, descriptor, [&]( const Task*, const U32 start, const U32 end )
+        {
+            for ( U32 i = start; i < end && !failed; ++i )
+            {
+                const I32 tx = to_I32( i ) % _tileCountX;
+                const I32 ty = to_I32( i ) / _tileCountX;
+                if ( !rasterizeTileLayers( data, tileTriangles[i], tx, ty, cfg, tiles[i] ) )
+                {
+                    Console::errorfn( LOCALE_STR( "ERROR_NAV_TILE_BUILD" ), tx, ty );
+                    failed = true;
+                }
+            }
+        });
+
+        // The cache takes ownership of every layer it accepts. Anything left over is ours to free.
+        // A layer the cache can't take would leave a hole in the navmesh, so that fails the whole build
+        for ( TileLayers& tile : tiles )
+        {
+            for ( I32 i = 0; i < tile._layerCount; ++i )
+            {
+                if ( failed )
+                {
+                    dtFree( tile._data[i] );
+                }
+                else if ( !addLayer( tile._data[i], tile._dataSize[i], nullptr ) )
+                {
+                    failed = true;
+                }
+            }
+        }
+
+        if ( failed )
+        {
+            dtFreeNavMesh( navMesh );
+            return false;
+        }
+
+        // Decompressing the layers and building the final polygons goes through the cache's single allocator and
+        // navMesh->addTile, neither of which are thread safe, so this part stays serial
+        for ( I32 ty = 0; ty < _tileCountY; ++ty )
+        {
+            for ( I32 tx = 0; tx < _tileCountX; ++tx )
+            {
+                if ( dtStatusFailed( _tileCache->buildNavMeshTilesAt( tx, ty, navMesh ) ) )
+                {
+                    Console::errorfn( LOCALE_STR( "ERROR_NAV_TILE_BUILD" ), tx, ty );
+                    dtFreeNavMesh( navMesh );
+                    return false;
+                }
+            }
+        }
+
+        navMeshOut = navMesh;
+        return true;
+    }
+
+    bool DivideTileCache::init( const dtTileCacheParams& cacheParams, const dtNavMeshParams& navMeshParams, dtNavMesh*& navMeshOut )
+    {
+        navMeshOut = nullptr;
+        dtFreeTileCache( _tileCache );
+        _tileCache = nullptr;
+        _compressedSize = 0u;
+
+        _tileCache = dtAllocTileCache();
+        if ( _tileCache == nullptr || dtStatusFailed( _tileCache->init( &cacheParams, &_allocator, &_compressor, &_meshProcess ) ) )
+        {
+            Console::errorfn( LOCALE_STR( "ERROR_NAV_TILE_CACHE_INIT" ) );
+            return false;
+        }
+
+        dtNavMesh* navMesh = dtAllocNavMesh();
+        if ( navMesh == nullptr || dtStatusFailed( navMesh->init( &navMeshParams ) ) )
+        {
+            dtFreeNavMesh( navMesh );
+            Console::errorfn( LOCALE_STR( "ERROR_NAV_TILE_CACHE_INIT" ) );
+            return false;
+        }
+
+        navMeshOut = navMesh;
+        return true;
+    }
+
+    bool DivideTileCache::addLayer( U8* data, const I32 dataSize, dtCompressedTileRef* refOut )
+    {
+        const dtStatus status = _tileCache->addTile( data, dataSize, DT_COMPRESSEDTILE_FREE_DATA, refOut );
+        if ( dtStatusSucceed( status ) )
+        {
+            _compressedSize += to_size( dataSize );
+            return true;
+        }
+
+        // Compressed layers always start with their (uncompressed) header
+        const dtTileCacheLayerHeader* header = reinterpret_cast<const dtTileCacheLayerHeader*>(data);
+        Console::errorfn( LOCALE_STR( "ERROR_NAV_TILE_CACHE_ADD_LAYER" ), header->tlayer, header->tx, header->ty, status );
+        dtFree( data );
+        return false;
+    }
+
+    bool DivideTileCache::save( FILE* fp ) const
+    {
+        if ( _tileCache == nullptr )
+        {
+            return false;
+        }
+
+        TileCacheSetHeader header;
+        memcpy( &header._params, _tileCache->getParams(), sizeof( dtTileCacheParams ) );
+        for ( I32 i = 0; i < _tileCache->getTileCount(); ++i )
+        {
+            const dtCompressedTile* tile = _tileCache->getTile( i );
+            if ( tile != nullptr && tile->header != nullptr && tile->dataSize > 0 )
+            {
+                ++header._layerCount;
+            }
+        }
+
+        if ( fwrite( &header, sizeof header, 1, fp ) != 1 )
+        {
+            return false;
+        }
+
+        for ( I32 i = 0; i < _tileCache->getTileCount(); ++i )
+        {
+            const dtCompressedTile* tile = _tileCache->getTile( i );
+            if ( tile == nullptr || tile->header == nullptr || tile->dataSize <= 0 )
+            {
+                continue;
+            }
+
+            const TileCacheLayerHeader layerHeader
+            {
+                ._ref = _tileCache->getTileRef( tile ),
+                ._dataSize = tile->dataSize
+            };
+
+            if ( fwrite( &layerHeader, sizeof layerHeader, 1, fp ) != 1 ||
+                 fwrite( tile->data, to_size( tile->dataSize ), 1, fp ) != 1 )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool DivideTileCache::load( FILE* fp, const dtNavMeshParams& navMeshParams, dtNavMesh*& navMeshOut )
+    {
+        PROFILE_SCOPE_AUTO( Divide::Profiler::Category::Streaming );
+
+        navMeshOut = nullptr;
+
+        TileCacheSetHeader header;
+        if ( fread( &header, sizeof header, 1, fp ) != 1 || header._layerCount < 0 )
+        {
+            return false;
+        }
+
+        dtNavMesh* navMesh = nullptr;
+        if ( !init( header._params, navMeshParams, navMesh ) )
+        {
+            return false;
+        }
+
+        _tileCountX = _tileCountY = 0;
+
+        vector<dtCompressedTileRef> layers;
+        layers.reserve( to_size( header._layerCount ) );
+        for ( I32 i = 0; i < header._layerCount; ++i )
+        {
+            TileCacheLayerHeader layerHeader;
+            if ( fread( &layerHeader, sizeof layerHeader, 1, fp ) != 1 || layerHeader._dataSize < to_I32( sizeof( dtTileCacheLayerHeader ) ) )
+            {
+                dtFreeNavMesh( navMesh );
+                return false;
+            }
+
+            U8* data = static_cast<U8*>(dtAlloc( to_size( layerHeader._dataSize ), DT_ALLOC_PERM ));
+            if ( data == nullptr || fread( data, to_size( layerHeader._dataSize ), 1, fp ) != 1 )
+            {
+                dtFree( data );
+                dtFreeNavMesh( navMesh );
+                return false;
+            }
+
+            const dtTileCacheLayerHeader* layer = reinterpret_cast<const dtTileCacheLayerHeader*>(data);
+            _tileCountX = std::max( _tileCountX, layer->tx + 1 );
+            _tileCountY = std::max( _tileCountY, layer->ty + 1 );
+
+            dtCompressedTileRef ref = 0u;
+            if ( !addLayer( data, layerHeader._dataSize, &ref ) )
+            {
+                dtFreeNavMesh( navMesh );
+                return false;
+            }
+            layers.push_back( ref );
+        }
+
+        for ( const dtCompressedTileRef ref : layers )
+        {
+            if ( dtStatusFailed( _tileCache->buildNavMeshTile( ref, navMesh ) ) )
+            {
+                const dtTileCacheLayerHeader* layer = _tileCache->getTileByRef( ref )->header;
+                Console::errorfn( LOCALE_STR( "ERROR_NAV_TILE_BUILD" ), layer->tx, layer->ty );
+                dtFreeNavMesh( navMesh );
+                return false;
+            }
+        }
+
+        navMeshOut = navMesh;
+        return true;
+    }
+
+    bool DivideTileCache::rasterizeTileLayers( const NavModelData& data, const vector<I32>& tileTriangles, const I32 tx, const I32 ty, const rcConfig& cfg, TileLayers& layersOut )
+    {
+        layersOut._layerCount = 0;
+        if ( tileTriangles.empty() )
+        {
+            return true;
+        }
+
+        rcContextDivide ctx( false );
+        RasterizationContext rc;
+
+        rcConfig tcfg = cfg;
+        const F32 tileWorldSize = cfg.tileSize * cfg.cs;
+        const F32 borderWorldSize = cfg.borderSize * cfg.cs;
+        tcfg.bmin[0] = cfg.bmin[0] + tx * tileWorldSize - borderWorldSize;
+        tcfg.bmin[2] = cfg.bmin[2] + ty * tileWorldSize - borderWorldSize;
+        tcfg.bmax[0] = cfg.bmin[0] + (tx + 1) * tileWorldSize + borderWorldSize;
+        tcfg.bmax[2] = cfg.bmin[2] + (ty + 1) * tileWorldSize + borderWorldSize;
+
+        rc._solid = rcAllocHeightfield();
+        if ( rc._solid == nullptr || !rcCreateHeightfield( &ctx, *rc._solid, tcfg.width, tcfg.height, tcfg.bmin, tcfg.bmax, tcfg.cs, tcfg.ch ) )
+        {
+            return false;
+        }
+
+        const I32* tris = data.getTris();
+        const I32 triCount = to_I32( tileTriangles.size() );
+
+        vector<I32> localTris( tileTriangles.size() * 3 );
+        for ( I32 i = 0; i < triCount; ++i )
+        {
+            memcpy( &localTris[i * 3], &tris[tileTriangles[i] * 3], sizeof( I32 ) * 3 );
+        }
+
+        vector<U8> areas( tileTriangles.size(), 0u );
+        rcMarkWalkableTriangles( &ctx, tcfg.walkableSlopeAngle, data.getVerts(), to_I32( data.getVertCount() ), localTris.data(), triCount, areas.data() );
+        if ( !rcRasterizeTriangles( &ctx, data.getVerts(), to_I32( data.getVertCount() ), localTris.data(), areas.data(), triCount, *rc._solid, tcfg.walkableClimb ) )
+        {
+            return false;
+        }
+
+        rcFilterLowHangingWalkableObstacles( &ctx, tcfg.walkableClimb, *rc._solid );
+        rcFilterLedgeSpans( &ctx, tcfg.walkableHeight, tcfg.walkableClimb, *rc._solid );
+        rcFilterWalkableLowHeightSpans( &ctx, tcfg.walkableHeight, *rc._solid );
+
+        rc._chf = rcAllocCompactHeightfield();
+        if ( rc._chf == nullptr || !rcBuildCompactHeightfield( &ctx, tcfg.walkableHeight, tcfg.walkableClimb, *rc._solid, *rc._chf ) )
+        {
+            return false;
+        }
+
+        if ( !rcErodeWalkableArea( &ctx, tcfg.walkableRadius, *rc._chf ) )
+        {
+            return false;
+        }
+
+        rc._lset = rcAllocHeightfieldLayerSet();
+        if ( rc._lset == nullptr || !rcBuildHeightfieldLayers( &ctx, *rc._chf, tcfg.borderSize, tcfg.walkableHeight, *rc._lset ) )
+        {
+            return false;
+        }
+
+        for ( I32 i = 0; i < std::min( rc._lset->nlayers, MAX_TILE_CACHE_LAYERS ); ++i )
+        {
+            const rcHeightfieldLayer& layer = rc._lset->layers[i];
+
+            dtTileCacheLayerHeader header;
+            memset( &header, 0, sizeof header );
+            header.magic = DT_TILECACHE_MAGIC;
+            header.version = DT_TILECACHE_VERSION;
+            header.tx = tx;
+            header.ty = ty;
+            header.tlayer = i;
+            dtVcopy( header.bmin, layer.bmin );
+            dtVcopy( header.bmax, layer.bmax );
+            header.width = to_U8( layer.width );
+            header.height = to_U8( layer.height );
+            header.minx = to_U8( layer.minx );
+            header.maxx = to_U8( layer.maxx );
+            header.miny = to_U8( layer.miny );
+            header.maxy = to_U8( layer.maxy );
+            header.hmin = to_U16( layer.hmin );
+            header.hmax = to_U16( layer.hmax );
+
+            if ( dtStatusFailed( dtBuildTileCacheLayer( &_compressor, &header, layer.heights, layer.areas, layer.cons,
+                                             &layersOut._data[i], &layersOut._dataSize[i] ) ) )
+            {
+                return false;
+            }
+
+            layersOut._layerCount = i + 1;
+        }
+
+        return true;
+    }
+
+    dtObstacleRef DivideTileCache::addObstacle( const float3& position, const F32 radius, const F32 height )
+    {
+        dtObstacleRef ret = 0u;
+        if ( _tileCache == nullptr || dtStatusFailed( _tileCache->addObstacle( &position[0], radius, height, &ret ) ) )
+        {
+            return 0u;
+        }
+
+        return ret;
+    }
+
+    dtObstacleRef DivideTileCache::addObstacle( const BoundingBox& aabb )
+    {
+        dtObstacleRef ret = 0u;
+        if ( _tileCache == nullptr || dtStatusFailed( _tileCache->addBoxObstacle( &aabb._min[0], &aabb._max[0], &ret ) ) )
+        {
+            return 0u;
+        }
+
+        return ret;
+    }
+
+    bool DivideTileCache::removeObstacle( const dtObstacleRef obstacle )
+    {
+        return _tileCache != nullptr && obstacle != 0u && dtStatusSucceed( _tileCache->removeObstacle( obstacle ) );
+    }
+
+    bool DivideTileCache::update( const F32 deltaTimeSeconds, dtNavMesh& navMesh )
+    {
+        if ( _tileCache == nullptr )
+        {
+            return true;
+        }
+
+        bool upToDate = false;
+        _tileCache->update( deltaTimeSeconds, &navMesh, &upToDate );
+        return upToDate;
+    }
+
+} //namespace Divide::AI::Navigation
@@ -83,26 +83,23 @@ namespace Navigation {
 
 constexpr I32 NAVMESHSET_MAGIC =
     'M' << 24 | 'S' << 16 | 'E' << 8 | 'T';  //'MSET';
-constexpr I32 NAVMESHSET_VERSION = 1;
+constexpr I32 NAVMESHSET_VERSION = 2;
 
+/// Followed by the compressed tile cache layers (see DivideTileCache::save). Navmesh tiles are rebuilt from those on load
 struct NavMeshSetHeader {
     I32 magic;
     I32 version;
-    I32 numTiles;
     F32 extents[3];
     dtNavMeshParams params;
 };
 
-struct NavMeshTileHeader {
-    dtTileRef tileRef;
-    I32 dataSize;
-};
-
 /// @class NavigationMesh
 /// Represents a set of bounds within which a Recast navigation mesh is
 /// generated.
 class NavMeshDebugDraw;
 class DivideDtCrowd;
+class PathQueryService;
+class DivideTileCache;
 class DivideRecast;
 
 
@@ -116,9 +113,6 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
    protected:
     enum class RenderMode : U8 {
         RENDER_NAVMESH = 0,
-        RENDER_CONTOURS,
-        RENDER_POLYMESH,
-        RENDER_DETAILMESH,
         RENDER_PORTALS,
     };
 
@@ -136,7 +130,7 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
     bool save(const SceneGraphNode* sgn);
     /// Load a saved NavigationMesh from a file.
     bool load(const SceneGraphNode* sgn);
-    /// Unload the navmesh reverting the instance to an empty container
+    /// Unload the navmesh reverting the instance to an empty container. Pending path queries against it are dropped
     bool unload();
     /// Render the debug mesh if debug drawing is enabled
     void draw(bool force, GFX::CommandBuffer& bufferInOut, GFX::MemoryBarrierCommand& memCmdInOut );
@@ -144,11 +138,21 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
     bool debugDraw() const noexcept { return _debugDraw; }
 
     void setRenderMode(const RenderMode& mode) noexcept { _renderMode = mode; }
-    void setRenderConnections(const bool state) noexcept { _renderConnections = state; }
+
+    /// Add a temporary cylinder obstacle (position is the base of the cylinder). Only the tiles it overlaps are rebuilt,
+    /// over the next few update() calls. Returns 0 if there is no mesh yet or the obstacle queue is full.
+    dtObstacleRef addObstacle(const float3& position, F32 radius, F32 height);
+    /// Add a temporary axis aligned box obstacle. Same rules as the cylinder version.
+    dtObstacleRef addObstacle(const BoundingBox& aabb);
+    /// Remove a temporary obstacle and queue a rebuild of the tiles it used to cover
+    bool removeObstacle(dtObstacleRef obstacle);
+    /// Process pending obstacle changes and rebuild the affected tiles
+    void update(U64 deltaTimeUS);
 
     const float3& getExtents() const noexcept { return _extents; }
 
     const dtNavMeshQuery& getNavQuery() const noexcept { return *_navQuery; }
+    const dtNavMesh* getNavMesh() const noexcept { return _navMesh; }
 
     bool getRandomPosition(float3& result) const;
 
@@ -160,7 +164,8 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
                                    const float3& extents, float3& result,
                                    U8 maxIters = 15) const;
 
-    NavigationMesh(PlatformContext& context, DivideRecast& recastInterface, Scene& parentScene);
+    /// pathQueryLock is the lock held around pathQueries.update(). Meshes are only freed while holding it exclusively
+    NavigationMesh(PlatformContext& context, DivideRecast& recastInterface, Scene& parentScene, PathQueryService& pathQueries, SharedMutex& pathQueryLock);
     ~NavigationMesh() override;
 
    private:
@@ -173,13 +178,14 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
     bool buildProcess();
     /// Used for multithreaded loading
     void buildInternal();
-    /// Generates a navigation mesh for the collection of objects in this
-    /// mesh. Returns true if successful. Stores the created mesh in tnm.
+    /// Generates a tiled navigation mesh for the collection of objects in this
+    /// mesh. Returns true if successful. Stores the created mesh in _tempNavMesh
+    /// and the tile cache used to build it in _tempTileCache.
     bool generateMesh();
-    /// Performs the Recast part of the build process.
-    bool createPolyMesh(const rcConfig& cfg, const NavModelData& data, rcContextDivide* ctx);
-    /// Performs the Detour part of the build process.
-    bool createNavigationMesh(dtNavMeshCreateParams& params);
+    /// Replace the active mesh and tile cache with the ones produced by generateMesh()
+    void swapGeneratedMesh();
+    /// Replace the active mesh and tile cache and create a new query for them. Takes ownership of navMesh
+    void swapMesh(dtNavMesh* navMesh, std::unique_ptr<DivideTileCache>&& tileCache);
     /// Load nav mesh configuration from file
     bool loadConfigFromFile();
     /// Create a navigation mesh query to help in pathfinding.
@@ -188,25 +194,19 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
     static Str<256> GenerateMeshName(const SceneGraphNode* sgn);
    private:
     Scene& _parentScene;
-    bool _saveIntermediates = false;
     NavigationMeshConfig _configParams;
     /// @name NavigationMesh build
     /// @{
     /// Do we build in a separate thread?
     bool _buildThreaded;
-    /// @name Intermediate data
-    /// @{
-    rcHeightfield* _heightField;
-    rcCompactHeightfield* _compactHeightField;
-    rcContourSet* _countourSet;
-    rcPolyMesh* _polyMesh;
-    rcPolyMeshDetail* _polyMeshDetail;
+    /// @}
     dtNavMesh* _navMesh;
     dtNavMesh* _tempNavMesh;
-    /// Free all stored working data.
-    /// @param freeAll Force all data to be freed, retain none.
-    void freeIntermediates(bool freeAll);
-    /// @}
+    /// Compressed tile layers backing _navMesh. Saved alongside it, so meshes loaded from disk have one as well
+    std::unique_ptr<DivideTileCache> _tileCache;
+    std::unique_ptr<DivideTileCache> _tempTileCache;
+    /// Set when obstacles changed and the tile cache still has tiles to rebuild
+    bool _obstaclesDirty = false;
 
     /// A thread for us to update in.
     I64 _buildJobGUID = -1;
@@ -228,13 +228,14 @@ class NavigationMesh : public GUIDWrapper, public PlatformContextComponent /*,pu
     /// SceneGraphNode from which to build
     SceneGraphNode* _sgn;
     std::atomic_bool _debugDraw;
-    bool _renderConnections;
     RenderMode _renderMode;
     /// DebugDraw interface
     std::unique_ptr<NavMeshDebugDraw> _debugDrawInterface;
 
     Task* _buildTask = nullptr;
     DivideRecast& _recastInterface;
+    PathQueryService& _pathQueries;
+    SharedMutex& _pathQueryLock;
 };
 
 namespace Attorney {
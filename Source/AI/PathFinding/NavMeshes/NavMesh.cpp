@@ -2,7 +2,9 @@
 
 #include "Headers/NavMesh.h"
 #include "Headers/NavMeshDebugDraw.h"
+#include "AI/PathFinding/NavMeshes/DetourTileCache/Headers/DivideTileCache.h"
 #include "AI/PathFinding/Headers/DivideRecast.h"
+#include "AI/PathFinding/Headers/PathQueryService.h"
 
 #include "Core/Headers/PlatformContext.h"
 #include "Core/Time/Headers/ProfileTimer.h"
@@ -13,34 +15,28 @@
 #include "ECS/Components/Headers/BoundsComponent.h"
 #include "Utility/Headers/Localization.h"
 
-#include <recastnavigation/RecastDump.h>
 #include <recastnavigation/DetourDebugDraw.h>
-#include <recastnavigation/RecastDebugDraw.h>
 
 #include <SimpleIni.h>
 
 namespace Divide::AI::Navigation
 {
 
-    NavigationMesh::NavigationMesh( PlatformContext& context, DivideRecast& recastInterface, Scene& parentScene )
+    NavigationMesh::NavigationMesh( PlatformContext& context, DivideRecast& recastInterface, Scene& parentScene, PathQueryService& pathQueries, SharedMutex& pathQueryLock )
         : GUIDWrapper()
         , PlatformContextComponent( context )
         , _parentScene(parentScene)
         , _debugDrawInterface( std::make_unique<NavMeshDebugDraw>( context.gfx() ) )
         , _recastInterface( recastInterface )
+        , _pathQueries( pathQueries )
+        , _pathQueryLock( pathQueryLock )
     {
         _filePath =  Scene::GetSceneFullPath( _parentScene ) / Paths::g_navMeshesLocation;
         _configFile = (_filePath / "navMeshConfig.ini").string();
 
         _buildThreaded = true;
         _debugDraw = false;
-        _renderConnections = false;
         _renderMode = RenderMode::RENDER_NAVMESH;
-        _heightField = nullptr;
-        _compactHeightField = nullptr;
-        _countourSet = nullptr;
-        _polyMesh = nullptr;
-        _polyMeshDetail = nullptr;
         _navMesh = nullptr;
         _tempNavMesh = nullptr;
         _navQuery = nullptr;
@@ -55,6 +51,7 @@ namespace Divide::AI::Navigation
 
     bool NavigationMesh::unload()
     {
+        // Before taking the query lock: a build that is about to finish needs it to swap its mesh in
         stopThreadedBuild();
 
         if ( _navQuery )
@@ -63,11 +60,19 @@ namespace Divide::AI::Navigation
             _navQuery = nullptr;
         }
 
-        freeIntermediates( true );
+        LockGuard<SharedMutex> q_lock( _pathQueryLock );
+        LockGuard<Mutex> w_lock( _navigationMeshLock );
+        if ( _navMesh != nullptr )
+        {
+            _pathQueries.purge( *_navMesh );
+        }
         dtFreeNavMesh( _navMesh );
         dtFreeNavMesh( _tempNavMesh );
         _navMesh = nullptr;
         _tempNavMesh = nullptr;
+        _tileCache.reset();
+        _tempTileCache.reset();
+        _obstaclesDirty = false;
 
         return true;
     }
@@ -82,26 +87,6 @@ namespace Divide::AI::Navigation
         }
     }
 
-    void NavigationMesh::freeIntermediates( const bool freeAll )
-    {
-        LockGuard<Mutex> w_lock( _navigationMeshLock );
-
-        rcFreeHeightField( _heightField );
-        rcFreeCompactHeightfield( _compactHeightField );
-        _heightField = nullptr;
-        _compactHeightField = nullptr;
-
-        if ( !_saveIntermediates || freeAll )
-        {
-            rcFreeContourSet( _countourSet );
-            rcFreePolyMesh( _polyMesh );
-            rcFreePolyMeshDetail( _polyMeshDetail );
-            _countourSet = nullptr;
-            _polyMesh = nullptr;
-            _polyMeshDetail = nullptr;
-        }
-    }
-
     namespace
     {
         I32 charToInt( const char* val, const I32 defaultValue)
@@ -230,24 +215,8 @@ namespace Divide::AI::Navigation
             Console::printfn( LOCALE_STR( "NAV_MESH_GENERATION_COMPLETE" ),
                               Time::MicrosecondsToSeconds<F32>( importTimer.get() ) );
 
-            {
-                std::lock_guard<Mutex> lock( _navigationMeshLock );
-                // Copy new NavigationMesh into old.
-                dtNavMesh* old = _navMesh;
-                // I am trusting that this is atomic.
-                _navMesh = _tempNavMesh;
-                dtFreeNavMesh( old );
-                _debugDrawInterface->setDirty( true );
-                _tempNavMesh = nullptr;
-
-                const bool navQueryComplete = createNavigationQuery();
-                DIVIDE_ASSERT(
-                    navQueryComplete,
-                    "NavigationMesh Error: Navigation query creation failed!" );
-            }
-
-            // Free structs used during build
-            freeIntermediates( false );
+            swapGeneratedMesh();
+            save( _sgn );
 
             if ( _loadCompleteClbk )
             {
@@ -281,24 +250,8 @@ namespace Divide::AI::Navigation
         Console::printfn( LOCALE_STR( "NAV_MESH_GENERATION_COMPLETE" ),
                           Time::MicrosecondsToSeconds<F32>( importTimer.get() ) );
 
-        {
-            LockGuard<Mutex> w_lock( _navigationMeshLock );
-            // Copy new NavigationMesh into old.
-            dtNavMesh* old = _navMesh;
-            // I am trusting that this is atomic.
-            _navMesh = _tempNavMesh;
-            dtFreeNavMesh( old );
-            _debugDrawInterface->setDirty( true );
-            _tempNavMesh = nullptr;
-
-            const bool navQueryComplete = createNavigationQuery();
-            DIVIDE_ASSERT(
-                navQueryComplete,
-                "NavigationMesh Error: Navigation query creation failed!" );
-        }
-
-        // Free structs used during build
-        freeIntermediates( false );
+        swapGeneratedMesh();
+        save( _sgn );
 
         _building = false;
 
@@ -345,297 +298,115 @@ namespace Divide::AI::Navigation
             return false;
         }
 
-        // Free intermediate and final results
-        freeIntermediates( true );
-        // Recast initialisation data
-        rcContextDivide ctx( true );
-
-        rcConfig cfg;
-        memset( &cfg, 0, sizeof cfg );
-
-        cfg.cs = _configParams.getCellSize();
-        cfg.ch = _configParams.getCellHeight();
-        cfg.walkableHeight = _configParams.base_getWalkableHeight();
-        cfg.walkableClimb = _configParams.base_getWalkableClimb();
-        cfg.walkableRadius = _configParams.base_getWalkableRadius();
-        cfg.walkableSlopeAngle = _configParams.getAgentMaxSlope();
-        cfg.borderSize =
-            _configParams.base_getWalkableRadius() + (I32)BORDER_PADDING;
-        cfg.detailSampleDist = _configParams.getDetailSampleDist();
-        cfg.detailSampleMaxError = _configParams.getDetailSampleMaxError();
-        cfg.maxEdgeLen = _configParams.getEdgeMaxLen();
-        cfg.maxSimplificationError = _configParams.getEdgeMaxError();
-        cfg.maxVertsPerPoly = _configParams.getVertsPerPoly();
-        cfg.minRegionArea = _configParams.getRegionMinSize();
-        cfg.mergeRegionArea = _configParams.getRegionMergeSize();
-        cfg.tileSize = _configParams.getTileSize();
-
-        _saveIntermediates = _configParams.getKeepInterResults();
-        rcCalcBounds( data.getVerts(), data.getVertCount(), cfg.bmin, cfg.bmax );
-        rcCalcGridSize( cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height );
-        Console::printfn( LOCALE_STR( "NAV_MESH_BOUNDS" ), cfg.bmax[0], cfg.bmax[1],
-                          cfg.bmax[2], cfg.bmin[0], cfg.bmin[1], cfg.bmin[2] );
-
-        _extents = float3( cfg.bmax[0] - cfg.bmin[0], cfg.bmax[1] - cfg.bmin[1],
-                              cfg.bmax[2] - cfg.bmin[2] );
-
-        if ( !createPolyMesh( cfg, data, &ctx ) )
-        {
-            data.valid( false );
-            return false;
-        }
-
-        // Detour initialisation data
-        dtNavMeshCreateParams params;
-        memset( &params, 0, sizeof params );
-        rcVcopy( params.bmax, cfg.bmax );
-        rcVcopy( params.bmin, cfg.bmin );
-
-        params.ch = cfg.ch;
-        params.cs = cfg.cs;
-        params.walkableHeight = to_F32( cfg.walkableHeight );
-        params.walkableRadius = to_F32( cfg.walkableRadius );
-        params.walkableClimb = to_F32( cfg.walkableClimb );
-
-        params.tileX = 0;
-        params.tileY = 0;
-        params.tileLayer = 0;
-        params.buildBvTree = true;
-
-        params.verts = _polyMesh->verts;
-        params.vertCount = _polyMesh->nverts;
-        params.polys = _polyMesh->polys;
-        params.polyAreas = _polyMesh->areas;
-        params.polyFlags = _polyMesh->flags;
-        params.polyCount = _polyMesh->npolys;
-        params.nvp = _polyMesh->nvp;
-
-        params.detailMeshes = _polyMeshDetail->meshes;
-        params.detailVerts = _polyMeshDetail->verts;
-        params.detailVertsCount = _polyMeshDetail->nverts;
-        params.detailTris = _polyMeshDetail->tris;
-        params.detailTriCount = _polyMeshDetail->ntris;
-
-
-        if ( _navMesh )
-        {
-            dtFreeNavMesh( _navMesh );
-        }
+        F32 bmin[3], bmax[3];
+        rcCalcBounds( data.getVerts(), data.getVertCount(), bmin, bmax );
+        Console::printfn( LOCALE_STR( "NAV_MESH_BOUNDS" ), bmax[0], bmax[1], bmax[2], bmin[0], bmin[1], bmin[2] );
 
-        load( _sgn );
-        if ( _navMesh == nullptr )
-        {
-            createNavigationMesh( params );
-        }
+        _extents = float3( bmax[0] - bmin[0], bmax[1] - bmin[1], bmax[2] - bmin[2] );
 
-        if ( _navMesh == nullptr )
+        // Tiles are rasterized in parallel and kept around as compressed layers so that obstacles can patch them later
+        dtFreeNavMesh( _tempNavMesh );
+        _tempNavMesh = nullptr;
+        _tempTileCache = std::make_unique<DivideTileCache>( _configParams );
+        if ( !_tempTileCache->build( data, _context.taskPool( TaskPoolType::HIGH_PRIORITY ), _tempNavMesh ) )
         {
+            _tempTileCache.reset();
             data.valid( false );
             return false;
         }
 
         data.valid( true );
-        save( _sgn );
 
         return NavigationMeshLoader::SaveMeshFile( data, _filePath, geometrySaveFile.c_str() );  // input geometry;
     }
 
+    void NavigationMesh::swapGeneratedMesh()
+    {
+        swapMesh( _tempNavMesh, MOV( _tempTileCache ) );
+        _tempNavMesh = nullptr;
+    }
+
+    void NavigationMesh::swapMesh( dtNavMesh* navMesh, std::unique_ptr<DivideTileCache>&& tileCache )
+    {
+        // Path queries run outside of our own lock, so keep the service from touching the old mesh until it is gone.
+        // Lock order matches AIManager::update: query lock first, then ours
+        LockGuard<SharedMutex> q_lock( _pathQueryLock );
+        LockGuard<Mutex> w_lock( _navigationMeshLock );
+        // Copy new NavigationMesh into old.
+        dtNavMesh* old = _navMesh;
+        _navMesh = navMesh;
+        if ( old != nullptr )
+        {
+            _pathQueries.purge( *old );
+        }
+        dtFreeNavMesh( old );
+        _tileCache = MOV( tileCache );
+        _obstaclesDirty = false;
+        _debugDrawInterface->setDirty( true );
+
+        const bool navQueryComplete = createNavigationQuery();
+        DIVIDE_ASSERT(
+            navQueryComplete,
+            "NavigationMesh Error: Navigation query creation failed!" );
+    }
+
     bool NavigationMesh::createNavigationQuery( const U32 maxNodes )
     {
         _navQuery = dtAllocNavMeshQuery();
         return _navQuery->init( _navMesh, maxNodes ) == DT_SUCCESS;
     }
 
-    bool NavigationMesh::createPolyMesh( const rcConfig& cfg, const NavModelData& data, rcContextDivide* ctx )
+    dtObstacleRef NavigationMesh::addObstacle( const float3& position, const F32 radius, const F32 height )
     {
-        if ( _fileName.empty() )
-        {
-            _fileName = data.name();
-        }
-
-        // Create a heightfield to voxelise our input geometry
-        _heightField = rcAllocHeightfield();
-
-        if ( !_heightField )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_OUT_OF_MEMORY" ), "rcAllocHeightfield", _fileName.c_str() );
-            return false;
-        }
-
-        // Reset build times gathering.
-        ctx->resetTimers();
-        // Start the build process.
-        ctx->startTimer( RC_TIMER_TOTAL );
-        ctx->log( RC_LOG_PROGRESS, "Building navigation:" );
-        ctx->log( RC_LOG_PROGRESS, " - %d x %d cells", cfg.width, cfg.height );
-        ctx->log( RC_LOG_PROGRESS, " - %.1fK verts, %.1fK tris",
-                  data.getVertCount() / 1000.0f, data.getTriCount() / 1000.0f );
-
-        if ( !rcCreateHeightfield( ctx, *_heightField, cfg.width, cfg.height,
-                                   cfg.bmin, cfg.bmax, cfg.cs, cfg.ch ) )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_HEIGHTFIELD" ), _fileName.c_str() );
-            return false;
-        }
-
-        U8* areas = new U8[data.getTriCount()];
-
-        if ( !areas )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_OUT_OF_MEMORY" ), "areaFlag allocation", _fileName.c_str() );
-            return false;
-        }
-
-        memset( areas, 0, data.getTriCount() * sizeof( U8 ) );
-
-        // Filter triangles by angle and rasterize
-        rcMarkWalkableTriangles( ctx, cfg.walkableSlopeAngle, data.getVerts(),
-                                 data.getVertCount(), data.getTris(),
-                                 data.getTriCount(), areas );
-
-        rcRasterizeTriangles( ctx, data.getVerts(), data.getVertCount(),
-                              data.getTris(), areas, data.getTriCount(),
-                              *_heightField, cfg.walkableClimb );
-
-        if ( !_saveIntermediates )
-        {
-            delete[] areas;
-        }
-
-        // Filter out areas with low ceilings and other stuff
-        rcFilterLowHangingWalkableObstacles( ctx, cfg.walkableClimb, *_heightField );
-
-        rcFilterLedgeSpans( ctx, cfg.walkableHeight, cfg.walkableClimb,
-                            *_heightField );
-
-        rcFilterWalkableLowHeightSpans( ctx, cfg.walkableHeight, *_heightField );
-
-        _compactHeightField = rcAllocCompactHeightfield();
-
-        if ( !_compactHeightField ||
-             !rcBuildCompactHeightfield( ctx, cfg.walkableHeight, cfg.walkableClimb,
-                                         *_heightField, *_compactHeightField ) )
+        LockGuard<Mutex> w_lock( _navigationMeshLock );
+        if ( !_tileCache )
         {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_COMPACT_HEIGHTFIELD" ), _fileName.c_str() );
-            return false;
+            return 0u;
         }
 
-        if ( !rcErodeWalkableArea( ctx, cfg.walkableRadius, *_compactHeightField ) )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_WALKABLE" ), _fileName.c_str() );
-            return false;
-        }
-
-        if constexpr( false )
-        {
-            if ( !rcBuildRegionsMonotone( ctx, *_compactHeightField, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea ) )
-            {
-                Console::errorfn( LOCALE_STR( "ERROR_NAV_REGIONS" ), _fileName.c_str() );
-                return false;
-            }
-        }
-        else
-        {
-            if ( !rcBuildDistanceField( ctx, *_compactHeightField ) )
-            {
-                return false;
-            }
-
-            if ( !rcBuildRegions( ctx, *_compactHeightField, cfg.borderSize,
-                                  cfg.minRegionArea, cfg.mergeRegionArea ) )
-            {
-                return false;
-            }
-        }
+        const dtObstacleRef ret = _tileCache->addObstacle( position, radius, height );
+        _obstaclesDirty = _obstaclesDirty || ret != 0u;
+        return ret;
+    }
 
-        _countourSet = rcAllocContourSet();
-        if ( !_countourSet ||
-             !rcBuildContours( ctx, *_compactHeightField, cfg.maxSimplificationError,
-                               cfg.maxEdgeLen, *_countourSet ) )
+    dtObstacleRef NavigationMesh::addObstacle( const BoundingBox& aabb )
+    {
+        LockGuard<Mutex> w_lock( _navigationMeshLock );
+        if ( !_tileCache )
         {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_COUNTOUR" ), _fileName.c_str() );
-            return false;
+            return 0u;
         }
 
-        _polyMesh = rcAllocPolyMesh();
-        if ( !_polyMesh ||
-             !rcBuildPolyMesh( ctx, *_countourSet, cfg.maxVertsPerPoly, *_polyMesh ) )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_POLY_MESH" ), _fileName.c_str() );
-            return false;
-        }
+        const dtObstacleRef ret = _tileCache->addObstacle( aabb );
+        _obstaclesDirty = _obstaclesDirty || ret != 0u;
+        return ret;
+    }
 
-        _polyMeshDetail = rcAllocPolyMeshDetail();
-        if ( !_polyMeshDetail ||
-             !rcBuildPolyMeshDetail( ctx, *_polyMesh, *_compactHeightField,
-                                     cfg.detailSampleDist, cfg.detailSampleMaxError,
-                                     *_polyMeshDetail ) )
+    bool NavigationMesh::removeObstacle( const dtObstacleRef obstacle )
+    {
+        LockGuard<Mutex> w_lock( _navigationMeshLock );
+        if ( !_tileCache || !_tileCache->removeObstacle( obstacle ) )
         {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_POLY_MESH_DETAIL" ), _fileName.c_str() );
             return false;
         }
 
-        // Show performance stats.
-        ctx->stopTimer( RC_TIMER_TOTAL );
-        duLogBuildTimes( *ctx, ctx->getAccumulatedTime( RC_TIMER_TOTAL ) );
-        ctx->log( RC_LOG_PROGRESS, ">> Polymesh: %d vertices  %d polygons",
-                  _polyMesh->nverts, _polyMesh->npolys );
-
-        Console::printfn(
-            "[RC_LOG_PROGRESS] Polymesh: %d vertices  %d polygons %5.2f ms\n",
-            _polyMesh->nverts, _polyMesh->npolys,
-            to_F32( ctx->getAccumulatedTime( RC_TIMER_TOTAL ) / 1000.0f ) );
-
+        _obstaclesDirty = true;
         return true;
     }
 
-    bool NavigationMesh::createNavigationMesh( dtNavMeshCreateParams& params )
+    void NavigationMesh::update( const U64 deltaTimeUS )
     {
+        PROFILE_SCOPE_AUTO( Divide::Profiler::Category::GameLogic );
 
-        U8* tileData = nullptr;
-        I32 tileDataSize = 0;
-        if ( !dtCreateNavMeshData( &params, &tileData, &tileDataSize ) )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_MESH_DATA" ), _fileName.c_str() );
-            return false;
-        }
-
-        _tempNavMesh = dtAllocNavMesh();
-        if ( !_tempNavMesh )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_DT_OUT_OF_MEMORY" ), _fileName.c_str() );
-            return false;
-        }
-
-        const dtStatus s = _tempNavMesh->init( tileData, tileDataSize, DT_TILE_FREE_DATA );
-        if ( dtStatusFailed( s ) )
-        {
-            Console::errorfn( LOCALE_STR( "ERROR_NAV_DT_INIT" ), _fileName.c_str() );
-            return false;
-        }
-
-        // Initialise all flags to something helpful.
-        for ( U32 i = 0; i < to_U32( _tempNavMesh->getMaxTiles() ); ++i )
+        LockGuard<Mutex> w_lock( _navigationMeshLock );
+        if ( !_obstaclesDirty || !_tileCache || !_navMesh )
         {
-            const dtMeshTile* tile = ((const dtNavMesh*)_tempNavMesh)->getTile( i );
-
-            if ( !tile->header )
-            {
-                continue;
-            }
-
-            const dtPolyRef base = _tempNavMesh->getPolyRefBase( tile );
-
-            for ( U32 j = 0; j < to_U32( tile->header->polyCount ); ++j )
-            {
-                const dtPolyRef ref = base | j;
-                U16 f = 0;
-                _tempNavMesh->getPolyFlags( ref, &f );
-                _tempNavMesh->setPolyFlags( ref, f | 1 );
-            }
+            return;
         }
 
-        return true;
+        // Each call only processes a bounded number of requests and tiles, so big changes are spread over a few frames
+        _obstaclesDirty = !_tileCache->update( Time::MicrosecondsToSeconds<F32>( deltaTimeUS ), *_navMesh );
+        _debugDrawInterface->setDirty( true );
     }
 
     void NavigationMesh::draw( const bool force, GFX::CommandBuffer& bufferInOut, GFX::MemoryBarrierCommand& memCmdInOut )
@@ -663,24 +434,6 @@ namespace Divide::AI::Navigation
                         duDebugDrawNavMesh( _debugDrawInterface.get(), *_navMesh, 0 );
                     }
                     break;
-                case RenderMode::RENDER_CONTOURS:
-                    if ( _countourSet )
-                    {
-                        duDebugDrawContours( _debugDrawInterface.get(), *_countourSet );
-                    }
-                    break;
-                case RenderMode::RENDER_POLYMESH:
-                    if ( _polyMesh )
-                    {
-                        duDebugDrawPolyMesh( _debugDrawInterface.get(), *_polyMesh );
-                    }
-                    break;
-                case RenderMode::RENDER_DETAILMESH:
-                    if ( _polyMeshDetail )
-                    {
-                        duDebugDrawPolyMeshDetail( _debugDrawInterface.get(), *_polyMeshDetail );
-                    }
-                    break;
                 case RenderMode::RENDER_PORTALS:
                     if ( _navMesh )
                     {
@@ -691,15 +444,6 @@ namespace Divide::AI::Navigation
                 default:
                     break;
             }
-
-            if ( !_building )
-            {
-                if ( _countourSet && _renderConnections )
-                {
-                    duDebugDrawRegionConnections( _debugDrawInterface.get(), *_countourSet );
-                }
-            }
-
         }
 
         _debugDrawInterface->endBatch();
@@ -731,64 +475,28 @@ namespace Divide::AI::Navigation
         }
         // Read header.
         NavMeshSetHeader header;
-        fread( &header, sizeof( NavMeshSetHeader ), 1, fp );
-
-        if ( header.magic != NAVMESHSET_MAGIC )
-        {
-            fclose( fp );
-            return false;
-        }
-
-        if ( header.version != NAVMESHSET_VERSION )
-        {
-            fclose( fp );
-            return false;
-        }
-
-        std::lock_guard<Mutex> lock( _navigationMeshLock );
-        dtNavMesh* temp = dtAllocNavMesh();
-
-        if ( !temp )
+        if ( fread( &header, sizeof( NavMeshSetHeader ), 1, fp ) != 1 ||
+             header.magic != NAVMESHSET_MAGIC ||
+             header.version != NAVMESHSET_VERSION )
         {
             fclose( fp );
             return false;
         }
 
-        const dtStatus status = temp->init( &header.params );
+        // Restore the compressed layers and rebuild the mesh from them, so that obstacles work on loaded meshes as well
+        std::unique_ptr<DivideTileCache> tileCache = std::make_unique<DivideTileCache>( _configParams );
+        dtNavMesh* navMesh = nullptr;
+        const bool loaded = tileCache->load( fp, header.params, navMesh );
+        fclose( fp );
 
-        if ( dtStatusFailed( status ) )
+        if ( !loaded )
         {
-            fclose( fp );
             return false;
         }
 
-        // Read tiles.
-        for ( U32 i = 0; i < to_U32( header.numTiles ); ++i )
-        {
-            NavMeshTileHeader tileHeader;
-            fread( &tileHeader, sizeof tileHeader, 1, fp );
-            if ( !tileHeader.tileRef || !tileHeader.dataSize )
-            {
-                return false;  // break;
-            }
-            U8* data = (U8*)dtAlloc( tileHeader.dataSize, DT_ALLOC_PERM );
-
-            if ( !data )
-            {
-                return false;  // break;
-            }
-
-            memset( data, 0, tileHeader.dataSize );
-            fread( data, tileHeader.dataSize, 1, fp );
-
-            temp->addTile( data, tileHeader.dataSize, DT_TILE_FREE_DATA,
-                           tileHeader.tileRef, nullptr );
-        }
-        fclose( fp );
-
         _extents.set( header.extents[0], header.extents[1], header.extents[2] );
-        _navMesh = temp;
-        return createNavigationQuery();
+        swapMesh( navMesh, MOV( tileCache ) );
+        return true;
     }
 
     bool NavigationMesh::save( const SceneGraphNode* sgn )
@@ -819,43 +527,16 @@ namespace Divide::AI::Navigation
 
         header.magic = NAVMESHSET_MAGIC;
         header.version = NAVMESHSET_VERSION;
-        header.numTiles = 0;
-
-        for ( U32 i = 0; i < to_U32( _navMesh->getMaxTiles() ); ++i )
-        {
-            const dtMeshTile* tile = ((const dtNavMesh*)_navMesh)->getTile( i );
-
-            if ( !tile || !tile->header || !tile->dataSize )
-            {
-                continue;
-            }
-            header.numTiles++;
-        }
-
         memcpy( &header.params, _navMesh->getParams(), sizeof( dtNavMeshParams ) );
-        fwrite( &header, sizeof( NavMeshSetHeader ), 1, fp );
-
-        // Store tiles.
-        for ( U32 i = 0; i < to_U32( _navMesh->getMaxTiles() ); ++i )
-        {
-            const dtMeshTile* tile = ((const dtNavMesh*)_navMesh)->getTile( i );
-
-            if ( !tile || !tile->header || !tile->dataSize )
-            {
-                continue;
-            }
 
-            NavMeshTileHeader tileHeader;
-            tileHeader.tileRef = _navMesh->getTileRef( tile );
-            tileHeader.dataSize = tile->dataSize;
-
-            fwrite( &tileHeader, sizeof tileHeader, 1, fp );
-            fwrite( tile->data, tile->dataSize, 1, fp );
-        }
+        // Store the compressed tile layers. They are a lot smaller than the tiles built from them
+        const bool saved = _tileCache != nullptr &&
+                           fwrite( &header, sizeof( NavMeshSetHeader ), 1, fp ) == 1 &&
+                           _tileCache->save( fp );
 
         fclose( fp );
 
-        return true;
+        return saved;
     }
 
     Str<256> NavigationMesh::GenerateMeshName( const SceneGraphNode* sgn )
@@ -0,0 +1,384 @@
+
+
+#include "Headers/PathQueryService.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Time/Headers/ApplicationTimer.h"
+
+namespace Divide::AI::Navigation
+{
+    PathQueryService::PathQueryService( TaskPool& pool, const U32 maxSearchNodes, const U32 batchSize )
+        : _pool( pool )
+        , _maxSearchNodes( maxSearchNodes )
+        , _batchSize( std::max( batchSize, 1u ) )
+    {
+        // Same filter as DivideRecast: walk on everything the navmesh generator marked as ground
+        _filter.setIncludeFlags( 0xFFFF );
+        _filter.setExcludeFlags( 0 );
+        _filter.setAreaCost( to_I32( SamplePolyAreas::SAMPLE_POLYAREA_GROUND ), 1.0f );
+        _filter.setAreaCost( RC_WALKABLE_AREA, 1.0f );
+    }
+
+    PathQueryService::~PathQueryService()
+    {
+        for ( dtNavMeshQuery* navQuery : _navQueries )
+        {
+            dtFreeNavMeshQuery( navQuery );
+        }
+    }
+
+    PathQueryHandle PathQueryService::requestPath( const dtNavMesh& navMesh, const float3& start, const float3& end, const float3& extents )
+    {
+        return request( PathQueryType::PATH, navMesh, start, end, extents );
+    }
+
+    PathQueryHandle PathQueryService::requestClosestPoint( const dtNavMesh& navMesh, const float3& position, const float3& extents )
+    {
+        return request( PathQueryType::CLOSEST_POINT, navMesh, position, position, extents );
+    }
+
+    PathQueryHandle PathQueryService::requestRaycast( const dtNavMesh& navMesh, const float3& start, const float3& end, const float3& extents )
+    {
+        return request( PathQueryType::RAYCAST, navMesh, start, end, extents );
+    }
+
+    PathQueryHandle PathQueryService::request( const PathQueryType type, const dtNavMesh& navMesh, const float3& start, const float3& end, const float3& extents )
+    {
+        Query query{};
+        query._start = start;
+        query._end = end;
+        query._extents = extents;
+        query._navMesh = &navMesh;
+        query._type = type;
+        Util::Hash_combine( query._key, static_cast<const void*>(&navMesh), to_base( type ),
+                            start.x, start.y, start.z,
+                            end.x, end.y, end.z,
+                            extents.x, extents.y, extents.z );
+
+        LockGuard<Mutex> w_lock( _lock );
+
+        // Identical requests that have not run yet share one entry (e.g. a whole squad heading for the same flag)
+        const auto pendingIt = _pendingByKey.find( query._key );
+        if ( pendingIt != std::end( _pendingByKey ) )
+        {
+            Entry& entry = _entries[pendingIt->second];
+            if ( entry._query._navMesh == query._navMesh &&
+                 entry._query._type == query._type &&
+                 entry._query._start == query._start &&
+                 entry._query._end == query._end &&
+                 entry._query._extents == query._extents )
+            {
+                ++entry._refCount;
+                return pendingIt->second;
+            }
+        }
+
+        const PathQueryHandle handle = _nextHandle++;
+        if ( _nextHandle == INVALID_PATH_QUERY )
+        {
+            _nextHandle = INVALID_PATH_QUERY + 1u;
+        }
+
+        _entries[handle]._query = query;
+        _pendingByKey[query._key] = handle;
+        _pending.push_back( handle );
+
+        return handle;
+    }
+
+    bool PathQueryService::poll( const PathQueryHandle handle, PathQueryResult& resultOut )
+    {
+        LockGuard<Mutex> w_lock( _lock );
+
+        const auto it = _entries.find( handle );
+        if ( it == std::end( _entries ) || !it->second._completed )
+        {
+            return false;
+        }
+
+        if ( it->second._refCount == 1u )
+        {
+            resultOut = MOV( it->second._result );
+        }
+        else
+        {
+            resultOut = it->second._result;
+        }
+
+        release( it );
+        return true;
+    }
+
+    void PathQueryService::cancel( const PathQueryHandle handle )
+    {
+        LockGuard<Mutex> w_lock( _lock );
+
+        const auto it = _entries.find( handle );
+        if ( it != std::end( _entries ) )
+        {
+            release( it );
+        }
+    }
+
+    void PathQueryService::release( const hashMap<PathQueryHandle, Entry>::iterator it )
+    {
+        if ( --it->second._refCount > 0u )
+        {
+            return;
+        }
+
+        const PathQueryHandle handle = it->first;
+        if ( !it->second._completed )
+        {
+            dvd_erase_if( _pending, [handle]( const PathQueryHandle pending ) { return pending == handle; } );
+
+            const auto pendingIt = _pendingByKey.find( it->second._query._key );
+            if ( pendingIt != std::end( _pendingByKey ) && pendingIt->second == handle )
+            {
+                _pendingByKey.erase( pendingIt );
+            }
+        }
+
+        _entries.erase( it );
+    }
+
+    void PathQueryService::purge( const dtNavMesh& navMesh )
+    {
+        LockGuard<Mutex> w_lock( _lock );
+
+        for ( auto it = std::begin( _entries ); it != std::end( _entries ); )
+        {
+            if ( it->second._query._navMesh != &navMesh )
+            {
+                ++it;
+                continue;
+            }
+
+            const PathQueryHandle handle = it->first;
+            dvd_erase_if( _pending, [handle]( const PathQueryHandle pending ) { return pending == handle; } );
+
+            const auto pendingIt = _pendingByKey.find( it->second._query._key );
+            if ( pendingIt != std::end( _pendingByKey ) && pendingIt->second == handle )
+            {
+                _pendingByKey.erase( pendingIt );
+            }
+
+            it = _entries.erase( it );
+        }
+    }
+
+    size_t PathQueryService::pendingCount() const
+    {
+        LockGuard<Mutex> w_lock( _lock );
+        return _pending.size();
+    }
+
+    U32 PathQueryService::update( const U64 budgetUS )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::GameLogic );
+
+        const D64 startTimeUS = Time::App::ElapsedMicroseconds();
+
+        // One batch per worker plus one for the calling thread
+        const size_t slotCount = _pool.threads().size() + 1u;
+        while ( _navQueries.size() < slotCount )
+        {
+            _navQueries.push_back( dtAllocNavMeshQuery() );
+        }
+
+        const auto budgetSpent = [startTimeUS, budgetUS]()
+        {
+            return Time::App::ElapsedMicroseconds() - startTimeUS >= to_D64( budgetUS );
+        };
+
+        U32 executedCount = 0u;
+
+        vector<PathQueryHandle> waveHandles;
+        vector<Query> wave;
+        vector<PathQueryResult> results;
+        vector<U8> executed;
+        bool outOfBudget = false;
+        do
+        {
+            waveHandles.resize( 0 );
+            wave.resize( 0 );
+            {
+                LockGuard<Mutex> w_lock( _lock );
+                if ( _pending.empty() )
+                {
+                    break;
+                }
+
+                const size_t count = std::min( _pending.size(), slotCount * _batchSize );
+                waveHandles.insert( waveHandles.end(), _pending.begin(), _pending.begin() + count );
+                _pending.erase( _pending.begin(), _pending.begin() + count );
+
+                for ( const PathQueryHandle handle : waveHandles )
+                {
+                    const Query& query = _entries[handle]._query;
+                    _pendingByKey.erase( query._key );
+                    wave.push_back( query );
+                }
+            }
+
+            results.resize( 0 );
+            results.resize( wave.size() );
+            executed.resize( 0 );
+            executed.resize( wave.size(), 0u );
+
+            ParallelForDescriptor descriptor = {};
+            descriptor._iterCount = to_U32( wave.size() );
+            descriptor._partitionSize = _batchSize;
+            descriptor._priority = TaskPriority::HIGH;
+            Parallel_For( _pool, descriptor, [&]( const Task*, const U32 start, const U32 end )
+            {
+                // Partitions never overlap, so each one owns its query object for the duration of the wave
+                dtNavMeshQuery& navQuery = *_navQueries[start / _batchSize];
+                for ( U32 i = start; i < end; ++i )
+                {
+                    // Stop picking up queries once the budget is spent. The very first one always runs so that every update() makes progress
+                    if ( (executedCount > 0u || i > 0u) && budgetSpent() )
+                    {
+                        return;
+                    }
+
+                    executed[i] = 1u;
+
+                    const Query& query = wave[i];
+                    if ( navQuery.getAttachedNavMesh() != query._navMesh &&
+                         dtStatusFailed( navQuery.init( query._navMesh, to_I32( _maxSearchNodes ) ) ) )
+                    {
+                        results[i]._error = PathErrorCode::PATH_ERROR_COULD_NOT_CREATE_PATH;
+                        continue;
+                    }
+
+                    execute( navQuery, query, results[i] );
+                }
+            });
+
+            {
+                LockGuard<Mutex> w_lock( _lock );
+
+                // Queries that never started go back to the front of the queue, in their original order
+                vector<PathQueryHandle> requeued;
+                for ( size_t i = 0u; i < waveHandles.size(); ++i )
+                {
+                    // Cancelled or purged while it was running (or waiting to run)
+                    const auto it = _entries.find( waveHandles[i] );
+                    if ( it == std::end( _entries ) )
+                    {
+                        continue;
+                    }
+
+                    if ( executed[i] != 0u )
+                    {
+                        it->second._result = MOV( results[i] );
+                        it->second._completed = true;
+                        ++executedCount;
+                    }
+                    else
+                    {
+                        requeued.push_back( waveHandles[i] );
+                        // An identical request that came in meanwhile got its own entry. Leave new requests pointing to that one
+                        if ( _pendingByKey.find( it->second._query._key ) == std::end( _pendingByKey ) )
+                        {
+                            _pendingByKey[it->second._query._key] = waveHandles[i];
+                        }
+                    }
+                }
+
+                outOfBudget = !requeued.empty();
+                _pending.insert( _pending.begin(), requeued.begin(), requeued.end() );
+            }
+        }
+        while ( !outOfBudget && !budgetSpent() );
+
+        return executedCount;
+    }
+
+    void PathQueryService::execute( dtNavMeshQuery& navQuery, const Query& query, PathQueryResult& resultOut ) const
+    {
+        F32 startNearest[3];
+        dtPolyRef startPoly = 0u;
+        if ( dtStatusFailed( navQuery.findNearestPoly( &query._start[0], &query._extents[0], &_filter, &startPoly, startNearest ) ) || startPoly == 0u )
+        {
+            resultOut._error = PathErrorCode::PATH_ERROR_NO_NEAREST_POLY_START;
+            return;
+        }
+
+        resultOut._poly = startPoly;
+
+        switch ( query._type )
+        {
+            case PathQueryType::CLOSEST_POINT:
+            {
+                resultOut._points.emplace_back( startNearest[0], startNearest[1], startNearest[2] );
+            } break;
+
+            case PathQueryType::RAYCAST:
+            {
+                dtPolyRef visited[MAX_PATHPOLY];
+                I32 visitedCount = 0;
+                if ( dtStatusFailed( navQuery.raycast( startPoly, startNearest, &query._end[0], &_filter, &resultOut._hitT, &resultOut._hitNormal[0], visited, &visitedCount, MAX_PATHPOLY ) ) )
+                {
+                    resultOut._error = PathErrorCode::PATH_ERROR_COULD_NOT_CREATE_PATH;
+                    return;
+                }
+
+                const float3 start( startNearest[0], startNearest[1], startNearest[2] );
+                resultOut._points.push_back( start );
+                resultOut._points.push_back( resultOut._hitT >= 1.f ? query._end : start + (query._end - start) * resultOut._hitT );
+            } break;
+
+            case PathQueryType::PATH:
+            {
+                F32 endNearest[3];
+                dtPolyRef endPoly = 0u;
+                if ( dtStatusFailed( navQuery.findNearestPoly( &query._end[0], &query._extents[0], &_filter, &endPoly, endNearest ) ) || endPoly == 0u )
+                {
+                    resultOut._error = PathErrorCode::PATH_ERROR_NO_NEAREST_POLY_END;
+                    return;
+                }
+
+                dtPolyRef polyPath[MAX_PATHPOLY];
+                I32 polyCount = 0;
+                if ( dtStatusFailed( navQuery.findPath( startPoly, endPoly, startNearest, endNearest, &_filter, polyPath, &polyCount, MAX_PATHPOLY ) ) )
+                {
+                    resultOut._error = PathErrorCode::PATH_ERROR_COULD_NOT_CREATE_PATH;
+                    return;
+                }
+
+                if ( polyCount == 0 )
+                {
+                    resultOut._error = PathErrorCode::PATH_ERROR_COULD_NOT_FIND_PATH;
+                    return;
+                }
+
+                F32 straightPath[MAX_PATHVERT * 3];
+                I32 vertCount = 0;
+                if ( dtStatusFailed( navQuery.findStraightPath( startNearest, endNearest, polyPath, polyCount, straightPath, nullptr, nullptr, &vertCount, MAX_PATHVERT ) ) )
+                {
+                    resultOut._error = PathErrorCode::PATH_ERROR_NO_STRAIGHT_PATH_CREATE;
+                    return;
+                }
+
+                if ( vertCount == 0 )
+                {
+                    resultOut._error = PathErrorCode::PATH_ERROR_NO_STRAIGHT_PATH_FIND;
+                    return;
+                }
+
+                resultOut._points.reserve( to_size( vertCount ) );
+                for ( I32 i = 0; i < vertCount; ++i )
+                {
+                    resultOut._points.emplace_back( straightPath[i * 3 + 0], straightPath[i * 3 + 1], straightPath[i * 3 + 2] );
+                }
+            } break;
+
+            default: DIVIDE_UNEXPECTED_CALL(); return;
+        }
+
+        resultOut._success = true;
+    }
+
+} //namespace Divide::AI::Navigation
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_AI_SENSOR_GRID_H_
+#define DVD_AI_SENSOR_GRID_H_
+
+namespace Divide
+{
+
+class SceneGraphNode;
+
+namespace AI
+{
+
+/// A radius (or cone, if _cosHalfFOV > -1) search around a point
+struct SensorQuery
+{
+    float3 _origin;
+    /// Normalised view direction. Only used for cone queries
+    float3 _direction{ 0.f, 0.f, -1.f };
+    F32 _minRange{ 0.f };
+    F32 _maxRange{ F32_MAX };
+    /// Cosine of half the field of view angle. -1 accepts every direction
+    F32 _cosHalfFOV{ -1.f };
+    /// Usually the querying agent's own node, so it doesn't see itself
+    I64 _ignoreGUID{ -1 };
+};
+
+struct SensorHit
+{
+    SceneGraphNode* _node{ nullptr };
+    float3 _position;
+    I64 _guid{ -1 };
+    F32 _distanceSq{ F32_MAX };
+};
+
+/// Uniform grid (XZ plane) of AI relevant nodes, rebuilt once per AI tick by the AIManager.
+/// Building is not thread safe, but every query is const and may run concurrently between builds.
+class SensorGrid final : NonCopyable
+{
+  public:
+    explicit SensorGrid(F32 cellSize = 16.f) noexcept;
+
+    /// Drop every entry. Follow with insert() calls and a build()
+    void clear();
+    /// Queue a node for the next build(). Duplicate GUIDs are ignored
+    void insert(I64 guid, SceneGraphNode* node, const float3& position);
+    /// Sort the inserted nodes into their cells. Queries only see nodes from the last build
+    void build();
+
+    [[nodiscard]] bool contains(I64 guid) const;
+    [[nodiscard]] bool getPosition(I64 guid, float3& positionOut) const;
+
+    /// Append every node matching the query to hitsOut, closest first
+    void query(const SensorQuery& query, vector<SensorHit>& hitsOut) const;
+    /// Batched version of the above: the hits of queries[i] are hitsOut[offsetsOut[i] .. offsetsOut[i + 1])
+    void query(const vector<SensorQuery>& queries, vector<SensorHit>& hitsOut, vector<U32>& offsetsOut) const;
+    /// Closest node to origin (within maxRange) accepted by the filter. Searches outwards ring by ring and stops
+    /// as soon as no unvisited cell can hold anything closer
+    [[nodiscard]] bool findClosest(const float3& origin, F32 maxRange, const DELEGATE<bool, I64>& filter, SensorHit& hitOut) const;
+
+    /// Range and field of view test used by every query. Ignores _ignoreGUID
+    [[nodiscard]] static bool Matches(const SensorQuery& query, const float3& position, F32& distanceSqOut) noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return _entries.size(); }
+    [[nodiscard]] F32 cellSize() const noexcept { return _cellSize; }
+
+  private:
+    struct Entry
+    {
+        SceneGraphNode* _node{ nullptr };
+        float3 _position;
+        I64 _guid{ -1 };
+        U64 _cellKey{ 0u };
+    };
+
+    struct CellRange
+    {
+        U32 _first{ 0u };
+        U32 _count{ 0u };
+    };
+
+    [[nodiscard]] I32 cellCoord(F32 value) const noexcept;
+    [[nodiscard]] static U64 CellKey(I32 x, I32 z) noexcept;
+
+    /// Calls 'cbk(entry)' for every entry in the cells overlapping the XZ square of the given half-extent around origin
+    template<typename Callback>
+    void forEachInRange(const float3& origin, F32 range, Callback&& cbk) const;
+
+  private:
+    const F32 _cellSize;
+    vector<Entry> _entries;
+    hashMap<U64, CellRange> _cells;
+    hashMap<I64, U32> _indexByGUID;
+    int2 _minCell, _maxCell;
+};
+
+} // namespace AI
+} // namespace Divide
+
+#endif //DVD_AI_SENSOR_GRID_H_
@@ -50,6 +50,10 @@ using NodePositions = hashMap<I64, float3 >;
 /// Container ID, NodePositions
 using NodePositionsMap = hashMap<U32, NodePositions>;
 
+class SensorGrid;
+
+/// Followed nodes that are also AI team members are read from the AIManager's shared SensorGrid (built once per tick),
+/// so agents don't each have to refresh and scan every other agent. Anything else (e.g. flags) is tracked locally.
 class VisualSensor final : public Sensor
 {
    public:
@@ -76,10 +80,18 @@ class VisualSensor final : public Sensor
 
     float3 getNodePosition(U32 containerID, I64 nodeGUID);
     SceneGraphNode* findClosestNode(U32 containerID);
+    /// Every node in the container within the sensor's range and field of view, closest first
+    void getVisibleNodes(U32 containerID, vector<SceneGraphNode*>& nodesOut);
+
+    /// Full view cone angle. 360 degrees (or more) disables direction checks
+    PROPERTY_RW(F32, fieldOfViewDegrees, 360.f);
 
+   protected:
+    [[nodiscard]] const SensorGrid* sensorGrid() const;
 
    protected:
     NodeContainerMap _nodeContainerMap;
+    /// Only the followed nodes the sensor grid doesn't know about
     NodePositionsMap _nodePositionsMap;
 };
 
@@ -0,0 +1,309 @@
+
+
+#include "Headers/SensorGrid.h"
+
+namespace Divide::AI
+{
+
+namespace
+{
+    // Keeps cell coordinates (and the ring arithmetic done on them) well away from I32 overflow
+    constexpr F32 g_maxCellCoord = 1 << 24;
+
+    bool CloserHit(const SensorHit& lhs, const SensorHit& rhs) noexcept
+    {
+        return lhs._distanceSq < rhs._distanceSq || (lhs._distanceSq == rhs._distanceSq && lhs._guid < rhs._guid);
+    }
+}
+
+SensorGrid::SensorGrid(const F32 cellSize) noexcept
+    : _cellSize(std::max(cellSize, 1.f))
+{
+}
+
+void SensorGrid::clear()
+{
+    _entries.clear();
+    _cells.clear();
+    _indexByGUID.clear();
+    _minCell.set(0);
+    _maxCell.set(-1);
+}
+
+void SensorGrid::insert(const I64 guid, SceneGraphNode* node, const float3& position)
+{
+    if (_indexByGUID.find(guid) != std::end(_indexByGUID))
+    {
+        return;
+    }
+
+    _indexByGUID[guid] = to_U32(_entries.size());
+
+    Entry& entry = _entries.emplace_back();
+    entry._node = node;
+    entry._position = position;
+    entry._guid = guid;
+    entry._cellKey = CellKey(cellCoord(position.x), cellCoord(position.z));
+}
+
+void SensorGrid::build()
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::GameLogic );
+
+    _cells.clear();
+    _indexByGUID.clear();
+    _minCell.set(I32_MAX);
+    _maxCell.set(-I32_MAX);
+
+    // Sorting by cell makes every cell a contiguous range of entries
+    eastl::sort(begin(_entries), end(_entries), [](const Entry& lhs, const Entry& rhs) noexcept
+    {
+        return lhs._cellKey < rhs._cellKey || (lhs._cellKey == rhs._cellKey && lhs._guid < rhs._guid);
+    });
+
+    const U32 entryCount = to_U32(_entries.size());
+    for (U32 i = 0u; i < entryCount; ++i)
+    {
+        const Entry& entry = _entries[i];
+        _indexByGUID[entry._guid] = i;
+
+        CellRange& range = _cells[entry._cellKey];
+        if (range._count == 0u)
+        {
+            range._first = i;
+
+            const I32 x = cellCoord(entry._position.x);
+            const I32 z = cellCoord(entry._position.z);
+            _minCell.set(std::min(_minCell.x, x), std::min(_minCell.y, z));
+            _maxCell.set(std::max(_maxCell.x, x), std::max(_maxCell.y, z));
+        }
+        ++range._count;
+    }
+}
+
+bool SensorGrid::contains(const I64 guid) const
+{
+    return _indexByGUID.find(guid) != std::cend(_indexByGUID);
+}
+
+bool SensorGrid::getPosition(const I64 guid, float3& positionOut) const
+{
+    const auto it = _indexByGUID.find(guid);
+    if (it == std::cend(_indexByGUID))
+    {
+        return false;
+    }
+
+    positionOut = _entries[it->second]._position;
+    return true;
+}
+
+I32 SensorGrid::cellCoord(const F32 value) const noexcept
+{
+    return static_cast<I32>(std::floor(CLAMPED(value / _cellSize, -g_maxCellCoord, g_maxCellCoord)));
+}
+
+U64 SensorGrid::CellKey(const I32 x, const I32 z) noexcept
+{
+    return (static_cast<U64>(static_cast<U32>(x)) << 32u) | static_cast<U64>(static_cast<U32>(z));
+}
+
+template<typename Callback>
+void SensorGrid::forEachInRange(const float3& origin, const F32 range, Callback&& cbk) const
+{
+    if (_entries.empty())
+    {
+        return;
+    }
+
+    const I32 minX = std::max(_minCell.x, cellCoord(origin.x - range));
+    const I32 maxX = std::min(_maxCell.x, cellCoord(origin.x + range));
+    const I32 minZ = std::max(_minCell.y, cellCoord(origin.z - range));
+    const I32 maxZ = std::min(_maxCell.y, cellCoord(origin.z + range));
+    if (minX > maxX || minZ > maxZ)
+    {
+        return;
+    }
+
+    const auto visitCell = [&](const CellRange& cell)
+    {
+        for (U32 i = cell._first; i < cell._first + cell._count; ++i)
+        {
+            cbk(_entries[i]);
+        }
+    };
+
+    const U64 boxCellCount = to_U64(maxX - minX + 1) * to_U64(maxZ - minZ + 1);
+    if (boxCellCount > _cells.size())
+    {
+        // Sparse grid: cheaper to walk the occupied cells than every cell in the box
+        for (const auto& [key, cell] : _cells)
+        {
+            const I32 x = static_cast<I32>(static_cast<U32>(key >> 32u));
+            const I32 z = static_cast<I32>(static_cast<U32>(key & 0xFFFFFFFFu));
+            if (x >= minX && x <= maxX && z >= minZ && z <= maxZ)
+            {
+                visitCell(cell);
+            }
+        }
+        return;
+    }
+
+    for (I32 x = minX; x <= maxX; ++x)
+    {
+        for (I32 z = minZ; z <= maxZ; ++z)
+        {
+            const auto it = _cells.find(CellKey(x, z));
+            if (it != std::cend(_cells))
+            {
+                visitCell(it->second);
+            }
+        }
+    }
+}
+
+bool SensorGrid::Matches(const SensorQuery& query, const float3& position, F32& distanceSqOut) noexcept
+{
+    const float3 delta = position - query._origin;
+    distanceSqOut = delta.lengthSquared();
+    if (distanceSqOut < SQUARED(query._minRange) ||
+        (query._maxRange < Sqrt(F32_MAX) && distanceSqOut > SQUARED(query._maxRange)))
+    {
+        return false;
+    }
+
+    // cos(angle) >= cosHalfFOV, without normalising delta
+    return query._cosHalfFOV <= -1.f ||
+           distanceSqOut <= EPSILON_F32 ||
+           delta.dot(query._direction) >= query._cosHalfFOV * Sqrt(distanceSqOut);
+}
+
+void SensorGrid::query(const SensorQuery& query, vector<SensorHit>& hitsOut) const
+{
+    const size_t firstHit = hitsOut.size();
+
+    forEachInRange(query._origin, query._maxRange, [&](const Entry& entry)
+    {
+        F32 distanceSq = F32_MAX;
+        if (entry._guid == query._ignoreGUID || !Matches(query, entry._position, distanceSq))
+        {
+            return;
+        }
+
+        SensorHit& hit = hitsOut.emplace_back();
+        hit._node = entry._node;
+        hit._position = entry._position;
+        hit._guid = entry._guid;
+        hit._distanceSq = distanceSq;
+    });
+
+    eastl::sort(begin(hitsOut) + firstHit, end(hitsOut), CloserHit);
+}
+
+void SensorGrid::query(const vector<SensorQuery>& queries, vector<SensorHit>& hitsOut, vector<U32>& offsetsOut) const
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::GameLogic );
+
+    offsetsOut.resize(queries.size() + 1u);
+    offsetsOut[0] = to_U32(hitsOut.size());
+    for (size_t i = 0u; i < queries.size(); ++i)
+    {
+        query(queries[i], hitsOut);
+        offsetsOut[i + 1u] = to_U32(hitsOut.size());
+    }
+}
+
+bool SensorGrid::findClosest(const float3& origin, const F32 maxRange, const DELEGATE<bool, I64>& filter, SensorHit& hitOut) const
+{
+    if (_entries.empty())
+    {
+        return false;
+    }
+
+    const F32 maxRangeSq = maxRange >= Sqrt(F32_MAX) ? F32_MAX : SQUARED(maxRange);
+    const I32 cx = cellCoord(origin.x);
+    const I32 cz = cellCoord(origin.z);
+
+    // Past this ring there is nothing left in the grid (or in range)
+    I32 lastRing = std::max({ cx - _minCell.x, _maxCell.x - cx, cz - _minCell.y, _maxCell.y - cz });
+    if (maxRangeSq < F32_MAX)
+    {
+        lastRing = std::min(lastRing, to_I32(std::ceil(maxRange / _cellSize)) + 1);
+    }
+
+    bool found = false;
+    const auto visitEntries = [&](const U32 first, const U32 count)
+    {
+        for (U32 i = first; i < first + count; ++i)
+        {
+            const Entry& entry = _entries[i];
+            const F32 distanceSq = origin.distanceSquared(entry._position);
+            if (distanceSq > maxRangeSq)
+            {
+                continue;
+            }
+            if (found && (distanceSq > hitOut._distanceSq || (distanceSq == hitOut._distanceSq && entry._guid >= hitOut._guid)))
+            {
+                continue;
+            }
+            if (filter && !filter(entry._guid))
+            {
+                continue;
+            }
+
+            hitOut._node = entry._node;
+            hitOut._position = entry._position;
+            hitOut._guid = entry._guid;
+            hitOut._distanceSq = distanceSq;
+            found = true;
+        }
+    };
+
+    const auto visitCell = [&](const I32 x, const I32 z)
+    {
+        const auto it = _cells.find(CellKey(x, z));
+        if (it != std::cend(_cells))
+        {
+            visitEntries(it->second._first, it->second._count);
+        }
+    };
+
+    const U64 occupiedCellCount = _cells.size();
+    for (I32 ring = 0; ring <= lastRing; ++ring)
+    {
+        // The origin can sit anywhere in its own cell, so ring N is at least (N - 1) cells away on the XZ plane
+        if (found && ring > 1 && SQUARED(to_F32(ring - 1) * _cellSize) > hitOut._distanceSq)
+        {
+            break;
+        }
+
+        // Far away from everything: probing empty cells would cost more than just checking every entry
+        const U64 ringSide = to_U64(ring) * 2u + 1u;
+        if (ringSide * ringSide > occupiedCellCount * 2u + 8u)
+        {
+            visitEntries(0u, to_U32(_entries.size()));
+            break;
+        }
+
+        if (ring == 0)
+        {
+            visitCell(cx, cz);
+            continue;
+        }
+
+        for (I32 x = cx - ring; x <= cx + ring; ++x)
+        {
+            visitCell(x, cz - ring);
+            visitCell(x, cz + ring);
+        }
+        for (I32 z = cz - ring + 1; z <= cz + ring - 1; ++z)
+        {
+            visitCell(cx - ring, z);
+            visitCell(cx + ring, z);
+        }
+    }
+
+    return found;
+}
+
+} // namespace Divide::AI
@@ -2,7 +2,11 @@
 
 #include "Headers/VisualSensor.h"
 
+#include "Headers/SensorGrid.h"
+
 #include "AI/Headers/AIEntity.h"
+#include "AI/Headers/AIManager.h"
+#include "AI/ActionInterface/Headers/AITeam.h"
 #include "Utility/Headers/Localization.h"
 #include "Graphs/Headers/SceneGraphNode.h"
 #include "Dynamics/Entities/Units/Headers/NPC.h"
@@ -46,8 +50,19 @@ void VisualSensor::followSceneGraphNode(const U32 containerID, SceneGraphNode* n
        
     }
 
-    NodePositions& positions = _nodePositionsMap[containerID];
-    insert(positions, node->getGUID(), node->get<TransformComponent>()->getWorldPosition());
+    // Team members get their positions from the sensor grid. update() also moves nodes over once the grid picks them up
+    const SensorGrid* grid = sensorGrid();
+    if (grid == nullptr || !grid->contains(node->getGUID()))
+    {
+        NodePositions& positions = _nodePositionsMap[containerID];
+        insert(positions, node->getGUID(), node->get<TransformComponent>()->getWorldPosition());
+    }
+}
+
+const SensorGrid* VisualSensor::sensorGrid() const
+{
+    const AITeam* team = _parentEntity->getTeam();
+    return team != nullptr ? &team->parentManager().sensorGrid() : nullptr;
 }
 
 void VisualSensor::unfollowSceneGraphNode(const U32 containerID, const I64 nodeGUID)
@@ -73,57 +88,143 @@ void VisualSensor::unfollowSceneGraphNode(const U32 containerID, const I64 nodeG
 
 void VisualSensor::update( [[maybe_unused]] const U64 deltaTimeUS)
 {
+    const SensorGrid* grid = sensorGrid();
+
     for (const NodeContainerMap::value_type& container : _nodeContainerMap)
     {
         NodePositions& positions = _nodePositionsMap[container.first];
 
-        for (const NodeContainer::value_type& entry : container.second)
+        for (NodePositions::iterator it = std::begin(positions); it != std::end(positions);)
         {
-            SceneGraphNode* sgn(entry.second);
-            if (sgn != nullptr)
+            if (grid != nullptr && grid->contains(it->first))
             {
-                positions[entry.first] = sgn->get<TransformComponent>()->getWorldPosition();
+                // Tracked by the grid from now on
+                it = positions.erase(it);
+                continue;
             }
+
+            const NodeContainer::const_iterator nodeEntry = container.second.find(it->first);
+            if (nodeEntry != std::end(container.second) && nodeEntry->second != nullptr)
+            {
+                it->second = nodeEntry->second->get<TransformComponent>()->getWorldPosition();
+            }
+            ++it;
         }
     }
 }
 
 SceneGraphNode* VisualSensor::findClosestNode(const U32 containerID)
 {
-    NodeContainerMap::iterator container = _nodeContainerMap.find(containerID);
-    if (container != std::end(_nodeContainerMap))
+    const NodeContainerMap::iterator container = _nodeContainerMap.find(containerID);
+    if (container == std::end(_nodeContainerMap))
     {
-        NodePositions& positions = _nodePositionsMap[container->first];
-        NPC* const unit = _parentEntity->getUnitRef();
-        if (unit)
+        return nullptr;
+    }
+
+    NPC* const unit = _parentEntity->getUnitRef();
+    if (unit == nullptr)
+    {
+        return nullptr;
+    }
+
+    const NodeContainer& nodes = container->second;
+    const float3& currentPosition = unit->getCurrentPosition();
+
+    I64 currentNearest = 0;
+    F32 currentDistanceSq = F32_MAX;
+    for (const NodePositions::value_type& entry : _nodePositionsMap[containerID])
+    {
+        const F32 temp = currentPosition.distanceSquared(entry.second);
+        if (temp < currentDistanceSq)
         {
-            const float3& currentPosition = unit->getCurrentPosition();
-            I64 currentNearest = positions.begin()->first;
-            F32 currentDistanceSq = F32_MAX;
-            for (const NodePositions::value_type& entry : positions)
-            {
-                const F32 temp = currentPosition.distanceSquared(entry.second);
-                if (temp < currentDistanceSq)
-                {
-                    currentDistanceSq = temp;
-                    currentNearest = entry.first;
-                }
-            }
+            currentDistanceSq = temp;
+            currentNearest = entry.first;
+        }
+    }
 
-            if (currentNearest != 0)
-            {
-                const NodeContainer::const_iterator nodeEntry = container->second.find(currentNearest);
-                if (nodeEntry != std::end(container->second))
-                {
-                    return nodeEntry->second;
-                }
-            }
+    if (const SensorGrid* grid = sensorGrid(); grid != nullptr)
+    {
+        SensorHit hit;
+        const F32 maxRange = currentNearest != 0 ? Sqrt<F32>(currentDistanceSq) : F32_MAX;
+        const auto isFollowed = [&nodes](const I64 guid) { return nodes.find(guid) != std::cend(nodes); };
+        if (grid->findClosest(currentPosition, maxRange, isFollowed, hit) && (currentNearest == 0 || hit._distanceSq < currentDistanceSq))
+        {
+            currentNearest = hit._guid;
+        }
+    }
+
+    if (currentNearest != 0)
+    {
+        const NodeContainer::const_iterator nodeEntry = nodes.find(currentNearest);
+        if (nodeEntry != std::end(nodes))
+        {
+            return nodeEntry->second;
         }
     }
 
     return nullptr;
 }
 
+void VisualSensor::getVisibleNodes(const U32 containerID, vector<SceneGraphNode*>& nodesOut)
+{
+    const NodeContainerMap::iterator container = _nodeContainerMap.find(containerID);
+    NPC* const unit = _parentEntity->getUnitRef();
+    if (container == std::end(_nodeContainerMap) || unit == nullptr)
+    {
+        return;
+    }
+
+    const NodeContainer& nodes = container->second;
+
+    SensorQuery query{};
+    query._origin = unit->getCurrentPosition();
+    query._minRange = std::max(_range.x, 0.f);
+    query._maxRange = _range.y > 0.f ? _range.y : F32_MAX;
+    if (fieldOfViewDegrees() < 360.f)
+    {
+        query._direction = Normalized(unit->getLookingDirection());
+        query._cosHalfFOV = std::cos(fieldOfViewDegrees() * to_F32(M_PI_DIV_360));
+    }
+    if (const SceneGraphNode* self = unit->getBoundNode(); self != nullptr)
+    {
+        query._ignoreGUID = self->getGUID();
+    }
+
+    vector<SensorHit> hits;
+    if (const SensorGrid* grid = sensorGrid(); grid != nullptr)
+    {
+        grid->query(query, hits);
+        dvd_erase_if(hits, [&nodes](const SensorHit& hit) { return nodes.find(hit._guid) == std::cend(nodes); });
+    }
+
+    for (const NodePositions::value_type& entry : _nodePositionsMap[containerID])
+    {
+        F32 distanceSq = F32_MAX;
+        if (entry.first != query._ignoreGUID && SensorGrid::Matches(query, entry.second, distanceSq))
+        {
+            SensorHit& hit = hits.emplace_back();
+            hit._guid = entry.first;
+            hit._position = entry.second;
+            hit._distanceSq = distanceSq;
+        }
+    }
+
+    eastl::sort(begin(hits), end(hits), [](const SensorHit& lhs, const SensorHit& rhs) noexcept
+    {
+        return lhs._distanceSq < rhs._distanceSq || (lhs._distanceSq == rhs._distanceSq && lhs._guid < rhs._guid);
+    });
+
+    nodesOut.reserve(nodesOut.size() + hits.size());
+    for (const SensorHit& hit : hits)
+    {
+        const NodeContainer::const_iterator nodeEntry = nodes.find(hit._guid);
+        if (nodeEntry != std::end(nodes) && nodeEntry->second != nullptr)
+        {
+            nodesOut.push_back(nodeEntry->second);
+        }
+    }
+}
+
 bool VisualSensor::getDistanceToNodeSq(const U32 containerID, const I64 nodeGUID, F32& distanceOut)
 {
     DIVIDE_ASSERT( nodeGUID != 0, "VisualSensor error: Invalid node GUID specified for distance request");
@@ -152,6 +253,15 @@ float3 VisualSensor::getNodePosition(const U32 containerID, const I64 nodeGUID)
         {
             return it->second;
         }
+
+        float3 position;
+        const SensorGrid* grid = sensorGrid();
+        if (grid != nullptr &&
+            container->second.find(nodeGUID) != std::end(container->second) &&
+            grid->getPosition(nodeGUID, position))
+        {
+            return position;
+        }
     }
 
     return float3( F32_MAX );
@@ -17,8 +17,10 @@ set( AI_SOURCE_HEADERS AI/ActionInterface/CustomGOAP/Action.h
                        AI/PathFinding/Waypoints/Headers/WaypointGraph.h
                        AI/PathFinding/Headers/DivideCrowd.h
                        AI/PathFinding/Headers/DivideRecast.h
+                       AI/PathFinding/Headers/PathQueryService.h
                        AI/Sensors/Headers/Sensor.h
                        AI/Sensors/Headers/AudioSensor.h
+                       AI/Sensors/Headers/SensorGrid.h
                        AI/Sensors/Headers/VisualSensor.h
                        AI/Headers/AIEntity.h
                        AI/Headers/AIManager.h
@@ -31,6 +33,7 @@ set( AI_SOURCE AI/ActionInterface/CustomGOAP/Action.cpp
                AI/ActionInterface/AIProcessor.cpp
                AI/ActionInterface/AITeam.cpp
                AI/ActionInterface/GOAPInterface.cpp
+               AI/PathFinding/NavMeshes/DetourTileCache/DivideTileCache.cpp
                AI/PathFinding/NavMeshes/NavMesh.cpp
                AI/PathFinding/NavMeshes/NavMeshContext.cpp
                AI/PathFinding/NavMeshes/NavMeshDebugDraw.cpp
@@ -39,7 +42,9 @@ set( AI_SOURCE AI/ActionInterface/CustomGOAP/Action.cpp
                AI/PathFinding/Waypoints/WaypointGraph.cpp
                AI/PathFinding/DivideCrowd.cpp
                AI/PathFinding/DivideRecast.cpp
+               AI/PathFinding/PathQueryService.cpp
                AI/Sensors/AudioSensor.cpp
+               AI/Sensors/SensorGrid.cpp
                AI/Sensors/VisualSensor.cpp
                AI/AIEntity.cpp
                AI/AIManager.cpp
@@ -314,9 +319,9 @@ set( ENVIRONMENT_SOURCE_HEADERS Environment/Sky/Headers/Sky.h
                                 Environment/Terrain/Headers/TerrainChunk.h
                                 Environment/Terrain/Headers/TerrainDescriptor.h
                                 Environment/Terrain/Headers/TerrainDescriptor.inl
+                                Environment/Terrain/Headers/TerrainTileCache.h
                                 Environment/Terrain/Headers/TileRing.h
                                 Environment/Terrain/Quadtree/Headers/Quadtree.h
-                                Environment/Terrain/Quadtree/Headers/QuadtreeNode.h
                                 Environment/Vegetation/Headers/Vegetation.h
                                 Environment/Vegetation/Headers/VegetationDescriptor.h
                                 Environment/Vegetation/Headers/VegetationDescriptor.inl
@@ -329,15 +334,16 @@ set( ENVIRONMENT_SOURCE Environment/Sky/Sky.cpp
                         Environment/Terrain/Terrain.cpp
                         Environment/Terrain/TerrainChunk.cpp
                         Environment/Terrain/TerrainDescriptor.cpp
+                        Environment/Terrain/TerrainTileCache.cpp
                         Environment/Terrain/TileRing.cpp
                         Environment/Terrain/Quadtree/Quadtree.cpp
-                        Environment/Terrain/Quadtree/QuadtreeNode.cpp
                         Environment/Vegetation/Vegetation.cpp
                         Environment/Water/Water.cpp
 
 )
 
-set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationEvaluator.h
+set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationBlendTree.h
+                             Geometry/Animations/Headers/AnimationEvaluator.h
                              Geometry/Animations/Headers/AnimationEvaluator.inl
                              Geometry/Animations/Headers/AnimationUtils.h
                              Geometry/Animations/Headers/Bone.h
@@ -345,6 +351,7 @@ set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationEvaluator.h
                              Geometry/Animations/Headers/SceneAnimator.inl
                              Geometry/Importer/Headers/DVDConverter.h
                              Geometry/Importer/Headers/MeshImporter.h
+                             Geometry/Importer/Headers/MeshletData.h
                              Geometry/Material/Headers/Material.h
                              Geometry/Material/Headers/Material.inl
                              Geometry/Material/Headers/MaterialEnums.h
@@ -359,11 +366,13 @@ set( GEOMETRY_SOURCE_HEADERS Geometry/Animations/Headers/AnimationEvaluator.h
 )
 
 set( GEOMETRY_SOURCE Geometry/Animations/Bone.cpp
+                     Geometry/Animations/AnimationBlendTree.cpp
                      Geometry/Animations/AnimationEvaluator.cpp
                      Geometry/Animations/AnimationUtils.cpp
                      Geometry/Animations/SceneAnimator.cpp
                      Geometry/Importer/DVDConverter.cpp
                      Geometry/Importer/MeshImporter.cpp
+                     Geometry/Importer/MeshletData.cpp
                      Geometry/Material/Material.cpp
                      Geometry/Material/MaterialProperties.cpp
                      Geometry/Material/ShaderComputeQueue.cpp
@@ -478,9 +487,19 @@ set ( PHYSICS_NONE_SOURCE_HEADERS Physics/None/Headers/None.h
 )
 
 set ( JOLT_SOURCE Physics/Jolt/Jolt.cpp
+                  Physics/Jolt/JoltContactListener.cpp
+                  Physics/Jolt/JoltHeightField.cpp
+                  Physics/Jolt/JoltJobSystem.cpp
+                  Physics/Jolt/JoltQueries.cpp
+                  Physics/Jolt/JoltRigidBody.cpp
 )
 
 set ( JOLT_SOURCE_HEADERS Physics/Jolt/Headers/Jolt.h
+                          Physics/Jolt/Headers/JoltContactListener.h
+                          Physics/Jolt/Headers/JoltHeightField.h
+                          Physics/Jolt/Headers/JoltJobSystem.h
+                          Physics/Jolt/Headers/JoltQueries.h
+                          Physics/Jolt/Headers/JoltRigidBody.h
 )
 
 set( PHYSICS_SOURCE ${PHYSICS_SOURCE}
@@ -503,6 +522,7 @@ set( PLATFORM_SOURCE_HEADERS Platform/Audio/fmod/Headers/FmodWrapper.h
                              Platform/File/Headers/FileManagement.inl
                              Platform/File/Headers/FileUpdateMonitor.h
                              Platform/File/Headers/FileWatcherManager.h
+                             Platform/File/Headers/MemoryMappedFile.h
                              Platform/File/Headers/ResourcePath.h
                              Platform/Headers/ConditionalWait.h
                              Platform/Headers/DisplayWindow.h
@@ -615,6 +635,7 @@ set( PLATFORM_SOURCE_HEADERS Platform/Audio/fmod/Headers/FmodWrapper.h
                              Platform/Video/Shaders/glsw/Headers/glsw.h
                              Platform/Video/Shaders/Headers/GLSLToSPIRV.h
                              Platform/Video/Shaders/Headers/ShaderDataUploader.h
+                             Platform/Video/Shaders/Headers/ShaderModuleBuilds.h
                              Platform/Video/Shaders/Headers/ShaderProgram.h
                              Platform/Video/Shaders/Headers/ShaderProgramFwd.h
                              Platform/Video/Shaders/Headers/ShaderProgramFwd.inl
@@ -623,6 +644,7 @@ set( PLATFORM_SOURCE_HEADERS Platform/Audio/fmod/Headers/FmodWrapper.h
                              Platform/Video/Textures/Headers/Texture.h
                              Platform/Video/Textures/Headers/TextureDescriptor.h
                              Platform/Video/Textures/Headers/TextureDescriptor.inl
+                             Platform/Video/Textures/Headers/TextureStreamer.h
 )
 
 set( PLATFORM_SOURCE Platform/ConditionalWait.cpp
@@ -642,6 +664,7 @@ set( PLATFORM_SOURCE Platform/ConditionalWait.cpp
                      Platform/File/FileManagementPaths.cpp
                      Platform/File/FileUpdateMonitor.cpp
                      Platform/File/FileWatcherManager.cpp
+                     Platform/File/MemoryMappedFile.cpp
                      Platform/File/ResourcePath.cpp
                      Platform/Input/AutoKeyRepeat.cpp
                      Platform/Input/Input.cpp
@@ -706,12 +729,14 @@ set( PLATFORM_SOURCE Platform/ConditionalWait.cpp
                      Platform/Video/RenderBackend/Vulkan/Vulkan-Descriptor-Allocator/descriptor_allocator.cpp
                      Platform/Video/Shaders/GLSLToSPIRV.cpp
                      Platform/Video/Shaders/ShaderDataUploader.cpp
+                     Platform/Video/Shaders/ShaderModuleBuilds.cpp
                      Platform/Video/Shaders/ShaderProgram.cpp
                      Platform/Video/Shaders/glsw/bstrlib.c
                      Platform/Video/Shaders/glsw/glsw.c
                      Platform/Video/Textures/SamplerDescriptor.cpp
                      Platform/Video/Textures/Texture.cpp
                      Platform/Video/Textures/TextureDescriptor.cpp
+                     Platform/Video/Textures/TextureStreamer.cpp
 )
 set_source_files_properties(${PLATFORM_SOURCE} PROPERTIES LANGUAGE CXX )
 set_source_files_properties(${PLATFORM_SOURCE_HEADERS} PROPERTIES LANGUAGE CXX )
@@ -835,11 +860,29 @@ set( UTILITY_SOURCE Utility/Colours.cpp
 
 set( TEST_ENGINE_SOURCE UnitTests/unitTestCommon.h
                         UnitTests/unitTestCommon.cpp
+                        UnitTests/Test-Engine/AnimationBlendTreeTests.cpp
                         UnitTests/Test-Engine/ByteBufferTests.cpp
+                        UnitTests/Test-Engine/GeometryCacheTests.cpp
+                        UnitTests/Test-Engine/GOAPPlannerTests.cpp
                         UnitTests/Test-Engine/MathMatrixTests.cpp
                         UnitTests/Test-Engine/MathVectorTests.cpp
+                        UnitTests/Test-Engine/MeshletTests.cpp
+                        UnitTests/Test-Engine/PathQueryServiceTests.cpp
+                        UnitTests/Test-Engine/PhysicsQueryTests.cpp
                         UnitTests/Test-Engine/RendererTests.cpp
                         UnitTests/Test-Engine/ScriptingTests.cpp
+                        UnitTests/Test-Engine/SensorGridTests.cpp
+                        UnitTests/Test-Engine/ShaderModuleBuildsTests.cpp
+                        UnitTests/Test-Engine/TerrainQuadtreeTests.cpp
+                        UnitTests/Test-Engine/TerrainTileCacheTests.cpp
+                        UnitTests/Test-Engine/TextureStreamerTests.cpp
+)
+
+set( BENCHMARK_ENGINE_SOURCE UnitTests/unitTestCommon.h
+                             UnitTests/unitTestCommon.cpp
+                             UnitTests/Benchmark-Engine/CoreBenchmarks.cpp
+                             UnitTests/Benchmark-Engine/GeometryBenchmarks.cpp
+                             UnitTests/Benchmark-Engine/RenderingBenchmarks.cpp
 )
 
 set( TEST_PLATFORM_SOURCE UnitTests/unitTestCommon.h
@@ -167,11 +167,13 @@ set(EXTERNAL_LIBS
     vk-bootstrap::vk-bootstrap
     Freetype::Freetype
     concurrentqueue::concurrentqueue
+    ZLIB::ZLIB
     Vulkan::Vulkan GPUOpen::VulkanMemoryAllocator
     RecastNavigation::Detour
     RecastNavigation::Recast
     RecastNavigation::DebugUtils
     RecastNavigation::DetourCrowd
+    RecastNavigation::DetourTileCache
     SDL3::SDL3
     SDL3_mixer::SDL3_mixer
     SDL3_image::SDL3_image
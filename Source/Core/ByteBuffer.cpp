@@ -5,6 +5,7 @@
 #include "Utility/Headers/Localization.h"
 
 #include "Platform/File/Headers/FileManagement.h"
+#include "Platform/File/Headers/MemoryMappedFile.h"
 
 namespace Divide {
 
@@ -25,11 +26,16 @@ void ByteBufferException::printPosError() const {
 
 void ByteBuffer::clear() noexcept {
     _storage.clear();
+    _mappedFile.reset();
+    _view = nullptr;
+    _viewSize = 0u;
     _rpos = _wpos = 0u;
 }
 
 void ByteBuffer::append(const Byte *src, const size_t cnt)
  {
+    DIVIDE_ASSERT(!isView(), "ByteBuffer::append: buffer is a read-only view!");
+
     if (src != nullptr && cnt > 0) {
         _storage.reserve(DEFAULT_SIZE);
 
@@ -45,12 +51,12 @@ void ByteBuffer::append(const Byte *src, const size_t cnt)
 
 bool ByteBuffer::dumpToFile(const ResourcePath& path, const std::string_view fileName, const U8 version)
 {
-    if (!_storage.empty() && to_U8(_storage.back()) != version)
+    if (!storageEmpty() && to_U8(contents()[storageSize() - 1u]) != version)
     {
         append(version);
     }
 
-    return writeFile(path, fileName, _storage.data(), _storage.size(), FileType::BINARY) == FileError::NONE;
+    return writeFile(path, fileName, contents(), storageSize(), FileType::BINARY) == FileError::NONE;
 }
 
 bool ByteBuffer::loadFromFile(const ResourcePath& path, const std::string_view fileName, const U8 version)
@@ -72,4 +78,26 @@ bool ByteBuffer::loadFromFile(const ResourcePath& path, const std::string_view f
     return false;
 }
 
+bool ByteBuffer::mapFromFile(const ResourcePath& path, const std::string_view fileName, const U8 version)
+{
+    clear();
+
+    auto file = std::make_shared<MemoryMappedFile>();
+    if (file->open(path, fileName) != FileError::NONE || file->size() == 0u)
+    {
+        return false;
+    }
+
+    if (version != 0u && to_U8(file->data()[file->size() - 1u]) != version)
+    {
+        return false;
+    }
+
+    _view = file->data();
+    _viewSize = file->size();
+    _wpos = _viewSize;
+    _mappedFile = MOV(file);
+    return true;
+}
+
 }  // namespace Divide
@@ -51,6 +51,7 @@ bool Configuration::fromXML(const ResourcePath& xmlFilePath, const char* fileNam
         GET_PARAM_ATTRIB(runtime.resolution, width);
         GET_PARAM_ATTRIB(runtime.resolution, height);
         GET_PARAM(runtime.simSpeed);
+        GET_PARAM(runtime.maxPhysicsBodies);
         GET_PARAM(runtime.cameraViewDistance);
         GET_PARAM(runtime.horizontalFOV);
         GET_PARAM(gui.cegui.enabled);
@@ -68,6 +69,7 @@ bool Configuration::fromXML(const ResourcePath& xmlFilePath, const char* fileNam
         GET_PARAM(rendering.reflectionProbeResolution);
         GET_PARAM(rendering.reflectionPlaneResolution);
         GET_PARAM(rendering.numLightsPerCluster);
+        GET_PARAM(rendering.textureStreamingInFlightMB);
         GET_PARAM(rendering.enableFog);
         GET_PARAM(rendering.fogDensity);
         GET_PARAM(rendering.fogScatter);
@@ -217,6 +219,7 @@ bool Configuration::toXML(const ResourcePath& xmlFilePath, const char* fileName
     PUT_PARAM_ATTRIB(runtime.resolution, width);
     PUT_PARAM_ATTRIB(runtime.resolution, height);
     PUT_PARAM(runtime.simSpeed);
+    PUT_PARAM(runtime.maxPhysicsBodies);
     PUT_PARAM(runtime.cameraViewDistance);
     PUT_PARAM(runtime.horizontalFOV);
     PUT_PARAM(gui.cegui.enabled);
@@ -233,6 +236,7 @@ bool Configuration::toXML(const ResourcePath& xmlFilePath, const char* fileName
     PUT_PARAM(rendering.maxAnisotropicFilteringLevel);
     PUT_PARAM(rendering.reflectionPlaneResolution);
     PUT_PARAM(rendering.numLightsPerCluster);
+    PUT_PARAM(rendering.textureStreamingInFlightMB);
     PUT_PARAM(rendering.enableFog);
     PUT_PARAM(rendering.fogDensity);
     PUT_PARAM(rendering.fogScatter);
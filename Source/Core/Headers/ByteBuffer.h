@@ -51,6 +51,8 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Divide {
 
+class MemoryMappedFile;
+
 namespace Networking
 {
     class Connection;
@@ -196,6 +198,11 @@ class ByteBuffer
     /// To skip version checking, pass 0u as the version!
     /// This will erase any existing data inside of the buffer
     [[nodiscard]] bool loadFromFile(const ResourcePath& path, std::string_view fileName, const U8 version = BUFFER_FORMAT_VERSION);
+    /// Same as loadFromFile, but maps the file into memory and reads from it in place instead of copying it into the buffer's storage.
+    /// The buffer becomes a read-only view: any write is an error until clear() is called (which also releases the mapping)
+    [[nodiscard]] bool mapFromFile(const ResourcePath& path, std::string_view fileName, const U8 version = BUFFER_FORMAT_VERSION);
+    /// Returns true if the buffer is a read-only view over a mapped file (see mapFromFile)
+    [[nodiscard]] bool isView() const noexcept;
 
    private:
     /// Limited for internal use because can "append" any unexpected type (e.g. a pointer) with hard detection problem
@@ -205,6 +212,10 @@ class ByteBuffer
    protected:
     size_t _rpos = 0u, _wpos = 0u;
     vector<Byte> _storage;
+    /// Only set for read-only views. Shared so that copies of a view stay valid
+    std::shared_ptr<MemoryMappedFile> _mappedFile;
+    const Byte* _view = nullptr;
+    size_t _viewSize = 0u;
 };
 
 namespace Attorney
@@ -286,14 +286,14 @@ void ByteBuffer::readNoSkipFrom(const size_t pos, T& out) const
     DIVIDE_EXPECTED_CALL( pos + sizeof(T) <= storageSize() );
 
 
-    std::memcpy(&out, &_storage[pos], sizeof(T));
+    std::memcpy(&out, contents() + pos, sizeof(T));
 }
 
 inline void ByteBuffer::read(Byte *dest, const size_t len)
 {
     DIVIDE_EXPECTED_CALL( _rpos + len <= storageSize() );
 
-    memcpy(dest, &_storage[_rpos], len);
+    memcpy(dest, contents() + _rpos, len);
     _rpos += len;
 }
 
@@ -388,30 +388,39 @@ inline bool ByteBuffer::bufferEmpty() const noexcept {
 }
 
 inline size_t ByteBuffer::storageSize() const noexcept {
-    return _storage.size();
+    return _view != nullptr ? _viewSize : _storage.size();
 }
 
 inline bool ByteBuffer::storageEmpty() const noexcept {
-    return _storage.empty();
+    return storageSize() == 0u;
+}
+
+inline bool ByteBuffer::isView() const noexcept {
+    return _view != nullptr;
 }
 
 inline void ByteBuffer::resize(const size_t newsize) {
+    DIVIDE_ASSERT(!isView(), "ByteBuffer::resize: buffer is a read-only view!");
+
     _storage.resize(newsize);
     _rpos = 0;
     _wpos = storageSize();
 }
 
 inline void ByteBuffer::reserve(const size_t resize) {
+    DIVIDE_ASSERT(!isView(), "ByteBuffer::reserve: buffer is a read-only view!");
+
     if (resize > storageSize()) {
         _storage.reserve(resize);
     }
 }
 
 inline const Byte* ByteBuffer::contents() const noexcept {
-    return _storage.data();
+    return _view != nullptr ? _view : _storage.data();
 }
 
 inline void ByteBuffer::put(const size_t pos, const Byte *src, const size_t cnt) {
+    DIVIDE_ASSERT(!isView(), "ByteBuffer::put: buffer is a read-only view!");
     DIVIDE_EXPECTED_CALL(pos + cnt <= storageSize());
 
     memcpy(&_storage[pos], src, cnt);
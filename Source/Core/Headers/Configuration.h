@@ -92,6 +92,7 @@ struct Configuration final : XML::IXMLSerializable {
         vec2<U16> windowSize = { 1280, 720 };
         vec2<U16> resolution = { 1024, 768 };
         F32 simSpeed = 1.f;
+        U32 maxPhysicsBodies = 65536u;
         F32 cameraViewDistance = 1000.0f;
         U8  horizontalFOV = 90u;
     } runtime = {};
@@ -147,6 +148,8 @@ struct Configuration final : XML::IXMLSerializable {
         U16 reflectionProbeResolution = 256;
         U16 reflectionPlaneResolution = 512;
         I32 numLightsPerCluster = -1;
+        /// Max mip data being read and uploaded at once by texture streaming. Images still get their whole mip chain allocated, so this is not a memory budget. 0 = load every texture fully
+        U32 textureStreamingInFlightMB = 64u;
         bool enableFog = true;
         F32 fogDensity = 0.01f;
         F32 fogScatter = 0.01f;
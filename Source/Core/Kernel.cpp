@@ -731,6 +731,7 @@ ErrorCode Kernel::initialize(const string& entryPoint)
 
     ResourceCache::Init(renderingAPI, _platformContext);
     Attorney::TextureKernel::UseTextureDDSCache( config.debug.cache.enabled && config.debug.cache.textureDDS );
+    Attorney::TextureKernel::TextureStreamingInFlightBudget( to_size( config.rendering.textureStreamingInFlightMB ) * 1024u * 1024u );
 
     Camera::InitPool();
     initError = _platformContext.gfx().initRenderingAPI(_argc, _argv, renderingAPI);
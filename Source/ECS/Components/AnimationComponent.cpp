@@ -145,6 +145,22 @@ void AnimationComponent::setAnimator(SceneAnimator* animator)
     enabled(_animator != nullptr);
 }
 
+void AnimationComponent::blendTree(const AnimationBlendTree_ptr& tree)
+{
+    if (tree == nullptr)
+    {
+        _blendState.reset();
+        _skinningOffset = U32_MAX;
+        _previousSkinningOffset = U32_MAX;
+    }
+    else
+    {
+        _blendState = std::make_unique<AnimationBlendState>(tree);
+    }
+
+    _animationStateChanged = true;
+}
+
 void AnimationComponent::resetTimers(const D64 parentTimeStamp) noexcept
 {
     _currentTimeStamp = -1.0;
@@ -219,12 +235,6 @@ const vector<Line>& AnimationComponent::skeletonLines() const
     return  _animator->skeletonLines( _animationIndex, animTimeStamp, !_playInReverse);
 }
 
-ShaderBuffer* AnimationComponent::getBoneBuffer() const
-{
-    const AnimEvaluator& anim = getAnimationByIndex( std::min( _previousAnimationIndex, to_U32(_animator->animations().size()) ) );
-    return anim.boneBuffer();
-}
-
 I32 AnimationComponent::frameCount(const U32 animationID) const
 {
     assert(_animator != nullptr);
@@ -241,6 +251,12 @@ U8 AnimationComponent::boneCount() const
 
 bool AnimationComponent::frameTicked() const noexcept
 {
+    if (_blendState != nullptr)
+    {
+        // Runtime poses change every update
+        return playAnimations();
+    }
+
     return _playAnimations ? _frameIndex._prev != _frameIndex._curr : false;
 }
 
@@ -35,7 +35,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "SGNComponent.h"
 #include "Core/Math/Headers/Line.h"
-#include "Geometry/Animations/Headers/AnimationEvaluator.h"
+#include "Geometry/Animations/Headers/AnimationBlendTree.h"
 
 namespace Divide {
 
@@ -65,7 +65,8 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
     [[nodiscard]] bool frameTicked() const noexcept;
 
     [[nodiscard]] const vector<Line>& skeletonLines() const;
-    [[nodiscard]] ShaderBuffer* getBoneBuffer() const;
+    /// Shared bone buffer that holds this node's skinning data (see AnimationSystem::uploadBoneData). nullptr until the first upload
+    [[nodiscard]] ShaderBuffer* getBoneBuffer() const noexcept { return _boneBuffer; }
     
     [[nodiscard]] AnimEvaluator& getAnimationByIndex(U32 animationID) const;
 
@@ -77,6 +78,10 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
 
     [[nodiscard]] AnimEvaluator& getCurrentAnimation() const { return getAnimationByIndex(animationIndex()); }
 
+    /// Evaluate poses at runtime using the specified blend tree instead of playing back baked clips. Pass nullptr to go back to baked playback.
+    void blendTree(const AnimationBlendTree_ptr& tree);
+    [[nodiscard]] AnimationBlendState* blendState() const noexcept { return _blendState.get(); }
+
     PROPERTY_R(bool, showSkeleton, false);
     PROPERTY_RW(F32, animationSpeed, 1.f);
     PROPERTY_RW(bool, playInReverse, false);
@@ -88,6 +93,10 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
     PROPERTY_RW(U32, previousAnimationIndex, U32_MAX);
 
     PROPERTY_RW(bool, applyAnimationChangeToAllMeshes, true);
+    /// Offset (in bones) of this node's runtime pose in AnimationSystem::skinningMatrices(). U32_MAX if not using a blend tree
+    PROPERTY_R(U32, skinningOffset, U32_MAX);
+    /// Animation frame the shaders should use to index getBoneBuffer(). The previous frame's data is stored one block (boneCount() entries) before it
+    PROPERTY_R(U32, boneBufferFrame, 0u);
 
                   void playAnimations(const bool state)       noexcept { _playAnimations = state;}
     [[nodiscard]] bool playAnimations()                 const noexcept { return _playAnimations && s_globalAnimationState; }
@@ -98,6 +107,10 @@ BEGIN_COMPONENT(Animation, ComponentType::ANIMATION)
 
    protected:
     AnimEvaluator::FrameIndex _frameIndex = {};
+    AnimationBlendState_uptr _blendState = nullptr;
+    ShaderBuffer* _boneBuffer = nullptr;
+    /// Offset of this node's runtime pose in the skinning matrices evaluated during the previous AnimationSystem update
+    U32 _previousSkinningOffset = U32_MAX;
     /// Current animation timestamp for the current SGN
     D64 _currentTimeStamp = -1.0;
     /// Previous animation index
@@ -458,6 +458,12 @@ namespace Divide
                     const F32 distanceSQToCenter = LoDtarget.distanceSquared( cameraEye );
                     _lodLevels[to_base( renderStagePass._stage )] = getLoDLevelInternal( distanceSQToCenter, renderStagePass._stage, sceneRenderState.lodThresholds( renderStagePass._stage ) );
                 }
+
+                // Texture streaming uses the main view's LoD level as the finest mip this node needs
+                if ( renderStagePass._stage == RenderStage::DISPLAY && _materialInstance != INVALID_HANDLE<Material> )
+                {
+                    Get( _materialInstance )->requestTextureMips( _lodLevels[to_base( RenderStage::DISPLAY )] );
+                }
             }
         }
 
@@ -4,8 +4,49 @@
 
 #include "Graphs/Headers/SceneGraphNode.h"
 #include "Geometry/Animations/Headers/SceneAnimator.h"
+#include "Core/Headers/PlatformContext.h"
+#include "Platform/Video/Headers/GFXDevice.h"
 
 namespace Divide {
+    namespace
+    {
+        constexpr U32 g_parallelPartitionSize = 16u;
+
+        /// Returns the offset of a [previous, current] block of size 2 * boneCount allocated at the end of the specified range.
+        /// The offset is a multiple of boneCount so that the shaders can reach it as "boneCount * frame"
+        U32 AllocateBoneBlock(U32& rangeSizeInOut, const U32 boneCount) noexcept
+        {
+            const U32 offset = ((rangeSizeInOut + boneCount - 1u) / boneCount) * boneCount;
+            rangeSizeInOut = offset + 2u * boneCount;
+            return offset;
+        }
+
+        template<typename T>
+        void ResizeBoneBuffer(GFXDevice& context, ShaderBuffer_uptr& bufferInOut, const U32 elementCount, const char* name, vector<AnimationSystem::RetiredBuffer>& retiredBuffersInOut)
+        {
+            if (bufferInOut != nullptr && bufferInOut->getPrimitiveCount() >= elementCount)
+            {
+                return;
+            }
+
+            if (bufferInOut != nullptr)
+            {
+                // Frames that are still in flight may be reading from the old buffer, so keep it alive until they are done
+                retiredBuffersInOut.push_back(AnimationSystem::RetiredBuffer{ MOV(bufferInOut), GFXDevice::FrameCount() });
+            }
+
+            ShaderBufferDescriptor bufferDescriptor{};
+            bufferDescriptor._ringBufferLength = Config::MAX_FRAMES_IN_FLIGHT + 1u;
+            bufferDescriptor._usageType = BufferUsageType::UNBOUND_BUFFER;
+            bufferDescriptor._updateFrequency = BufferUpdateFrequency::OFTEN;
+            bufferDescriptor._elementSize = sizeof(T);
+            // Leave some room for new nodes so we don't reallocate every time something is spawned
+            bufferDescriptor._elementCount = elementCount + elementCount / 2u;
+            bufferDescriptor._name = name;
+            bufferInOut = context.newShaderBuffer(bufferDescriptor);
+        }
+    }
+
     AnimationSystem::AnimationSystem(ECS::ECSEngine& parentEngine, PlatformContext& context)
         : PlatformContextComponent(context)
         , ECSSystem(parentEngine)
@@ -35,13 +76,32 @@ namespace Divide {
 
         Parent::Update(dt);
 
+        _animatedComponents.resize(0);
+        _blendedComponents.resize(0);
+        U32 skinningOffset = 0u;
+
         for (AnimationComponent* comp : _componentCache)
         {
             const SceneAnimator* animator = comp->animator();
+            if (!animator)
+            {
+                continue;
+            }
 
-            if (!animator || COMPARE(comp->_parentTimeStamp, comp->_currentTimeStamp))
+            _animatedComponents.push_back(comp);
+
+            if (comp->_blendState != nullptr)
             {
-                return;
+                comp->_previousSkinningOffset = comp->_skinningOffset;
+                comp->_skinningOffset = skinningOffset;
+                skinningOffset += comp->boneCount();
+                _blendedComponents.push_back(comp);
+                continue;
+            }
+
+            if (COMPARE(comp->_parentTimeStamp, comp->_currentTimeStamp))
+            {
+                continue;
             }
 
             comp->_currentTimeStamp = comp->_parentTimeStamp;
@@ -71,6 +131,195 @@ namespace Divide {
                 /// And read back ragdoll results to update transforms accordingly
             //}
         }
+
+        // Runtime blended poses all write to their own range of the same output buffer, so they can be evaluated in parallel
+        std::swap(_skinningMatrices, _previousSkinningMatrices);
+        _skinningMatrices.resize(skinningOffset, MAT4_IDENTITY);
+
+        const D64 deltaTimeSeconds = Time::MillisecondsToSeconds<D64>(dt);
+        Parallel_For( _context.taskPool( TaskPoolType::HIGH_PRIORITY ),
+                      ParallelForDescriptor
+                      {
+                          ._iterCount = to_U32(_blendedComponents.size()),
+                          ._partitionSize = g_parallelPartitionSize
+                      },
+                      [this, deltaTimeSeconds](const Task*, const U32 start, const U32 end)
+                      {
+                          for (U32 i = start; i < end; ++i)
+                          {
+                              AnimationComponent* comp = _blendedComponents[i];
+                              const SceneAnimator* animator = comp->animator();
+
+                              const D64 compDelta = comp->playAnimations() ? deltaTimeSeconds * comp->animationSpeed() * (comp->playInReverse() ? -1.0 : 1.0) : 0.0;
+                              comp->_blendState->update(animator->skeletonLayout(),
+                                                        animator->animations(),
+                                                        compDelta,
+                                                        std::span<mat4<F32>>(_skinningMatrices.data() + comp->_skinningOffset, comp->boneCount()));
+                          }
+                      });
+
+        packBoneData();
+    }
+
+    void AnimationSystem::packBoneData()
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+        dvd_erase_if(_retiredBoneBuffers, [](const RetiredBuffer& entry)
+        {
+            return GFXDevice::FrameCount() - entry._frame > Config::MAX_FRAMES_IN_FLIGHT + 1u;
+        });
+
+        U32 matrixCount = 0u, quaternionCount = 0u;
+        for (AnimationComponent* comp : _animatedComponents)
+        {
+            const U32 boneCount = comp->boneCount();
+            if (boneCount == 0u)
+            {
+                comp->_boneBufferFrame = 0u;
+                continue;
+            }
+
+            const U32 offset = AllocateBoneBlock(comp->animator()->useDualQuaternion() ? quaternionCount : matrixCount, boneCount);
+            // The shaders read the previous frame's data from "frame - 1"
+            comp->_boneBufferFrame = offset / boneCount + 1u;
+        }
+
+        _boneMatrixData.resize(matrixCount);
+        _boneQuaternionData.resize(quaternionCount);
+
+        GFXDevice& gfx = _context.gfx();
+        if (matrixCount > 0u)
+        {
+            ResizeBoneBuffer<mat4<F32>>(gfx, _boneMatrixBuffer, matrixCount, "BONE_BUFFER_MATRICES", _retiredBoneBuffers);
+        }
+        if (quaternionCount > 0u)
+        {
+            ResizeBoneBuffer<DualQuaternion>(gfx, _boneQuaternionBuffer, quaternionCount, "BONE_BUFFER_QUATERNIONS", _retiredBoneBuffers);
+        }
+
+        // Every node writes to its own block so we can fill them all in parallel
+        Parallel_For( _context.taskPool( TaskPoolType::HIGH_PRIORITY ),
+                      ParallelForDescriptor
+                      {
+                          ._iterCount = to_U32(_animatedComponents.size()),
+                          ._partitionSize = g_parallelPartitionSize
+                      },
+                      [this](const Task*, const U32 start, const U32 end)
+                      {
+                          for (U32 i = start; i < end; ++i)
+                          {
+                              AnimationComponent* comp = _animatedComponents[i];
+                              const SceneAnimator* animator = comp->animator();
+
+                              const U32 boneCount = comp->boneCount();
+                              if (boneCount == 0u)
+                              {
+                                  comp->_boneBuffer = nullptr;
+                                  continue;
+                              }
+
+                              comp->_boneBuffer = animator->useDualQuaternion() ? _boneQuaternionBuffer.get() : _boneMatrixBuffer.get();
+
+                              const mat4<F32>* previousPose = nullptr;
+                              const mat4<F32>* currentPose = nullptr;
+                              const DualQuaternion* previousQuaternions = nullptr;
+                              const DualQuaternion* currentQuaternions = nullptr;
+
+                              if (comp->_blendState != nullptr)
+                              {
+                                  currentPose = _skinningMatrices.data() + comp->_skinningOffset;
+                                  previousPose = comp->_previousSkinningOffset != U32_MAX && comp->_previousSkinningOffset + boneCount <= _previousSkinningMatrices.size()
+                                                                                          ? _previousSkinningMatrices.data() + comp->_previousSkinningOffset
+                                                                                          : currentPose;
+                              }
+                              else
+                              {
+                                  const U32 animationIndex = comp->animationIndex();
+                                  if (animationIndex < animator->animations().size() && animator->frameCount(animationIndex) > 0u)
+                                  {
+                                      const AnimEvaluator& animation = animator->animationByIndex(animationIndex);
+                                      const U32 lastFrame = animation.frameCount() - 1u;
+                                      const U32 currentFrame = comp->playAnimations() ? std::min(to_U32(std::max(comp->_frameIndex._curr, 0)), lastFrame) : 0u;
+                                      const U32 previousFrame = comp->playAnimations() ? std::min(to_U32(std::max(comp->_frameIndex._prev, 0)), lastFrame) : 0u;
+
+                                      if (animator->useDualQuaternion())
+                                      {
+                                          previousQuaternions = animation.transQuaternions()[previousFrame].data();
+                                          currentQuaternions = animation.transQuaternions()[currentFrame].data();
+                                      }
+                                      else
+                                      {
+                                          previousPose = animation.transformMatrices(previousFrame).data();
+                                          currentPose = animation.transformMatrices(currentFrame).data();
+                                      }
+                                  }
+                              }
+
+                              const U32 offset = (comp->_boneBufferFrame - 1u) * boneCount;
+                              if (animator->useDualQuaternion())
+                              {
+                                  DualQuaternion* target = _boneQuaternionData.data() + offset;
+                                  if (currentQuaternions != nullptr)
+                                  {
+                                      std::memcpy(target, previousQuaternions, boneCount * sizeof(DualQuaternion));
+                                      std::memcpy(target + boneCount, currentQuaternions, boneCount * sizeof(DualQuaternion));
+                                  }
+                                  else if (currentPose != nullptr)
+                                  {
+                                      for (U32 b = 0u; b < boneCount; ++b)
+                                      {
+                                          Util::ToDualQuaternion(previousPose[b], target[b].a, target[b].b);
+                                          Util::ToDualQuaternion(currentPose[b], target[boneCount + b].a, target[boneCount + b].b);
+                                      }
+                                  }
+                                  else
+                                  {
+                                      // No valid animation to sample: identity skinning leaves the mesh in its bind pose instead of showing stale data
+                                      Util::ToDualQuaternion(MAT4_IDENTITY, target[0].a, target[0].b);
+                                      std::fill(target + 1u, target + 2u * boneCount, target[0]);
+                                  }
+                              }
+                              else
+                              {
+                                  mat4<F32>* target = _boneMatrixData.data() + offset;
+                                  if (currentPose != nullptr)
+                                  {
+                                      std::memcpy(target, previousPose, boneCount * sizeof(mat4<F32>));
+                                      std::memcpy(target + boneCount, currentPose, boneCount * sizeof(mat4<F32>));
+                                  }
+                                  else
+                                  {
+                                      // No valid animation to sample: identity skinning leaves the mesh in its bind pose instead of showing stale data
+                                      std::fill(target, target + 2u * boneCount, MAT4_IDENTITY);
+                                  }
+                              }
+                          }
+                      });
+    }
+
+    void AnimationSystem::uploadBoneData(GFX::MemoryBarrierCommand& memCmdInOut)
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Graphics );
+
+        // Multiple player passes may request an upload in the same frame
+        if (_lastUploadFrame == GFXDevice::FrameCount())
+        {
+            return;
+        }
+        _lastUploadFrame = GFXDevice::FrameCount();
+
+        if (!_boneMatrixData.empty())
+        {
+            _boneMatrixBuffer->incQueue();
+            memCmdInOut._bufferLocks.push_back(_boneMatrixBuffer->writeData({0u, _boneMatrixData.size()}, _boneMatrixData.data()));
+        }
+
+        if (!_boneQuaternionData.empty())
+        {
+            _boneQuaternionBuffer->incQueue();
+            memCmdInOut._bufferLocks.push_back(_boneQuaternionBuffer->writeData({0u, _boneQuaternionData.size()}, _boneQuaternionData.data()));
+        }
     }
 
     void AnimationSystem::PostUpdate(const F32 dt)
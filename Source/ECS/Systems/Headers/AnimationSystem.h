@@ -38,6 +38,11 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ECS/Components/Headers/AnimationComponent.h"
 
 namespace Divide {
+    namespace GFX
+    {
+        struct MemoryBarrierCommand;
+    };
+
     class AnimationSystem final : public PlatformContextComponent,
                                   public ECSSystem<AnimationSystem, AnimationComponent> {
         using Parent = ECSSystem<AnimationSystem, AnimationComponent>;
@@ -53,6 +58,38 @@ namespace Divide {
 
         void toggleAnimationState(bool state) noexcept;
         [[nodiscard]] bool getAnimationState() const noexcept;
+
+        /// Skinning matrices of every node that uses a blend tree, evaluated during the last Update call. See AnimationComponent::skinningOffset()
+        [[nodiscard]] const BoneMatrices& skinningMatrices() const noexcept { return _skinningMatrices; }
+
+        /// Copies the skinning data gathered during the last Update call to the shared bone buffers.
+        /// Must be called once per frame before any render pass binds a node's bone buffer
+        void uploadBoneData(GFX::MemoryBarrierCommand& memCmdInOut);
+
+        struct RetiredBuffer
+        {
+            ShaderBuffer_uptr _buffer;
+            U64 _frame{ 0u };
+        };
+
+      private:
+        void packBoneData();
+
+      private:
+        vector<AnimationComponent*> _animatedComponents;
+        vector<AnimationComponent*> _blendedComponents;
+        BoneMatrices _skinningMatrices;
+        BoneMatrices _previousSkinningMatrices;
+
+        /// Per frame skinning data of every animated node. Each node owns a [previous frame, current frame] block
+        /// that starts at a multiple of its bone count so that the shaders can index it by frame
+        BoneMatrices    _boneMatrixData;
+        BoneQuaternions _boneQuaternionData;
+        ShaderBuffer_uptr _boneMatrixBuffer = nullptr;
+        ShaderBuffer_uptr _boneQuaternionBuffer = nullptr;
+        /// Bone buffers replaced by a larger allocation. Kept alive until no frame in flight can still be reading from them
+        vector<RetiredBuffer> _retiredBoneBuffers;
+        U64 _lastUploadFrame = U64_MAX;
     };
 }
 
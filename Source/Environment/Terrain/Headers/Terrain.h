@@ -38,6 +38,7 @@
 #include "Geometry/Shapes/Headers/Object3D.h"
 #include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
 #include "Environment/Terrain/Quadtree/Headers/Quadtree.h"
+#include "Environment/Terrain/Headers/TerrainTileCache.h"
 #include "Rendering/Lighting/ShadowMapping/Headers/ShadowMap.h"
 #include "Platform/Video/Buffers/VertexBuffer/Headers/VertexBuffer.h"
 
@@ -125,7 +126,7 @@ DEFINE_3D_OBJECT_TYPE(Terrain, SceneNodeType::TYPE_TERRAIN)
 
     void toggleBoundingBoxes();
 
-    [[nodiscard]] const vector<VertexBuffer::Vertex>& getVerts() const noexcept;
+    [[nodiscard]] const TerrainTileCache& tileCache() const noexcept { return _tileCache; }
     [[nodiscard]] Vert      getVert(F32 x_clampf, F32 z_clampf, bool smooth) const;
     [[nodiscard]] Vert      getVertFromGlobal(F32 x, F32 z, bool smooth) const;
     [[nodiscard]] vec2<U16> getDimensions() const noexcept;
@@ -150,6 +151,8 @@ DEFINE_3D_OBJECT_TYPE(Terrain, SceneNodeType::TYPE_TERRAIN)
 
      void buildDrawCommands(SceneGraphNode* sgn, GenericDrawCommandContainer& cmdsOut) override;
 
+     void sceneUpdate(U64 deltaTimeUS, SceneGraphNode* sgn, SceneState& sceneState) override;
+
      void prepareRender(SceneGraphNode* sgn,
                         RenderingComponent& rComp,
                         RenderPackage& pkg,
@@ -167,15 +170,15 @@ DEFINE_3D_OBJECT_TYPE(Terrain, SceneNodeType::TYPE_TERRAIN)
      [[nodiscard]] bool loadResources( PlatformContext& context );
 
      PROPERTY_R(TessellationParams, tessParams);
+     /// Base name (without extension) of every cache file generated from this terrain's heightfield. Stored in Paths::g_terrainCacheLocation
+     PROPERTY_R(string, cacheFileName);
 
    protected:
      friend class ResourceCache;
      bool postLoad() override;
 
-   public:
-     vector<VertexBuffer::Vertex> _physicsVerts;
-
    protected:
+    TerrainTileCache _tileCache;
     Quadtree _terrainQuadtree;
     vector<TerrainChunk*> _terrainChunks;
     GPUBuffer_uptr _terrainVBBuffer = nullptr;
@@ -41,7 +41,7 @@ namespace Divide {
 class Mesh;
 class Terrain;
 class BoundingBox;
-class QuadtreeNode;
+class Quadtree;
 class ShaderProgram;
 class SceneGraphNode;
 class SceneRenderState;
@@ -60,7 +60,7 @@ class TerrainChunk
     friend class Attorney::TerrainChunkVegetation;
 
    public:
-    TerrainChunk(Terrain* parentTerrain, QuadtreeNode& parentNode) noexcept;
+    TerrainChunk(Terrain* parentTerrain, const Quadtree& quadtree, U32 leafIndex) noexcept;
 
     void load(U8 depth, const uint2 pos, U32 targetChunkDimension, uint2 HMSize, BoundingBox& bbInOut);
 
@@ -70,21 +70,21 @@ class TerrainChunk
     }
 
     [[nodiscard]] const Terrain& parent() const noexcept { return *_parentTerrain; }
-    [[nodiscard]] const QuadtreeNode& quadtreeNode() const noexcept { return _quadtreeNode; }
+    [[nodiscard]] const Quadtree& quadtree() const noexcept { return _quadtree; }
 
-    [[nodiscard]] const BoundingBox& bounds() const noexcept;
+    [[nodiscard]] BoundingBox bounds() const noexcept;
     void drawBBox(GFXDevice& context) const;
 
-    [[nodiscard]] U8 LoD() const noexcept;
-
     PROPERTY_R(U32, id, 0u);
+    /// Index of this chunk's leaf in the quadtree's Morton ordered leaf level
+    PROPERTY_R(U32, leafIndex, 0u);
 
 
    private:
     void initVegetation( PlatformContext& context, Handle<Vegetation> handle );
 
    private:
-    QuadtreeNode& _quadtreeNode;
+    const Quadtree& _quadtree;
 
     F32 _xOffset{0.f};
     F32 _yOffset{0.f};
@@ -0,0 +1,133 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_TERRAIN_TILE_CACHE_H_
+#define DVD_TERRAIN_TILE_CACHE_H_
+
+#include "Platform/File/Headers/MemoryMappedFile.h"
+
+namespace Divide {
+
+/// Height and physics vertex data of a terrain, stored as square tiles in a page-aligned cache file.
+/// The file is memory-mapped and queried in place, so only the tiles that are actually read stay resident.
+class TerrainTileCache final : NonCopyable
+{
+  public:
+    static constexpr U16 FILE_VERSION = 1u;
+    /// Vertices per tile edge
+    static constexpr U32 TILE_SIZE = 64u;
+    /// Header size and tile stride granularity. Matches (or is a multiple of) the VM page size on every platform we ship on
+    static constexpr size_t PAGE_ALIGNMENT = 16u * 1024u;
+
+    struct Vertex
+    {
+        float3 _position;
+        F32    _normal{0.f};
+        F32    _tangent{0.f};
+    };
+
+    /// Allocates an in-memory image of the cache that can be filled in through vertex(x, y) and then persisted with save()
+    void create(U32 width, U32 height, size_t inputHash);
+    /// Writes the in-memory image to disk and swaps it for a mapped view of the new file
+    [[nodiscard]] bool save(const ResourcePath& filePath, std::string_view fileName);
+    /// Maps an existing cache file. Fails if the file is missing, truncated or was built from different inputs
+    [[nodiscard]] bool load(const ResourcePath& filePath, std::string_view fileName, U32 width, U32 height, size_t inputHash);
+    void clear() noexcept;
+
+    /// Prefetch the tiles within tileRadius of the vertex rect [minVertex, maxVertex] and allow the OS to drop the ones that fell out of range since the last call
+    void setActiveRegion(const uint2& minVertex, const uint2& maxVertex, U32 tileRadius) noexcept;
+
+    [[nodiscard]] const Vertex& vertex(U32 x, U32 y) const noexcept;
+    /// Only valid on an image that was create()-ed and not yet saved
+    [[nodiscard]] Vertex& vertex(U32 x, U32 y) noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return _data == nullptr; }
+    [[nodiscard]] bool isMapped() const noexcept { return _file.isOpen(); }
+
+    PROPERTY_R(U32, width, 0u);
+    PROPERTY_R(U32, height, 0u);
+    /// Hash of the source data the cache was built from. Derived caches (e.g. physics) can use it to validate themselves
+    PROPERTY_R(size_t, inputHash, 0u);
+
+  private:
+    struct Header
+    {
+        U32 _magic{ 0u };
+        U16 _version{ 0u };
+        U16 _tileSize{ 0u };
+        U32 _width{ 0u };
+        U32 _height{ 0u };
+        U64 _tileStride{ 0u };
+        U64 _inputHash{ 0u };
+    };
+
+    [[nodiscard]] size_t tileOffset(U32 tileX, U32 tileY) const noexcept;
+    [[nodiscard]] size_t vertexOffset(U32 x, U32 y) const noexcept;
+    void setLayout(U32 width, U32 height) noexcept;
+
+  private:
+    MemoryMappedFile _file;
+    vector<Byte> _image;
+    const Byte* _data = nullptr;
+    size_t _tileStride = 0u;
+    U32 _tileCountX = 0u;
+    U32 _tileCountY = 0u;
+    /// Tile rect (min x, min y, max x, max y) requested by the last setActiveRegion call. Empty until the first call
+    int4 _activeTiles{ 0, 0, -1, -1 };
+};
+
+FORCE_INLINE size_t TerrainTileCache::vertexOffset(const U32 x, const U32 y) const noexcept
+{
+    return tileOffset(x / TILE_SIZE, y / TILE_SIZE) + (to_size(y % TILE_SIZE) * TILE_SIZE + x % TILE_SIZE) * sizeof(Vertex);
+}
+
+FORCE_INLINE size_t TerrainTileCache::tileOffset(const U32 tileX, const U32 tileY) const noexcept
+{
+    return PAGE_ALIGNMENT + (to_size(tileY) * _tileCountX + tileX) * _tileStride;
+}
+
+FORCE_INLINE const TerrainTileCache::Vertex& TerrainTileCache::vertex(const U32 x, const U32 y) const noexcept
+{
+    DIVIDE_ASSERT(x < _width && y < _height);
+    return *reinterpret_cast<const Vertex*>(_data + vertexOffset(x, y));
+}
+
+FORCE_INLINE TerrainTileCache::Vertex& TerrainTileCache::vertex(const U32 x, const U32 y) noexcept
+{
+    DIVIDE_ASSERT(x < _width && y < _height && !_image.empty());
+    return *reinterpret_cast<Vertex*>(_image.data() + vertexOffset(x, y));
+}
+
+}; //namespace Divide
+
+#endif //DVD_TERRAIN_TILE_CACHE_H_
@@ -33,51 +33,78 @@
 #ifndef DVD_QUAD_TREE
 #define DVD_QUAD_TREE
 
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+
 namespace Divide {
 
 class Terrain;
 class GFXDevice;
-class SceneState;
-class BoundingBox;
-class IMPrimitive;
-class VertexBuffer;
-class ShaderProgram;
-class SceneGraphNode;
-class SceneRenderState;
-
-struct RenderPackage;
 
-FWD_DECLARE_MANAGED_CLASS(QuadtreeNode);
+FWD_DECLARE_MANAGED_CLASS(TerrainChunk);
 
+/// Implicit, complete quadtree over the terrain's chunks.
+/// Nodes are stored level by level, in Morton (Z) order inside each level, so a node's four children are always adjacent
+/// and every leaf (chunk) below a node occupies a contiguous index range. Bounds live in SoA arrays for batched tests.
 class Quadtree {
   public:
-    Quadtree();
+    static constexpr U8 MAX_DEPTH = 14u;
+
+    struct Selection
+    {
+        U32 _node{ 0u };
+        /// Number of levels above the leaves the node sits at. 0 is full resolution
+        U8 _LoD{ 0u };
+    };
+
+    Quadtree() = default;
     ~Quadtree();
 
+    /// Builds the node hierarchy and, if a terrain is specified, creates and loads its chunks. Passing nullptr builds flat bounds only
     void build(const BoundingBox& terrainBBox,
-               const vec2<U16> HMSize,
+               vec2<U16> HMSize,
                Terrain* terrain);
 
-    [[nodiscard]] const BoundingBox& computeBoundingBox() const;
+    [[nodiscard]] BoundingBox computeBoundingBox() const noexcept;
+
+    [[nodiscard]] U32 getChunkCount() const noexcept { return to_U32(_chunks.size()); }
+    [[nodiscard]] U32 getNodeCount() const noexcept { return to_U32(_minX.size()); }
+    [[nodiscard]] U8  getLeafLevel() const noexcept { return _leafLevel; }
 
-    [[nodiscard]] U32 getChunkCount() const noexcept { return _chunkCount; }
+    /// Picks, per view, the coarsest set of visible nodes whose horizontal extent is below lodThreshold times their distance to the eye.
+    /// Node bounds are in the terrain's local space, so eye and frustumPlanes must be transformed into that space by the caller.
+    /// Traversal is iterative and allocation-free once selectionOut has grown to its working size. Results are in Morton order
+    void selectLoD(const float3& eye, const PlaneList<6>& frustumPlanes, F32 lodThreshold, vector<Selection>& selectionOut) const;
+
+    /// Range of chunk indices [first, last) covered by the specified node
+    [[nodiscard]] std::pair<U32, U32> leafRange(const Selection& selection) const noexcept;
+
+    [[nodiscard]] BoundingBox nodeBounds(U32 node) const noexcept;
+    [[nodiscard]] TerrainChunk* chunk(const U32 index) const noexcept { return _chunks[index].get(); }
+    [[nodiscard]] TerrainChunk* findLeaf(float2 pos) const noexcept;
 
     void drawBBox(GFXDevice& context) const;
     void toggleBoundingBoxes();
 
-    [[nodiscard]] QuadtreeNode* findLeaf(float2 pos) const noexcept;
-
-    const QuadtreeNode_uptr& getRoot() const noexcept { return _root; }
+    /// Index of the first node of the specified level
+    [[nodiscard]] static U32 LevelOffset(U8 level) noexcept;
 
     PROPERTY_R_IW(U32, targetChunkDimension, 0u);
 
    private:
-    QuadtreeNode_uptr _root;
-    VertexBuffer* _parentVB = nullptr;
-    U32 _chunkCount = 0u;
+    vector<F32> _minX, _minY, _minZ;
+    vector<F32> _maxX, _maxY, _maxZ;
+    /// Leaf chunks, in Morton order
+    vector<TerrainChunk_uptr> _chunks;
+    U8 _leafLevel = 0u;
     bool _drawBBoxes = false;
 };
 
+FORCE_INLINE U32 Quadtree::LevelOffset(const U8 level) noexcept
+{
+    // 1 + 4 + 16 + ... + 4^(level - 1)
+    return ((1u << (2u * level)) - 1u) / 3u;
+}
+
 }  // namespace Divide
 
 #endif //DVD_QUAD_TREE
@@ -1,80 +1,321 @@
 
 
 #include "Headers/Quadtree.h"
-#include "Headers/QuadtreeNode.h"
 #include "Environment/Terrain/Headers/Terrain.h"
+#include "Environment/Terrain/Headers/TerrainChunk.h"
 #include "Platform/Video/Headers/GFXDevice.h"
 
 namespace Divide {
 
-Quadtree::Quadtree()
-    : _root(std::make_unique<QuadtreeNode>(this))
+namespace
 {
+    /// Interleaves the bits of x (even) and y (odd). Child order inside a node is therefore NW, NE, SW, SE
+    [[nodiscard]] U32 MortonEncode(const U32 x, const U32 y) noexcept
+    {
+        const auto spread = [](U32 v) noexcept
+        {
+            v &= 0x0000FFFFu;
+            v = (v | (v << 8u)) & 0x00FF00FFu;
+            v = (v | (v << 4u)) & 0x0F0F0F0Fu;
+            v = (v | (v << 2u)) & 0x33333333u;
+            v = (v | (v << 1u)) & 0x55555555u;
+            return v;
+        };
+
+        return spread(x) | (spread(y) << 1u);
+    }
+
+    [[nodiscard]] U32 MortonCompact(U32 v) noexcept
+    {
+        v &= 0x55555555u;
+        v = (v | (v >> 1u)) & 0x33333333u;
+        v = (v | (v >> 2u)) & 0x0F0F0F0Fu;
+        v = (v | (v >> 4u)) & 0x00FF00FFu;
+        v = (v | (v >> 8u)) & 0x0000FFFFu;
+        return v;
+    }
+
+    struct NodeTest
+    {
+        bool _visible[4]{};
+        bool _coarseEnough[4]{};
+    };
+
+    /// Frustum and LoD tests for count (1 or 4) adjacent nodes. Written as flat loops over the SoA arrays so they vectorise
+    void TestNodes(const F32* minX, const F32* minY, const F32* minZ,
+                   const F32* maxX, const F32* maxY, const F32* maxZ,
+                   const U32 count,
+                   const float3& eye,
+                   const PlaneList<6>& frustumPlanes,
+                   const F32 lodThreshold,
+                   NodeTest& testOut) noexcept
+    {
+        F32 outside[4]{ 0.f, 0.f, 0.f, 0.f };
+        for (const Plane<F32>& plane : frustumPlanes)
+        {
+            const float3& n = plane._normal;
+            for (U32 i = 0u; i < count; ++i)
+            {
+                // Positive vertex: the box corner furthest along the plane normal
+                const F32 px = n.x >= 0.f ? maxX[i] : minX[i];
+                const F32 py = n.y >= 0.f ? maxY[i] : minY[i];
+                const F32 pz = n.z >= 0.f ? maxZ[i] : minZ[i];
+                const F32 d = n.x * px + n.y * py + n.z * pz + plane._distance;
+                outside[i] = std::min(outside[i], d);
+            }
+        }
+
+        for (U32 i = 0u; i < count; ++i)
+        {
+            const F32 dx = std::max(std::max(minX[i] - eye.x, 0.f), eye.x - maxX[i]);
+            const F32 dy = std::max(std::max(minY[i] - eye.y, 0.f), eye.y - maxY[i]);
+            const F32 dz = std::max(std::max(minZ[i] - eye.z, 0.f), eye.z - maxZ[i]);
+            const F32 distance = Sqrt<F32>(dx * dx + dy * dy + dz * dz);
+            const F32 extent = std::max(maxX[i] - minX[i], maxZ[i] - minZ[i]);
+
+            testOut._visible[i] = outside[i] >= 0.f;
+            testOut._coarseEnough[i] = extent < lodThreshold * distance;
+        }
+    }
 }
 
 Quadtree::~Quadtree()
 {
 }
 
-void Quadtree::toggleBoundingBoxes() {
+void Quadtree::toggleBoundingBoxes()
+{
     _drawBBoxes = !_drawBBoxes;
-    _root->toggleBoundingBoxes();
 }
 
-void Quadtree::drawBBox(GFXDevice& context) const {
-    if (!_drawBBoxes) {
+void Quadtree::drawBBox(GFXDevice& context) const
+{
+    if (!_drawBBoxes || _minX.empty())
+    {
         return;
     }
 
-    _root->drawBBox(context);
- 
     IM::BoxDescriptor descriptor;
-    descriptor.min = _root->getBoundingBox()._min;
-    descriptor.max = _root->getBoundingBox()._max;
+    descriptor.colour = UColour4(0, 128, 255, 255);
+
+    const U32 leafOffset = LevelOffset(_leafLevel);
+    for (U32 i = 0u; i < getChunkCount(); ++i)
+    {
+        descriptor.min.set(_minX[leafOffset + i], _minY[leafOffset + i], _minZ[leafOffset + i]);
+        descriptor.max.set(_maxX[leafOffset + i], _maxY[leafOffset + i], _maxZ[leafOffset + i]);
+        context.debugDrawBox(_chunks[i]->id(), descriptor);
+    }
+
+    descriptor.min.set(_minX[0], _minY[0], _minZ[0]);
+    descriptor.max.set(_maxX[0], _maxY[0], _maxZ[0]);
     descriptor.colour = UColour4(0, 64, 255, 255);
     context.debugDrawBox(-1, descriptor);
 }
 
-QuadtreeNode* Quadtree::findLeaf(const float2 pos) const noexcept
+BoundingBox Quadtree::nodeBounds(const U32 node) const noexcept
 {
-    assert(_root);
-
-    QuadtreeNode* node = _root.get();
-    while (!node->isALeaf()) {
-        U32 i;
-        for (i = 0; i < 4; i++) {
-            QuadtreeNode* child = &node->getChild(i);
-            const BoundingBox& bb = child->getBoundingBox();
-            if (bb.containsPoint(float3(pos.x, bb.getCenter().y, pos.y))) {
-                node = child;
-                break;
-            }
-        }
+    return BoundingBox(_minX[node], _minY[node], _minZ[node], _maxX[node], _maxY[node], _maxZ[node]);
+}
 
-        if (i >= 4) {
-            return nullptr;
-        }
+std::pair<U32, U32> Quadtree::leafRange(const Selection& selection) const noexcept
+{
+    const U8 level = _leafLevel - selection._LoD;
+    const U32 shift = 2u * selection._LoD;
+    const U32 first = (selection._node - LevelOffset(level)) << shift;
+    return { first, first + (1u << shift) };
+}
+
+TerrainChunk* Quadtree::findLeaf(const float2 pos) const noexcept
+{
+    if (_chunks.empty() || pos.x < _minX[0] || pos.x > _maxX[0] || pos.y < _minZ[0] || pos.y > _maxZ[0])
+    {
+        return nullptr;
     }
 
-    return node;
+    const U32 leavesPerSide = 1u << _leafLevel;
+    const F32 cellX = (_maxX[0] - _minX[0]) / leavesPerSide;
+    const F32 cellZ = (_maxZ[0] - _minZ[0]) / leavesPerSide;
+    const U32 x = std::min(to_U32((pos.x - _minX[0]) / cellX), leavesPerSide - 1u);
+    const U32 y = std::min(to_U32((pos.y - _minZ[0]) / cellZ), leavesPerSide - 1u);
+    return _chunks[MortonEncode(x, y)].get();
 }
 
 void Quadtree::build(const BoundingBox& terrainBBox,
                      const vec2<U16> HMSize,
-                     Terrain* const terrain) {
-
+                     Terrain* const terrain)
+{
+    _chunks.clear();
     _targetChunkDimension = std::max(HMSize.maxComponent() / 8u, 8u);
+    const U32 targetChunkDimension = std::min(_targetChunkDimension, to_U32(HMSize.width));
+
+    // Every level splits all of its nodes the same way, so the tree is complete: find the leaf level and the heightmap offset each split applies
+    std::array<vec2<U16>, MAX_DEPTH> splitSize{};
+    _leafLevel = 0u;
+    for (;; ++_leafLevel)
+    {
+        const U32 div = 1u << _leafLevel;
+        vec2<U16> nodesize = HMSize / div;
+        if (nodesize.x % 2 == 0)
+        {
+            nodesize.x++;
+        }
+        if (nodesize.y % 2 == 0)
+        {
+            nodesize.y++;
+        }
+
+        const vec2<U16> newsize = nodesize / 2;
+        if (std::max(newsize.x, newsize.y) < targetChunkDimension || _leafLevel == MAX_DEPTH)
+        {
+            break;
+        }
+        splitSize[_leafLevel] = newsize;
+    }
+
+    const U32 nodeCount = LevelOffset(_leafLevel + 1u);
+    for (vector<F32>* component : { &_minX, &_minY, &_minZ, &_maxX, &_maxY, &_maxZ })
+    {
+        component->resize(nodeCount);
+    }
 
-    _root->setBoundingBox(terrainBBox);
-    _root->build(0, vec2<U16>(0u), HMSize, _targetChunkDimension, terrain, _chunkCount);
+    _minX[0] = terrainBBox._min.x; _minY[0] = terrainBBox._min.y; _minZ[0] = terrainBBox._min.z;
+    _maxX[0] = terrainBBox._max.x; _maxY[0] = terrainBBox._max.y; _maxZ[0] = terrainBBox._max.z;
+
+    // Top-down: split every node's XZ rectangle around its centre. Heights are filled in bottom-up once the chunks are loaded
+    for (U8 level = 0u; level < _leafLevel; ++level)
+    {
+        const U32 levelStart = LevelOffset(level);
+        const U32 childStart = LevelOffset(level + 1u);
+        for (U32 m = 0u; m < (1u << (2u * level)); ++m)
+        {
+            const U32 node = levelStart + m;
+            const F32 centreX = (_minX[node] + _maxX[node]) * 0.5f;
+            const F32 centreZ = (_minZ[node] + _maxZ[node]) * 0.5f;
+            for (U32 c = 0u; c < 4u; ++c)
+            {
+                const U32 child = childStart + m * 4u + c;
+                const bool east = (c & 1u) != 0u;
+                const bool south = (c & 2u) != 0u;
+                _minX[child] = east ? centreX : _minX[node];
+                _maxX[child] = east ? _maxX[node] : centreX;
+                _minZ[child] = south ? centreZ : _minZ[node];
+                _maxZ[child] = south ? _maxZ[node] : centreZ;
+                _minY[child] = _minY[node];
+                _maxY[child] = _maxY[node];
+            }
+        }
+    }
+
+    if (terrain != nullptr)
+    {
+        const U32 leafOffset = LevelOffset(_leafLevel);
+        const U32 leafCount = 1u << (2u * _leafLevel);
+        _chunks.reserve(leafCount);
+
+        // Morton order matches the old depth-first NW, NE, SW, SE creation order, so chunk IDs and registration order are unchanged
+        for (U32 m = 0u; m < leafCount; ++m)
+        {
+            const U32 x = MortonCompact(m);
+            const U32 y = MortonCompact(m >> 1u);
+
+            uint2 pos{ 0u, 0u };
+            for (U8 level = 0u; level < _leafLevel; ++level)
+            {
+                const U32 bit = _leafLevel - 1u - level;
+                pos.x += ((x >> bit) & 1u) * splitSize[level].x;
+                pos.y += ((y >> bit) & 1u) * splitSize[level].y;
+            }
+
+            const U32 node = leafOffset + m;
+            BoundingBox leafBB = nodeBounds(node);
+
+            TerrainChunk_uptr& chunk = _chunks.emplace_back(std::make_unique<TerrainChunk>(terrain, *this, m));
+            chunk->load(_leafLevel, pos, targetChunkDimension, uint2{ HMSize.x, HMSize.y }, leafBB);
+
+            _minY[node] = leafBB._min.y;
+            _maxY[node] = leafBB._max.y;
+        }
+    }
+
+    // Bottom-up: every interior node encloses its (adjacent) children. The root also keeps the terrain's own bounds
+    for (I32 level = to_I32(_leafLevel) - 1; level >= 0; --level)
+    {
+        const U32 levelStart = LevelOffset(to_U8(level));
+        const U32 childStart = LevelOffset(to_U8(level + 1));
+        for (U32 m = 0u; m < (1u << (2u * level)); ++m)
+        {
+            const U32 node = levelStart + m;
+            const U32 first = childStart + m * 4u;
+
+            F32 minY = level == 0 ? _minY[node] : F32_MAX;
+            F32 maxY = level == 0 ? _maxY[node] : F32_LOWEST;
+            for (U32 c = 0u; c < 4u; ++c)
+            {
+                minY = std::min(minY, _minY[first + c]);
+                maxY = std::max(maxY, _maxY[first + c]);
+            }
+            _minY[node] = minY;
+            _maxY[node] = maxY;
+        }
+    }
 }
 
-const BoundingBox& Quadtree::computeBoundingBox() const {
-    assert(_root);
-    BoundingBox rootBB = _root->getBoundingBox();
-    DIVIDE_EXPECTED_CALL( _root->computeBoundingBox(rootBB) );
+BoundingBox Quadtree::computeBoundingBox() const noexcept
+{
+    assert(!_minX.empty());
+    return nodeBounds(0u);
+}
 
-    return _root->getBoundingBox();
+void Quadtree::selectLoD(const float3& eye, const PlaneList<6>& frustumPlanes, const F32 lodThreshold, vector<Selection>& selectionOut) const
+{
+    selectionOut.clear();
+    if (_minX.empty())
+    {
+        return;
+    }
+
+    NodeTest test{};
+    TestNodes(&_minX[0], &_minY[0], &_minZ[0], &_maxX[0], &_maxY[0], &_maxZ[0], 1u, eye, frustumPlanes, lodThreshold, test);
+    if (!test._visible[0])
+    {
+        return;
+    }
+
+    // Depth-first with an explicit stack. Each expansion pushes at most 4 nodes and pops 1, so 3 per level plus one is enough
+    struct StackEntry
+    {
+        U32 _node;
+        U8  _level;
+        bool _coarseEnough;
+    };
+    std::array<StackEntry, 3u * MAX_DEPTH + 1u> stack;
+    U32 stackSize = 0u;
+    stack[stackSize++] = { 0u, 0u, test._coarseEnough[0] };
+
+    while (stackSize > 0u)
+    {
+        const StackEntry entry = stack[--stackSize];
+        if (entry._level == _leafLevel || entry._coarseEnough)
+        {
+            selectionOut.push_back({ entry._node, to_U8(_leafLevel - entry._level) });
+            continue;
+        }
+
+        const U8 childLevel = entry._level + 1u;
+        const U32 firstChild = LevelOffset(childLevel) + (entry._node - LevelOffset(entry._level)) * 4u;
+        TestNodes(&_minX[firstChild], &_minY[firstChild], &_minZ[firstChild],
+                  &_maxX[firstChild], &_maxY[firstChild], &_maxZ[firstChild],
+                  4u, eye, frustumPlanes, lodThreshold, test);
+
+        // Push in reverse so that children pop (and get selected) in Morton order
+        for (I32 c = 3; c >= 0; --c)
+        {
+            if (test._visible[c])
+            {
+                stack[stackSize++] = { firstChild + to_U32(c), childLevel, test._coarseEnough[c] };
+            }
+        }
+    }
 }
 
 } //namespace Divide
@@ -6,7 +6,6 @@
 #include "Headers/TileRing.h"
 
 #include "Core/Headers/Kernel.h"
-#include "Core/Headers/ByteBuffer.h"
 #include "Core/Headers/Configuration.h"
 #include "Core/Headers/PlatformContext.h"
 #include "Platform/File/Headers/FileManagement.h"
@@ -14,6 +13,7 @@
 #include "Geometry/Shapes/Predefined/Headers/Quad3D.h"
 #include "Graphs/Headers/SceneGraphNode.h"
 #include "Managers/Headers/ProjectManager.h"
+#include "Rendering/Camera/Headers/Camera.h"
 
 #include "Environment/Vegetation/Headers/Vegetation.h"
 
@@ -29,7 +29,8 @@ namespace Divide {
 
 namespace
 {
-    constexpr U16 BYTE_BUFFER_VERSION = 1u;
+    /// Tiles of physics data kept resident around the main camera, per direction
+    constexpr U32 g_residentTileRadius = 3u;
 
     ResourcePath ClimatesLocation( U8 textureQuality )
     {
@@ -591,6 +592,7 @@ bool Terrain::load( PlatformContext& context )
 bool Terrain::unload()
 {
     DestroyResource(_vegetation);
+    _tileCache.clear();
     return Object3D::unload();
 }
 
@@ -611,22 +613,23 @@ bool Terrain::loadResources( PlatformContext& context )
     const float3& bMin = terrainBB._min;
     const float3& bMax = terrainBB._max;
 
-    ByteBuffer terrainCache;
-    if ( terrainCache.loadFromFile( Paths::g_terrainCacheLocation, (terrainRawFile.string() + ".cache") ) )
+    const U32 terrainWidth  = terrainDimensions.x;
+    const U32 terrainHeight = terrainDimensions.y;
+    const bool flipHeight = !ImageTools::UseUpperLeftOrigin();
+
+    size_t inputHash = 0u;
     {
-        auto tempVer = decltype(BYTE_BUFFER_VERSION){0};
-        terrainCache >> tempVer;
-        if ( tempVer == BYTE_BUFFER_VERSION )
-        {
-            terrainCache >> _physicsVerts;
-        }
-        else
+        U64 heightfieldWriteTime = 0u;
+        if ( fileLastWriteTime( terrainMapLocation, terrainRawFile.string(), heightfieldWriteTime ) != FileError::NONE )
         {
-            terrainCache.clear();
+            NOP();
         }
+        Util::Hash_combine( inputHash, _ID( terrainRawFile.string().c_str() ), heightfieldWriteTime, minAltitude, maxAltitude, flipHeight );
     }
 
-    if ( _physicsVerts.empty() )
+    _cacheFileName = terrainRawFile.string();
+    const string tileCacheName = _cacheFileName + ".tiles";
+    if ( !_tileCache.load( Paths::g_terrainCacheLocation, tileCacheName, terrainWidth, terrainHeight, inputHash ) )
     {
         size_t dataSize = to_size( terrainDimensions.width ) * terrainDimensions.height * (sizeof( U16 ) / sizeof( char ));
         vector<Byte> data( dataSize, Byte_ZERO );
@@ -637,10 +640,7 @@ bool Terrain::loadResources( PlatformContext& context )
 
         constexpr F32 ushortMax = 1.f + U16_MAX;
 
-        const U32 terrainWidth  = terrainDimensions.x;
-        const U32 terrainHeight = terrainDimensions.y;
-
-        _physicsVerts.resize( to_size( terrainWidth ) * terrainHeight );
+        _tileCache.create( terrainWidth, terrainHeight, inputHash );
 
         // scale and translate all heights by half to convert from 0-255 (0-65335) to -127 - 128 (-32767 - 32768)
         const F32 altitudeRange = maxAltitude - minAltitude;
@@ -648,8 +648,6 @@ bool Terrain::loadResources( PlatformContext& context )
         const F32 bXRange = bMax.x - bMin.x;
         const F32 bZRange = bMax.z - bMin.z;
 
-        const bool flipHeight = !ImageTools::UseUpperLeftOrigin();
-
         ParallelForDescriptor descriptor = {};
         descriptor._iterCount = terrainHeight;
         descriptor._partitionSize = std::min(terrainHeight, 64u);
@@ -659,8 +657,7 @@ bool Terrain::loadResources( PlatformContext& context )
             {
                 for ( U32 width = 0; width < terrainWidth; ++width )
                 {
-                    const U32 idxTER = TER_COORD( width, height, terrainWidth );
-                    float3& vertexData = _physicsVerts[idxTER]._position;
+                    float3& vertexData = _tileCache.vertex( width, height )._position;
 
 
                     F32 yOffset = 0.0f;
@@ -693,10 +690,10 @@ bool Terrain::loadResources( PlatformContext& context )
                 {
                     float3 vU, vV, vUV;
 
-                    vU.set( _physicsVerts[TER_COORD( i + offset, j + 0, terrainWidth )]._position -
-                            _physicsVerts[TER_COORD( i - offset, j + 0, terrainWidth )]._position );
-                    vV.set( _physicsVerts[TER_COORD( i + 0, j + offset, terrainWidth )]._position -
-                            _physicsVerts[TER_COORD( i + 0, j - offset, terrainWidth )]._position );
+                    vU.set( _tileCache.vertex( i + offset, j + 0 )._position -
+                            _tileCache.vertex( i - offset, j + 0 )._position );
+                    vV.set( _tileCache.vertex( i + 0, j + offset )._position -
+                            _tileCache.vertex( i + 0, j - offset )._position );
 
                     vUV.cross( vV, vU );
                     vUV.normalize();
@@ -704,8 +701,7 @@ bool Terrain::loadResources( PlatformContext& context )
                     vU.normalize();
 
                     {
-                        const I32 idx = TER_COORD( i, j, terrainWidth );
-                        VertexBuffer::Vertex& vert = _physicsVerts[idx];
+                        TerrainTileCache::Vertex& vert = _tileCache.vertex( i, j );
                         vert._normal = Util::PACK_VEC3( vUV );
                         vert._tangent = Util::PACK_VEC3( vU );
                     }
@@ -713,21 +709,20 @@ bool Terrain::loadResources( PlatformContext& context )
             }
         });
 
+        const auto copyNormal = [&]( const U32 xDst, const U32 yDst, const U32 xSrc, const U32 ySrc )
+        {
+            const TerrainTileCache::Vertex& src = _tileCache.vertex( xSrc, ySrc );
+            TerrainTileCache::Vertex& dst = _tileCache.vertex( xDst, yDst );
+            dst._normal  = src._normal;
+            dst._tangent = src._tangent;
+        };
+
         for ( U32 j = 0u; j < offset; ++j )
         {
             for ( U32 i = 0u; i < terrainWidth; ++i )
             {
-                U32 idx0 = TER_COORD( i, j, terrainWidth );
-                U32 idx1 = TER_COORD( i, offset, terrainWidth );
-
-                _physicsVerts[idx0]._normal  = _physicsVerts[idx1]._normal;
-                _physicsVerts[idx0]._tangent = _physicsVerts[idx1]._tangent;
-
-                idx0 = TER_COORD( i, terrainHeight - 1 - j, terrainWidth );
-                idx1 = TER_COORD( i, terrainHeight - 1 - offset, terrainWidth );
-
-                _physicsVerts[idx0]._normal  = _physicsVerts[idx1]._normal;
-                _physicsVerts[idx0]._tangent = _physicsVerts[idx1]._tangent;
+                copyNormal( i, j, i, offset );
+                copyNormal( i, terrainHeight - 1 - j, i, terrainHeight - 1 - offset );
             }
         }
 
@@ -735,23 +730,15 @@ bool Terrain::loadResources( PlatformContext& context )
         {
             for ( U32 j = 0u; j < terrainHeight; ++j )
             {
-                U32 idx0 = TER_COORD( i, j, terrainWidth );
-                U32 idx1 = TER_COORD( offset, j, terrainWidth );
-
-                _physicsVerts[idx0]._normal  = _physicsVerts[idx1]._normal;
-                _physicsVerts[idx0]._tangent = _physicsVerts[idx1]._tangent;
-
-                idx0 = TER_COORD( terrainWidth - 1 - i, j, terrainWidth );
-                idx1 = TER_COORD( terrainWidth - 1 - offset, j, terrainWidth );
-
-                _physicsVerts[idx0]._normal  = _physicsVerts[idx1]._normal;
-                _physicsVerts[idx0]._tangent = _physicsVerts[idx1]._tangent;
+                copyNormal( i, j, offset, j );
+                copyNormal( terrainWidth - 1 - i, j, terrainWidth - 1 - offset, j );
             }
         }
 
-        terrainCache << BYTE_BUFFER_VERSION;
-        terrainCache << _physicsVerts;
-        DIVIDE_EXPECTED_CALL( terrainCache.dumpToFile( Paths::g_terrainCacheLocation, terrainRawFile.string() + ".cache" ) );
+        if ( !_tileCache.save( Paths::g_terrainCacheLocation, tileCacheName ) )
+        {
+            Console::errorfn( LOCALE_STR( "ERROR_TERRAIN_TILE_CACHE_SAVE" ), tileCacheName );
+        }
     }
 
     // Then compute quadtree and all additional terrain-related structures
@@ -835,6 +822,10 @@ void Terrain::createVegetation( PlatformContext& context )
 
     vegDetails.name = resourceName() + "_vegetation";
 
+    // Vegetation layouts are a pure function of this seed (and the chunk layout) so they can be cached and reproduced
+    const string vegetationSeed = GetVariable( _descriptor, "vegetationSeed" );
+    vegDetails.seed = to_U32( _ID( vegetationSeed.empty() ? resourceName().c_str() : vegetationSeed.c_str() ) );
+
     const ResourcePath terrainLocation{ Paths::g_heightmapLocation / GetVariable( _descriptor, "descriptor" ) };
 
     vegDetails.grassMap.reset( new ImageTools::ImageData );
@@ -1080,6 +1071,43 @@ void Terrain::toggleBoundingBoxes()
     rebuildDrawCommands(true);
 }
 
+void Terrain::sceneUpdate(const U64 deltaTimeUS, SceneGraphNode* sgn, SceneState& sceneState)
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    // Keep the tiles around every local player's camera resident. Done here, once per frame, so the render passes only ever read the cache
+    const Scene& scene = sceneState.parentScene();
+    const vec2<U16>& dim = _descriptor._dimensions;
+
+    uint2 minVertex{ U32_MAX, U32_MAX };
+    uint2 maxVertex{ 0u, 0u };
+    for (U8 i = 0u; i < scene.playerCount(); ++i)
+    {
+        const Camera* camera = scene.playerCamera(i);
+        if (camera == nullptr)
+        {
+            continue;
+        }
+
+        const float2 eyeLocal = camera->snapshot()._eye.xz() - _boundingBox.getCenter().xz();
+        const uint2 eyeVertex
+        {
+            to_U32(CLAMPED(0.5f * dim.width  + eyeLocal.x, 0.f, to_F32(dim.width))),
+            to_U32(CLAMPED(0.5f * dim.height + eyeLocal.y, 0.f, to_F32(dim.height)))
+        };
+
+        minVertex.set(std::min(minVertex.x, eyeVertex.x), std::min(minVertex.y, eyeVertex.y));
+        maxVertex.set(std::max(maxVertex.x, eyeVertex.x), std::max(maxVertex.y, eyeVertex.y));
+    }
+
+    if (minVertex.x <= maxVertex.x)
+    {
+        _tileCache.setActiveRegion(minVertex, maxVertex, g_residentTileRadius);
+    }
+
+    SceneNode::sceneUpdate(deltaTimeUS, sgn, sceneState);
+}
+
 void Terrain::prepareRender(SceneGraphNode* sgn,
                             RenderingComponent& rComp,
                             RenderPackage& pkg,
@@ -1157,11 +1185,6 @@ void Terrain::buildDrawCommands(SceneGraphNode* sgn, GenericDrawCommandContainer
     Object3D::buildDrawCommands(sgn, cmdsOut);
 }
 
-const vector<VertexBuffer::Vertex>& Terrain::getVerts() const noexcept
-{
-    return _physicsVerts;
-}
-
 Terrain::Vert Terrain::getVertFromGlobal(F32 x, F32 z, const bool smooth) const
 {
     x -= _boundingBox.getCenter().x;
@@ -1202,10 +1225,10 @@ Terrain::Vert Terrain::getSmoothVert(const F32 x_clampf, const F32 z_clampf) con
     assert(posI.width  >= 0 && posI.width  < to_I32(dim.width)  - 1 &&
            posI.height >= 0 && posI.height < to_I32(dim.height) - 1);
 
-    const VertexBuffer::Vertex& tempVert1 = _physicsVerts[TER_COORD(posI.width,     posI.height,     to_I32(dim.width))];
-    const VertexBuffer::Vertex& tempVert2 = _physicsVerts[TER_COORD(posI.width + 1, posI.height,     to_I32(dim.width))];
-    const VertexBuffer::Vertex& tempVert3 = _physicsVerts[TER_COORD(posI.width,     posI.height + 1, to_I32(dim.width))];
-    const VertexBuffer::Vertex& tempVert4 = _physicsVerts[TER_COORD(posI.width + 1, posI.height + 1, to_I32(dim.width))];
+    const TerrainTileCache::Vertex& tempVert1 = _tileCache.vertex(posI.width,     posI.height);
+    const TerrainTileCache::Vertex& tempVert2 = _tileCache.vertex(posI.width + 1, posI.height);
+    const TerrainTileCache::Vertex& tempVert3 = _tileCache.vertex(posI.width,     posI.height + 1);
+    const TerrainTileCache::Vertex& tempVert4 = _tileCache.vertex(posI.width + 1, posI.height + 1);
 
     const float3 normals[4]{
         Util::UNPACK_VEC3(tempVert1._normal),
@@ -1272,7 +1295,7 @@ Terrain::Vert Terrain::getVert(const F32 x_clampf, const F32 z_clampf) const
     assert(posI.width  >= 0 && posI.width  < to_I32(dim.width)  - 1 &&
            posI.height >= 0 && posI.height < to_I32(dim.height) - 1);
 
-    const VertexBuffer::Vertex& tempVert1 = _physicsVerts[TER_COORD(posI.width, posI.height, to_I32(dim.width))];
+    const TerrainTileCache::Vertex& tempVert1 = _tileCache.vertex(posI.width, posI.height);
 
     Vert ret = {};
     ret._position.set(tempVert1._position);
@@ -2,9 +2,10 @@
 
 #include "Headers/TerrainChunk.h"
 #include "Headers/Terrain.h"
-#include "Quadtree/Headers/QuadtreeNode.h"
+#include "Quadtree/Headers/Quadtree.h"
 
 #include "Managers/Headers/ProjectManager.h"
+#include "Platform/Video/Headers/GFXDevice.h"
 #include "Geometry/Material/Headers/Material.h"
 #include "Environment/Vegetation/Headers/Vegetation.h"
 
@@ -13,9 +14,11 @@ namespace Divide {
 U32 TerrainChunk::_chunkID = 0;
 
 TerrainChunk::TerrainChunk(Terrain* const parentTerrain,
-                           QuadtreeNode& parentNode) noexcept
+                           const Quadtree& quadtree,
+                           const U32 leafIndex) noexcept
     : _id(_chunkID++)
-    , _quadtreeNode(parentNode)
+    , _leafIndex(leafIndex)
+    , _quadtree(quadtree)
     , _parentTerrain(parentTerrain)
 {
 }
@@ -36,14 +39,13 @@ void TerrainChunk::load(const U8 depth, const uint2 pos, const U32 targetChunkDi
     const U32 nHMWidth = heightmapDataSize.x;
     const U32 nHMHeight = heightmapDataSize.y;
 
-    const vector<VertexBuffer::Vertex>& verts = _parentTerrain->_physicsVerts;
+    const TerrainTileCache& tileCache = _parentTerrain->tileCache();
 
     for (U16 j = 0; j < nHMHeight - 1; ++j) {
         const U32 jOffset = j * offset+pos.y;
         for (U16 i = 0; i < nHMWidth; ++i) {
             const U32 iOffset = i * offset+pos.x;
-            U32 idx = iOffset + jOffset * HMSize.x;
-            F32 height = verts[idx]._position.y;
+            F32 height = tileCache.vertex(iOffset, jOffset)._position.y;
 
             if (height > tempMax) {
                 tempMax = height;
@@ -53,8 +55,7 @@ void TerrainChunk::load(const U8 depth, const uint2 pos, const U32 targetChunkDi
             }
 
 
-            idx = iOffset + (jOffset + offset) * HMSize.x;
-            height = verts[idx]._position.y;
+            height = tileCache.vertex(iOffset, jOffset + offset)._position.y;
 
             if (height > tempMax) {
                 tempMax = height;
@@ -71,19 +72,20 @@ void TerrainChunk::load(const U8 depth, const uint2 pos, const U32 targetChunkDi
     Attorney::TerrainChunk::registerTerrainChunk(*_parentTerrain, this);
 }
 
-const BoundingBox& TerrainChunk::bounds() const noexcept
+BoundingBox TerrainChunk::bounds() const noexcept
 {
-    return _quadtreeNode.getBoundingBox();
-}
-
-U8 TerrainChunk::LoD() const noexcept
-{
-    return _quadtreeNode.LoD();
+    return _quadtree.nodeBounds(Quadtree::LevelOffset(_quadtree.getLeafLevel()) + _leafIndex);
 }
 
 void TerrainChunk::drawBBox(GFXDevice& context) const
 {
-    _quadtreeNode.drawBBox(context);
+    const BoundingBox bb = bounds();
+
+    IM::BoxDescriptor descriptor;
+    descriptor.min = bb._min;
+    descriptor.max = bb._max;
+    descriptor.colour = UColour4(0, 128, 255, 255);
+    context.debugDrawBox(_id, descriptor);
 }
 
 void TerrainChunk::initVegetation( PlatformContext& context, const Handle<Vegetation> handle )
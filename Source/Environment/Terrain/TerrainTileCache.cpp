@@ -0,0 +1,171 @@
+
+
+#include "Headers/TerrainTileCache.h"
+
+#include "Platform/File/Headers/FileManagement.h"
+
+namespace Divide {
+
+namespace
+{
+    constexpr U32 g_tileCacheMagic = 0x43525444u; //"DTRC"
+
+    static_assert(sizeof(TerrainTileCache::Vertex) == 5 * sizeof(F32));
+    static_assert((TerrainTileCache::TILE_SIZE * TerrainTileCache::TILE_SIZE * sizeof(TerrainTileCache::Vertex)) % TerrainTileCache::PAGE_ALIGNMENT == 0u,
+                  "Tile size should be picked so that tiles do not need padding between them");
+
+    [[nodiscard]] bool Overlaps(const int4& rect, const I32 x, const I32 y) noexcept
+    {
+        return x >= rect.x && x <= rect.z && y >= rect.y && y <= rect.w;
+    }
+}
+
+void TerrainTileCache::setLayout(const U32 width, const U32 height) noexcept
+{
+    _width = width;
+    _height = height;
+    _tileCountX = (width + TILE_SIZE - 1u) / TILE_SIZE;
+    _tileCountY = (height + TILE_SIZE - 1u) / TILE_SIZE;
+    _tileStride = Util::GetAlignmentCorrected(to_size(TILE_SIZE) * TILE_SIZE * sizeof(Vertex), PAGE_ALIGNMENT);
+    _activeTiles.set(0, 0, -1, -1);
+}
+
+void TerrainTileCache::create(const U32 width, const U32 height, const size_t inputHash)
+{
+    clear();
+    setLayout(width, height);
+
+    _image.resize(tileOffset(0u, _tileCountY), Byte_ZERO);
+
+    Header header{};
+    header._magic = g_tileCacheMagic;
+    header._version = FILE_VERSION;
+    header._tileSize = to_U16(TILE_SIZE);
+    header._width = width;
+    header._height = height;
+    header._tileStride = _tileStride;
+    header._inputHash = inputHash;
+    _inputHash = inputHash;
+    std::memcpy(_image.data(), &header, sizeof(Header));
+
+    _data = _image.data();
+}
+
+bool TerrainTileCache::save(const ResourcePath& filePath, const std::string_view fileName)
+{
+    DIVIDE_ASSERT(!_image.empty());
+
+    if (writeFileAtomic(filePath, fileName, reinterpret_cast<const char*>(_image.data()), _image.size(), FileType::BINARY) != FileError::NONE)
+    {
+        // Keep serving queries from the in-memory image
+        return false;
+    }
+
+    MemoryMappedFile file;
+    if (file.open(filePath, fileName) != FileError::NONE || file.size() != _image.size())
+    {
+        return false;
+    }
+
+    _file = MOV(file);
+    _data = _file.data();
+    vector<Byte>().swap(_image);
+    return true;
+}
+
+bool TerrainTileCache::load(const ResourcePath& filePath, const std::string_view fileName, const U32 width, const U32 height, const size_t inputHash)
+{
+    clear();
+
+    MemoryMappedFile file;
+    if (file.open(filePath, fileName) != FileError::NONE || file.size() < sizeof(Header))
+    {
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (header._magic != g_tileCacheMagic ||
+        header._version != FILE_VERSION ||
+        header._tileSize != TILE_SIZE ||
+        header._width != width ||
+        header._height != height ||
+        header._inputHash != inputHash)
+    {
+        return false;
+    }
+
+    setLayout(width, height);
+    if (header._tileStride != _tileStride || file.size() != tileOffset(0u, _tileCountY))
+    {
+        setLayout(0u, 0u);
+        return false;
+    }
+
+    _file = MOV(file);
+    _data = _file.data();
+    _inputHash = inputHash;
+    return true;
+}
+
+void TerrainTileCache::clear() noexcept
+{
+    _file.close();
+    vector<Byte>().swap(_image);
+    _data = nullptr;
+    _inputHash = 0u;
+    setLayout(0u, 0u);
+}
+
+void TerrainTileCache::setActiveRegion(const uint2& minVertex, const uint2& maxVertex, const U32 tileRadius) noexcept
+{
+    if (!isMapped())
+    {
+        return;
+    }
+
+    const I32 radius = to_I32(tileRadius);
+
+    const int4 region
+    {
+        std::max(to_I32(std::min(minVertex.x, _width - 1u) / TILE_SIZE) - radius, 0),
+        std::max(to_I32(std::min(minVertex.y, _height - 1u) / TILE_SIZE) - radius, 0),
+        std::min(to_I32(std::min(maxVertex.x, _width - 1u) / TILE_SIZE) + radius, to_I32(_tileCountX) - 1),
+        std::min(to_I32(std::min(maxVertex.y, _height - 1u) / TILE_SIZE) + radius, to_I32(_tileCountY) - 1)
+    };
+
+    if (region == _activeTiles)
+    {
+        return;
+    }
+
+    // Everything got faulted in while the terrain was being built, so on the first call treat the whole grid as previously active
+    const int4 previous = _activeTiles.z < 0 ? int4{ 0, 0, to_I32(_tileCountX) - 1, to_I32(_tileCountY) - 1 } : _activeTiles;
+
+    for (I32 tileY = std::min(previous.y, region.y); tileY <= std::max(previous.w, region.w); ++tileY)
+    {
+        for (I32 tileX = std::min(previous.x, region.x); tileX <= std::max(previous.z, region.z); ++tileX)
+        {
+            const bool wasActive = Overlaps(previous, tileX, tileY);
+            const bool isActive = Overlaps(region, tileX, tileY);
+            if (wasActive == isActive)
+            {
+                continue;
+            }
+
+            const size_t offset = tileOffset(to_U32(tileX), to_U32(tileY));
+            if (isActive)
+            {
+                _file.prefetch(offset, _tileStride);
+            }
+            else
+            {
+                _file.evict(offset, _tileStride);
+            }
+        }
+    }
+
+    _activeTiles = region;
+}
+
+}; //namespace Divide
@@ -85,6 +85,27 @@ struct VegetationData
 };
 //RenderDoc: mat4 transform; vec4 posAndIndex; vec4 extentAndRender;
 
+/// Placement points bucketed per grid cell (counting sort) so that a chunk only reads the contiguous ranges of the cells it overlaps.
+/// Points are stored in chunk space ([-extent, extent] on both axes) and cells line up with the terrain chunk layout.
+struct VegetationPlacementGrid
+{
+    /// Points sorted by cell (row major)
+    vector<float2> _points;
+    /// index = cell; entry = offset of the cell's first point in _points. Has (cell count + 1) entries
+    vector<U32> _cellOffsets;
+    F32 _extent = 0.f;
+    U32 _cellsPerSide = 0u;
+
+    void build(const eastl::unordered_set<float2>& points, F32 extent, U32 cellsPerSide);
+
+    /// Calls cbk(point, pointIndex) for every point that may be inside [-halfSize, halfSize]
+    template<typename Cbk>
+    void forEachPoint(float2 halfSize, Cbk&& cbk) const;
+
+    [[nodiscard]] U32 cellIndex(F32 coord) const noexcept;
+    [[nodiscard]] size_t size() const noexcept { return _points.size(); }
+};
+
 class VegetationInstance;
 
 /// Generates grass on the terrain.
@@ -142,6 +163,7 @@ DEFINE_NODE_TYPE(Vegetation, SceneNodeType::TYPE_VEGETATION)
     F32 _treeDistance = -1.0f;
     U32 _maxGrassInstances = 0u;
     U32 _maxTreeInstances = 0u;
+    size_t _descriptorHash = 0u;
 
     Pipeline* _cullPipelineGrass = nullptr;
     Pipeline* _cullPipelineTrees = nullptr;
@@ -153,8 +175,8 @@ DEFINE_NODE_TYPE(Vegetation, SceneNodeType::TYPE_VEGETATION)
     ShaderBuffer_uptr _grassData;
     vector<Handle<Mesh>> _treeMeshes;
 
-    eastl::unordered_set<float2> _grassPositions;
-    eastl::unordered_set<float2> _treePositions;
+    VegetationPlacementGrid _grassPositions;
+    VegetationPlacementGrid _treePositions;
 
     Handle<ShaderProgram> _cullShaderGrass = INVALID_HANDLE<ShaderProgram>;
     Handle<ShaderProgram> _cullShaderTrees = INVALID_HANDLE<ShaderProgram>;
@@ -188,6 +210,29 @@ private:
 
 FWD_DECLARE_MANAGED_CLASS( VegetationInstance );
 
+template<typename Cbk>
+void VegetationPlacementGrid::forEachPoint(const float2 halfSize, Cbk&& cbk) const
+{
+    if (_points.empty())
+    {
+        return;
+    }
+
+    const U32 minX = cellIndex(-halfSize.x), maxX = cellIndex(halfSize.x);
+    const U32 minY = cellIndex(-halfSize.y), maxY = cellIndex(halfSize.y);
+
+    for (U32 y = minY; y <= maxY; ++y)
+    {
+        // Cells of the same row are adjacent so every row is a single contiguous range
+        const U32 rowStart = _cellOffsets[y * _cellsPerSide + minX];
+        const U32 rowEnd   = _cellOffsets[y * _cellsPerSide + maxX + 1u];
+        for (U32 i = rowStart; i < rowEnd; ++i)
+        {
+            cbk(_points[i], i);
+        }
+    }
+}
+
 }  // namespace Divide
 
 #endif //DVD_VEGETATION_H_
@@ -53,6 +53,8 @@ struct PropertyDescriptor<Vegetation>
     float4 treeScales = VECTOR4_UNIT;
     Terrain* parentTerrain = nullptr;
     U32 chunkSize = 0u;
+    /// World seed used for instance placement
+    U32 seed = 0u;
 };
 
 using VegetationDescriptor = PropertyDescriptor<Vegetation>;
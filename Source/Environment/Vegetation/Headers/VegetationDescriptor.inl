@@ -62,6 +62,7 @@ inline size_t GetHash( const VegetationDescriptor& descriptor ) noexcept
     Util::Hash_combine( hash,
                         descriptor.name,
                         descriptor.chunkSize,
+                        descriptor.seed,
                         descriptor.billboardTextureArray,
                         descriptor.treeScales.x,
                         descriptor.treeScales.y,
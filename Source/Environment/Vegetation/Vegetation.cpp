@@ -33,7 +33,7 @@ namespace Divide
 
     namespace
     {
-        constexpr U16 BYTE_BUFFER_VERSION = 1u;
+        constexpr U16 BYTE_BUFFER_VERSION = 2u;
 
         constexpr U32 WORK_GROUP_SIZE = 64;
         constexpr I16 g_maxRadiusSteps = 512;
@@ -46,6 +46,124 @@ namespace Divide
         constexpr F32 g_distanceRingsBaseTrees = 2.5f;
         constexpr F32 g_slopeLimitGrass = 30.0f;
         constexpr F32 g_slopeLimitTrees = 10.0f;
+        // Placement points are bucketed in a grid of g_placementGridCellsPerSide x g_placementGridCellsPerSide cells per chunk
+        constexpr U32 g_placementGridCellsPerSide = 16u;
+
+        // Texture array layer probabilities (out of 10) based on the dominant channel of the density map
+        constexpr U8 g_layerWeights[4][4] =
+        {
+            {5, 2, 2, 1},
+            {1, 5, 2, 2},
+            {2, 1, 5, 2},
+            {2, 2, 1, 5}
+        };
+
+        enum class RandomStream : U8
+        {
+            ARRAY_LAYER = 0,
+            ROTATION,
+            COUNT
+        };
+
+        /// Counter based generator: every value is a pure function of (key, counter, stream) so chunks can be generated
+        /// in any order, on any thread, and still produce the exact same layout on every run.
+        /// ref: "Hash Functions for GPU Rendering", Jarzynski & Olano (PCG output permutation)
+        struct VegetationRandom
+        {
+            [[nodiscard]] static U32 Permute( const U32 value ) noexcept
+            {
+                const U32 state = value * 747796405u + 2891336453u;
+                const U32 word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+                return (word >> 22u) ^ word;
+            }
+
+            [[nodiscard]] U32 next( const U32 counter, const RandomStream stream ) const noexcept
+            {
+                return Permute( _key ^ Permute( counter * to_base( RandomStream::COUNT ) + to_base( stream ) ) );
+            }
+
+            /// [0, 1)
+            [[nodiscard]] F32 nextFloat( const U32 counter, const RandomStream stream ) const noexcept
+            {
+                return to_F32( next( counter, stream ) >> 8u ) * (1.f / 16777216.f);
+            }
+
+            U32 _key = 0u;
+        };
+
+        /// Every chunk gets its own random stream, keyed by its position so that it doesn't depend on chunk creation order
+        [[nodiscard]] VegetationRandom ChunkRandom( const U32 seed, const float2 chunkPos, const bool treeData ) noexcept
+        {
+            return VegetationRandom
+            {
+                ._key = VegetationRandom::Permute( seed ^
+                        VegetationRandom::Permute( to_U32( to_I32( chunkPos.x ) ) ^
+                        VegetationRandom::Permute( to_U32( to_I32( chunkPos.y ) ) ^ (treeData ? 1u : 0u) ) ) )
+            };
+        }
+
+        /// The tree mesh used by a chunk. Shared by the node that renders the mesh and by the instance transforms generated for it
+        [[nodiscard]] U32 TreeMeshID( const U32 seed, const float2 chunkPos, const size_t meshCount ) noexcept
+        {
+            return meshCount == 0u ? 0u : VegetationRandom::Permute( ChunkRandom( seed, chunkPos, true )._key ) % to_U32( meshCount );
+        }
+
+        [[nodiscard]] U8 PickArrayLayer( const U8 channel, const F32 random ) noexcept
+        {
+            const F32 target = random * 10.f;
+
+            F32 accumulated = 0.f;
+            for ( U8 i = 0u; i < 4u; ++i )
+            {
+                accumulated += g_layerWeights[channel][i];
+                if ( target < accumulated )
+                {
+                    return i;
+                }
+            }
+
+            return 3u;
+        }
+    }
+
+    U32 VegetationPlacementGrid::cellIndex( const F32 coord ) const noexcept
+    {
+        const F32 cellSize = (2.f * _extent) / _cellsPerSide;
+        return to_U32( CLAMPED( to_I32( (coord + _extent) / cellSize ), 0, to_I32( _cellsPerSide ) - 1 ) );
+    }
+
+    void VegetationPlacementGrid::build( const eastl::unordered_set<float2>& points, const F32 extent, const U32 cellsPerSide )
+    {
+        _extent = extent;
+        _cellsPerSide = cellsPerSide;
+
+        const U32 cellCount = SQUARED( cellsPerSide );
+
+        // Counting sort: count the points in every cell, prefix sum the counts into offsets, then scatter the points
+        vector<U32> pointCells;
+        pointCells.reserve( points.size() );
+
+        _cellOffsets.assign( cellCount + 1u, 0u );
+        for ( const float2 point : points )
+        {
+            const U32 cell = cellIndex( point.y ) * cellsPerSide + cellIndex( point.x );
+            pointCells.push_back( cell );
+            ++_cellOffsets[cell + 1u];
+        }
+
+        for ( U32 i = 0u; i < cellCount; ++i )
+        {
+            _cellOffsets[i + 1u] += _cellOffsets[i];
+        }
+
+        vector<U32> writeOffsets( _cellOffsets.begin(), _cellOffsets.end() - 1 );
+        _points.resize( points.size() );
+
+        size_t idx = 0u;
+        for ( const float2 point : points )
+        {
+            _points[writeOffsets[pointCells[idx++]]++] = point;
+        }
     }
 
     Vegetation::Vegetation( const ResourceDescriptor<Vegetation>& descriptor )
@@ -250,8 +368,9 @@ namespace Divide
         }
 
         //ref: http://mollyrocket.com/casey/stream_0016.html
-        _grassPositions.reserve( to_size( SQUARED(_descriptor.chunkSize )));
-        _treePositions.reserve( to_size( SQUARED( _descriptor.chunkSize )));
+        eastl::unordered_set<float2> grassPositions, treePositions;
+        grassPositions.reserve( to_size( SQUARED(_descriptor.chunkSize )));
+        treePositions.reserve( to_size( SQUARED( _descriptor.chunkSize )));
 
         const F32 posOffset = to_F32( _descriptor.chunkSize * 2 );
 
@@ -269,7 +388,7 @@ namespace Divide
 
         for ( U8 i = 0; i < 2; ++i )
         {
-            auto& set = (i == 0 ? _grassPositions : _treePositions);
+            auto& set = (i == 0 ? grassPositions : treePositions);
 
             for ( I16 RadiusStepA = 0; RadiusStepA < g_maxRadiusSteps; ++RadiusStepA )
             {
@@ -296,6 +415,13 @@ namespace Divide
             }
         }
 
+        _grassPositions.build( grassPositions, to_F32( _descriptor.chunkSize ), g_placementGridCellsPerSide );
+        _treePositions.build( treePositions, to_F32( _descriptor.chunkSize ), g_placementGridCellsPerSide );
+
+        // Instance positions and orientations are sampled from the terrain, so its inputs are part of every chunk's cache key
+        _descriptorHash = GetHash( _descriptor );
+        Util::Hash_combine( _descriptorHash, GetHash( _descriptor.parentTerrain ) );
+
         _maxGrassInstances = to_U32(_grassPositions.size());
         _maxTreeInstances  = to_U32(_treePositions.size());
 
@@ -489,7 +615,7 @@ namespace Divide
         }
 
         const U32 ID = sgn->dataFlag();
-        const U32 meshID = to_U32( ID % _treeMeshNames.size() );
+        const U32 meshID = TreeMeshID( _descriptor.seed, instance->_chunk->getOffsetAndSize().xy, _treeMeshNames.size() );
 
         if ( instance->_instanceCountTrees > 0 && !_treeMeshNames.empty() )
         {
@@ -912,68 +1038,86 @@ namespace Divide
     {
         const U32 ID = _chunk->id();
 
-        const string cacheFileName = Util::StringFormat( "{}_{}_{}_{}.cache", _chunk->parent().resourceName().c_str(), Get(_parent)->resourceName().c_str(), treeData ? "trees" : "grass", ID );
+        vector<VegetationData> container;
+
+        ResourcePtr<Vegetation> parent = Get(_parent);
+        const VegetationDescriptor& descriptor = parent->_descriptor;
+
+        const float2 chunkSize = _chunk->getOffsetAndSize().zw;
+        const float2 chunkPos = _chunk->getOffsetAndSize().xy;
+        const auto& positions = treeData ? parent->_treePositions : parent->_grassPositions;
+        const U32 meshID = TreeMeshID( descriptor.seed, chunkPos, parent->_treeMeshNames.size() );
+
+        // Chunk IDs are assigned in creation order, so the file is named after the chunk's position instead
+        const string cacheFileName = Util::StringFormat( "{}_{}_{}_{}_{}.cache",
+                                                         _chunk->parent().resourceName().c_str(),
+                                                         parent->resourceName().c_str(),
+                                                         treeData ? "trees" : "grass",
+                                                         to_I32( chunkPos.x ),
+                                                         to_I32( chunkPos.y ) );
         Console::printfn( Locale::Get( treeData ? _ID( "CREATE_TREE_START" ) : _ID( "CREATE_GRASS_BEGIN" ) ), ID );
 
-        vector<VegetationData> container;
+        // Everything that ends up in the cached data has to be part of its key. That includes the chunk ID we store in each entry
+        size_t inputHash = parent->_descriptorHash;
+        Util::Hash_combine( inputHash, treeData, chunkPos.x, chunkPos.y, chunkSize.x, chunkSize.y, positions.size(), meshID, ID );
+
+        bool loadedFromCache = false;
 
         ByteBuffer chunkCache;
         if ( context().config().debug.cache.enabled && 
              context().config().debug.cache.vegetation &&
-             chunkCache.loadFromFile( Paths::g_terrainCacheLocation, cacheFileName ) )
+             chunkCache.mapFromFile( Paths::g_terrainCacheLocation, cacheFileName ) )
         {
             auto tempVer = decltype(BYTE_BUFFER_VERSION){0};
             chunkCache >> tempVer;
             if ( tempVer == BYTE_BUFFER_VERSION )
             {
-                size_t containerSize = 0u;
-                chunkCache.read<size_t>(containerSize);
-                container.resize( containerSize );
-                chunkCache.read( reinterpret_cast<Byte*>(container.data()), sizeof( VegetationData ) * container.size() );
+                size_t cachedInputHash = 0u;
+                U64 cachedContentHash = 0u;
+                chunkCache >> cachedInputHash;
+                chunkCache >> cachedContentHash;
+
+                if ( cachedInputHash == inputHash )
+                {
+                    size_t containerSize = 0u;
+                    chunkCache.read<size_t>(containerSize);
+                    container.resize( containerSize );
+                    chunkCache.read( reinterpret_cast<Byte*>(container.data()), sizeof( VegetationData ) * container.size() );
+
+                    loadedFromCache = _ID_VIEW( reinterpret_cast<const char*>(container.data()), sizeof( VegetationData ) * container.size() ) == cachedContentHash;
+                }
             }
-            else
+
+            if ( !loadedFromCache )
             {
+                container.clear();
                 chunkCache.clear();
             }
         }
-        else
-        {
-            ResourcePtr<Vegetation> parent = Get(_parent);
-            const VegetationDescriptor& descriptor = parent->_descriptor;
 
+        if ( !loadedFromCache )
+        {
             const size_t maxInstances = treeData ? parent->_maxTreeInstances : parent->_maxGrassInstances;
 
             container.reserve( maxInstances);
 
-            static std::discrete_distribution<> distribution[] = 
-            {
-                {5, 2, 2, 1},
-                {1, 5, 2, 2},
-                {2, 1, 5, 2},
-                {2, 2, 1, 5}
-            };
-
-            std::default_random_engine generator( to_U32( std::chrono::system_clock::now().time_since_epoch().count() ) );
+            const VegetationRandom random = ChunkRandom( descriptor.seed, chunkPos, treeData );
 
-            const U32 meshID = to_U32( ID % parent->_treeMeshNames.size() );
-
-            const float2 chunkSize = _chunk->getOffsetAndSize().zw;
-            const float2 chunkPos = _chunk->getOffsetAndSize().xy;
             //const F32 waterLevel = 0.0f;// ToDo: make this dynamic! (cull underwater points later on?)
             const auto& map = treeData ? descriptor.treeMap : descriptor.grassMap;
             const U16 mapWidth = map->dimensions( 0u, 0u ).width;
             const U16 mapHeight = map->dimensions( 0u, 0u ).height;
-            const auto& positions = treeData ? parent->_treePositions : parent->_grassPositions;
             const auto& scales = treeData ? descriptor.treeScales : descriptor.grassScales;
             const F32 slopeLimit = treeData ? g_slopeLimitTrees : g_slopeLimitGrass;
 
             const Terrain& terrain = _chunk->parent();
 
-            for ( float2 pos : positions )
+            positions.forEachPoint( chunkSize, [&]( const float2 point, const U32 pointIndex )
             {
+                float2 pos = point;
                 if ( !ScaleAndCheckBounds( chunkPos, chunkSize, pos ) )
                 {
-                    continue;
+                    return;
                 }
 
                 const float2 mapCoord( pos.x + mapWidth * 0.5f, pos.y + mapHeight * 0.5f );
@@ -992,7 +1136,7 @@ namespace Divide
                 const Angle::DEGREES_F angle = Angle::to_DEGREES( Angle::RADIANS_F(std::acos( dot / length ) ));
                 if ( angle > slopeLimit )
                 {
-                    continue;
+                    return;
                 }
                 const F32 slopeScaleFactor = 1.f - MAP( angle.value, 0.f, slopeLimit, 0.f, 0.9f);
 
@@ -1003,10 +1147,10 @@ namespace Divide
                 const F32 colourVal = colour[index];
                 if ( colourVal <= EPSILON_F32 )
                 {
-                    continue;
+                    return;
                 }
 
-                const U8 arrayLayer = to_U8( distribution[index]( generator ) );
+                const U8 arrayLayer = PickArrayLayer( index, random.nextFloat( pointIndex, RandomStream::ARRAY_LAYER ) );
 
                 const F32 xmlScale = scales[treeData ? meshID : index];
                 // Don't go under 75% of the scale specified in the data files
@@ -1031,7 +1175,7 @@ namespace Divide
                     modelRotation = RotationFromVToU( WORLD_Y_AXIS, vert._normal, WORLD_Z_NEG_AXIS );
                 }
 
-                entry._orientationQuat = (quatf( vert._normal, Angle::to_RADIANS(Angle::DEGREES_F(Random( 360.0f )))) * modelRotation)._elements;
+                entry._orientationQuat = (quatf( vert._normal, Angle::to_RADIANS(Angle::DEGREES_F(random.nextFloat( pointIndex, RandomStream::ROTATION ) * 360.0f))) * modelRotation)._elements;
                 entry._data = {
                     to_F32( arrayLayer ),
                     to_F32( ID ),
@@ -1040,10 +1184,12 @@ namespace Divide
                 };
 
                 container.push_back( entry );
-            }
+            });
 
             container.shrink_to_fit();
             chunkCache << BYTE_BUFFER_VERSION;
+            chunkCache << inputHash;
+            chunkCache << _ID_VIEW( reinterpret_cast<const char*>(container.data()), sizeof( VegetationData ) * container.size() );
             chunkCache << container.size();
             chunkCache.append( container.data(), container.size() );
             DIVIDE_EXPECTED_CALL( chunkCache.dumpToFile(Paths::g_terrainCacheLocation, cacheFileName ) );
@@ -0,0 +1,579 @@
+
+
+#include "Headers/AnimationBlendTree.h"
+#include "Headers/AnimationUtils.h"
+#include "Headers/SceneAnimator.h"
+
+namespace Divide
+{
+
+namespace
+{
+    [[nodiscard]] mat4<F32> ComposeMatrix(const BonePose& pose) noexcept
+    {
+        // Same layout as AnimEvaluator::evaluate so that runtime poses match the baked ones
+        aiMatrix4x4 mat(pose._rotation.GetMatrix());
+        mat.a1 *= pose._scale.x; mat.b1 *= pose._scale.x; mat.c1 *= pose._scale.x;
+        mat.a2 *= pose._scale.y; mat.b2 *= pose._scale.y; mat.c2 *= pose._scale.y;
+        mat.a3 *= pose._scale.z; mat.b3 *= pose._scale.z; mat.c3 *= pose._scale.z;
+        mat.a4 = pose._translation.x;
+        mat.b4 = pose._translation.y;
+        mat.c4 = pose._translation.z;
+
+        mat4<F32> ret;
+        AnimUtils::TransformMatrix(mat, ret);
+        return ret;
+    }
+
+    [[nodiscard]] F32 AdvancePhase(const F32 phase, const D64 deltaTimeSeconds, const D64 durationSeconds) noexcept
+    {
+        if (durationSeconds <= 0.0)
+        {
+            return 0.f;
+        }
+
+        F32 ret = to_F32(std::fmod(to_D64(phase) + deltaTimeSeconds / durationSeconds, 1.0));
+        if (ret < 0.f)
+        {
+            ret += 1.f;
+        }
+
+        return ret;
+    }
+
+    [[nodiscard]] F32 MaskWeight(const BoneMask& mask, const size_t boneIndex, const F32 weight) noexcept
+    {
+        return mask.empty() ? weight : (boneIndex < mask.size() ? weight * mask[boneIndex] : 0.f);
+    }
+
+    [[nodiscard]] F32 SafeRatio(const F32 value, const F32 reference) noexcept
+    {
+        return IS_ZERO(reference) ? 1.f : value / reference;
+    }
+} //namespace
+
+U8 AnimationBlendTree::addParameter(const std::string_view name, const F32 defaultValue)
+{
+    DIVIDE_ASSERT(_parameters.size() < INVALID_PARAMETER, "AnimationBlendTree::addParameter: too many parameters!");
+
+    const U64 nameHash = _ID(name);
+    const U8 existing = parameterIndex(nameHash);
+    if (existing != INVALID_PARAMETER)
+    {
+        _parameters[existing]._defaultValue = defaultValue;
+        return existing;
+    }
+
+    _parameters.emplace_back(Parameter{ ._nameHash = nameHash, ._defaultValue = defaultValue });
+    return to_U8(_parameters.size() - 1u);
+}
+
+U8 AnimationBlendTree::parameterIndex(const U64 nameHash) const noexcept
+{
+    for (size_t i = 0u; i < _parameters.size(); ++i)
+    {
+        if (_parameters[i]._nameHash == nameHash)
+        {
+            return to_U8(i);
+        }
+    }
+
+    return INVALID_PARAMETER;
+}
+
+U32 AnimationBlendTree::addClip(const U32 animationIndex)
+{
+    Node& node = _nodes.emplace_back();
+    node._type = BlendNodeType::CLIP;
+    node._animationIndex = animationIndex;
+
+    if (_rootNode == INVALID_NODE)
+    {
+        _rootNode = to_U32(_nodes.size() - 1u);
+    }
+
+    return to_U32(_nodes.size() - 1u);
+}
+
+U32 AnimationBlendTree::addBlend1D(const U8 parameter, const vector<std::pair<F32, U32>>& thresholdsAndChildren)
+{
+    DIVIDE_ASSERT(parameter < _parameters.size());
+
+    vector<std::pair<F32, U32>> sorted = thresholdsAndChildren;
+    eastl::sort(begin(sorted), end(sorted), [](const std::pair<F32, U32>& lhs, const std::pair<F32, U32>& rhs) noexcept
+    {
+        return lhs.first < rhs.first;
+    });
+
+    Node& node = _nodes.emplace_back();
+    node._type = BlendNodeType::BLEND_1D;
+    node._parameterX = parameter;
+    node._children.reserve(sorted.size());
+    node._positions.reserve(sorted.size());
+    for (const auto& [threshold, child] : sorted)
+    {
+        DIVIDE_ASSERT(child < _nodes.size() - 1u, "AnimationBlendTree::addBlend1D: child nodes must be added before their parent!");
+        node._children.push_back(child);
+        node._positions.emplace_back(threshold, 0.f);
+    }
+
+    _rootNode = to_U32(_nodes.size() - 1u);
+    return _rootNode;
+}
+
+U32 AnimationBlendTree::addBlend2D(const U8 parameterX, const U8 parameterY, const vector<std::pair<float2, U32>>& positionsAndChildren)
+{
+    DIVIDE_ASSERT(parameterX < _parameters.size() && parameterY < _parameters.size());
+
+    Node& node = _nodes.emplace_back();
+    node._type = BlendNodeType::BLEND_2D;
+    node._parameterX = parameterX;
+    node._parameterY = parameterY;
+    node._children.reserve(positionsAndChildren.size());
+    node._positions.reserve(positionsAndChildren.size());
+    for (const auto& [position, child] : positionsAndChildren)
+    {
+        DIVIDE_ASSERT(child < _nodes.size() - 1u, "AnimationBlendTree::addBlend2D: child nodes must be added before their parent!");
+        node._children.push_back(child);
+        node._positions.push_back(position);
+    }
+
+    _rootNode = to_U32(_nodes.size() - 1u);
+    return _rootNode;
+}
+
+U32 AnimationBlendTree::addAdditive(const U32 baseNode, const U32 additiveNode, const U8 weightParameter)
+{
+    DIVIDE_ASSERT(baseNode < _nodes.size() && additiveNode < _nodes.size() && weightParameter < _parameters.size());
+
+    Node& node = _nodes.emplace_back();
+    node._type = BlendNodeType::ADDITIVE;
+    node._parameterX = weightParameter;
+    node._children = { baseNode, additiveNode };
+
+    _rootNode = to_U32(_nodes.size() - 1u);
+    return _rootNode;
+}
+
+void AnimationBlendTree::ComputeWeights(const Node& node, const vector<F32>& parameters, vector<F32>& weightsOut)
+{
+    const size_t childCount = node._children.size();
+    weightsOut.resize(childCount);
+    std::fill(begin(weightsOut), end(weightsOut), 0.f);
+
+    if (childCount == 0u)
+    {
+        return;
+    }
+
+    switch (node._type)
+    {
+        case BlendNodeType::BLEND_1D:
+        {
+            const F32 x = parameters[node._parameterX];
+            if (x <= node._positions.front().x)
+            {
+                weightsOut.front() = 1.f;
+            }
+            else if (x >= node._positions.back().x)
+            {
+                weightsOut.back() = 1.f;
+            }
+            else
+            {
+                for (size_t i = 0u; i < childCount - 1u; ++i)
+                {
+                    const F32 lower = node._positions[i].x;
+                    const F32 upper = node._positions[i + 1u].x;
+                    if (x >= lower && x < upper)
+                    {
+                        const F32 t = (x - lower) / (upper - lower);
+                        weightsOut[i] = 1.f - t;
+                        weightsOut[i + 1u] = t;
+                        break;
+                    }
+                }
+            }
+        } break;
+        case BlendNodeType::BLEND_2D:
+        {
+            const float2 point{ parameters[node._parameterX], parameters[node._parameterY] };
+
+            F32 totalWeight = 0.f;
+            for (size_t i = 0u; i < childCount; ++i)
+            {
+                const F32 distanceSQ = point.distanceSquared(node._positions[i]);
+                if (distanceSQ <= EPSILON_F32)
+                {
+                    // Exactly on a sample point
+                    std::fill(begin(weightsOut), end(weightsOut), 0.f);
+                    weightsOut[i] = 1.f;
+                    return;
+                }
+
+                weightsOut[i] = 1.f / distanceSQ;
+                totalWeight += weightsOut[i];
+            }
+
+            for (F32& weight : weightsOut)
+            {
+                weight /= totalWeight;
+            }
+        } break;
+        case BlendNodeType::CLIP:
+        case BlendNodeType::ADDITIVE:
+        case BlendNodeType::COUNT:
+        {
+            weightsOut.front() = 1.f;
+        } break;
+    }
+}
+
+AnimationBlendState::AnimationBlendState(const AnimationBlendTree_ptr& tree)
+    : _tree(tree)
+{
+    DIVIDE_ASSERT(_tree != nullptr);
+
+    _activeNode = _tree->rootNode();
+    _parameterValues.reserve(_tree->parameters().size());
+    for (const AnimationBlendTree::Parameter& parameter : _tree->parameters())
+    {
+        _parameterValues.push_back(parameter._defaultValue);
+    }
+}
+
+F32 AnimationBlendState::parameter(const U8 index) const noexcept
+{
+    return index < _parameterValues.size() ? _parameterValues[index] : 0.f;
+}
+
+void AnimationBlendState::parameter(const U8 index, const F32 value) noexcept
+{
+    if (index < _parameterValues.size())
+    {
+        _parameterValues[index] = value;
+    }
+}
+
+bool AnimationBlendState::parameter(const std::string_view name, const F32 value) noexcept
+{
+    const U8 index = _tree->parameterIndex(_ID(name));
+    if (index == AnimationBlendTree::INVALID_PARAMETER)
+    {
+        return false;
+    }
+
+    parameter(index, value);
+    return true;
+}
+
+void AnimationBlendState::crossFadeTo(const U32 targetNode, const F32 durationSeconds)
+{
+    DIVIDE_ASSERT(targetNode < _tree->nodes().size());
+
+    if (targetNode == _activeNode)
+    {
+        return;
+    }
+
+    if (durationSeconds <= 0.f || _activeNode == AnimationBlendTree::INVALID_NODE)
+    {
+        _fadeSourceNode = AnimationBlendTree::INVALID_NODE;
+    }
+    else
+    {
+        // Interrupting an existing fade just drops the oldest source
+        _fadeSourceNode = _activeNode;
+        _fadeSourcePhase = _phase;
+        _fadeElapsed = 0.f;
+        _fadeDuration = durationSeconds;
+    }
+
+    _activeNode = targetNode;
+    _phase = 0.f;
+}
+
+U8 AnimationBlendState::addLayer(const U32 node, BoneMask&& mask, const F32 weight, const bool additive)
+{
+    DIVIDE_ASSERT(node < _tree->nodes().size() && _layers.size() < U8_MAX);
+
+    Layer& layer = _layers.emplace_back();
+    layer._node = node;
+    layer._mask = MOV(mask);
+    layer._weight = weight;
+    layer._additive = additive;
+
+    return to_U8(_layers.size() - 1u);
+}
+
+AnimationBlendState::Layer& AnimationBlendState::layer(const U8 index)
+{
+    DIVIDE_ASSERT(index < _layers.size());
+    return _layers[index];
+}
+
+LocalPose& AnimationBlendState::scratchPose(const U8 depth, const size_t boneCount)
+{
+    DIVIDE_ASSERT(depth < MAX_TREE_DEPTH, "AnimationBlendState: blend tree is too deep!");
+
+    LocalPose& pose = _scratchPoses[depth];
+    pose.resize(boneCount);
+    return pose;
+}
+
+D64 AnimationBlendState::nodeDurationSeconds(const AnimationList& animations, const U32 nodeIndex, const U8 depth)
+{
+    DIVIDE_ASSERT(depth < MAX_TREE_DEPTH, "AnimationBlendState: blend tree is too deep!");
+
+    const AnimationBlendTree::Node& node = _tree->nodes()[nodeIndex];
+    switch (node._type)
+    {
+        case BlendNodeType::CLIP:
+        {
+            return node._animationIndex < animations.size() ? animations[node._animationIndex]->durationSeconds() : 0.0;
+        }
+        case BlendNodeType::ADDITIVE:
+        {
+            return nodeDurationSeconds(animations, node._children.front(), depth + 1u);
+        }
+        case BlendNodeType::BLEND_1D:
+        case BlendNodeType::BLEND_2D:
+        {
+            // Children are phase-synced, so the blended cycle length is the weighted average of the child lengths
+            vector<F32>& weights = _scratchWeights[depth];
+            AnimationBlendTree::ComputeWeights(node, _parameterValues, weights);
+
+            D64 ret = 0.0;
+            for (size_t i = 0u; i < node._children.size(); ++i)
+            {
+                if (weights[i] > EPSILON_F32)
+                {
+                    ret += weights[i] * nodeDurationSeconds(animations, node._children[i], depth + 1u);
+                }
+            }
+            return ret;
+        }
+        case BlendNodeType::COUNT: break;
+    }
+
+    return 0.0;
+}
+
+void AnimationBlendState::evaluateNode(const SkeletonLayout& layout, const AnimationList& animations, const U32 nodeIndex, const F32 phase, const U8 depth, LocalPose& poseOut)
+{
+    DIVIDE_ASSERT(depth < MAX_TREE_DEPTH, "AnimationBlendState: blend tree is too deep!");
+
+    const size_t boneCount = layout.boneCount();
+    const AnimationBlendTree::Node& node = _tree->nodes()[nodeIndex];
+
+    switch (node._type)
+    {
+        case BlendNodeType::CLIP:
+        {
+            poseOut.assign(begin(layout._bindPose), end(layout._bindPose));
+            if (node._animationIndex < animations.size() && node._animationIndex < layout._channelBones.size())
+            {
+                animations[node._animationIndex]->samplePose(phase, layout._channelBones[node._animationIndex], poseOut);
+            }
+        } break;
+        case BlendNodeType::BLEND_1D:
+        case BlendNodeType::BLEND_2D:
+        {
+            vector<F32>& weights = _scratchWeights[depth];
+            AnimationBlendTree::ComputeWeights(node, _parameterValues, weights);
+
+            F32 totalWeight = 0.f;
+            for (size_t i = 0u; i < node._children.size(); ++i)
+            {
+                const F32 weight = weights[i];
+                if (weight <= EPSILON_F32)
+                {
+                    continue;
+                }
+
+                if (IS_ZERO(totalWeight))
+                {
+                    evaluateNode(layout, animations, node._children[i], phase, depth + 1u, poseOut);
+                }
+                else
+                {
+                    LocalPose& childPose = scratchPose(depth + 1u, boneCount);
+                    evaluateNode(layout, animations, node._children[i], phase, depth + 1u, childPose);
+                    // Running weighted average: avg' = lerp(avg, child, w / (W + w))
+                    AnimUtils::BlendPoses(poseOut, childPose, weight / (totalWeight + weight));
+                }
+
+                totalWeight += weight;
+            }
+
+            if (IS_ZERO(totalWeight))
+            {
+                poseOut.assign(begin(layout._bindPose), end(layout._bindPose));
+            }
+        } break;
+        case BlendNodeType::ADDITIVE:
+        {
+            evaluateNode(layout, animations, node._children[0], phase, depth + 1u, poseOut);
+
+            const F32 weight = _parameterValues[node._parameterX];
+            if (weight > EPSILON_F32)
+            {
+                LocalPose& additivePose = scratchPose(depth + 1u, boneCount);
+                evaluateNode(layout, animations, node._children[1], phase, depth + 1u, additivePose);
+
+                LocalPose& referencePose = scratchPose(depth + 2u, boneCount);
+                evaluateNode(layout, animations, node._children[1], 0.f, depth + 2u, referencePose);
+
+                AnimUtils::AddPoses(poseOut, additivePose, referencePose, weight);
+            }
+        } break;
+        case BlendNodeType::COUNT:
+        {
+            poseOut.assign(begin(layout._bindPose), end(layout._bindPose));
+        } break;
+    }
+}
+
+void AnimationBlendState::update(const SkeletonLayout& layout, const AnimationList& animations, const D64 deltaTimeSeconds, const std::span<mat4<F32>> skinningOut)
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    const size_t boneCount = layout.boneCount();
+    if (boneCount == 0u || _activeNode == AnimationBlendTree::INVALID_NODE)
+    {
+        return;
+    }
+
+    _phase = AdvancePhase(_phase, deltaTimeSeconds, nodeDurationSeconds(animations, _activeNode, 0u));
+    _localPose.resize(boneCount);
+    evaluateNode(layout, animations, _activeNode, _phase, 0u, _localPose);
+
+    if (crossFading())
+    {
+        _fadeElapsed += to_F32(std::abs(deltaTimeSeconds));
+        if (_fadeElapsed >= _fadeDuration)
+        {
+            _fadeSourceNode = AnimationBlendTree::INVALID_NODE;
+        }
+        else
+        {
+            _fadeSourcePhase = AdvancePhase(_fadeSourcePhase, deltaTimeSeconds, nodeDurationSeconds(animations, _fadeSourceNode, 1u));
+
+            LocalPose& sourcePose = scratchPose(1u, boneCount);
+            evaluateNode(layout, animations, _fadeSourceNode, _fadeSourcePhase, 1u, sourcePose);
+            AnimUtils::BlendPoses(_localPose, sourcePose, 1.f - _fadeElapsed / _fadeDuration);
+        }
+    }
+
+    for (Layer& layer : _layers)
+    {
+        if (layer._weight <= EPSILON_F32)
+        {
+            continue;
+        }
+
+        layer._phase = AdvancePhase(layer._phase, deltaTimeSeconds, nodeDurationSeconds(animations, layer._node, 1u));
+
+        LocalPose& layerPose = scratchPose(1u, boneCount);
+        evaluateNode(layout, animations, layer._node, layer._phase, 1u, layerPose);
+
+        if (layer._additive)
+        {
+            LocalPose& referencePose = scratchPose(2u, boneCount);
+            evaluateNode(layout, animations, layer._node, 0.f, 2u, referencePose);
+            AnimUtils::AddPoses(_localPose, layerPose, referencePose, layer._weight, layer._mask);
+        }
+        else
+        {
+            AnimUtils::BlendPoses(_localPose, layerPose, layer._weight, layer._mask);
+        }
+    }
+
+    AnimUtils::ComputeSkinningMatrices(layout, _localPose, _globalTransforms, skinningOut);
+}
+
+namespace AnimUtils
+{
+    void BlendPoses(LocalPose& inOut, const LocalPose& target, const F32 weight, const BoneMask& mask)
+    {
+        const size_t boneCount = std::min(inOut.size(), target.size());
+        for (size_t i = 0u; i < boneCount; ++i)
+        {
+            const F32 w = MaskWeight(mask, i, weight);
+            if (w <= EPSILON_F32)
+            {
+                continue;
+            }
+
+            BonePose& pose = inOut[i];
+            const BonePose& targetPose = target[i];
+            if (w >= 1.f - EPSILON_F32)
+            {
+                pose = targetPose;
+                continue;
+            }
+
+            pose._translation += (targetPose._translation - pose._translation) * w;
+            pose._scale += (targetPose._scale - pose._scale) * w;
+
+            const aiQuaternion source = pose._rotation;
+            aiQuaternion::Interpolate(pose._rotation, source, targetPose._rotation, w);
+        }
+    }
+
+    void AddPoses(LocalPose& inOut, const LocalPose& additive, const LocalPose& reference, const F32 weight, const BoneMask& mask)
+    {
+        static const aiQuaternion s_identity{ 1.f, 0.f, 0.f, 0.f };
+
+        const size_t boneCount = std::min(inOut.size(), std::min(additive.size(), reference.size()));
+        for (size_t i = 0u; i < boneCount; ++i)
+        {
+            const F32 w = MaskWeight(mask, i, weight);
+            if (w <= EPSILON_F32)
+            {
+                continue;
+            }
+
+            BonePose& pose = inOut[i];
+            const BonePose& additivePose = additive[i];
+            const BonePose& referencePose = reference[i];
+
+            pose._translation += (additivePose._translation - referencePose._translation) * w;
+
+            pose._scale.x *= 1.f + (SafeRatio(additivePose._scale.x, referencePose._scale.x) - 1.f) * w;
+            pose._scale.y *= 1.f + (SafeRatio(additivePose._scale.y, referencePose._scale.y) - 1.f) * w;
+            pose._scale.z *= 1.f + (SafeRatio(additivePose._scale.z, referencePose._scale.z) - 1.f) * w;
+
+            aiQuaternion delta = referencePose._rotation;
+            delta.Conjugate();
+            delta = delta * additivePose._rotation;
+
+            aiQuaternion weightedDelta;
+            aiQuaternion::Interpolate(weightedDelta, s_identity, delta, w);
+
+            pose._rotation = pose._rotation * weightedDelta;
+            pose._rotation.Normalize();
+        }
+    }
+
+    void ComputeSkinningMatrices(const SkeletonLayout& layout, const LocalPose& pose, vector<mat4<F32>>& globalScratch, const std::span<mat4<F32>> skinningOut)
+    {
+        const size_t boneCount = std::min(layout.boneCount(), pose.size());
+        globalScratch.resize(boneCount);
+
+        for (size_t i = 0u; i < boneCount; ++i)
+        {
+            const I16 parent = layout._parents[i];
+            // Parents are always stored before their children
+            globalScratch[i] = parent < 0 ? ComposeMatrix(pose[i]) : ComposeMatrix(pose[i]) * globalScratch[parent];
+
+            const U8 boneID = layout._boneIDs[i];
+            if (boneID != Bone::INVALID_BONE_IDX && boneID < skinningOut.size())
+            {
+                skinningOut[boneID] = layout._offsetMatrices[i] * globalScratch[i];
+            }
+        }
+    }
+} //namespace AnimUtils
+
+} //namespace Divide
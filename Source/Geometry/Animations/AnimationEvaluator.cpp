@@ -12,6 +12,17 @@ namespace Divide
     constexpr U16 BYTE_BUFFER_VERSION_EVALUATOR = 1u;
     constexpr F32 SCALING_TOLERANCE_VALUE = 1e-3;
 
+namespace
+{
+    /// Returns the index of the last key with a time stamp <= time (or 0)
+    template<typename Key>
+    [[nodiscard]] U32 FindKey(const vector<Key>& keys, const D64 time) noexcept
+    {
+        const auto it = std::upper_bound(keys.cbegin(), keys.cend(), time, [](const D64 t, const Key& key) noexcept { return t < key.mTime; });
+        return it == keys.cbegin() ? 0u : to_U32(std::distance(keys.cbegin(), it) - 1);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Constructor on a given animation.
 AnimEvaluator::AnimEvaluator(const aiAnimation* pAnim, U32 idx) noexcept 
@@ -69,60 +80,6 @@ AnimEvaluator::AnimEvaluator(const aiAnimation* pAnim, U32 idx) noexcept
     Console::d_printfn(LOCALE_STR("CREATE_ANIMATION_END"), _name.c_str());
 }
 
-bool AnimEvaluator::initBuffers( GFXDevice& context, const bool useDualQuaternions )
-{
-    DIVIDE_ASSERT(boneBuffer() == nullptr);
-    
-    DIVIDE_ASSERT((useDualQuaternions && _transformQuaternions.size() == frameCount()) ||
-                  _transformMatrices.size() == frameCount(),
-                  "AnimEvaluator error: can't create bone buffer at current stage!");
-
-
-    if ( frameCount() > 0u)
-    {
-        DIVIDE_ASSERT(_transformMatrices.front().size() <= Config::MAX_BONE_COUNT_PER_NODE, "AnimEvaluator error: Too many bones for current node! Increase MAX_BONE_COUNT_PER_NODE in Config!");
-
-        ShaderBufferDescriptor bufferDescriptor{};
-        bufferDescriptor._ringBufferLength = 1;
-        Util::StringFormatTo(bufferDescriptor._name, "BONE_BUFFER_{}", name());
-        bufferDescriptor._usageType = BufferUsageType::UNBOUND_BUFFER;
-        bufferDescriptor._updateFrequency = BufferUpdateFrequency::ONCE;
-
-        if ( useDualQuaternions )
-        {
-            vector<DualQuaternion> animationData;
-            animationData.reserve(frameCount() * _transformQuaternions.size() * 2u);
-            for (const BoneQuaternions& boneTransforms : _transformQuaternions)
-            {
-                animationData.insert(eastl::end(animationData), eastl::begin(boneTransforms), eastl::end(boneTransforms));
-            }
-
-            bufferDescriptor._elementSize = sizeof(DualQuaternion);
-            bufferDescriptor._elementCount = to_U32(animationData.size());
-            bufferDescriptor._initialData = { animationData.data(), animationData.size() * sizeof(DualQuaternion) };
-            _boneBuffer = context.newShaderBuffer(bufferDescriptor);
-        }
-        else
-        {
-            vector<mat4<F32>> animationData;
-            animationData.reserve(frameCount() * _transformMatrices.size());
-            for (const BoneMatrices& boneTransforms : _transformMatrices)
-            {
-                animationData.insert(eastl::end(animationData), eastl::begin(boneTransforms), eastl::end(boneTransforms));
-            }
-
-            bufferDescriptor._elementSize = sizeof(mat4<F32>);
-            bufferDescriptor._elementCount = to_U32(animationData.size());
-            bufferDescriptor._initialData = { animationData.data(), animationData.size() * sizeof(mat4<F32>) };
-            _boneBuffer = context.newShaderBuffer(bufferDescriptor);
-        }
-
-        return _boneBuffer != nullptr;
-    }
-
-    return false;
-}
-
 AnimEvaluator::FrameIndex AnimEvaluator::frameIndexAt(const D64 elapsedTimeS, const bool forward) const noexcept
 {
     FrameIndex ret = {};
@@ -310,6 +267,84 @@ void AnimEvaluator::evaluate(const D64 dt, Bone& skeleton)
     _lastTime = time;
 }
 
+void AnimEvaluator::samplePose(const F32 phase, const vector<I16>& channelBones, LocalPose& poseInOut) const
+{
+    sampleTicks(duration() > 0.0 ? std::fmod(to_D64(CLAMPED_01(phase)) * duration(), duration()) : 0.0, channelBones, poseInOut);
+}
+
+void AnimEvaluator::samplePoseAt(const D64 elapsedTimeS, const vector<I16>& channelBones, LocalPose& poseInOut) const
+{
+    sampleTicks(duration() > 0.0 ? std::fmod(elapsedTimeS * ticksPerSecond(), duration()) : 0.0, channelBones, poseInOut);
+}
+
+void AnimEvaluator::sampleTicks(const D64 time, const vector<I16>& channelBones, LocalPose& poseInOut) const
+{
+    const size_t channelCount = std::min(_channels.size(), channelBones.size());
+    for (size_t a = 0u; a < channelCount; ++a)
+    {
+        const I16 boneIndex = channelBones[a];
+        if (boneIndex < 0)
+        {
+            continue;
+        }
+
+        const AnimationChannel& channel = _channels[a];
+        BonePose& pose = poseInOut[boneIndex];
+
+        if (!channel._positionKeys.empty())
+        {
+            const U32 frame = FindKey(channel._positionKeys, time);
+            const U32 nextFrame = (frame + 1) % channel._positionKeys.size();
+
+            const aiVectorKey& key = channel._positionKeys[frame];
+            const aiVectorKey& nextKey = channel._positionKeys[nextFrame];
+            D64 diffTime = nextKey.mTime - key.mTime;
+            if (diffTime < 0.0)
+            {
+                diffTime += duration();
+            }
+
+            pose._translation = diffTime > 0.0
+                                   ? key.mValue + (nextKey.mValue - key.mValue) * to_F32((time - key.mTime) / diffTime)
+                                   : key.mValue;
+        }
+        else
+        {
+            pose._translation.Set(0.f, 0.f, 0.f);
+        }
+
+        if (!channel._rotationKeys.empty())
+        {
+            const U32 frame = FindKey(channel._rotationKeys, time);
+            const U32 nextFrame = (frame + 1) % channel._rotationKeys.size();
+
+            const aiQuatKey& key = channel._rotationKeys[frame];
+            const aiQuatKey& nextKey = channel._rotationKeys[nextFrame];
+            D64 diffTime = nextKey.mTime - key.mTime;
+            if (diffTime < 0.0)
+            {
+                diffTime += duration();
+            }
+
+            if (diffTime > 0.0)
+            {
+                aiQuaternion::Interpolate(pose._rotation, key.mValue, nextKey.mValue, to_F32((time - key.mTime) / diffTime));
+            }
+            else
+            {
+                pose._rotation = key.mValue;
+            }
+        }
+        else
+        {
+            pose._rotation = aiQuaternion(1.f, 0.f, 0.f, 0.f);
+        }
+
+        // Scaling keys are stepped, same as in evaluate()
+        pose._scale = channel._scalingKeys.empty() ? aiVector3D(1.f, 1.f, 1.f) : channel._scalingKeys[FindKey(channel._scalingKeys, time)].mValue;
+    }
+}
+
 void AnimEvaluator::save(const AnimEvaluator& evaluator, ByteBuffer& dataOut)
 {
     dataOut << BYTE_BUFFER_VERSION_EVALUATOR;
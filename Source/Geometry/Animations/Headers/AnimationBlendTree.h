@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_ANIMATION_BLEND_TREE_H_
+#define DVD_ANIMATION_BLEND_TREE_H_
+
+#include "AnimationEvaluator.h"
+
+namespace Divide
+{
+
+struct SkeletonLayout;
+
+using AnimationList = vector<std::unique_ptr<AnimEvaluator>>;
+
+enum class BlendNodeType : U8
+{
+    CLIP = 0,  ///< Plays a single animation
+    BLEND_1D,  ///< Blends between children based on a single parameter and sorted thresholds
+    BLEND_2D,  ///< Blends between children placed in a 2D parameter space (inverse distance weighting)
+    ADDITIVE,  ///< Applies the difference between the second child and its first frame on top of the first child
+    COUNT
+};
+
+/// Per bone weights [0...1] indexed by SkeletonLayout bone index. An empty mask affects every bone.
+using BoneMask = vector<F32>;
+
+FWD_DECLARE_MANAGED_CLASS(AnimationBlendTree);
+
+/// Describes how animations of a single SceneAnimator get combined at runtime.
+/// A tree is immutable once built and can be shared by any number of AnimationBlendState instances.
+class AnimationBlendTree
+{
+  public:
+    static constexpr U32 INVALID_NODE = U32_MAX;
+    static constexpr U8  INVALID_PARAMETER = U8_MAX;
+
+    struct Node
+    {
+        vector<U32>    _children;
+        /// BLEND_1D uses .x as the threshold for each child (sorted ascending). BLEND_2D uses both coordinates.
+        vector<float2> _positions;
+        U32            _animationIndex{ U32_MAX };
+        BlendNodeType  _type{ BlendNodeType::COUNT };
+        U8             _parameterX{ INVALID_PARAMETER };
+        U8             _parameterY{ INVALID_PARAMETER };
+    };
+
+    struct Parameter
+    {
+        U64 _nameHash{ 0u };
+        F32 _defaultValue{ 0.f };
+    };
+
+  public:
+    U8  addParameter(std::string_view name, F32 defaultValue = 0.f);
+    U32 addClip(U32 animationIndex);
+    U32 addBlend1D(U8 parameter, const vector<std::pair<F32, U32>>& thresholdsAndChildren);
+    U32 addBlend2D(U8 parameterX, U8 parameterY, const vector<std::pair<float2, U32>>& positionsAndChildren);
+    U32 addAdditive(U32 baseNode, U32 additiveNode, U8 weightParameter);
+
+    [[nodiscard]] U8 parameterIndex(U64 nameHash) const noexcept;
+
+    /// Computes child weights for blend nodes. weightsOut is resized to the node's child count and always sums to 1 (or 0 for an empty node)
+    static void ComputeWeights(const Node& node, const vector<F32>& parameters, vector<F32>& weightsOut);
+
+    PROPERTY_RW(U32, rootNode, INVALID_NODE);
+    PROPERTY_R(vector<Node>, nodes);
+    PROPERTY_R(vector<Parameter>, parameters);
+};
+
+/// Runtime state of a blend tree for a single animated node: parameter values, playback phase, active crossfade and layers.
+/// Distinct instances can be updated in parallel as long as the skeleton and animations aren't modified at the same time.
+class AnimationBlendState
+{
+  public:
+    struct Layer
+    {
+        BoneMask _mask{};
+        U32  _node{ AnimationBlendTree::INVALID_NODE };
+        F32  _weight{ 1.f };
+        F32  _phase{ 0.f };
+        /// Additive layers apply their delta from their first frame instead of overriding the pose
+        bool _additive{ false };
+    };
+
+  public:
+    explicit AnimationBlendState(const AnimationBlendTree_ptr& tree);
+
+    [[nodiscard]] F32  parameter(U8 index) const noexcept;
+                  void parameter(U8 index, F32 value) noexcept;
+                  bool parameter(std::string_view name, F32 value) noexcept;
+
+    /// Start blending from the active base node to targetNode over durationSeconds. A duration of 0 switches instantly.
+    void crossFadeTo(U32 targetNode, F32 durationSeconds);
+
+    /// Layers are applied in order on top of the base tree. Returns the new layer's index.
+    U8 addLayer(U32 node, BoneMask&& mask, F32 weight, bool additive);
+    [[nodiscard]] Layer& layer(U8 index);
+
+    /// Advances playback by deltaTimeSeconds and writes one skinning matrix per bone ID in skinningOut
+    void update(const SkeletonLayout& layout, const AnimationList& animations, D64 deltaTimeSeconds, std::span<mat4<F32>> skinningOut);
+
+    [[nodiscard]] bool crossFading() const noexcept { return _fadeSourceNode != AnimationBlendTree::INVALID_NODE; }
+
+    PROPERTY_R(AnimationBlendTree_ptr, tree, nullptr);
+    PROPERTY_R(U32, activeNode, AnimationBlendTree::INVALID_NODE);
+    /// Final blended local pose from the last update() call
+    PROPERTY_R(LocalPose, localPose);
+
+  private:
+    void evaluateNode(const SkeletonLayout& layout, const AnimationList& animations, U32 nodeIndex, F32 phase, U8 depth, LocalPose& poseOut);
+    [[nodiscard]] D64 nodeDurationSeconds(const AnimationList& animations, U32 nodeIndex, U8 depth);
+    [[nodiscard]] LocalPose& scratchPose(U8 depth, size_t boneCount);
+
+  private:
+    static constexpr U8 MAX_TREE_DEPTH = 16u;
+
+    vector<F32> _parameterValues;
+    vector<Layer> _layers;
+    /// One scratch pose and weight list per tree depth level so recursion doesn't allocate after warm-up
+    std::array<LocalPose, MAX_TREE_DEPTH> _scratchPoses;
+    std::array<vector<F32>, MAX_TREE_DEPTH> _scratchWeights;
+    vector<mat4<F32>> _globalTransforms;
+
+    F32 _phase{ 0.f };
+    U32 _fadeSourceNode{ AnimationBlendTree::INVALID_NODE };
+    F32 _fadeSourcePhase{ 0.f };
+    F32 _fadeElapsed{ 0.f };
+    F32 _fadeDuration{ 0.f };
+};
+
+FWD_DECLARE_MANAGED_CLASS(AnimationBlendState);
+
+namespace AnimUtils
+{
+    /// out = lerp(out, in, weight) per bone (with an optional per bone mask)
+    void BlendPoses(LocalPose& inOut, const LocalPose& target, F32 weight, const BoneMask& mask = {});
+    /// out += (additive - reference) * weight per bone (with an optional per bone mask)
+    void AddPoses(LocalPose& inOut, const LocalPose& additive, const LocalPose& reference, F32 weight, const BoneMask& mask = {});
+    /// Converts a local pose into skinning matrices (offset * global) indexed by bone ID
+    void ComputeSkinningMatrices(const SkeletonLayout& layout, const LocalPose& pose, vector<mat4<F32>>& globalScratch, std::span<mat4<F32>> skinningOut);
+} //namespace AnimUtils
+
+} //namespace Divide
+
+#endif //DVD_ANIMATION_BLEND_TREE_H_
@@ -71,6 +71,17 @@ struct DualQuaternion
 using BoneQuaternions = vector<DualQuaternion>;
 using BoneMatrices   = vector<mat4<F32>>;
 
+/// Decomposed, parent-relative bone transform used for runtime pose blending
+struct BonePose
+{
+    aiVector3D   _translation{ 0.f, 0.f, 0.f };
+    aiQuaternion _rotation{ 1.f, 0.f, 0.f, 0.f };
+    aiVector3D   _scale{ 1.f, 1.f, 1.f };
+};
+
+/// index = skeleton layout bone index (see SceneAnimator::skeletonLayout())
+using LocalPose = vector<BonePose>;
+
 class GFXDevice;
 class ByteBuffer;
 class SceneAnimator;
@@ -93,6 +104,16 @@ class AnimEvaluator
 
     void evaluate(D64 dt, Bone& skeleton);
 
+    /// Stateless alternative to evaluate(): samples every channel at the given normalised animation time [0...1]
+    /// and writes the result in poseInOut[channelBones[channel]]. Channels mapped to -1 are skipped.
+    /// Safe to call from multiple threads at the same time.
+    void samplePose(F32 phase, const vector<I16>& channelBones, LocalPose& poseInOut) const;
+    /// Same as samplePose but uses an elapsed time in seconds (wrapped around the animation's duration) like evaluate() does
+    void samplePoseAt(D64 elapsedTimeS, const vector<I16>& channelBones, LocalPose& poseInOut) const;
+
+    /// Animation duration in seconds (duration is stored in ticks)
+    [[nodiscard]] D64 durationSeconds() const noexcept;
+
     [[nodiscard]] FrameIndex frameIndexAt(D64 elapsedTimeS, bool forward) const noexcept;
 
     [[nodiscard]]       vector<BoneMatrices>&   transformMatrices()       noexcept;
@@ -109,8 +130,6 @@ class AnimEvaluator
     [[nodiscard]] const BoneMatrices& transformMatrices(const D64 elapsedTime, const bool forward) const;
     [[nodiscard]] const BoneMatrices& transformMatrices(const D64 elapsedTime, const bool forward, I32& resultingFrameIndex) const;
 
-    [[nodiscard]] bool initBuffers(GFXDevice& context, bool useDualQuaternions);
-
     static void save(const AnimEvaluator& evaluator, ByteBuffer& dataOut);
     static void load(AnimEvaluator& evaluator, ByteBuffer& dataIn);
 
@@ -120,7 +139,9 @@ class AnimEvaluator
     PROPERTY_R(bool, hasScaling, false);
     PROPERTY_R(U32, frameCount, 0u);
 
-    [[nodiscard]] inline ShaderBuffer* boneBuffer() const { return _boneBuffer.get(); }
+   protected:
+    /// Samples every channel at the given time (in ticks, already wrapped to [0, duration))
+    void sampleTicks(D64 time, const vector<I16>& channelBones, LocalPose& poseInOut) const;
 
    protected:
     /// Array to return transformations results inside.
@@ -130,8 +151,6 @@ class AnimEvaluator
     vector<uint3> _lastPositions;
     /// vector that holds all bone channels
     vector<AnimationChannel> _channels;
-    /// GPU buffer to hold bone transforms
-    ShaderBuffer_uptr _boneBuffer = nullptr;
     D64 _lastTime = 0.0;
 };
 
@@ -146,6 +165,11 @@ namespace Attorney
             animation._frameCount = frameCount;
         }
 
+        [[nodiscard]] static const vector<AnimationChannel>& channels(const AnimEvaluator& animation) noexcept
+        {
+            return animation._channels;
+        }
+
         friend class Divide::SceneAnimator;
     };
 }
@@ -39,6 +39,11 @@ namespace Divide
     inline       vector<BoneQuaternions>& AnimEvaluator::transformQuaternions()       noexcept { return _transformQuaternions; }
     inline const vector<BoneQuaternions>& AnimEvaluator::transQuaternions()     const noexcept { return _transformQuaternions; }
 
+    inline D64 AnimEvaluator::durationSeconds() const noexcept
+    {
+        return IS_ZERO(ticksPerSecond()) ? 0.0 : duration() / ticksPerSecond();
+    }
+
     inline BoneMatrices& AnimEvaluator::transformMatrices(const U32 frameIndex)
     {
         assert(frameIndex < to_U32(_transformMatrices.size()));
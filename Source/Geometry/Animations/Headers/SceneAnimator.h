@@ -59,6 +59,25 @@ class PlatformContext;
 
 FWD_DECLARE_MANAGED_CLASS( AnimEvaluator );
 
+/// Flattened copy of the bone hierarchy used by runtime pose evaluation (e.g. blend trees).
+/// Bones are stored in depth-first order so parents are always processed before their children.
+struct SkeletonLayout
+{
+    /// Parent layout index for every bone (-1 for the root)
+    vector<I16>       _parents;
+    /// Skinning slot for every bone (Bone::INVALID_BONE_IDX for bones that don't influence any vertex)
+    vector<U8>        _boneIDs;
+    vector<U64>       _nameHashes;
+    vector<mat4<F32>> _offsetMatrices;
+    /// Local transforms of the skeleton before any animation is applied
+    LocalPose         _bindPose;
+    /// index = animationID; entry = channel index -> layout bone index (-1 if the channel doesn't match any bone)
+    vector<vector<I16>> _channelBones;
+
+    [[nodiscard]] I16 boneIndex(U64 nameHash) const noexcept;
+    [[nodiscard]] size_t boneCount() const noexcept { return _parents.size(); }
+};
+
 class SceneAnimator
 {
     friend class Attorney::SceneAnimatorMeshImporter;
@@ -137,10 +156,11 @@ class SceneAnimator
     [[nodiscard]] U8 boneCount() const noexcept;
 
     PROPERTY_R(bool, useDualQuaternion, true);
+    PROPERTY_R(SkeletonLayout, skeletonLayout);
 
    private:
     bool init(PlatformContext& context);
-    void buildBuffers(GFXDevice& gfxDevice);
+    void buildSkeletonLayout();
 
     /// I/O operations
     void  saveSkeleton(ByteBuffer& dataOut, const Bone& parentIn) const;
@@ -180,11 +200,6 @@ namespace Attorney
             animations.clear();
         }
 
-        static void buildBuffers(Divide::SceneAnimator& animator, GFXDevice& gfxDevice)
-        {
-            animator.buildBuffers(gfxDevice);
-        }
-
         friend class Divide::Mesh;
         friend class Divide::MeshImporter;
     };
@@ -3,6 +3,7 @@
 #include "Headers/SceneAnimator.h"
 #include "Platform/Video/Headers/GFXDevice.h"
 #include "Headers/AnimationUtils.h"
+#include "Headers/AnimationBlendTree.h"
 
 #include "Core/Headers/PlatformContext.h"
 #include "Core/Headers/ByteBuffer.h"
@@ -12,6 +13,8 @@ namespace Divide
 {
     constexpr U16 BYTE_BUFFER_VERSION_ANIMATOR = 1u;
     constexpr U16 BYTE_BUFFER_VERSION_SKELETON = 2u;
+    /// Number of baked frames processed by a single task
+    constexpr U32 g_bakePartitionSize = 32u;
 
 namespace
 {
@@ -56,6 +59,40 @@ namespace
 
         return 1;
     }
+
+    void FlattenSkeleton(const Bone& bone, const I16 parentIndex, SkeletonLayout& layoutOut)
+    {
+        const I16 index = to_I16(layoutOut._parents.size());
+
+        layoutOut._parents.push_back(parentIndex);
+        layoutOut._boneIDs.push_back(bone._boneID);
+        layoutOut._nameHashes.push_back(bone.nameHash());
+        layoutOut._offsetMatrices.push_back(bone._offsetMatrix);
+
+        aiMatrix4x4 localTransform;
+        AnimUtils::TransformMatrix(bone._localTransform, localTransform);
+
+        BonePose& pose = layoutOut._bindPose.emplace_back();
+        localTransform.Decompose(pose._scale, pose._rotation, pose._translation);
+
+        for (const Bone_uptr& child : bone.children())
+        {
+            FlattenSkeleton(*child, index, layoutOut);
+        }
+    }
+}
+
+I16 SkeletonLayout::boneIndex(const U64 nameHash) const noexcept
+{
+    for (size_t i = 0u; i < _nameHashes.size(); ++i)
+    {
+        if (_nameHashes[i] == nameHash)
+        {
+            return to_I16(i);
+        }
+    }
+
+    return -1;
 }
 
 SceneAnimator::SceneAnimator(const bool useDualQuaternion)
@@ -85,85 +122,129 @@ void SceneAnimator::release(const bool releaseAnimations)
     }
 }
 
-void UpdateTransformContainer(const Bone_uptr& node, BoneMatrices& containerOut)
-{
-    if ( node != nullptr)
-    {
-        if ( node->_boneID != Bone::INVALID_BONE_IDX)
-        {
-            containerOut[node->_boneID] = node->_offsetMatrix * GetBoneGlobalTransform(*node);
-        }
-
-        for (const Bone_uptr& child :  node->children())
-        {
-            UpdateTransformContainer(child, containerOut);
-        }
-    }
-}
-
-bool SceneAnimator::init([[maybe_unused]] PlatformContext& context)
+bool SceneAnimator::init(PlatformContext& context)
 {
     Console::d_printfn(LOCALE_STR("LOAD_ANIMATIONS_BEGIN"));
 
+    buildSkeletonLayout();
+
     constexpr D64 timeStep = 1. / ANIMATION_TICKS_PER_SECOND;
 
     const U32 animationCount = to_U32(_animations.size());
     _skeletonLines.resize(animationCount);
 
-    // pre-calculate the animations
+    // Count the frames of every animation first so that all of the output storage is allocated upfront.
+    // index = animationID; entry = index of the animation's first frame in the global frame range
+    vector<U32> firstFrame(animationCount + 1u, 0u);
     for (U32 i = 0u; i < animationCount; ++i)
     {
         AnimEvaluator* crtAnimation = _animations[i].get();
         const D64 duration = crtAnimation->duration();
         const D64 tickStep = crtAnimation->ticksPerSecond() / ANIMATION_TICKS_PER_SECOND;
-        D64 dt = 0;
+
         U32 frameCount = 0u;
         for (D64 ticks = 0; ticks < duration; ticks += tickStep)
         {
-            dt += timeStep;
-            calculate(i, dt);
-
-            BoneMatrices& transformMatrices = crtAnimation->transformMatrices().emplace_back();
-            transformMatrices.resize(_skeletonDepthCache, MAT4_IDENTITY);
-            UpdateTransformContainer(_skeleton, transformMatrices);
             ++frameCount;
         }
 
-        _maximumAnimationFrames = std::max(crtAnimation->frameCount(), _maximumAnimationFrames);
-        _skeletonLines[i].resize(_maximumAnimationFrames, -1);
-
-        if ( useDualQuaternion() )
+        crtAnimation->transformMatrices().resize(frameCount);
+        for (BoneMatrices& transformMatrices : crtAnimation->transformMatrices())
         {
-            crtAnimation->transformQuaternions().reserve(crtAnimation->transformMatrices().size());
+            transformMatrices.resize(_skeletonDepthCache, MAT4_IDENTITY);
+        }
 
-            for (const BoneMatrices& transformMatrices : crtAnimation->transformMatrices() )
+        if (useDualQuaternion())
+        {
+            crtAnimation->transformQuaternions().resize(frameCount);
+            for (BoneQuaternions& transformQuaternions : crtAnimation->transformQuaternions())
             {
-                BoneQuaternions& transformQuaternions = crtAnimation->transformQuaternions().emplace_back();
-                transformQuaternions.resize(transformMatrices.size());
-
-                size_t index = 0u;
-                for ( const mat4<F32>& matrix : transformMatrices )
-                {
-                    DualQuaternion& dualQuat = transformQuaternions[index++];
-                    Util::ToDualQuaternion(matrix, dualQuat.a, dualQuat.b);
-                }
+                transformQuaternions.resize(_skeletonDepthCache);
             }
         }
 
         Attorney::AnimEvaluatorSceneAnimator::frameCount(*crtAnimation, frameCount);
+        _maximumAnimationFrames = std::max(frameCount, _maximumAnimationFrames);
+        firstFrame[i + 1u] = firstFrame[i] + frameCount;
     }
 
+    for (LineMap& lines : _skeletonLines)
+    {
+        lines.resize(_maximumAnimationFrames, -1);
+    }
+
+    // Every frame is sampled from the immutable animation data and the bind pose so frames don't depend on each other
+    // and we can bake all of the frames of all of the animations at the same time.
+    Parallel_For(context.taskPool(TaskPoolType::HIGH_PRIORITY),
+                 ParallelForDescriptor
+                 {
+                     ._iterCount = firstFrame.back(),
+                     ._partitionSize = g_bakePartitionSize
+                 },
+                 [&](const Task*, const U32 start, const U32 end)
+                 {
+                     LocalPose pose;
+                     BoneMatrices globalScratch;
+
+                     U32 animationIndex = to_U32(eastl::distance(eastl::begin(firstFrame), eastl::upper_bound(eastl::begin(firstFrame), eastl::end(firstFrame), start))) - 1u;
+
+                     for (U32 i = start; i < end; ++i)
+                     {
+                         while (i >= firstFrame[animationIndex + 1u])
+                         {
+                             ++animationIndex;
+                         }
+
+                         AnimEvaluator& crtAnimation = *_animations[animationIndex];
+                         const U32 frame = i - firstFrame[animationIndex];
+
+                         pose = _skeletonLayout._bindPose;
+                         crtAnimation.samplePoseAt(timeStep * (frame + 1u), _skeletonLayout._channelBones[animationIndex], pose);
+
+                         BoneMatrices& transformMatrices = crtAnimation.transformMatrices()[frame];
+                         AnimUtils::ComputeSkinningMatrices(_skeletonLayout, pose, globalScratch, std::span<mat4<F32>>(transformMatrices.data(), transformMatrices.size()));
+
+                         if (useDualQuaternion())
+                         {
+                             BoneQuaternions& transformQuaternions = crtAnimation.transformQuaternions()[frame];
+
+                             size_t index = 0u;
+                             for (const mat4<F32>& matrix : transformMatrices)
+                             {
+                                 DualQuaternion& dualQuat = transformQuaternions[index++];
+                                 Util::ToDualQuaternion(matrix, dualQuat.a, dualQuat.b);
+                             }
+                         }
+                     }
+                 });
+
     Console::d_printfn(LOCALE_STR("LOAD_ANIMATIONS_END"), _skeletonDepthCache);
 
     return _skeletonDepthCache > 0;
 }
 
-void SceneAnimator::buildBuffers(GFXDevice& gfxDevice)
+void SceneAnimator::buildSkeletonLayout()
 {
-    // pay the cost upfront
-    for (AnimEvaluator_uptr& crtAnimation : _animations)
+    _skeletonLayout = {};
+
+    if (_skeleton == nullptr)
     {
-        DIVIDE_EXPECTED_CALL( crtAnimation->initBuffers(gfxDevice, useDualQuaternion()) );
+        return;
+    }
+
+    FlattenSkeleton(*_skeleton, -1, _skeletonLayout);
+
+    _skeletonLayout._channelBones.resize(_animations.size());
+    for (size_t i = 0u; i < _animations.size(); ++i)
+    {
+        const vector<AnimationChannel>& channels = Attorney::AnimEvaluatorSceneAnimator::channels(*_animations[i]);
+
+        vector<I16>& channelBones = _skeletonLayout._channelBones[i];
+        channelBones.resize(channels.size(), -1);
+        for (size_t c = 0u; c < channels.size(); ++c)
+        {
+            channelBones[c] = _skeletonLayout.boneIndex(channels[c]._nameKey);
+        }
     }
 }
 
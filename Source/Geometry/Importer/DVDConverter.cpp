@@ -63,6 +63,38 @@ namespace {
 
         return internalNode;
     }
+
+    template<typename T>
+    void RemapStream(vector<T>& stream, const vector<U32>& remap, const size_t newVertexCount)
+    {
+        if (stream.empty())
+        {
+            return;
+        }
+
+        vector<T> remapped(newVertexCount);
+        meshopt_remapVertexBuffer(remapped.data(), stream.data(), stream.size(), sizeof(T), remap.data());
+        stream.swap(remapped);
+    }
+
+    void RemapStreams(Import::SubMeshData::VertexStreams& streams, const vector<U32>& remap, const size_t newVertexCount)
+    {
+        RemapStream(streams._positions,   remap, newVertexCount);
+        RemapStream(streams._normals,     remap, newVertexCount);
+        RemapStream(streams._tangents,    remap, newVertexCount);
+        RemapStream(streams._texcoords,   remap, newVertexCount);
+        RemapStream(streams._boneIndices, remap, newVertexCount);
+        RemapStream(streams._boneWeights, remap, newVertexCount);
+    }
+
+    template<typename T>
+    void AddStream(const vector<T>& stream, vector<meshopt_Stream>& streamsOut)
+    {
+        if (!stream.empty())
+        {
+            streamsOut.push_back({ stream.data(), sizeof(T), sizeof(T) });
+        }
+    }
 }; //namespace 
 
 namespace DVDConverter
@@ -315,6 +347,11 @@ bool Load(PlatformContext& context, Import::ImportData& target)
 
     const ResourcePath& modelFolderName = getTopLevelFolderName(filePath);
 
+    // Geometry processing (remapping, optimisation, LoD generation) only touches the submesh's own data so it runs in parallel after this loop.
+    // Submeshes keep their slot in _subMeshData so the merged buffers (and the cache file) come out identical regardless of scheduling
+    vector<const aiMesh*> sourceMeshes;
+    sourceMeshes.reserve(numMeshes);
+
     for (U16 n = 0u; n < numMeshes; ++n)
     {
         const aiMesh* currentMesh = aiScenePointer->mMeshes[n];
@@ -334,7 +371,7 @@ bool Load(PlatformContext& context, Import::ImportData& target)
         subMeshTemp._index = n;
         subMeshTemp._boneCount = to_U8(currentMesh->mNumBones);
 
-        detail::LoadSubMeshGeometry(currentMesh, subMeshTemp, target);
+        sourceMeshes.push_back(currentMesh);
 
         detail::LoadSubMeshMaterial(subMeshTemp._material,
                                     aiScenePointer,
@@ -345,6 +382,20 @@ bool Load(PlatformContext& context, Import::ImportData& target)
                                     true);
     }
 
+    DIVIDE_ASSERT(sourceMeshes.size() == target._subMeshData.size());
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = to_U32(sourceMeshes.size());
+    descriptor._partitionSize = 1u;
+
+    Parallel_For(context.taskPool(TaskPoolType::HIGH_PRIORITY), descriptor, [&](const Task*, const U32 start, const U32 end)
+    {
+        for (U32 i = start; i < end; ++i)
+        {
+            detail::LoadSubMeshGeometry(sourceMeshes[i], target._subMeshData[i], target);
+        }
+    });
+
     detail::BuildGeometryBuffers(context, target);
     return true;
 }
@@ -362,7 +413,7 @@ void BuildGeometryBuffers(PlatformContext& context, Import::ImportData& target)
         {
             indexCount += data._indices[lod].size();
         }
-        vertexCount += data._vertices.size();
+        vertexCount += data._vertices.count();
     }
 
     VertexBuffer::Descriptor descriptor
@@ -375,73 +426,102 @@ void BuildGeometryBuffers(PlatformContext& context, Import::ImportData& target)
     target._vertexBuffer = context.gfx().newVB( descriptor );
     VertexBuffer* vb = target._vertexBuffer.get();
 
-    vb->setVertexCount(vertexCount);
+    vector<VertexBuffer::Vertex> vertices;
+    vector<U32> indices;
+    vertices.reserve(vertexCount);
+    indices.reserve(indexCount);
     vb->reserveIndexCount(indexCount);
 
-    U32 vertexOffset = 0u;
+    AttributeFlags usedAttributes{};
     for ( Import::SubMeshData& data : target._subMeshData )
     {
-        const bool hasTexCoord = data._useAttribute[to_base( AttribLocation::TEXCOORD )];
-        const bool hasTangent  = data._useAttribute[to_base( AttribLocation::TANGENT )];
-        const bool hasBones    = data._useAttribute[to_base( AttribLocation::BONE_INDICE )] && 
-                                 data._useAttribute[to_base( AttribLocation::BONE_WEIGHT )];
+        const size_t firstIndex = indices.size();
+        PackSubMeshGeometry(data, to_U32(vertices.size()), vertices, indices);
 
+        size_t lodIndex = firstIndex;
         for ( U8 lod = 0u; lod < data._lodCount; ++lod )
         {
-            const size_t idxCount = data._indices[lod].size();
-
-            DIVIDE_ASSERT(idxCount != 0u);
-
-            data._triangles[lod].reserve(idxCount / 3);
-            const auto& indices = data._indices[lod];
-            for (size_t i = 0u; i < idxCount; i += 3u)
+            const size_t lodIndexEnd = lodIndex + data._indices[lod].size();
+            for (; lodIndex < lodIndexEnd; ++lodIndex)
             {
-                const uint3 triangleTemp = data._triangles[lod].emplace_back
-                (
-                    indices[i + 0] + vertexOffset,
-                    indices[i + 1] + vertexOffset,
-                    indices[i + 2] + vertexOffset
-                );
-
-                vb->addIndex(triangleTemp[0]);
-                vb->addIndex(triangleTemp[1]);
-                vb->addIndex(triangleTemp[2]);
+                vb->addIndex(indices[lodIndex]);
             }
 
             data._partitionIDs[lod] = vb->partitionBuffer();
         }
 
-        const U32 vertCount = to_U32(data._vertices.size());
-
-        for (U32 i = 0u; i < vertCount; ++i)
+        for (U8 i = 0u; i < to_base(AttribLocation::COUNT); ++i)
         {
-            const Import::SubMeshData::Vertex& vert = data._vertices[i];
+            usedAttributes[i] = usedAttributes[i] || data._useAttribute[i];
+        }
 
-            const U32 idx = i + vertexOffset;
+        // The vertex buffer keeps its own (packed) copy from here on
+        data._vertices.clear();
+    } //submesh data
 
-            vb->modifyPositionValue(idx, vert.position);
-            vb->modifyNormalValue(idx, vert.normal);
+    vb->setVertices(MOV(vertices), usedAttributes);
+}
 
-            if (hasTexCoord)
-            {
-                vb->modifyTexCoordValue(idx, vert.texcoord.xy);
-            }
-            if (hasTangent)
-            {
-                vb->modifyTangentValue(idx, vert.tangent.xyz);
-            }
-            if (hasBones)
-            {
-                vb->modifyBoneIndices(idx, vert.indices);
-                vb->modifyBoneWeights(idx, vert.weights);
-            }
+void PackSubMeshGeometry(Import::SubMeshData& subMeshData, const U32 vertexOffset, vector<VertexBuffer::Vertex>& verticesOut, vector<U32>& indicesOut)
+{
+    const bool hasTexCoord = subMeshData._useAttribute[to_base( AttribLocation::TEXCOORD )];
+    const bool hasTangent  = subMeshData._useAttribute[to_base( AttribLocation::TANGENT )];
+    const bool hasBones    = subMeshData._useAttribute[to_base( AttribLocation::BONE_INDICE )] && 
+                             subMeshData._useAttribute[to_base( AttribLocation::BONE_WEIGHT )];
+
+    for ( U8 lod = 0u; lod < subMeshData._lodCount; ++lod )
+    {
+        const size_t idxCount = subMeshData._indices[lod].size();
+
+        DIVIDE_ASSERT(idxCount != 0u);
+
+        vector<uint3>& triangles = subMeshData._triangles[lod];
+        triangles.clear();
+        triangles.reserve(idxCount / 3);
+
+        const auto& indices = subMeshData._indices[lod];
+        for (size_t i = 0u; i < idxCount; i += 3u)
+        {
+            const uint3 triangleTemp = triangles.emplace_back
+            (
+                indices[i + 0] + vertexOffset,
+                indices[i + 1] + vertexOffset,
+                indices[i + 2] + vertexOffset
+            );
+
+            indicesOut.insert(end(indicesOut), { triangleTemp[0], triangleTemp[1], triangleTemp[2] });
         }
+    }
 
-        vertexOffset += vertCount;
-    } //submesh data
+    const Import::SubMeshData::VertexStreams& streams = subMeshData._vertices;
+    const size_t vertCount = streams.count();
+    const size_t firstVertex = verticesOut.size();
+    verticesOut.resize(firstVertex + vertCount);
+
+    for (size_t i = 0u; i < vertCount; ++i)
+    {
+        VertexBuffer::Vertex& vertex = verticesOut[firstVertex + i];
+
+        vertex._position = streams._positions[i];
+        vertex._normal = streams._normals[i];
+
+        if (hasTexCoord)
+        {
+            vertex._texcoord = streams._texcoords[i];
+        }
+        if (hasTangent)
+        {
+            vertex._tangent = streams._tangents[i];
+        }
+        if (hasBones)
+        {
+            vertex._indices = streams._boneIndices[i];
+            vertex._weights = streams._boneWeights[i];
+        }
+    }
 }
 
-void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData, Import::ImportData& target)
+void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData, const Import::ImportData& target)
 {
     subMeshData._maxPos = { source->mAABB.mMax.x, source->mAABB.mMax.y, source->mAABB.mMax.z };
     subMeshData._minPos = { source->mAABB.mMin.x, source->mAABB.mMin.y, source->mAABB.mMin.z };
@@ -456,34 +536,41 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
         input_indices[j++] = indices[2];
     }
 
-    vector<Import::SubMeshData::Vertex> vertices(source->mNumVertices);
-    for (U32 j = 0u; j < source->mNumVertices; ++j)
+    const U32 sourceVertexCount = source->mNumVertices;
+
+    // Only allocate the streams we actually have data for, and quantize straight away to the formats the vertex buffer expects
+    Import::SubMeshData::VertexStreams vertices{};
+    vertices._positions.resize(sourceVertexCount);
+    vertices._normals.resize(sourceVertexCount);
+    for (U32 j = 0u; j < sourceVertexCount; ++j)
     {
         const aiVector3D position = source->mVertices[j];
         const aiVector3D normal = source->mNormals[j];
 
-        vertices[j].position.set( position.x, position.y, position.z );
-        vertices[j].normal.set( normal.x, normal.y, normal.z );
+        vertices._positions[j].set( position.x, position.y, position.z );
+        vertices._normals[j] = Util::PACK_VEC3( normal.x, normal.y, normal.z );
     }
     subMeshData._useAttribute[to_base( AttribLocation::POSITION )] = true;
     subMeshData._useAttribute[to_base( AttribLocation::NORMAL )] = true;
 
     if (source->mTextureCoords[0] != nullptr)
     {
-        for (U32 j = 0u; j < source->mNumVertices; ++j)
+        vertices._texcoords.resize(sourceVertexCount);
+        for (U32 j = 0u; j < sourceVertexCount; ++j)
         {
             const aiVector3D texCoord = source->mTextureCoords[0][j];
-            vertices[j].texcoord.set(texCoord.x, texCoord.y, texCoord.z);
+            vertices._texcoords[j].set(texCoord.x, texCoord.y);
         }
         subMeshData._useAttribute[to_base( AttribLocation::TEXCOORD )] = true;
     }
 
     if (source->mTangents != nullptr)
     {
-        for (U32 j = 0u; j < source->mNumVertices; ++j)
+        vertices._tangents.resize(sourceVertexCount);
+        for (U32 j = 0u; j < sourceVertexCount; ++j)
         {
             const aiVector3D tangent = source->mTangents[j];
-            vertices[j].tangent.set( tangent.x, tangent.y, tangent.z, 1.f);
+            vertices._tangents[j] = Util::PACK_VEC3( tangent.x, tangent.y, tangent.z );
         }
         subMeshData._useAttribute[to_base( AttribLocation::TANGENT )] = true;
     }
@@ -499,6 +586,11 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
             Console::errorfn( LOCALE_STR( "SUBMESH_TOO_MANY_BONES" ), subMeshData.name().c_str(), source->mNumBones, Config::MAX_BONE_COUNT_PER_NODE , Config::MAX_BONE_COUNT_PER_NODE );
         }
 
+        // Weights are gathered at full precision (assimp hands them to us per bone, not per vertex) and quantized once complete
+        vector<float4> boneWeights(sourceVertexCount, float4{0.f, 0.f, 0.f, 0.f});
+        vector<U8> weightCounts(sourceVertexCount, 0u);
+        vertices._boneIndices.resize(sourceVertexCount, vec4<U8>{0u, 0u, 0u, 0u});
+
         for ( U32 boneIndex = 0u; boneIndex < source->mNumBones; ++boneIndex )
         {
 
@@ -517,17 +609,27 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
             for ( U32 weightIndex = 0u; weightIndex < numWeights; ++weightIndex )
             {
                 const U32 vertexId = weights[weightIndex].mVertexId;
-                Import::SubMeshData::Vertex& vertex = vertices[vertexId];
+                U8& weightCount = weightCounts[vertexId];
 
-                DIVIDE_ASSERT(vertex.weightCount < 4u);
+                DIVIDE_ASSERT(weightCount < 4u);
                 {
-                    vertex.weights[vertex.weightCount] = weights[weightIndex].mWeight;
-                    vertex.indices[vertex.weightCount] = bone->_boneID;
-                    ++vertex.weightCount;
+                    boneWeights[vertexId][weightCount] = weights[weightIndex].mWeight;
+                    vertices._boneIndices[vertexId][weightCount] = bone->_boneID;
+                    ++weightCount;
                 }
             }
         }
 
+        vertices._boneWeights.resize(sourceVertexCount);
+        for (U32 j = 0u; j < sourceVertexCount; ++j)
+        {
+            const float4& weights = boneWeights[j];
+            vertices._boneWeights[j].set(FLOAT_TO_CHAR_UNORM(weights.x),
+                                         FLOAT_TO_CHAR_UNORM(weights.y),
+                                         FLOAT_TO_CHAR_UNORM(weights.z),
+                                         FLOAT_TO_CHAR_UNORM(weights.w));
+        }
+
         subMeshData._useAttribute[to_base( AttribLocation::BONE_INDICE )] = true;
         subMeshData._useAttribute[to_base( AttribLocation::BONE_WEIGHT )] = true;
     }
@@ -539,14 +641,22 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
     { // Generate LoD 0 (max detail)
         auto& target_indices = subMeshData._indices[0];
 
-        //Remap VB & IB
-        vector<U32> remap(source->mNumVertices);
-        const size_t vertex_count = meshopt_generateVertexRemap( remap.data(),
-                                                                 input_indices.data(),
-                                                                 input_indices.size(),
-                                                                 vertices.data(),
-                                                                 source->mNumVertices,
-                                                                 sizeof( Import::SubMeshData::Vertex ) );
+        //Remap VB & IB. Deduplicate on the quantized streams, so vertices that only differed past our storage precision get merged
+        vector<meshopt_Stream> streams;
+        AddStream(vertices._positions,   streams);
+        AddStream(vertices._normals,     streams);
+        AddStream(vertices._tangents,    streams);
+        AddStream(vertices._texcoords,   streams);
+        AddStream(vertices._boneIndices, streams);
+        AddStream(vertices._boneWeights, streams);
+
+        vector<U32> remap(sourceVertexCount);
+        const size_t vertex_count = meshopt_generateVertexRemapMulti( remap.data(),
+                                                                      input_indices.data(),
+                                                                      input_indices.size(),
+                                                                      sourceVertexCount,
+                                                                      streams.data(),
+                                                                      streams.size() );
         const size_t index_count = input_indices.size();
         target_indices.resize( index_count );
         meshopt_remapIndexBuffer(target_indices.data(),
@@ -557,38 +667,44 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
         // Don't need these anymore. Each LoD level will be calculated from the previous level's data
         input_indices.clear();
 
-        subMeshData._vertices.resize( vertex_count );
-        meshopt_remapVertexBuffer( subMeshData._vertices.data(),
-                                   vertices.data(),
-                                   source->mNumVertices,
-                                   sizeof( Import::SubMeshData::Vertex ),
-                                   remap.data() );
-        vertices.clear();
-        
+        subMeshData._vertices = MOV(vertices);
+        RemapStreams( subMeshData._vertices, remap, vertex_count );
+
+        const vector<float3>& positions = subMeshData._vertices._positions;
+
         // Optimise VB & IB
         meshopt_optimizeVertexCache( target_indices.data(),
                                      target_indices.data(),
                                      index_count,
-                                     subMeshData._vertices.size() );
+                                     vertex_count );
 
         meshopt_optimizeOverdraw( target_indices.data(),
                                   target_indices.data(),
                                   index_count,
-                                  &subMeshData._vertices[0].position.x,
-                                  subMeshData._vertices.size(),
-                                  sizeof( Import::SubMeshData::Vertex ),
+                                  &positions[0].x,
+                                  vertex_count,
+                                  sizeof( float3 ),
                                   kThreshold );
 
         // vertex fetch optimization should go last as it depends on the final index order
-        const size_t next_vertices = meshopt_optimizeVertexFetch( subMeshData._vertices.data(),
-                                                                  target_indices.data(),
-                                                                  index_count,
-                                                                  subMeshData._vertices.data(),
-                                                                  subMeshData._vertices.size(),
-                                                                  sizeof( Import::SubMeshData::Vertex ) );
-        subMeshData._vertices.resize( next_vertices );
+        const size_t next_vertices = meshopt_optimizeVertexFetchRemap( remap.data(),
+                                                                       target_indices.data(),
+                                                                       index_count,
+                                                                       vertex_count );
+        meshopt_remapIndexBuffer( target_indices.data(),
+                                  target_indices.data(),
+                                  index_count,
+                                  remap.data() );
+        RemapStreams( subMeshData._vertices, remap, next_vertices );
 
         subMeshData._lodCount = 1u;
+
+        // Cluster the final LoD 0 triangles for fine grained culling
+        BuildMeshlets( target_indices,
+                       &subMeshData._vertices._positions[0].x,
+                       subMeshData._vertices.count(),
+                       sizeof( float3 ),
+                       subMeshData._meshlets );
     }
     { // Generate LoDs [1 ... Import::MAX_LOD_LEVELS-1] data and place inside VB & IB with proper offsets
         if (subMeshData._indices[0].size() >= g_minIndexCountForAutoLoD)
@@ -607,9 +723,9 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
                 const size_t next_indices = meshopt_simplify( target_indices.data(),
                                                               source_indices.data(),
                                                               source_indices.size(),
-                                                              &subMeshData._vertices[0].position.x,
-                                                              subMeshData._vertices.size(),
-                                                              sizeof( Import::SubMeshData::Vertex ),
+                                                              &subMeshData._vertices._positions[0].x,
+                                                              subMeshData._vertices.count(),
+                                                              sizeof( float3 ),
                                                               target_index_count,
                                                               target_error );
 
@@ -625,14 +741,14 @@ void LoadSubMeshGeometry(const aiMesh* source, Import::SubMeshData& subMeshData,
                 meshopt_optimizeVertexCache(target_indices.data(),
                                             target_indices.data(),
                                             target_indices.size(),
-                                            subMeshData._vertices.size());
+                                            subMeshData._vertices.count());
 
                 meshopt_optimizeOverdraw( target_indices.data(),
                                           target_indices.data(),
                                           target_indices.size(),
-                                          &subMeshData._vertices[0].position.x,
-                                          subMeshData._vertices.size(),
-                                          sizeof( Import::SubMeshData::Vertex ),
+                                          &subMeshData._vertices._positions[0].x,
+                                          subMeshData._vertices.count(),
+                                          sizeof( float3 ),
                                           kThreshold );
                                           
                 ++subMeshData._lodCount;
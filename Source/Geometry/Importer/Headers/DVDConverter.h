@@ -96,9 +96,10 @@ namespace DVDConverter {
     [[nodiscard]] bool Load(PlatformContext& context, Import::ImportData& target);
 
     namespace detail{
+        /// Only writes to subMeshData, so different submeshes can be processed concurrently
         void LoadSubMeshGeometry(const aiMesh* source, 
                                  Import::SubMeshData& subMeshData,
-                                 Import::ImportData& target);
+                                 const Import::ImportData& target);
 
         void LoadSubMeshMaterial(Import::MaterialData& material,
                                  const aiScene* source,
@@ -109,6 +110,13 @@ namespace DVDConverter {
                                  bool convertHeightToBumpMap);
 
         void BuildGeometryBuffers(PlatformContext& context, Import::ImportData& target);
+
+        /// The device free part of BuildGeometryBuffers: fills in subMeshData's LoD triangle lists and appends its vertices and
+        /// indices (offset by vertexOffset) in the layout the vertex buffer stores them. Indices are appended one LoD after the other
+        void PackSubMeshGeometry(Import::SubMeshData& subMeshData,
+                                 U32 vertexOffset,
+                                 vector<VertexBuffer::Vertex>& verticesOut,
+                                 vector<U32>& indicesOut);
     }; //namespace Detail
 }; //namespace DVDConverter
 
@@ -37,6 +37,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Platform/Video/Textures/Headers/Texture.h"
 #include "Geometry/Animations/Headers/SceneAnimator.h"
 #include "Geometry/Shapes/Headers/Mesh.h"
+#include "MeshletData.h"
 
 namespace Divide {
     enum class GeometryFormat : U8
@@ -111,15 +112,22 @@ namespace Divide {
 
         struct SubMeshData
         {
-            struct Vertex
+            /// Per-attribute vertex streams, already quantized to the VertexBuffer::Vertex formats.
+            /// Only the streams flagged in _useAttribute are populated; the rest stay empty.
+            struct VertexStreams
             {
-                float3 position = {0.f, 0.f, 0.f };
-                float3 normal = {0.f, 0.f, 0.f };
-                float4 tangent = { 0.f, 0.f, 0.f, 0.f };
-                float3 texcoord = { 0.f, 0.f, 0.f };
-                float4 weights = {0.f, 0.f, 0.f, 0.f};
-                vec4<U8> indices = {0u, 0u, 0u, 0u};
-                U8 weightCount = 0u;
+                [[nodiscard]] size_t count() const noexcept { return _positions.size(); }
+                void clear();
+
+                vector<float3>   _positions;
+                /// Util::PACK_VEC3 encoded
+                vector<F32>      _normals;
+                /// Util::PACK_VEC3 encoded
+                vector<F32>      _tangents;
+                vector<float2>   _texcoords;
+                vector<vec4<U8>> _boneIndices;
+                /// UNORM8 encoded
+                vector<vec4<U8>> _boneWeights;
             };
 
             bool serialize(ByteBuffer& dataOut) const;
@@ -129,10 +137,12 @@ namespace Divide {
 
             MaterialData _material;
             AttributeFlags _useAttribute{};
-            vector<Vertex> _vertices;
+            VertexStreams _vertices;
             vector<uint3> _triangles[MAX_LOD_LEVELS];
             vector<U32> _indices[MAX_LOD_LEVELS];
             std::array<U16, MAX_LOD_LEVELS> _partitionIDs{};
+            /// Clusters for LoD 0. Vertex indices are relative to this submesh's vertices
+            MeshletData _meshlets;
 
             float3 _minPos{};
             float3 _maxPos{};
@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_GEOMETRY_MESHLET_DATA_H_
+#define DVD_GEOMETRY_MESHLET_DATA_H_
+
+namespace Divide {
+
+class Frustum;
+class ByteBuffer;
+
+/// A small cluster of triangles. Offsets index into MeshletData::_vertices and MeshletData::_triangles
+struct Meshlet
+{
+    U32 _vertexOffset{ 0u };
+    U32 _triangleOffset{ 0u };
+    U32 _vertexCount{ 0u };
+    U32 _triangleCount{ 0u };
+};
+
+/// Culling data for a meshlet: a bounding sphere and a normal cone (all triangles face away from the camera if it is outside of the cone)
+struct MeshletBounds
+{
+    float3 _center{};
+    F32    _radius{ 0.f };
+    float3 _coneApex{};
+    float3 _coneAxis{};
+    F32    _coneCutoff{ 1.f }; ///< cos(angle / 2). 1 means the cone is degenerate and backface culling is skipped
+};
+
+struct MeshletData
+{
+    static constexpr U32 MAX_VERTICES = 64u;
+    static constexpr U32 MAX_TRIANGLES = 124u;
+    static constexpr F32 CONE_WEIGHT = 0.25f;
+
+    bool serialize(ByteBuffer& dataOut) const;
+    bool deserialize(ByteBuffer& dataIn);
+
+    [[nodiscard]] bool empty() const noexcept { return _meshlets.empty(); }
+
+    vector<Meshlet> _meshlets;
+    vector<MeshletBounds> _bounds;
+    /// Indices into the source vertex buffer
+    vector<U32> _vertices;
+    /// 3 entries per triangle. Each is an index into the meshlet's range of _vertices
+    vector<U8> _triangles;
+};
+
+/// Splits an indexed triangle list into meshlets and computes their bounds. positions points to the first vertex' position, vertexStride is in bytes
+void BuildMeshlets(const vector<U32>& indices, const F32* positions, size_t vertexCount, size_t vertexStride, MeshletData& dataOut);
+
+/// CPU reference for cluster culling. Frustum and camera position must be in the same space as the meshlet bounds (usually the mesh's local space)
+[[nodiscard]] bool IsMeshletCulled(const MeshletBounds& bounds, const Frustum& frustum, const float3& cameraPosition) noexcept;
+
+/// Appends the index of every meshlet that survives frustum and backface cone culling to visibleMeshletsOut
+void CullMeshlets(const MeshletData& data, const Frustum& frustum, const float3& cameraPosition, vector<U32>& visibleMeshletsOut);
+
+} //namespace Divide
+
+#endif //DVD_GEOMETRY_MESHLET_DATA_H_
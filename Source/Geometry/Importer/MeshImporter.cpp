@@ -17,12 +17,53 @@
 #include "Platform/File/Headers/FileManagement.h"
 #include "Platform/Video/Buffers/VertexBuffer/Headers/VertexBuffer.h"
 
+#include <meshoptimizer.h>
+
 namespace Divide {
 
 namespace {
-    constexpr U16 BYTE_BUFFER_VERSION = 1u;
+    constexpr U16 BYTE_BUFFER_VERSION = 3u;
     const char* g_parsedAssetGeometryExt = "DVDGeom";
     const char* g_parsedAssetAnimationExt = "DVDAnim";
+
+    static_assert(sizeof(uint3) == 3 * sizeof(U32), "Triangles are encoded as a flat index list");
+
+    /// Triangle lists are stored with meshoptimizer's index codec: triangle count, encoded size, payload.
+    /// The codec keeps the triangles and their order but may rotate the vertices of a triangle (winding is preserved)
+    void EncodeTriangles(const vector<uint3>& triangles, ByteBuffer& dataOut)
+    {
+        U32 maxIndex = 0u;
+        for (const uint3& triangle : triangles)
+        {
+            maxIndex = std::max({ maxIndex, triangle.x, triangle.y, triangle.z });
+        }
+
+        const size_t indexCount = triangles.size() * 3u;
+        vector<Byte> encoded(meshopt_encodeIndexBufferBound(indexCount, to_size(maxIndex) + 1u));
+        encoded.resize(meshopt_encodeIndexBuffer(reinterpret_cast<unsigned char*>(encoded.data()), encoded.size(), reinterpret_cast<const U32*>(triangles.data()), indexCount));
+
+        dataOut << to_U32(triangles.size());
+        dataOut << to_U32(encoded.size());
+        dataOut.append(encoded.data(), encoded.size());
+    }
+
+    [[nodiscard]] bool DecodeTriangles(ByteBuffer& dataIn, vector<uint3>& trianglesOut)
+    {
+        U32 triangleCount = 0u, encodedSize = 0u;
+        dataIn >> triangleCount;
+        dataIn >> encodedSize;
+        if (dataIn.bufferSize() - dataIn.rpos() < encodedSize)
+        {
+            return false;
+        }
+
+        trianglesOut.resize(triangleCount);
+        const Byte* payload = dataIn.contents() + dataIn.rpos();
+        dataIn.readSkip(encodedSize);
+
+        return triangleCount == 0u ||
+               meshopt_decodeIndexBuffer(trianglesOut.data(), to_size(triangleCount) * 3u, sizeof(U32), reinterpret_cast<const unsigned char*>(payload), encodedSize) == 0;
+    }
 };
 
 GeometryFormat GetGeometryFormatForExtension(const char* extension) noexcept
@@ -124,7 +165,7 @@ namespace Import
     bool ImportData::loadFromFile(PlatformContext& context, const ResourcePath& path, const std::string_view fileName)
     {
         ByteBuffer tempBuffer;
-        if (tempBuffer.loadFromFile(path, Util::StringFormat( "{}.{}", fileName, g_parsedAssetGeometryExt ) ))
+        if (tempBuffer.mapFromFile(path, Util::StringFormat( "{}.{}", fileName, g_parsedAssetGeometryExt ) ))
         {
             auto tempVer = decltype(BYTE_BUFFER_VERSION){0};
             tempBuffer >> tempVer;
@@ -175,6 +216,17 @@ namespace Import
         return false;
     }
 
+    void SubMeshData::VertexStreams::clear()
+    {
+        // Release the memory as well. Import data for large assets would otherwise linger until the whole ImportData dies
+        vector<float3>().swap(_positions);
+        vector<F32>().swap(_normals);
+        vector<F32>().swap(_tangents);
+        vector<float2>().swap(_texcoords);
+        vector<vec4<U8>>().swap(_boneIndices);
+        vector<vec4<U8>>().swap(_boneWeights);
+    }
+
     bool SubMeshData::serialize(ByteBuffer& dataOut) const
     {
         dataOut << _name;
@@ -184,12 +236,12 @@ namespace Import
         dataOut << _partitionIDs;
         dataOut << _minPos;
         dataOut << _maxPos;
-        for (const auto& triangle : _triangles)
+        for (const auto& triangles : _triangles)
         {
-            dataOut << triangle;
+            EncodeTriangles(triangles, dataOut);
         }
 
-        return _material.serialize(dataOut);
+        return _meshlets.serialize(dataOut) && _material.serialize(dataOut);
     }
 
     bool SubMeshData::deserialize(ByteBuffer& dataIn)
@@ -201,12 +253,15 @@ namespace Import
         dataIn >> _partitionIDs;
         dataIn >> _minPos;
         dataIn >> _maxPos;
-        for (auto& triangle : _triangles)
+        for (auto& triangles : _triangles)
         {
-            dataIn >> triangle;
+            if (!DecodeTriangles(dataIn, triangles))
+            {
+                return false;
+            }
         }
 
-        return _material.deserialize(dataIn);
+        return _meshlets.deserialize(dataIn) && _material.deserialize(dataIn);
     }
 
     bool MaterialData::serialize(ByteBuffer& dataOut) const
@@ -419,7 +474,7 @@ namespace Import
             const string saveFileName = Util::StringFormat( "{}.{}", tempMeshData.modelName(), g_parsedAssetAnimationExt );
             if (context.config().debug.cache.enabled  &&
                 context.config().debug.cache.geometry &&
-                tempBuffer.loadFromFile(Paths::g_geometryCacheLocation, saveFileName ))
+                tempBuffer.mapFromFile(Paths::g_geometryCacheLocation, saveFileName ))
             {
                 animator->load(context, tempBuffer);
             }
@@ -0,0 +1,165 @@
+
+
+#include "Headers/MeshletData.h"
+
+#include "Core/Headers/ByteBuffer.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+
+#include <meshoptimizer.h>
+
+namespace Divide {
+
+bool MeshletData::serialize(ByteBuffer& dataOut) const
+{
+    dataOut << to_U32(_meshlets.size());
+    for (size_t i = 0u; i < _meshlets.size(); ++i)
+    {
+        const Meshlet& meshlet = _meshlets[i];
+        const MeshletBounds& bounds = _bounds[i];
+
+        dataOut << meshlet._vertexOffset;
+        dataOut << meshlet._triangleOffset;
+        dataOut << meshlet._vertexCount;
+        dataOut << meshlet._triangleCount;
+        dataOut << bounds._center;
+        dataOut << bounds._radius;
+        dataOut << bounds._coneApex;
+        dataOut << bounds._coneAxis;
+        dataOut << bounds._coneCutoff;
+    }
+    dataOut << _vertices;
+    dataOut << _triangles;
+
+    return true;
+}
+
+bool MeshletData::deserialize(ByteBuffer& dataIn)
+{
+    U32 meshletCount = 0u;
+    dataIn >> meshletCount;
+
+    _meshlets.resize(meshletCount);
+    _bounds.resize(meshletCount);
+    for (U32 i = 0u; i < meshletCount; ++i)
+    {
+        Meshlet& meshlet = _meshlets[i];
+        MeshletBounds& bounds = _bounds[i];
+
+        dataIn >> meshlet._vertexOffset;
+        dataIn >> meshlet._triangleOffset;
+        dataIn >> meshlet._vertexCount;
+        dataIn >> meshlet._triangleCount;
+        dataIn >> bounds._center;
+        dataIn >> bounds._radius;
+        dataIn >> bounds._coneApex;
+        dataIn >> bounds._coneAxis;
+        dataIn >> bounds._coneCutoff;
+    }
+    dataIn >> _vertices;
+    dataIn >> _triangles;
+
+    for (const Meshlet& meshlet : _meshlets)
+    {
+        if (meshlet._vertexOffset + meshlet._vertexCount > _vertices.size() ||
+            meshlet._triangleOffset + meshlet._triangleCount * 3u > _triangles.size())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void BuildMeshlets(const vector<U32>& indices, const F32* positions, const size_t vertexCount, const size_t vertexStride, MeshletData& dataOut)
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Streaming );
+
+    dataOut = {};
+    if (indices.empty() || vertexCount == 0u)
+    {
+        return;
+    }
+
+    const size_t maxMeshlets = meshopt_buildMeshletsBound(indices.size(), MeshletData::MAX_VERTICES, MeshletData::MAX_TRIANGLES);
+
+    vector<meshopt_Meshlet> meshlets(maxMeshlets);
+    dataOut._vertices.resize(maxMeshlets * MeshletData::MAX_VERTICES);
+    dataOut._triangles.resize(maxMeshlets * MeshletData::MAX_TRIANGLES * 3u);
+
+    const size_t meshletCount = meshopt_buildMeshlets(meshlets.data(),
+                                                      dataOut._vertices.data(),
+                                                      dataOut._triangles.data(),
+                                                      indices.data(),
+                                                      indices.size(),
+                                                      positions,
+                                                      vertexCount,
+                                                      vertexStride,
+                                                      MeshletData::MAX_VERTICES,
+                                                      MeshletData::MAX_TRIANGLES,
+                                                      MeshletData::CONE_WEIGHT);
+    if (meshletCount == 0u)
+    {
+        dataOut = {};
+        return;
+    }
+
+    // Trim the scratch space down to what the last meshlet actually uses
+    const meshopt_Meshlet& last = meshlets[meshletCount - 1u];
+    dataOut._vertices.resize(last.vertex_offset + last.vertex_count);
+    dataOut._triangles.resize(last.triangle_offset + ((last.triangle_count * 3u + 3u) & ~3u));
+
+    dataOut._meshlets.resize(meshletCount);
+    dataOut._bounds.resize(meshletCount);
+    for (size_t i = 0u; i < meshletCount; ++i)
+    {
+        const meshopt_Meshlet& meshlet = meshlets[i];
+        dataOut._meshlets[i] = 
+        {
+            ._vertexOffset = meshlet.vertex_offset,
+            ._triangleOffset = meshlet.triangle_offset,
+            ._vertexCount = meshlet.vertex_count,
+            ._triangleCount = meshlet.triangle_count
+        };
+
+        const meshopt_Bounds bounds = meshopt_computeMeshletBounds(&dataOut._vertices[meshlet.vertex_offset],
+                                                                   &dataOut._triangles[meshlet.triangle_offset],
+                                                                   meshlet.triangle_count,
+                                                                   positions,
+                                                                   vertexCount,
+                                                                   vertexStride);
+        MeshletBounds& boundsOut = dataOut._bounds[i];
+        boundsOut._center.set(bounds.center[0], bounds.center[1], bounds.center[2]);
+        boundsOut._radius = bounds.radius;
+        boundsOut._coneApex.set(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]);
+        boundsOut._coneAxis.set(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+        boundsOut._coneCutoff = bounds.cone_cutoff;
+    }
+}
+
+bool IsMeshletCulled(const MeshletBounds& bounds, const Frustum& frustum, const float3& cameraPosition) noexcept
+{
+    if (frustum.ContainsSphere(bounds._center, bounds._radius) == FrustumCollision::FRUSTUM_OUT)
+    {
+        return true;
+    }
+
+    // Every triangle in the cluster faces away from the camera if the view vector is inside the (inverted) normal cone
+    const float3 toCenter = bounds._center - cameraPosition;
+    return bounds._coneCutoff < 1.f && Dot(toCenter, bounds._coneAxis) >= bounds._coneCutoff * toCenter.length() + bounds._radius;
+}
+
+void CullMeshlets(const MeshletData& data, const Frustum& frustum, const float3& cameraPosition, vector<U32>& visibleMeshletsOut)
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+    visibleMeshletsOut.reserve(visibleMeshletsOut.size() + data._bounds.size());
+    for (U32 i = 0u; i < to_U32(data._bounds.size()); ++i)
+    {
+        if (!IsMeshletCulled(data._bounds[i], frustum, cameraPosition))
+        {
+            visibleMeshletsOut.push_back(i);
+        }
+    }
+}
+
+} //namespace Divide
@@ -279,6 +279,8 @@ class Material final : public CachedResource {
                      TextureOperation op,
                      bool useInGeometryPasses = false );
     void setTextureOperation(TextureSlot textureUsageSlot, TextureOperation op);
+    /// Texture streaming feedback: every texture used by this material needs mips down to the specified level
+    void requestTextureMips(U8 mip) const;
 
     void lockInstancesForRead() const noexcept;
     void unlockInstancesForRead() const noexcept;
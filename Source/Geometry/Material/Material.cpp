@@ -483,6 +483,18 @@ namespace Divide
         return setTextureLocked( textureUsageSlot, texture, sampler, op, useInGeometryPasses );
     }
 
+    void Material::requestTextureMips( const U8 mip ) const
+    {
+        SharedLock<SharedMutex> r_lock( _textureLock );
+        for ( const TextureInfo& info : _textures )
+        {
+            if ( info._ptr != INVALID_HANDLE<Texture> )
+            {
+                Get( info._ptr )->requestMip( mip );
+            }
+        }
+    }
+
     void Material::setTextureOperation( const TextureSlot textureUsageSlot, const TextureOperation op )
     {
 
@@ -140,8 +140,6 @@ void Mesh::postLoad(SceneGraphNode* sgn)
     {
         PlatformContext& pContext = sgn->context();
 
-        Attorney::SceneAnimatorMeshImporter::buildBuffers(*_animator, pContext.gfx() );
-
         registerEditorComponent( pContext );
         DIVIDE_ASSERT( _editorComponent != nullptr );
 
@@ -388,21 +388,32 @@ namespace Divide
     {
         intersectionsOut.clear();
 
-        // Try to leverage our physics system as it will always be way more faster and accurate
-        if ( !parentScene().context().pfx().intersect( params._ray, params._range, intersectionsOut ) )
+        // Physics hits are exact, but only cover nodes that have a rigid body
+        DIVIDE_UNUSED( parentScene().context().pfx().intersect( params._ray, params._range, intersectionsOut ) );
+        const size_t physicsHitCount = intersectionsOut.size();
+
+        // Sphere/AABB/OBB intersections cover everything else
+        const IntersectionRay intersectRay = GetIntersectionRay(params._ray);
+        DIVIDE_UNUSED( _root->intersect( intersectRay, params._range, intersectionsOut ) );
+
+        if ( intersectionsOut.empty() )
         {
-            // Fallback to Sphere/AABB/OBB intersections
-            const IntersectionRay intersectRay = GetIntersectionRay(params._ray);
+            return false;
+        }
 
-            if ( !_root->intersect(intersectRay, params._range, intersectionsOut ) )
+        // Nodes hit by both keep their (more accurate) physics result
+        for ( size_t i = physicsHitCount; i < intersectionsOut.size(); ++i )
+        {
+            for ( size_t j = 0u; j < physicsHitCount; ++j )
             {
-                return false;
+                if ( intersectionsOut[i].sgnGUID == intersectionsOut[j].sgnGUID )
+                {
+                    intersectionsOut[i].sgnGUID = -1;
+                    break;
+                }
             }
         }
 
-
-        DIVIDE_ASSERT( !intersectionsOut.empty() );
-
         const auto isIgnored = [&params]( const SceneNodeType type )
         {
             for ( size_t i = 0; i < params._ignoredTypesCount; ++i )
@@ -417,6 +428,11 @@ namespace Divide
 
         for ( SGNRayResult& result : intersectionsOut )
         {
+            if ( result.sgnGUID == -1 )
+            {
+                continue;
+            }
+
             SceneGraphNode* node = findNode( result.sgnGUID );
             const SceneNodeType snType = node->getNode().type();
 
@@ -432,6 +448,13 @@ namespace Divide
                       return res.dist < 0.f || res.sgnGUID == -1;
                   } );
 
+        eastl::sort( begin( intersectionsOut ),
+                     end( intersectionsOut ),
+                     []( const SGNRayResult& lhs, const SGNRayResult& rhs ) noexcept
+                     {
+                         return lhs.dist < rhs.dist;
+                     } );
+
         return !intersectionsOut.empty();
     }
 
@@ -328,6 +328,7 @@ namespace Divide
         void postRender( GFX::CommandBuffer& bufferInOut, GFX::MemoryBarrierCommand& memCmdInOut );
         void debugDraw( GFX::CommandBuffer& bufferInOut, GFX::MemoryBarrierCommand& memCmdInOut );
         void prepareLightData( RenderStage stage, const CameraSnapshot& cameraSnapshot, GFX::MemoryBarrierCommand& memCmdInOut );
+        void prepareAnimationData( GFX::MemoryBarrierCommand& memCmdInOut );
         [[nodiscard]] Camera* playerCamera( bool skipOverride = false ) const noexcept;
         [[nodiscard]] Camera* playerCamera( PlayerIndex idx, bool skipOverride = false ) const noexcept;
         void editorPreviewNode( const I64 editorPreviewNode ) noexcept;
@@ -550,6 +551,11 @@ namespace Divide
                 mgr->prepareLightData( stage, cameraSnapshot, memCmdInOut );
             }
 
+            static void prepareAnimationData( Divide::ProjectManager* mgr, GFX::MemoryBarrierCommand& memCmdInOut )
+            {
+                mgr->prepareAnimationData( memCmdInOut );
+            }
+
             static void debugDraw( Divide::ProjectManager* mgr, GFX::CommandBuffer& bufferInOut, GFX::MemoryBarrierCommand& memCmdInOut )
             {
                 mgr->debugDraw( bufferInOut, memCmdInOut );
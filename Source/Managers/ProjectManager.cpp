@@ -43,6 +43,9 @@
 #include "ECS/Components/Headers/SelectionComponent.h"
 #include "ECS/Components/Headers/TransformComponent.h"
 #include "ECS/Components/Headers/UnitComponent.h"
+#include "ECS/Systems/Headers/ECSManager.h"
+#include "ECS/Systems/Headers/AnimationSystem.h"
+#include <ECS/SystemManager.h>
 #include <filesystem>
 
 namespace Divide
@@ -1121,6 +1124,14 @@ namespace Divide
         }
     }
 
+    void ProjectManager::prepareAnimationData( GFX::MemoryBarrierCommand& memCmdInOut )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Scene );
+
+        ECSManager& ecsManager = activeProject()->getActiveScene()->sceneGraph()->GetECSManager();
+        ecsManager.ecsEngine().GetSystemManager()->GetSystem<AnimationSystem>()->uploadBoneData( memCmdInOut );
+    }
+
     void ProjectManager::onChangeFocus( const bool hasFocus )
     {
         if ( !_init )
@@ -1295,7 +1306,7 @@ namespace Divide
         }
 
         ByteBuffer save;
-        if ( save.loadFromFile( path, g_saveFile ) )
+        if ( save.mapFromFile( path, g_saveFile ) )
         {
             auto tempVer = decltype(BYTE_BUFFER_VERSION){0};
             save >> tempVer;
@@ -1303,6 +1314,8 @@ namespace Divide
             {
                 if ( !Attorney::SceneLoadSave::load( activeScene, save ) )
                 {
+                    // Release the mapping first or the file can't be deleted on some platforms
+                    save.clear();
                     //Remove the save and try the backup
                     if ( deleteFile( path, g_saveFile ) != FileError::NONE )
                     {
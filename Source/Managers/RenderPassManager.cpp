@@ -200,6 +200,8 @@ void RenderPassManager::render(const RenderParams& params)
         {
             PROFILE_SCOPE("RenderPassManager::update sky light", Profiler::Category::Scene );
             gfx.updateSceneDescriptorSet(*skyLightRenderBuffer, memCmd );
+            // Bone buffers are bound per draw so they need to be up to date before we start building any render pass
+            Attorney::ProjectManagerRenderPass::prepareAnimationData( projectManager, memCmd );
             SceneEnvironmentProbePool::UpdateSkyLight(gfx, *skyLightRenderBuffer, memCmd );
             projectManager->getEnvProbes()->prepareDebugData();
         }
@@ -70,6 +70,9 @@ public:
     [[nodiscard]] const PhysicsAPIWrapper& getImpl() const { assert(_api != nullptr); return *_api; }
 
     bool intersect(const Ray& intersectionRay, float2 range, vector<SGNRayResult>& intersectionsOut) const override;
+    bool intersect(std::span<const Ray> rays, float2 range, std::span<vector<SGNRayResult>> intersectionsOut) const override;
+    bool overlap(const BoundingSphere& sphere, vector<SGNRayResult>& intersectionsOut) const override;
+    bool overlap(const BoundingBox& box, vector<SGNRayResult>& intersectionsOut) const override;
 
     [[nodiscard]] bool frameStarted( const FrameEvent& evt ) override;
     [[nodiscard]] bool frameEnded( const FrameEvent& evt ) noexcept override;
@@ -41,6 +41,8 @@ namespace Divide
 
 struct SGNRayResult;
 struct Ray;
+class BoundingBox;
+class BoundingSphere;
 
 enum class RigidBodyShape : U8 {
     SHAPE_SPHERE = 0,
@@ -84,6 +86,10 @@ NOINITVTABLE_CLASS(PhysicsAPIWrapper) : public PlatformContextComponent
     virtual PhysicsAsset* createRigidActor(SceneGraphNode* node, RigidBodyComponent& parentComp) = 0;
 
     virtual bool intersect(const Ray& intersectionRay, float2 range, vector<SGNRayResult>& intersectionsOut) const = 0;
+    /// Batched ray casts: intersectionsOut[i] receives the hits for rays[i]. Returns true if any ray hit something
+    virtual bool intersect(std::span<const Ray> rays, float2 range, std::span<vector<SGNRayResult>> intersectionsOut) const = 0;
+    virtual bool overlap(const BoundingSphere& sphere, vector<SGNRayResult>& intersectionsOut) const = 0;
+    virtual bool overlap(const BoundingBox& box, vector<SGNRayResult>& intersectionsOut) const = 0;
 
     void frameStarted(const U64 deltaTimeGameUS);
     void frameEnded(const U64 deltaTimeGameUS);
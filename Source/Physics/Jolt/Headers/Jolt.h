@@ -38,16 +38,29 @@
 #endif
 
 #include "Physics/Headers/PhysicsAPIWrapper.h"
+#include "Physics/Jolt/Headers/JoltJobSystem.h"
+#include "Physics/Jolt/Headers/JoltContactListener.h"
+#include "Physics/Jolt/Headers/JoltQueries.h"
 
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Physics/PhysicsSystem.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
 
 namespace Divide
 {
 
+namespace JoltUtil
+{
+    [[nodiscard]] inline JPH::Vec3 ToJolt(const float3& v) noexcept { return JPH::Vec3(v.x, v.y, v.z); }
+    [[nodiscard]] inline JPH::Quat ToJolt(const quatf& q) noexcept { return JPH::Quat(q.X(), q.Y(), q.Z(), q.W()); }
+    [[nodiscard]] inline float3 FromJolt(JPH::Vec3Arg v) noexcept { return { v.GetX(), v.GetY(), v.GetZ() }; }
+    [[nodiscard]] inline quatf FromJolt(JPH::QuatArg q) noexcept { return { q.GetX(), q.GetY(), q.GetZ(), q.GetW() }; }
+} //namespace JoltUtil
+
 class PhysicsAsset;
+class JoltRigidBody;
+class Terrain;
 class SceneGraphNode;
 class PhysicsJolt final : public PhysicsAPIWrapper
 {
@@ -66,16 +79,55 @@ public:
     [[nodiscard]] bool destroyPhysicsScene(const Scene& scene) override;
 
     [[nodiscard]] bool intersect(const Ray& intersectionRay, float2 range, vector<SGNRayResult>& intersectionsOut) const override;
+    [[nodiscard]] bool intersect(std::span<const Ray> rays, float2 range, std::span<vector<SGNRayResult>> intersectionsOut) const override;
+    [[nodiscard]] bool overlap(const BoundingSphere& sphere, vector<SGNRayResult>& intersectionsOut) const override;
+    [[nodiscard]] bool overlap(const BoundingBox& box, vector<SGNRayResult>& intersectionsOut) const override;
 
     [[nodiscard]] PhysicsAsset* createRigidActor(SceneGraphNode* node, RigidBodyComponent& parentComp) override;
 
     [[nodiscard]] bool convertActor(PhysicsAsset* actor, PhysicsGroup newGroup) override;
 
+    /// Move a body (added or still pending) to the specified world pose
+    void setBodyPose(JPH::BodyID bodyID, const float3& position, const quatf& orientation);
+    /// Rebuild the body's collision shape for the new scale. Identical shapes are shared between bodies.
+    void updateBodyShape(const JoltRigidBody& body, const float3& scale);
+    /// Remove the body from the world (or from the pending list if it was never added) and free it
+    void destroyBody(const JoltRigidBody& body);
+
+private:
+    /// Resolve the bodies reported by a query to the scene graph nodes that own them and append them to resultsOut. Returns true if anything was appended
+    bool toSGNResults(const vector<JoltQueries::QueryHit>& hits, vector<SGNRayResult>& resultsOut) const;
+    [[nodiscard]] JPH::RefConst<JPH::Shape> getOrCreateHeightField(const Terrain& terrain, const float3& scale);
+    [[nodiscard]] JPH::RefConst<JPH::Shape> getOrCreateShape(const SceneGraphNode& node, RigidBodyShape shapeType, const float3& scale);
+    /// Insert every body created since the last step using a single broadphase batch per activation state
+    void addPendingBodies();
+    /// Only rebuild the broadphase trees once enough bodies were inserted or removed since the last rebuild
+    void optimizeBroadPhase();
+    /// Forward the contacts gathered during the last step to the rigid body components involved
+    void dispatchContactEvents();
+    /// Drive kinematic bodies towards their scene graph node's world transform
+    void syncKinematicBodies(F32 deltaTimeS);
+    /// Write the simulated pose of every active dynamic body back to the scene graph
+    void syncDynamicBodies();
+
 private:
     F32 _simulationSpeed = 1.0f;
+    U32 _maxBodies = 0u;
+
+    Mutex _bodyLock;
+    JPH::BodyIDVector _pendingBodies;
+    JPH::BodyIDVector _activeBodies;
+    vector<JoltRigidBody*> _bodies;
+    U32 _broadPhaseChanges = 0u;
+
+    JoltContactListener _contactListener;
+    vector<JoltContactEvent> _contactEvents;
+
+    Mutex _shapeCacheLock;
+    hashMap<size_t, JPH::RefConst<JPH::Shape>> _shapeCache;
 
     std::unique_ptr<JPH::Factory> _factory;
-    std::unique_ptr<JPH::JobSystemThreadPool> _threadPool;
+    std::unique_ptr<JoltJobSystem> _jobSystem;
     std::unique_ptr<JPH::PhysicsSystem> _physicsSystem;
     std::unique_ptr<JPH::TempAllocatorImpl> _allocator;
 };
@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_PHYSICS_JOLT_CONTACT_LISTENER_H_
+#define DVD_PHYSICS_JOLT_CONTACT_LISTENER_H_
+
+#include <Jolt/Physics/Collision/ContactListener.h>
+
+namespace Divide
+{
+
+struct JoltContactEvent
+{
+    JPH::BodyID _bodyA{};
+    JPH::BodyID _bodyB{};
+};
+
+/// Records new contacts while a physics step runs without locking or allocating.
+/// Jolt calls the listener from its worker threads, so every thread appends to its own preallocated buffer.
+/// PhysicsJolt merges the buffers once the step is done and hands the result to the ECS in one go.
+class JoltContactListener final : public JPH::ContactListener
+{
+public:
+    /// threadCount should match the job system's max concurrency. Events past capacityPerThread still get recorded, but allocate.
+    void init(U32 threadCount, U32 capacityPerThread);
+
+    /// Append every recorded event to eventsOut and reset all thread buffers. Must not be called during a physics step.
+    void flush(vector<JoltContactEvent>& eventsOut);
+
+    void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
+
+private:
+    struct alignas(64) ThreadBuffer
+    {
+        vector<JoltContactEvent> _events;
+    };
+
+    [[nodiscard]] ThreadBuffer& localBuffer();
+
+private:
+    vector<ThreadBuffer> _buffers;
+    std::atomic<U32> _nextBuffer{ 0u };
+    /// Bumped on every init so that threads re-acquire a buffer slot
+    U32 _generation = 0u;
+
+    /// Only used if more threads report contacts than we have buffers for
+    Mutex _overflowLock;
+    ThreadBuffer _overflow;
+};
+
+};  // namespace Divide
+
+#endif //DVD_PHYSICS_JOLT_CONTACT_LISTENER_H_
@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_PHYSICS_JOLT_HEIGHT_FIELD_H_
+#define DVD_PHYSICS_JOLT_HEIGHT_FIELD_H_
+
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+namespace Divide
+{
+
+class Terrain;
+class TaskPool;
+
+/// Turns terrain height data into a static compound of Jolt HeightFieldShape tiles.
+/// Height samples are block compressed by Jolt (BLOCK_SIZE x BLOCK_SIZE blocks, quantised to the fewest bits that keep the
+/// error under MAX_HEIGHT_ERROR) and every quad carries a material index, so the collider is a fraction of the size of an
+/// equivalent triangle mesh.
+namespace JoltHeightField
+{
+    static constexpr U32 FILE_VERSION = 2u;
+    /// Samples per tile edge. Neighbouring tiles share their border samples, so a tile covers TILE_SAMPLES - 1 quads
+    static constexpr U32 TILE_SAMPLES = 128u;
+    static constexpr U32 BLOCK_SIZE = 4u;
+    /// Largest height difference (in world units) that sample compression is allowed to introduce
+    static constexpr F32 MAX_HEIGHT_ERROR = 0.05f;
+    /// Quads with a rise over run above this get the STEEP material
+    static constexpr F32 STEEP_SLOPE = 1.f;
+
+    enum class Material : U8
+    {
+        GROUND = 0,
+        STEEP,
+        COUNT
+    };
+
+    static_assert(TILE_SAMPLES % BLOCK_SIZE == 0u, "Jolt requires the sample count to be a multiple of the block size");
+
+    /// Build the collider from the terrain's tile cache. Tiles are built in parallel on the specified pool
+    [[nodiscard]] JPH::RefConst<JPH::Shape> Build(const Terrain& terrain, TaskPool& pool);
+
+    /// Load the collider saved next to the terrain's tile cache or, if that is missing or stale, build and save a new one
+    [[nodiscard]] JPH::RefConst<JPH::Shape> LoadOrBuild(const Terrain& terrain, TaskPool& pool);
+
+} //namespace JoltHeightField
+} //namespace Divide
+
+#endif //DVD_PHYSICS_JOLT_HEIGHT_FIELD_H_
@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_PHYSICS_JOLT_JOB_SYSTEM_H_
+#define DVD_PHYSICS_JOLT_JOB_SYSTEM_H_
+
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+
+namespace Divide
+{
+
+class TaskPool;
+
+/// Runs Jolt's physics jobs on one of the engine's task pools instead of a separate set of threads.
+/// Jobs are queued at TaskPriority::HIGH so a physics step is not held up behind regular background work.
+/// The pool is shared with the rest of the engine's high priority work on purpose: the stepping thread helps out on barriers
+/// and a dedicated pool would only add threads competing for the same cores.
+/// Running out of job slots is treated as back-pressure: CreateJob helps the pool or backs off until a slot frees up, warning once.
+/// Barriers come from JobSystemWithBarrier, whose Wait() also executes pending jobs on the calling thread.
+class JoltJobSystem final : public JPH::JobSystemWithBarrier
+{
+public:
+    JoltJobSystem( TaskPool& pool, JPH::uint maxJobs, JPH::uint maxBarriers );
+
+    [[nodiscard]] int GetMaxConcurrency() const override;
+    [[nodiscard]] JobHandle CreateJob( const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0 ) override;
+
+protected:
+    void QueueJob( Job* inJob ) override;
+    void QueueJobs( Job** inJobs, JPH::uint inNumJobs ) override;
+    void FreeJob( Job* inJob ) override;
+
+private:
+    TaskPool& _pool;
+    JPH::FixedSizeFreeList<Job> _jobs;
+    JPH::uint _maxJobs{ 0u };
+    std::atomic_bool _exhaustionReported{ false };
+};
+
+};  // namespace Divide
+
+#endif //DVD_PHYSICS_JOLT_JOB_SYSTEM_H_
@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_PHYSICS_JOLT_QUERIES_H_
+#define DVD_PHYSICS_JOLT_QUERIES_H_
+
+#include <Jolt/Physics/Body/BodyID.h>
+
+namespace JPH
+{
+    class PhysicsSystem;
+} //namespace JPH
+
+namespace Divide
+{
+
+struct Ray;
+class BoundingBox;
+class BoundingSphere;
+
+/// Scene independent spatial queries against a Jolt physics world.
+/// Everything here goes through the world's broadphase tree, so cost scales with the number of candidates near the query
+/// instead of the number of bodies in the scene.
+namespace JoltQueries
+{
+    struct QueryHit
+    {
+        JPH::BodyID _bodyID{};
+        /// Distance along the ray for ray casts.
+        /// OverlapSphere: radius minus penetration depth, i.e. how far the body's surface is from the sphere's centre along the contact normal (0 if the centre is inside).
+        /// OverlapBox: always 0, as the broadphase test has no contact information
+        F32 _distance = 0.f;
+        /// True if the query started inside the body
+        bool _inside = false;
+    };
+
+    /// Gather every body hit by the ray between range.min and range.max (ray direction is assumed to be normalised).
+    /// Hits are sorted by distance and reported once per body. Returns true if anything was hit.
+    [[nodiscard]] bool CastRay(const JPH::PhysicsSystem& system, const Ray& ray, float2 range, vector<QueryHit>& hitsOut);
+
+    /// Narrow phase test of a sphere against every body shape. Hits are sorted by distance and reported once per body.
+    [[nodiscard]] bool OverlapSphere(const JPH::PhysicsSystem& system, const BoundingSphere& sphere, vector<QueryHit>& hitsOut);
+
+    /// Broadphase only test of an axis aligned box against every body's world space bounds.
+    /// Conservative (reports body AABB overlaps), but does not touch any collision shape.
+    [[nodiscard]] bool OverlapBox(const JPH::PhysicsSystem& system, const BoundingBox& box, vector<QueryHit>& hitsOut);
+
+} //namespace JoltQueries
+} //namespace Divide
+
+#endif //DVD_PHYSICS_JOLT_QUERIES_H_
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_PHYSICS_JOLT_RIGID_BODY_H_
+#define DVD_PHYSICS_JOLT_RIGID_BODY_H_
+
+#include "Physics/Headers/PhysicsAsset.h"
+#include "Core/Math/Headers/Transform.h"
+
+#include <Jolt/Physics/Body/BodyID.h>
+
+namespace Divide
+{
+
+class PhysicsJolt;
+enum class RigidBodyShape : U8;
+
+/// A single Jolt body bound to a RigidBodyComponent.
+/// The body is created immediately but only inserted into the physics world by PhysicsJolt at the start of the next
+/// simulation step, together with every other body created in the same frame.
+class JoltRigidBody final : public PhysicsAsset
+{
+public:
+    explicit JoltRigidBody(RigidBodyComponent& parent, PhysicsJolt& api, JPH::BodyID bodyID, RigidBodyShape shape, const TransformValues& initialValues);
+    ~JoltRigidBody() override;
+
+    void physicsCollisionGroup(PhysicsGroup group) override;
+
+    void setPosition(const float3& position) noexcept override;
+    void setPosition(F32 x, F32 y, F32 z) noexcept override;
+    void setPositionX(F32 positionX) noexcept override;
+    void setPositionY(F32 positionY) noexcept override;
+    void setPositionZ(F32 positionZ) noexcept override;
+    void translate(const float3& axisFactors) noexcept override;
+
+    void setScale(F32 amount) noexcept override;
+    void setScale(const float3& amount) noexcept override;
+    void setScale(F32 X, F32 Y, F32 Z) noexcept override;
+    void setScaleX(F32 amount) noexcept override;
+    void setScaleY(F32 amount) noexcept override;
+    void setScaleZ(F32 amount) noexcept override;
+    void scale(const float3& axisFactors) noexcept override;
+    void scaleX(F32 amount) noexcept override;
+    void scaleY(F32 amount) noexcept override;
+    void scaleZ(F32 amount) noexcept override;
+
+    void setRotation(const float3& axis, Angle::DEGREES_F degrees) noexcept override;
+    void setRotation(Angle::DEGREES_F pitch, Angle::DEGREES_F yaw, Angle::DEGREES_F roll) noexcept override;
+    void setRotation(const quatf& quat) noexcept override;
+    void setRotationX(Angle::DEGREES_F angle) noexcept override;
+    void setRotationY(Angle::DEGREES_F angle) noexcept override;
+    void setRotationZ(Angle::DEGREES_F angle) noexcept override;
+    void rotate(const float3& axis, Angle::DEGREES_F degrees) noexcept override;
+    void rotate(Angle::DEGREES_F pitch, Angle::DEGREES_F yaw, Angle::DEGREES_F roll) noexcept override;
+    void rotate(const quatf& quat) noexcept override;
+    void rotateSlerp(const quatf& quat, D64 deltaTime) override;
+    void rotateX(Angle::DEGREES_F angle) noexcept override;
+    void rotateY(Angle::DEGREES_F angle) noexcept override;
+    void rotateZ(Angle::DEGREES_F angle) noexcept override;
+
+    void getScale(float3& scaleOut) const noexcept override;
+    void getPosition(float3& posOut) const noexcept override;
+    void getOrientation(quatf& quatOut) const noexcept override;
+
+    /// Called by PhysicsJolt after a step for every active dynamic body. Updates the cached pose and the owning node's transform.
+    void onSimulationPose(const float3& position, const quatf& orientation);
+
+    PROPERTY_R(JPH::BodyID, bodyID);
+    PROPERTY_R(RigidBodyShape, shapeType);
+
+private:
+    /// Push the cached position and orientation to the physics world
+    void syncPose() noexcept;
+    /// Scale is baked into the collision shape, so a scale change requires a new (possibly shared) shape
+    void syncShape() noexcept;
+
+private:
+    PhysicsJolt& _api;
+    Transform _transform;
+};
+
+FWD_DECLARE_MANAGED_CLASS(JoltRigidBody);
+
+} // namespace Divide
+
+#endif //DVD_PHYSICS_JOLT_RIGID_BODY_H_
@@ -1,4 +1,13 @@
 #include "Headers/Jolt.h"
+#include "Headers/JoltRigidBody.h"
+#include "Headers/JoltHeightField.h"
+
+#include "Core/Headers/Configuration.h"
+#include "Core/Headers/PlatformContext.h"
+#include "Graphs/Headers/SceneGraphNode.h"
+#include "ECS/Components/Headers/RigidBodyComponent.h"
+#include "ECS/Components/Headers/TransformComponent.h"
+#include "Environment/Terrain/Headers/Terrain.h"
 
 // Jolt includes
 // Disable common warnings triggered by Jolt, you can use JPH_SUPPRESS_WARNING_PUSH / JPH_SUPPRESS_WARNING_POP to store and restore the warning state
@@ -7,8 +16,12 @@ JPH_SUPPRESS_WARNING_PUSH
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
+#include <Jolt/Physics/Collision/Shape/ScaledShape.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <Jolt/Physics/Body/BodyLock.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
-#include <Jolt/Physics/Body/BodyActivationListener.h>
 JPH_SUPPRESS_WARNING_POP
 
 static void TraceImpl(const char* inFMT, ...)
@@ -132,62 +145,55 @@ namespace Divide
         }
     };
 
-    // An example contact listener
-    class MyContactListener : public JPH::ContactListener
+    namespace 
     {
-    public:
-        // See: ContactListener
-        virtual JPH::ValidateResult	OnContactValidate([[maybe_unused]] const JPH::Body& inBody1, [[maybe_unused]] const JPH::Body& inBody2, [[maybe_unused]] JPH::RVec3Arg inBaseOffset, [[maybe_unused]] const JPH::CollideShapeResult& inCollisionResult) override
-        {
-            Console::printfn("Contact validate callback");
-
-            // Allows you to ignore a contact before it is created (using layers to not make objects collide is cheaper!)
-            return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
-        }
+        constexpr JPH::uint cNumBodyMutexes = 0;
+        /// Shapes smaller than this (in any dimension) are clamped to avoid degenerate collision geometry
+        constexpr F32 g_minShapeHalfExtent = 0.01f;
+        /// Shape cache keys are built from dimensions rounded to this precision (1mm)
+        constexpr F32 g_shapeKeyPrecision = 1000.f;
+        /// Rebuild the broadphase trees once this many bodies were added or removed ...
+        constexpr U32 g_minBroadPhaseChanges = 128u;
+        /// ... or once 1 / g_broadPhaseChangeRatio of all bodies changed, whichever is larger
+        constexpr U32 g_broadPhaseChangeRatio = 10u;
+        /// Initial size of each worker thread's contact event buffer
+        constexpr U32 g_contactEventsPerThread = 512u;
+        /// Batched ray casts are split into tasks of this many rays
+        constexpr U32 g_rayBatchPartitionSize = 16u;
+        BPLayerInterfaceImpl broad_phase_layer_interface;
+        ObjectVsBroadPhaseLayerFilterImpl object_vs_broadphase_layer_filter;
+        ObjectLayerPairFilterImpl object_vs_object_layer_filter;
 
-        virtual void OnContactAdded([[maybe_unused]] const JPH::Body& inBody1, [[maybe_unused]] const JPH::Body& inBody2, [[maybe_unused]] const JPH::ContactManifold& inManifold, [[maybe_unused]] JPH::ContactSettings& ioSettings) override
+        [[nodiscard]] RigidBodyShape GetShapeForNode(const SceneNodeType type) noexcept
         {
-            Console::printfn("A contact was added");
-        }
+            switch (type)
+            {
+                case SceneNodeType::TYPE_SPHERE_3D: return RigidBodyShape::SHAPE_SPHERE;
+                case SceneNodeType::TYPE_TERRAIN:   return RigidBodyShape::SHAPE_HEIGHTFIELD;
+                default: break;
+            }
 
-        virtual void OnContactPersisted([[maybe_unused]] const JPH::Body& inBody1, [[maybe_unused]] const JPH::Body& inBody2, [[maybe_unused]] const JPH::ContactManifold& inManifold, [[maybe_unused]] JPH::ContactSettings& ioSettings) override
-        {
-            Console::printfn("A contact was persisted");
+            // Meshes use their bounding box until convex decomposition is available
+            return RigidBodyShape::SHAPE_BOX;
         }
 
-        virtual void OnContactRemoved([[maybe_unused]] const JPH::SubShapeIDPair& inSubShapePair) override
+        [[nodiscard]] JPH::EMotionType GetMotionType(const PhysicsGroup group) noexcept
         {
-            Console::printfn("A contact was removed");
-        }
-    };
+            switch (group)
+            {
+                case PhysicsGroup::GROUP_STATIC:    return JPH::EMotionType::Static;
+                case PhysicsGroup::GROUP_KINEMATIC:
+                case PhysicsGroup::GROUP_IGNORE:    return JPH::EMotionType::Kinematic;
+                default: break;
+            }
 
-    // An example activation listener
-    class MyBodyActivationListener : public JPH::BodyActivationListener
-    {
-    public:
-        virtual void OnBodyActivated([[maybe_unused]] const JPH::BodyID& inBodyID, [[maybe_unused]] JPH::uint64 inBodyUserData) override
-        {
-            Console::printfn("A body got activated");
+            return JPH::EMotionType::Dynamic;
         }
 
-        virtual void OnBodyDeactivated([[maybe_unused]] const JPH::BodyID& inBodyID, [[maybe_unused]] JPH::uint64 inBodyUserData) override
+        [[nodiscard]] JPH::ObjectLayer GetObjectLayer(const PhysicsGroup group) noexcept
         {
-            Console::printfn("A body went to sleep");
+            return group == PhysicsGroup::GROUP_STATIC ? Layers::NON_MOVING : Layers::MOVING;
         }
-    };
-
-    namespace 
-    {
-        constexpr JPH::uint cMaxBodies = 1024;
-        constexpr JPH::uint cNumBodyMutexes = 0;
-        constexpr JPH::uint cMaxBodyPairs = 1024;
-        constexpr JPH::uint cMaxContactConstraints = 1024;
-        BPLayerInterfaceImpl broad_phase_layer_interface;
-        ObjectVsBroadPhaseLayerFilterImpl object_vs_broadphase_layer_filter;
-        ObjectLayerPairFilterImpl object_vs_object_layer_filter;
-        MyBodyActivationListener body_activation_listener;
-        MyContactListener contact_listener;
-
     }
 
     PhysicsJolt::PhysicsJolt( PlatformContext& context )
@@ -211,23 +217,34 @@ namespace Divide
 
         _allocator = std::make_unique<JPH::TempAllocatorImpl>(Bytes::Mega(10u));
 
-        _threadPool = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+        // Share the engine's worker threads instead of spinning up a second, competing pool
+        _jobSystem = std::make_unique<JoltJobSystem>(_context.taskPool(TaskPoolType::HIGH_PRIORITY), JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 
         _physicsSystem = std::make_unique<JPH::PhysicsSystem>();
 
-        _physicsSystem->Init(cMaxBodies, cNumBodyMutexes, cMaxBodyPairs, cMaxContactConstraints, broad_phase_layer_interface, object_vs_broadphase_layer_filter, object_vs_object_layer_filter);
+        // Size every body related buffer once, up front, so that scene loading never triggers a reallocation
+        _maxBodies = std::max(_context.config().runtime.maxPhysicsBodies, 1024u);
+        _physicsSystem->Init(_maxBodies, cNumBodyMutexes, _maxBodies, _maxBodies, broad_phase_layer_interface, object_vs_broadphase_layer_filter, object_vs_object_layer_filter);
 
-        _physicsSystem->SetBodyActivationListener(&body_activation_listener);
+        _pendingBodies.reserve(_maxBodies);
+        _activeBodies.reserve(_maxBodies);
+        _bodies.reserve(_maxBodies);
 
-        _physicsSystem->SetContactListener(&contact_listener);
+        _contactListener.init(to_U32(_jobSystem->GetMaxConcurrency()), g_contactEventsPerThread);
+        _contactEvents.reserve(g_contactEventsPerThread);
+        _physicsSystem->SetContactListener(&_contactListener);
 
         return ErrorCode::NO_ERR;
     }
 
     bool PhysicsJolt::closePhysicsAPI()
     {
+        {
+            LockGuard<Mutex> w_lock(_shapeCacheLock);
+            _shapeCache.clear();
+        }
         _physicsSystem.reset();
-        _threadPool.reset();
+        _jobSystem.reset();
         _allocator.reset();
         JPH::UnregisterTypes();
         _factory.reset();
@@ -242,13 +259,133 @@ namespace Divide
         // If you take larger steps than 1 / 60th of a second you need to do multiple collision steps in order to keep the simulation stable. Do 1 collision step per 1 / 60th of a second (round up).
         const I32 cCollisionSteps = to_I32(std::ceil(std::max(60.f / _simulationFrameRate, 1.f)));
 
-        _physicsSystem->OptimizeBroadPhase();
-        _physicsSystem->Update(Time::MicrosecondsToSeconds<F32>(deltaTimeGameUS), cCollisionSteps, _allocator.get(), _threadPool.get());
+        const F32 deltaTimeS = Time::MicrosecondsToSeconds<F32>(deltaTimeGameUS);
+
+        addPendingBodies();
+        syncKinematicBodies(deltaTimeS);
+
+        optimizeBroadPhase();
+        _physicsSystem->Update(deltaTimeS, cCollisionSteps, _allocator.get(), _jobSystem.get());
+
+        dispatchContactEvents();
     }
 
     /// Update actors
     void PhysicsJolt::frameEndedInternal([[maybe_unused]] const U64 deltaTimeGameUS )
     {
+        syncDynamicBodies();
+    }
+
+    void PhysicsJolt::addPendingBodies()
+    {
+        LockGuard<Mutex> w_lock(_bodyLock);
+        if (_pendingBodies.empty())
+        {
+            return;
+        }
+
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+
+        // Static bodies never need to be woken up, so keep them in their own batch
+        const auto staticEnd = std::partition(std::begin(_pendingBodies), std::end(_pendingBodies), [&bodyInterface](const JPH::BodyID& bodyID)
+        {
+            return bodyInterface.GetMotionType(bodyID) == JPH::EMotionType::Static;
+        });
+
+        const auto addBatch = [&bodyInterface](JPH::BodyID* bodies, const I32 count, const JPH::EActivation activation)
+        {
+            if (count > 0)
+            {
+                const JPH::BodyInterface::AddState state = bodyInterface.AddBodiesPrepare(bodies, count);
+                bodyInterface.AddBodiesFinalize(bodies, count, state, activation);
+            }
+        };
+
+        const I32 staticCount = to_I32(std::distance(std::begin(_pendingBodies), staticEnd));
+        addBatch(_pendingBodies.data(), staticCount, JPH::EActivation::DontActivate);
+        addBatch(_pendingBodies.data() + staticCount, to_I32(_pendingBodies.size()) - staticCount, JPH::EActivation::Activate);
+
+        _broadPhaseChanges += to_U32(_pendingBodies.size());
+        _pendingBodies.clear();
+    }
+
+    void PhysicsJolt::optimizeBroadPhase()
+    {
+        {
+            LockGuard<Mutex> w_lock(_bodyLock);
+            if (_broadPhaseChanges < std::max(g_minBroadPhaseChanges, _physicsSystem->GetNumBodies() / g_broadPhaseChangeRatio))
+            {
+                return;
+            }
+            _broadPhaseChanges = 0u;
+        }
+
+        _physicsSystem->OptimizeBroadPhase();
+    }
+
+    void PhysicsJolt::dispatchContactEvents()
+    {
+        _contactEvents.clear();
+        _contactListener.flush(_contactEvents);
+
+        const JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+        for (const JoltContactEvent& event : _contactEvents)
+        {
+            const JoltRigidBody* bodyA = reinterpret_cast<const JoltRigidBody*>(bodyInterface.GetUserData(event._bodyA));
+            const JoltRigidBody* bodyB = reinterpret_cast<const JoltRigidBody*>(bodyInterface.GetUserData(event._bodyB));
+            if (bodyA != nullptr && bodyB != nullptr)
+            {
+                bodyA->getParent().onCollision(bodyB->getParent());
+                bodyB->getParent().onCollision(bodyA->getParent());
+            }
+        }
+    }
+
+    void PhysicsJolt::syncKinematicBodies(const F32 deltaTimeS)
+    {
+        if (deltaTimeS <= 0.f)
+        {
+            return;
+        }
+
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+
+        LockGuard<Mutex> r_lock(_bodyLock);
+        for (const JoltRigidBody* body : _bodies)
+        {
+            if (GetMotionType(body->getParent().physicsCollisionGroup()) != JPH::EMotionType::Kinematic)
+            {
+                continue;
+            }
+
+            const TransformComponent* tComp = body->getParent().parentSGN()->get<TransformComponent>();
+            if (tComp != nullptr)
+            {
+                bodyInterface.MoveKinematic(body->bodyID(), JoltUtil::ToJolt(tComp->getWorldPosition()), JoltUtil::ToJolt(tComp->getWorldOrientation()), deltaTimeS);
+            }
+        }
+    }
+
+    void PhysicsJolt::syncDynamicBodies()
+    {
+        _activeBodies.clear();
+        _physicsSystem->GetActiveBodies(JPH::EBodyType::RigidBody, _activeBodies);
+
+        const JPH::BodyLockInterfaceLocking& lockInterface = _physicsSystem->GetBodyLockInterface();
+        for (const JPH::BodyID& bodyID : _activeBodies)
+        {
+            JPH::BodyLockRead lock(lockInterface, bodyID);
+            if (!lock.Succeeded())
+            {
+                continue;
+            }
+
+            const JPH::Body& body = lock.GetBody();
+            if (body.IsDynamic() && body.GetUserData() != 0u)
+            {
+                reinterpret_cast<JoltRigidBody*>(body.GetUserData())->onSimulationPose(JoltUtil::FromJolt(body.GetPosition()), JoltUtil::FromJolt(body.GetRotation()));
+            }
+        }
     }
 
     void PhysicsJolt::idle()
@@ -265,19 +402,290 @@ namespace Divide
         return true;
     }
 
-    PhysicsAsset* PhysicsJolt::createRigidActor([[maybe_unused]] SceneGraphNode* node, [[maybe_unused]] RigidBodyComponent& parentComp )
+    JPH::RefConst<JPH::Shape> PhysicsJolt::getOrCreateHeightField(const Terrain& terrain, const float3& scale)
     {
-        return nullptr;
+        size_t key = to_size(to_base(RigidBodyShape::SHAPE_HEIGHTFIELD));
+        Util::Hash_combine(key, terrain.tileCache().inputHash(),
+                                to_I32(scale.x * g_shapeKeyPrecision),
+                                to_I32(scale.y * g_shapeKeyPrecision),
+                                to_I32(scale.z * g_shapeKeyPrecision));
+
+        {
+            LockGuard<Mutex> r_lock(_shapeCacheLock);
+            const auto it = _shapeCache.find(key);
+            if (it != std::cend(_shapeCache))
+            {
+                return it->second;
+            }
+        }
+
+        // Loading or building the height field can take a while. Don't block every other shape lookup on it
+        JPH::RefConst<JPH::Shape> shape = JoltHeightField::LoadOrBuild(terrain, _context.taskPool(TaskPoolType::HIGH_PRIORITY));
+        if (shape == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (!scale.compare(VECTOR3_UNIT))
+        {
+            shape = new JPH::ScaledShape(shape, JoltUtil::ToJolt(scale));
+        }
+
+        // If someone else built the same height field in the meantime, keep theirs so every body shares one shape
+        LockGuard<Mutex> w_lock(_shapeCacheLock);
+        return _shapeCache.emplace(key, shape).first->second;
+    }
+
+    JPH::RefConst<JPH::Shape> PhysicsJolt::getOrCreateShape(const SceneGraphNode& node, const RigidBodyShape shapeType, const float3& scale)
+    {
+        if (shapeType == RigidBodyShape::SHAPE_HEIGHTFIELD && node.getNode().type() == SceneNodeType::TYPE_TERRAIN)
+        {
+            JPH::RefConst<JPH::Shape> heightField = getOrCreateHeightField(node.getNode<Terrain>(), scale);
+            if (heightField != nullptr)
+            {
+                return heightField;
+            }
+        }
+
+        const BoundingBox& bounds = node.getNode().getBounds();
+        const float3 centre = bounds.getCenter() * scale;
+        float3 halfExtents = bounds.getHalfExtent() * scale;
+        halfExtents.set(std::max(halfExtents.x, g_minShapeHalfExtent),
+                        std::max(halfExtents.y, g_minShapeHalfExtent),
+                        std::max(halfExtents.z, g_minShapeHalfExtent));
+
+        size_t key = to_size(to_base(shapeType));
+        Util::Hash_combine(key, to_I32(halfExtents.x * g_shapeKeyPrecision),
+                                to_I32(halfExtents.y * g_shapeKeyPrecision),
+                                to_I32(halfExtents.z * g_shapeKeyPrecision),
+                                to_I32(centre.x * g_shapeKeyPrecision),
+                                to_I32(centre.y * g_shapeKeyPrecision),
+                                to_I32(centre.z * g_shapeKeyPrecision));
+
+        LockGuard<Mutex> w_lock(_shapeCacheLock);
+        const auto it = _shapeCache.find(key);
+        if (it != std::cend(_shapeCache))
+        {
+            return it->second;
+        }
+
+        JPH::RefConst<JPH::Shape> shape;
+        switch (shapeType)
+        {
+            case RigidBodyShape::SHAPE_SPHERE:
+            {
+                shape = new JPH::SphereShape(halfExtents.maxComponent());
+            } break;
+            case RigidBodyShape::SHAPE_CAPSULE:
+            {
+                const F32 radius = std::max(halfExtents.x, halfExtents.z);
+                shape = new JPH::CapsuleShape(std::max(halfExtents.y - radius, g_minShapeHalfExtent), radius);
+            } break;
+            default:
+            {
+                // Triangle meshes (and terrains without height data) fall back to their bounds for now
+                shape = new JPH::BoxShape(JoltUtil::ToJolt(halfExtents), std::min(JPH::cDefaultConvexRadius, halfExtents.minComponent()));
+            } break;
+        }
+
+        if (!centre.compare(VECTOR3_ZERO))
+        {
+            shape = new JPH::RotatedTranslatedShape(JoltUtil::ToJolt(centre), JPH::Quat::sIdentity(), shape);
+        }
+
+        _shapeCache[key] = shape;
+        return shape;
+    }
+
+    PhysicsAsset* PhysicsJolt::createRigidActor(SceneGraphNode* node, RigidBodyComponent& parentComp )
+    {
+        DIVIDE_ASSERT(node != nullptr);
+
+        TransformValues values{};
+        if (const TransformComponent* tComp = node->get<TransformComponent>(); tComp != nullptr)
+        {
+            values._translation = tComp->getWorldPosition();
+            values._orientation = tComp->getWorldOrientation();
+            values._scale = tComp->getWorldScale();
+        }
+
+        const PhysicsGroup group = parentComp.physicsCollisionGroup();
+        const RigidBodyShape shapeType = GetShapeForNode(node->getNode().type());
+
+        JPH::BodyCreationSettings settings(getOrCreateShape(*node, shapeType, values._scale),
+                                           JoltUtil::ToJolt(values._translation),
+                                           JoltUtil::ToJolt(values._orientation),
+                                           GetMotionType(group),
+                                           GetObjectLayer(group));
+        // Allow convertActor to turn static bodies into moving ones later on (height fields can never move)
+        settings.mAllowDynamicOrKinematic = !settings.GetShape()->MustBeStatic();
+        settings.mIsSensor = group == PhysicsGroup::GROUP_IGNORE;
+
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+        JPH::Body* body = bodyInterface.CreateBody(settings);
+        if (body == nullptr)
+        {
+            Console::errorfn(LOCALE_STR("ERROR_PHYSICS_BODY_LIMIT"), node->name().c_str(), _maxBodies);
+            return nullptr;
+        }
+
+        JoltRigidBody* ret = new JoltRigidBody(parentComp, *this, body->GetID(), shapeType, values);
+        body->SetUserData(reinterpret_cast<JPH::uint64>(ret));
+
+        // Insertion into the broadphase is deferred until the next step so that a scene load adds all of its bodies in one go
+        LockGuard<Mutex> w_lock(_bodyLock);
+        _pendingBodies.push_back(body->GetID());
+        _bodies.push_back(ret);
+
+        return ret;
     }
 
-    bool PhysicsJolt::convertActor([[maybe_unused]] PhysicsAsset* actor, [[maybe_unused]] const PhysicsGroup newGroup )
+    bool PhysicsJolt::convertActor(PhysicsAsset* actor, const PhysicsGroup newGroup )
     {
+        const JoltRigidBody* body = static_cast<JoltRigidBody*>(actor);
+        if (body == nullptr)
+        {
+            return false;
+        }
+
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+        const JPH::BodyID bodyID = body->bodyID();
+        const JPH::EActivation activation = bodyInterface.IsAdded(bodyID) ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
+
+        bodyInterface.SetObjectLayer(bodyID, GetObjectLayer(newGroup));
+        bodyInterface.SetMotionType(bodyID, GetMotionType(newGroup), activation);
+
+        JPH::BodyLockWrite lock(_physicsSystem->GetBodyLockInterface(), bodyID);
+        if (lock.Succeeded())
+        {
+            lock.GetBody().SetIsSensor(newGroup == PhysicsGroup::GROUP_IGNORE);
+        }
+
         return true;
     }
 
-    bool PhysicsJolt::intersect([[maybe_unused]] const Ray& intersectionRay, [[maybe_unused]] const float2 range, [[maybe_unused]] vector<SGNRayResult>& intersectionsOut ) const
+    void PhysicsJolt::setBodyPose(const JPH::BodyID bodyID, const float3& position, const quatf& orientation)
+    {
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+        const JPH::EActivation activation = bodyInterface.IsAdded(bodyID) ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
+        bodyInterface.SetPositionAndRotation(bodyID, JoltUtil::ToJolt(position), JoltUtil::ToJolt(orientation), activation);
+    }
+
+    void PhysicsJolt::updateBodyShape(const JoltRigidBody& body, const float3& scale)
+    {
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+        const JPH::BodyID bodyID = body.bodyID();
+        const JPH::EActivation activation = bodyInterface.IsAdded(bodyID) ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
+        bodyInterface.SetShape(bodyID, getOrCreateShape(*body.getParent().parentSGN(), body.shapeType(), scale), true, activation);
+    }
+
+    void PhysicsJolt::destroyBody(const JoltRigidBody& body)
     {
-        return false;
+        if (_physicsSystem == nullptr)
+        {
+            return;
+        }
+
+        JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+        const JPH::BodyID bodyID = body.bodyID();
+
+        LockGuard<Mutex> w_lock(_bodyLock);
+        dvd_erase_if(_bodies, [&body](const JoltRigidBody* it) noexcept { return it == &body; });
+
+        const auto it = std::find(std::begin(_pendingBodies), std::end(_pendingBodies), bodyID);
+        if (it != std::end(_pendingBodies))
+        {
+            _pendingBodies.erase(it);
+        }
+        else
+        {
+            bodyInterface.RemoveBody(bodyID);
+            ++_broadPhaseChanges;
+        }
+
+        bodyInterface.DestroyBody(bodyID);
+    }
+
+    bool PhysicsJolt::toSGNResults(const vector<JoltQueries::QueryHit>& hits, vector<SGNRayResult>& resultsOut) const
+    {
+        const JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+
+        const size_t initialSize = resultsOut.size();
+        resultsOut.reserve(initialSize + hits.size());
+        for (const JoltQueries::QueryHit& hit : hits)
+        {
+            const JoltRigidBody* body = reinterpret_cast<const JoltRigidBody*>(bodyInterface.GetUserData(hit._bodyID));
+            if (body != nullptr)
+            {
+                const SceneGraphNode* sgn = body->getParent().parentSGN();
+                resultsOut.push_back({ sgn->getGUID(), hit._distance, hit._inside, sgn->name().c_str() });
+            }
+        }
+
+        return resultsOut.size() > initialSize;
+    }
+
+    bool PhysicsJolt::intersect(const Ray& intersectionRay, const float2 range, vector<SGNRayResult>& intersectionsOut ) const
+    {
+        thread_local vector<JoltQueries::QueryHit> hits;
+
+        if (!JoltQueries::CastRay(*_physicsSystem, intersectionRay, range, hits))
+        {
+            return false;
+        }
+
+        return toSGNResults(hits, intersectionsOut);
+    }
+
+    bool PhysicsJolt::intersect(const std::span<const Ray> rays, const float2 range, const std::span<vector<SGNRayResult>> intersectionsOut) const
+    {
+        DIVIDE_ASSERT(rays.size() == intersectionsOut.size());
+
+        std::atomic_bool hit = false;
+
+        ParallelForDescriptor descriptor = {};
+        descriptor._iterCount = to_U32(rays.size());
+        descriptor._partitionSize = g_rayBatchPartitionSize;
+        descriptor._priority = TaskPriority::HIGH;
+        descriptor._useCurrentThread = true;
+
+        Parallel_For(_context.taskPool(TaskPoolType::HIGH_PRIORITY), descriptor, [&](const Task*, const U32 start, const U32 end)
+        {
+            for (U32 i = start; i < end; ++i)
+            {
+                intersectionsOut[i].resize(0);
+                if (intersect(rays[i], range, intersectionsOut[i]))
+                {
+                    hit.store(true, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        return hit.load();
+    }
+
+    bool PhysicsJolt::overlap(const BoundingSphere& sphere, vector<SGNRayResult>& intersectionsOut) const
+    {
+        thread_local vector<JoltQueries::QueryHit> hits;
+
+        if (!JoltQueries::OverlapSphere(*_physicsSystem, sphere, hits))
+        {
+            return false;
+        }
+
+        return toSGNResults(hits, intersectionsOut);
+    }
+
+    bool PhysicsJolt::overlap(const BoundingBox& box, vector<SGNRayResult>& intersectionsOut) const
+    {
+        thread_local vector<JoltQueries::QueryHit> hits;
+
+        if (!JoltQueries::OverlapBox(*_physicsSystem, box, hits))
+        {
+            return false;
+        }
+
+        return toSGNResults(hits, intersectionsOut);
     }
 
 };
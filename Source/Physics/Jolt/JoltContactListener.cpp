@@ -0,0 +1,70 @@
+#include "Headers/JoltContactListener.h"
+
+JPH_SUPPRESS_WARNING_PUSH
+#include <Jolt/Physics/Body/Body.h>
+JPH_SUPPRESS_WARNING_POP
+
+namespace Divide
+{
+    namespace
+    {
+        thread_local U32 t_bufferGeneration = 0u;
+        thread_local U32 t_bufferIndex = 0u;
+    }
+
+    void JoltContactListener::init(const U32 threadCount, const U32 capacityPerThread)
+    {
+        _buffers.resize(threadCount);
+        for (ThreadBuffer& buffer : _buffers)
+        {
+            buffer._events.clear();
+            buffer._events.reserve(capacityPerThread);
+        }
+
+        _overflow._events.clear();
+        _nextBuffer.store(0u);
+        ++_generation;
+    }
+
+    JoltContactListener::ThreadBuffer& JoltContactListener::localBuffer()
+    {
+        if (t_bufferGeneration != _generation)
+        {
+            t_bufferGeneration = _generation;
+            t_bufferIndex = _nextBuffer.fetch_add(1u);
+        }
+
+        return t_bufferIndex < _buffers.size() ? _buffers[t_bufferIndex] : _overflow;
+    }
+
+    void JoltContactListener::OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, [[maybe_unused]] const JPH::ContactManifold& inManifold, [[maybe_unused]] JPH::ContactSettings& ioSettings)
+    {
+        ThreadBuffer& buffer = localBuffer();
+        if (&buffer == &_overflow)
+        {
+            LockGuard<Mutex> w_lock(_overflowLock);
+            buffer._events.push_back({ inBody1.GetID(), inBody2.GetID() });
+        }
+        else
+        {
+            buffer._events.push_back({ inBody1.GetID(), inBody2.GetID() });
+        }
+    }
+
+    void JoltContactListener::flush(vector<JoltContactEvent>& eventsOut)
+    {
+        const auto append = [&eventsOut](vector<JoltContactEvent>& events)
+        {
+            eventsOut.insert(eventsOut.end(), events.begin(), events.end());
+            // clear() keeps the capacity around for the next step
+            events.clear();
+        };
+
+        for (ThreadBuffer& buffer : _buffers)
+        {
+            append(buffer._events);
+        }
+        append(_overflow._events);
+    }
+
+};  // namespace Divide
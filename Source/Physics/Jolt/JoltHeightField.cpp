@@ -0,0 +1,260 @@
+
+
+#include "Headers/JoltHeightField.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Environment/Terrain/Headers/Terrain.h"
+#include "Platform/File/Headers/FileManagement.h"
+
+JPH_SUPPRESS_WARNING_PUSH
+#include <Jolt/Core/StreamWrapper.h>
+#include <Jolt/Physics/Collision/PhysicsMaterialSimple.h>
+#include <Jolt/Physics/Collision/Shape/HeightFieldShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+JPH_SUPPRESS_WARNING_POP
+
+#include <fstream>
+#include <sstream>
+
+namespace Divide::JoltHeightField
+{
+    namespace
+    {
+        constexpr U32 g_heightFieldMagic = 0x46485444u; //"DTHF"
+        /// Shapes are stored in Jolt's own binary format, which is only guaranteed to round-trip with the same library version
+        constexpr U32 g_joltVersion = (JPH_VERSION_MAJOR << 16u) | (JPH_VERSION_MINOR << 8u) | JPH_VERSION_PATCH;
+
+        /// Everything a cached collider depends on. The tile cache hash only covers the height data, not the terrain's layout
+        struct CacheKey
+        {
+            U32 _joltVersion{ 0u };
+            U16 _width{ 0u };
+            U16 _height{ 0u };
+            U64 _inputHash{ 0u };
+
+            [[nodiscard]] bool operator==(const CacheKey& other) const noexcept = default;
+        };
+
+        struct Header
+        {
+            U32 _magic{ 0u };
+            U32 _version{ 0u };
+            CacheKey _key{};
+        };
+
+        [[nodiscard]] JPH::PhysicsMaterialList CreateMaterials()
+        {
+            JPH::PhysicsMaterialList materials;
+            materials.resize(to_base(Material::COUNT));
+            materials[to_base(Material::GROUND)] = new JPH::PhysicsMaterialSimple("TerrainGround", JPH::Color::sGreen);
+            materials[to_base(Material::STEEP)] = new JPH::PhysicsMaterialSimple("TerrainSteep", JPH::Color::sGrey);
+            return materials;
+        }
+
+        [[nodiscard]] JPH::RefConst<JPH::Shape> BuildTile(const TerrainTileCache& cache, const U32 tileX, const U32 tileY, const float2 spacing, const JPH::PhysicsMaterialList& materials)
+        {
+            constexpr U32 quadsPerEdge = TILE_SAMPLES - 1u;
+
+            const U32 startX = tileX * quadsPerEdge;
+            const U32 startY = tileY * quadsPerEdge;
+            const U32 width = cache.width();
+            const U32 height = cache.height();
+
+            vector<F32> samples(to_size(TILE_SAMPLES) * TILE_SAMPLES);
+            for (U32 y = 0u; y < TILE_SAMPLES; ++y)
+            {
+                for (U32 x = 0u; x < TILE_SAMPLES; ++x)
+                {
+                    const U32 globalX = startX + x;
+                    const U32 globalY = startY + y;
+                    // The last row/column of tiles usually hangs over the edge of the terrain. Leave that part as a hole
+                    samples[to_size(y) * TILE_SAMPLES + x] = globalX < width && globalY < height
+                                                                ? cache.vertex(globalX, globalY)._position.y
+                                                                : JPH::HeightFieldShapeConstants::cNoCollisionValue;
+                }
+            }
+
+            vector<U8> materialIndices(to_size(quadsPerEdge) * quadsPerEdge, to_U8(to_base(Material::GROUND)));
+            for (U32 y = 0u; y < quadsPerEdge; ++y)
+            {
+                for (U32 x = 0u; x < quadsPerEdge; ++x)
+                {
+                    const F32 h00 = samples[to_size(y) * TILE_SAMPLES + x];
+                    const F32 h10 = samples[to_size(y) * TILE_SAMPLES + x + 1u];
+                    const F32 h01 = samples[to_size(y + 1u) * TILE_SAMPLES + x];
+                    if (h00 == JPH::HeightFieldShapeConstants::cNoCollisionValue ||
+                        h10 == JPH::HeightFieldShapeConstants::cNoCollisionValue ||
+                        h01 == JPH::HeightFieldShapeConstants::cNoCollisionValue)
+                    {
+                        continue;
+                    }
+
+                    const F32 slope = std::max(std::abs(h10 - h00) / spacing.x, std::abs(h01 - h00) / spacing.y);
+                    if (slope > STEEP_SLOPE)
+                    {
+                        materialIndices[to_size(y) * quadsPerEdge + x] = to_U8(to_base(Material::STEEP));
+                    }
+                }
+            }
+
+            const float3& origin = cache.vertex(startX, startY)._position;
+
+            JPH::HeightFieldShapeSettings settings(samples.data(),
+                                                   JPH::Vec3(origin.x, 0.f, origin.z),
+                                                   JPH::Vec3(spacing.x, 1.f, spacing.y),
+                                                   TILE_SAMPLES,
+                                                   materialIndices.data(),
+                                                   materials);
+            settings.mBlockSize = BLOCK_SIZE;
+            settings.mBitsPerSample = settings.CalculateBitsPerSampleForError(MAX_HEIGHT_ERROR);
+
+            const JPH::ShapeSettings::ShapeResult result = settings.Create();
+            if (result.HasError())
+            {
+                Console::errorfn(LOCALE_STR("ERROR_PHYSICS_HEIGHTFIELD_TILE"), tileX, tileY, result.GetError().c_str());
+                return nullptr;
+            }
+
+            return result.Get();
+        }
+
+        [[nodiscard]] JPH::RefConst<JPH::Shape> Load(const ResourcePath& filePath, const CacheKey& key)
+        {
+            std::ifstream file(filePath.fileSystemPath(), std::ios::binary);
+            if (!file.is_open())
+            {
+                return nullptr;
+            }
+
+            JPH::StreamInWrapper stream(file);
+
+            Header header{};
+            stream.Read(header);
+            if (stream.IsFailed() || header._magic != g_heightFieldMagic || header._version != FILE_VERSION || header._key != key)
+            {
+                return nullptr;
+            }
+
+            JPH::Shape::IDToShapeMap shapeMap;
+            JPH::Shape::IDToMaterialMap materialMap;
+            const JPH::Shape::ShapeResult result = JPH::Shape::sRestoreWithChildren(stream, shapeMap, materialMap);
+            if (result.HasError())
+            {
+                return nullptr;
+            }
+
+            return result.Get();
+        }
+
+        [[nodiscard]] bool Save(const ResourcePath& filePath, const std::string_view fileName, const JPH::Shape& shape, const CacheKey& key)
+        {
+            // Serialize in memory first and write the file in one go, so a concurrent or interrupted save never leaves a partial cache behind
+            std::ostringstream data(std::ios::binary);
+            JPH::StreamOutWrapper stream(data);
+
+            const Header header
+            {
+                ._magic = g_heightFieldMagic,
+                ._version = FILE_VERSION,
+                ._key = key
+            };
+            stream.Write(header);
+
+            JPH::Shape::ShapeToIDMap shapeMap;
+            JPH::Shape::MaterialToIDMap materialMap;
+            shape.SaveWithChildren(stream, shapeMap, materialMap);
+            if (stream.IsFailed())
+            {
+                return false;
+            }
+
+            const std::string contents = data.str();
+            return writeFileAtomic(filePath, fileName, contents.data(), contents.size(), FileType::BINARY) == FileError::NONE;
+        }
+    } //namespace
+
+    JPH::RefConst<JPH::Shape> Build(const Terrain& terrain, TaskPool& pool)
+    {
+        const TerrainTileCache& cache = terrain.tileCache();
+        if (cache.empty() || cache.width() < 2u || cache.height() < 2u)
+        {
+            return nullptr;
+        }
+
+        constexpr U32 quadsPerEdge = TILE_SAMPLES - 1u;
+        const U32 tileCountX = (cache.width() - 1u + quadsPerEdge - 1u) / quadsPerEdge;
+        const U32 tileCountY = (cache.height() - 1u + quadsPerEdge - 1u) / quadsPerEdge;
+
+        const float3& first = cache.vertex(0u, 0u)._position;
+        const float2 spacing
+        {
+            cache.vertex(1u, 0u)._position.x - first.x,
+            cache.vertex(0u, 1u)._position.z - first.z
+        };
+
+        const JPH::PhysicsMaterialList materials = CreateMaterials();
+
+        vector<JPH::RefConst<JPH::Shape>> tiles(to_size(tileCountX) * tileCountY);
+
+        ParallelForDescriptor descriptor = {};
+        descriptor._iterCount = to_U32(tiles.size());
+        descriptor._partitionSize = 1u;
+        descriptor._priority = TaskPriority::HIGH;
+        Parallel_For(pool, descriptor, [&](const Task*, const U32 start, const U32 end)
+        {
+            for (U32 i = start; i < end; ++i)
+            {
+                tiles[i] = BuildTile(cache, i % tileCountX, i / tileCountX, spacing, materials);
+            }
+        });
+
+        JPH::StaticCompoundShapeSettings compound;
+        for (const JPH::RefConst<JPH::Shape>& tile : tiles)
+        {
+            if (tile == nullptr)
+            {
+                return nullptr;
+            }
+
+            // Tiles already carry their own offset, so they all sit at the compound's origin
+            compound.AddShape(JPH::Vec3::sZero(), JPH::Quat::sIdentity(), tile);
+        }
+
+        const JPH::ShapeSettings::ShapeResult result = compound.Create();
+        if (result.HasError())
+        {
+            Console::errorfn(LOCALE_STR("ERROR_PHYSICS_HEIGHTFIELD_COMPOUND"), tileCountX, tileCountY, result.GetError().c_str());
+            return nullptr;
+        }
+
+        return result.Get();
+    }
+
+    JPH::RefConst<JPH::Shape> LoadOrBuild(const Terrain& terrain, TaskPool& pool)
+    {
+        const string fileName = terrain.cacheFileName() + ".hf";
+        const ResourcePath filePath = Paths::g_terrainCacheLocation / fileName;
+        const CacheKey key
+        {
+            ._joltVersion = g_joltVersion,
+            ._width = terrain.getDimensions().width,
+            ._height = terrain.getDimensions().height,
+            ._inputHash = terrain.tileCache().inputHash()
+        };
+
+        JPH::RefConst<JPH::Shape> shape = Load(filePath, key);
+        if (shape != nullptr)
+        {
+            return shape;
+        }
+
+        shape = Build(terrain, pool);
+        if (shape != nullptr && !Save(Paths::g_terrainCacheLocation, fileName, *shape, key))
+        {
+            Console::errorfn(LOCALE_STR("ERROR_PHYSICS_HEIGHTFIELD_SAVE"), fileName);
+        }
+
+        return shape;
+    }
+
+} //namespace Divide::JoltHeightField
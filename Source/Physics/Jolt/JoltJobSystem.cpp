@@ -0,0 +1,92 @@
+#include "Headers/JoltJobSystem.h"
+
+#include "Core/Headers/TaskPool.h"
+
+namespace Divide
+{
+    namespace
+    {
+        /// Yields before CreateJob starts sleeping while waiting for a free job slot
+        constexpr U32 g_jobRetrySpinCount = 64u;
+    }
+
+    JoltJobSystem::JoltJobSystem( TaskPool& pool, const JPH::uint maxJobs, const JPH::uint maxBarriers )
+        : JPH::JobSystemWithBarrier( maxBarriers )
+        , _pool( pool )
+        , _maxJobs( maxJobs )
+    {
+        _jobs.Init( maxJobs, maxJobs );
+    }
+
+    int JoltJobSystem::GetMaxConcurrency() const
+    {
+        // Pool workers plus the thread that steps the simulation and helps out while waiting on a barrier
+        return to_I32( _pool.threads().size() ) + 1;
+    }
+
+    JPH::JobSystem::JobHandle JoltJobSystem::CreateJob( const char* inName, const JPH::ColorArg inColor, const JobFunction& inJobFunction, const JPH::uint32 inNumDependencies )
+    {
+        JPH::uint32 index = JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex;
+        U32 retryCount = 0u;
+        while ( (index = _jobs.ConstructObject( inName, inColor, this, inJobFunction, inNumDependencies )) == JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex )
+        {
+            // Out of job slots. That is back-pressure, not an error: help the pool retire some work so older jobs get freed
+            if ( !_exhaustionReported.exchange( true ) )
+            {
+                Console::warnfn( LOCALE_STR( "WARN_PHYSICS_JOB_POOL_EXHAUSTED" ), _maxJobs );
+            }
+
+            if ( !_pool.threadWaiting() )
+            {
+                // Nothing to help with, so the slots are held by running jobs. Spin briefly, then stop competing with them for a core
+                if ( ++retryCount < g_jobRetrySpinCount )
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+                }
+            }
+        }
+
+        Job* job = &_jobs.Get( index );
+
+        // Grab the handle before queueing: the job may run and complete right away
+        JobHandle handle( job );
+        if ( inNumDependencies == 0u )
+        {
+            QueueJob( job );
+        }
+
+        return handle;
+    }
+
+    void JoltJobSystem::QueueJob( Job* inJob )
+    {
+        // The queued task holds a reference until it has run
+        inJob->AddRef();
+
+        Task* task = CreateTask( [inJob]( const Task& )
+        {
+            inJob->Execute();
+            inJob->Release();
+        });
+
+        _pool.enqueue( *task, TaskPriority::HIGH );
+    }
+
+    void JoltJobSystem::QueueJobs( Job** inJobs, const JPH::uint inNumJobs )
+    {
+        for ( JPH::uint i = 0u; i < inNumJobs; ++i )
+        {
+            QueueJob( inJobs[i] );
+        }
+    }
+
+    void JoltJobSystem::FreeJob( Job* inJob )
+    {
+        _jobs.DestructObject( inJob );
+    }
+
+};
@@ -0,0 +1,136 @@
+
+
+#include "Headers/JoltQueries.h"
+
+#include "Core/Math/Headers/Ray.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingSphere.h"
+
+JPH_SUPPRESS_WARNING_PUSH
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+JPH_SUPPRESS_WARNING_POP
+
+namespace Divide::JoltQueries
+{
+    namespace
+    {
+        /// Sort by distance and keep only the closest hit per body (a body can be hit once per sub shape)
+        void SortAndRemoveDuplicates(vector<QueryHit>& hits)
+        {
+            eastl::sort(hits.begin(), hits.end(), [](const QueryHit& lhs, const QueryHit& rhs) noexcept
+            {
+                return lhs._bodyID == rhs._bodyID ? lhs._distance < rhs._distance : lhs._bodyID < rhs._bodyID;
+            });
+
+            hits.erase(eastl::unique(hits.begin(), hits.end(), [](const QueryHit& lhs, const QueryHit& rhs) noexcept
+            {
+                return lhs._bodyID == rhs._bodyID;
+            }), hits.end());
+
+            eastl::sort(hits.begin(), hits.end(), [](const QueryHit& lhs, const QueryHit& rhs) noexcept
+            {
+                return lhs._distance < rhs._distance;
+            });
+        }
+    } //namespace
+
+    bool CastRay(const JPH::PhysicsSystem& system, const Ray& ray, const float2 range, vector<QueryHit>& hitsOut)
+    {
+        hitsOut.resize(0);
+
+        const F32 length = range.max - range.min;
+        if (length <= 0.f)
+        {
+            return false;
+        }
+
+        const JPH::Vec3 direction(ray._direction.x, ray._direction.y, ray._direction.z);
+        const JPH::Vec3 origin = JPH::Vec3(ray._origin.x, ray._origin.y, ray._origin.z) + direction * range.min;
+
+        const JPH::RRayCast rayCast{ origin, direction * length };
+
+        JPH::RayCastSettings settings{};
+        settings.mTreatConvexAsSolid = true;
+
+        JPH::AllHitCollisionCollector<JPH::CastRayCollector> collector;
+        system.GetNarrowPhaseQuery().CastRay(rayCast, settings, collector);
+        if (!collector.HadHit())
+        {
+            return false;
+        }
+
+        hitsOut.reserve(collector.mHits.size());
+        for (const JPH::RayCastResult& hit : collector.mHits)
+        {
+            hitsOut.push_back({ hit.mBodyID, range.min + hit.mFraction * length, hit.mFraction <= 0.f });
+        }
+        SortAndRemoveDuplicates(hitsOut);
+
+        return true;
+    }
+
+    bool OverlapSphere(const JPH::PhysicsSystem& system, const BoundingSphere& sphere, vector<QueryHit>& hitsOut)
+    {
+        hitsOut.resize(0);
+
+        const F32 radius = sphere._sphere.w;
+        if (radius <= 0.f)
+        {
+            return false;
+        }
+
+        JPH::SphereShape shape(radius);
+        // Lives on the stack, so keep the reference counting from ever trying to free it
+        shape.SetEmbedded();
+        const JPH::RMat44 transform = JPH::RMat44::sTranslation(JPH::RVec3(sphere._sphere.x, sphere._sphere.y, sphere._sphere.z));
+
+        JPH::AllHitCollisionCollector<JPH::CollideShapeCollector> collector;
+        system.GetNarrowPhaseQuery().CollideShape(&shape, JPH::Vec3::sReplicate(1.f), transform, JPH::CollideShapeSettings{}, JPH::RVec3::sZero(), collector);
+        if (!collector.HadHit())
+        {
+            return false;
+        }
+
+        hitsOut.reserve(collector.mHits.size());
+        for (const JPH::CollideShapeResult& hit : collector.mHits)
+        {
+            // Penetration depth is measured from the sphere's surface, so radius - depth is how far the closest surface point is from the centre
+            hitsOut.push_back({ hit.mBodyID2, std::max(radius - hit.mPenetrationDepth, 0.f), hit.mPenetrationDepth >= radius });
+        }
+        SortAndRemoveDuplicates(hitsOut);
+
+        return true;
+    }
+
+    bool OverlapBox(const JPH::PhysicsSystem& system, const BoundingBox& box, vector<QueryHit>& hitsOut)
+    {
+        hitsOut.resize(0);
+
+        const float3 centre = box.getCenter();
+        const float3 halfExtent = box.getHalfExtent();
+        const JPH::Vec3 joltCentre(centre.x, centre.y, centre.z);
+        const JPH::Vec3 joltHalfExtent(halfExtent.x, halfExtent.y, halfExtent.z);
+        const JPH::AABox aabb(joltCentre - joltHalfExtent, joltCentre + joltHalfExtent);
+
+        JPH::AllHitCollisionCollector<JPH::CollideShapeBodyCollector> collector;
+        system.GetBroadPhaseQuery().CollideAABox(aabb, collector);
+        if (!collector.HadHit())
+        {
+            return false;
+        }
+
+        hitsOut.reserve(collector.mHits.size());
+        for (const JPH::BodyID& bodyID : collector.mHits)
+        {
+            hitsOut.push_back({ bodyID, 0.f, true });
+        }
+
+        return true;
+    }
+
+} //namespace Divide::JoltQueries
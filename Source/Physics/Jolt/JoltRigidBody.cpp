@@ -0,0 +1,264 @@
+
+
+#include "Headers/JoltRigidBody.h"
+#include "Headers/Jolt.h"
+
+#include "Graphs/Headers/SceneGraphNode.h"
+#include "ECS/Components/Headers/RigidBodyComponent.h"
+#include "ECS/Components/Headers/TransformComponent.h"
+
+namespace Divide
+{
+
+JoltRigidBody::JoltRigidBody(RigidBodyComponent& parent, PhysicsJolt& api, const JPH::BodyID bodyID, const RigidBodyShape shape, const TransformValues& initialValues)
+    : PhysicsAsset(parent)
+    , _bodyID(bodyID)
+    , _shapeType(shape)
+    , _api(api)
+{
+    _transform.setValues(initialValues);
+}
+
+JoltRigidBody::~JoltRigidBody()
+{
+    _api.destroyBody(*this);
+}
+
+void JoltRigidBody::physicsCollisionGroup(const PhysicsGroup group)
+{
+    if (!_api.convertActor(this, group))
+    {
+        DIVIDE_UNEXPECTED_CALL();
+    }
+}
+
+void JoltRigidBody::onSimulationPose(const float3& position, const quatf& orientation)
+{
+    _transform.setPosition(position);
+    _transform.setRotation(orientation);
+
+    const SceneGraphNode* sgn = _parentComponent.parentSGN();
+    TransformComponent* tComp = sgn->get<TransformComponent>();
+    if (tComp == nullptr)
+    {
+        return;
+    }
+
+    // The simulation pose is in world space but the transform component stores values relative to the node's parent (e.g. submeshes).
+    // Ignore the root node, as its transform should be identity anyway
+    const SceneGraphNode* parent = sgn->parent();
+    if (parent != nullptr && parent->parent() != nullptr && parent->HasComponents(ComponentType::TRANSFORM))
+    {
+        const TransformComponent* parentTComp = parent->get<TransformComponent>();
+        const quatf parentOrientationInv = parentTComp->getWorldOrientation().inverse();
+
+        tComp->setPosition(Rotate(position - parentTComp->getWorldPosition(), parentOrientationInv) / parentTComp->getWorldScale());
+        tComp->setRotation(parentOrientationInv * orientation);
+    }
+    else
+    {
+        tComp->setPosition(position);
+        tComp->setRotation(orientation);
+    }
+}
+
+void JoltRigidBody::syncPose() noexcept
+{
+    _api.setBodyPose(_bodyID, _transform._translation, _transform._orientation);
+}
+
+void JoltRigidBody::syncShape() noexcept
+{
+    _api.updateBodyShape(*this, _transform._scale);
+}
+
+void JoltRigidBody::setPosition(const float3& position) noexcept
+{
+    _transform.setPosition(position);
+    syncPose();
+}
+
+void JoltRigidBody::setPosition(const F32 x, const F32 y, const F32 z) noexcept
+{
+    _transform.setPosition(x, y, z);
+    syncPose();
+}
+
+void JoltRigidBody::setPositionX(const F32 positionX) noexcept
+{
+    _transform.setPositionX(positionX);
+    syncPose();
+}
+
+void JoltRigidBody::setPositionY(const F32 positionY) noexcept
+{
+    _transform.setPositionY(positionY);
+    syncPose();
+}
+
+void JoltRigidBody::setPositionZ(const F32 positionZ) noexcept
+{
+    _transform.setPositionZ(positionZ);
+    syncPose();
+}
+
+void JoltRigidBody::translate(const float3& axisFactors) noexcept
+{
+    _transform.translate(axisFactors);
+    syncPose();
+}
+
+void JoltRigidBody::setScale(const F32 amount) noexcept
+{
+    _transform.setScale(amount);
+    syncShape();
+}
+
+void JoltRigidBody::setScale(const float3& amount) noexcept
+{
+    _transform.setScale(amount);
+    syncShape();
+}
+
+void JoltRigidBody::setScale(const F32 X, const F32 Y, const F32 Z) noexcept
+{
+    _transform.setScale(X, Y, Z);
+    syncShape();
+}
+
+void JoltRigidBody::setScaleX(const F32 amount) noexcept
+{
+    _transform.setScaleX(amount);
+    syncShape();
+}
+
+void JoltRigidBody::setScaleY(const F32 amount) noexcept
+{
+    _transform.setScaleY(amount);
+    syncShape();
+}
+
+void JoltRigidBody::setScaleZ(const F32 amount) noexcept
+{
+    _transform.setScaleZ(amount);
+    syncShape();
+}
+
+void JoltRigidBody::scale(const float3& axisFactors) noexcept
+{
+    _transform.scale(axisFactors);
+    syncShape();
+}
+
+void JoltRigidBody::scaleX(const F32 amount) noexcept
+{
+    _transform.scaleX(amount);
+    syncShape();
+}
+
+void JoltRigidBody::scaleY(const F32 amount) noexcept
+{
+    _transform.scaleY(amount);
+    syncShape();
+}
+
+void JoltRigidBody::scaleZ(const F32 amount) noexcept
+{
+    _transform.scaleZ(amount);
+    syncShape();
+}
+
+void JoltRigidBody::setRotation(const float3& axis, const Angle::DEGREES_F degrees) noexcept
+{
+    _transform.setRotation(axis, degrees);
+    syncPose();
+}
+
+void JoltRigidBody::setRotation(const Angle::DEGREES_F pitch, const Angle::DEGREES_F yaw, const Angle::DEGREES_F roll) noexcept
+{
+    _transform.setRotation(pitch, yaw, roll);
+    syncPose();
+}
+
+void JoltRigidBody::setRotation(const quatf& quat) noexcept
+{
+    _transform.setRotation(quat);
+    syncPose();
+}
+
+void JoltRigidBody::setRotationX(const Angle::DEGREES_F angle) noexcept
+{
+    _transform.setRotationX(angle);
+    syncPose();
+}
+
+void JoltRigidBody::setRotationY(const Angle::DEGREES_F angle) noexcept
+{
+    _transform.setRotationY(angle);
+    syncPose();
+}
+
+void JoltRigidBody::setRotationZ(const Angle::DEGREES_F angle) noexcept
+{
+    _transform.setRotationZ(angle);
+    syncPose();
+}
+
+void JoltRigidBody::rotate(const float3& axis, const Angle::DEGREES_F degrees) noexcept
+{
+    _transform.rotate(axis, degrees);
+    syncPose();
+}
+
+void JoltRigidBody::rotate(const Angle::DEGREES_F pitch, const Angle::DEGREES_F yaw, const Angle::DEGREES_F roll) noexcept
+{
+    _transform.rotate(pitch, yaw, roll);
+    syncPose();
+}
+
+void JoltRigidBody::rotate(const quatf& quat) noexcept
+{
+    _transform.rotate(quat);
+    syncPose();
+}
+
+void JoltRigidBody::rotateSlerp(const quatf& quat, const D64 deltaTime)
+{
+    _transform.rotateSlerp(quat, deltaTime);
+    syncPose();
+}
+
+void JoltRigidBody::rotateX(const Angle::DEGREES_F angle) noexcept
+{
+    _transform.rotateX(angle);
+    syncPose();
+}
+
+void JoltRigidBody::rotateY(const Angle::DEGREES_F angle) noexcept
+{
+    _transform.rotateY(angle);
+    syncPose();
+}
+
+void JoltRigidBody::rotateZ(const Angle::DEGREES_F angle) noexcept
+{
+    _transform.rotateZ(angle);
+    syncPose();
+}
+
+void JoltRigidBody::getScale(float3& scaleOut) const noexcept
+{
+    _transform.getScale(scaleOut);
+}
+
+void JoltRigidBody::getPosition(float3& posOut) const noexcept
+{
+    _transform.getPosition(posOut);
+}
+
+void JoltRigidBody::getOrientation(quatf& quatOut) const noexcept
+{
+    _transform.getOrientation(quatOut);
+}
+
+} // namespace Divide
@@ -59,6 +59,9 @@ namespace Divide {
         [[nodiscard]] bool destroyPhysicsScene(const Scene& scene) override;
 
         [[nodiscard]] bool intersect(const Ray& intersectionRay, float2 range, vector<SGNRayResult>& intersectionsOut) const override;
+        [[nodiscard]] bool intersect(std::span<const Ray> rays, float2 range, std::span<vector<SGNRayResult>> intersectionsOut) const override;
+        [[nodiscard]] bool overlap(const BoundingSphere& sphere, vector<SGNRayResult>& intersectionsOut) const override;
+        [[nodiscard]] bool overlap(const BoundingBox& box, vector<SGNRayResult>& intersectionsOut) const override;
 
         [[nodiscard]] PhysicsAsset* createRigidActor(SceneGraphNode* node, RigidBodyComponent& parentComp) override;
 
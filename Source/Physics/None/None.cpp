@@ -56,4 +56,19 @@ namespace Divide
         return false;
     }
 
+    bool PhysicsNone::intersect([[maybe_unused]] const std::span<const Ray> rays, [[maybe_unused]] const float2 range, [[maybe_unused]] const std::span<vector<SGNRayResult>> intersectionsOut) const
+    {
+        return false;
+    }
+
+    bool PhysicsNone::overlap([[maybe_unused]] const BoundingSphere& sphere, [[maybe_unused]] vector<SGNRayResult>& intersectionsOut) const
+    {
+        return false;
+    }
+
+    bool PhysicsNone::overlap([[maybe_unused]] const BoundingBox& box, [[maybe_unused]] vector<SGNRayResult>& intersectionsOut) const
+    {
+        return false;
+    }
+
 };
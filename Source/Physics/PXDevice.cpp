@@ -137,4 +137,22 @@ namespace Divide
         PROFILE_SCOPE_AUTO( Profiler::Category::Physics );
         return _api->intersect( intersectionRay, range, intersectionsOut );
     }
+
+    bool PXDevice::intersect( const std::span<const Ray> rays, const float2 range, const std::span<vector<SGNRayResult>> intersectionsOut ) const
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Physics );
+        return _api->intersect( rays, range, intersectionsOut );
+    }
+
+    bool PXDevice::overlap( const BoundingSphere& sphere, vector<SGNRayResult>& intersectionsOut ) const
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Physics );
+        return _api->overlap( sphere, intersectionsOut );
+    }
+
+    bool PXDevice::overlap( const BoundingBox& box, vector<SGNRayResult>& intersectionsOut ) const
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Physics );
+        return _api->overlap( box, intersectionsOut );
+    }
 } //namespace Divide
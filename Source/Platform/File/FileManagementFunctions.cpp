@@ -122,6 +122,27 @@ FileError writeFile(const ResourcePath& filePath, const std::string_view fileNam
     return FileError::FILE_NOT_FOUND;
 }
 
+FileError writeFileAtomic(const ResourcePath& filePath, const std::string_view fileName, const char* content, const size_t length, const FileType fileType)
+{
+    // Unique per thread and call, so concurrent writers never share a temp file
+    size_t seed = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    Util::Hash_combine(seed, std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    const string tempFileName = Util::StringFormat("{}.{:x}.tmp", fileName, seed);
+
+    FileError ret = writeFile(filePath, tempFileName, content, length, fileType);
+    if (ret == FileError::NONE)
+    {
+        ret = moveFile(filePath, tempFileName, filePath, fileName);
+    }
+
+    if (ret != FileError::NONE)
+    {
+        DIVIDE_UNUSED(deleteFile(filePath, tempFileName));
+    }
+
+    return ret;
+}
+
 string stripQuotes( const std::string_view input)
 {
 
@@ -208,6 +208,8 @@ using FileList = vector<FileEntry>;
 
 [[nodiscard]] FileError writeFile(const ResourcePath& filePath, std::string_view fileName, bufferPtr content, size_t length, FileType fileType);
 [[nodiscard]] FileError writeFile(const ResourcePath& filePath, std::string_view fileName, const char* content, size_t length, FileType fileType);
+/// Writes to a temporary file next to the target and renames it into place once complete, so readers never see a partially written file
+[[nodiscard]] FileError writeFileAtomic(const ResourcePath& filePath, std::string_view fileName, const char* content, size_t length, FileType fileType);
 
 [[nodiscard]] FileError deleteFile(const ResourcePath& filePath, std::string_view fileName);
 
@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_PLATFORM_FILE_MEMORY_MAPPED_FILE_H_
+#define DVD_PLATFORM_FILE_MEMORY_MAPPED_FILE_H_
+
+#include "FileManagement.h"
+
+namespace Divide {
+
+/// Read-only view of an entire file mapped into the address space. Pages are faulted in by the OS on first access.
+class MemoryMappedFile final : NonCopyable
+{
+  public:
+    MemoryMappedFile() noexcept = default;
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    [[nodiscard]] FileError open(const ResourcePath& filePath, std::string_view fileName);
+    void close() noexcept;
+
+    /// Hint the OS that the [offset, offset + length) range will be read soon
+    void prefetch(size_t offset, size_t length) const noexcept;
+    /// Allow the OS to drop the [offset, offset + length) range from the resident set. It faults back in from disk on the next read
+    void evict(size_t offset, size_t length) const noexcept;
+
+    [[nodiscard]] const Byte* data() const noexcept { return _data; }
+    [[nodiscard]] size_t      size() const noexcept { return _size; }
+    [[nodiscard]] bool        isOpen() const noexcept { return _data != nullptr; }
+
+    [[nodiscard]] static size_t PageSize() noexcept;
+
+  private:
+    const Byte* _data = nullptr;
+    size_t _size = 0u;
+};
+
+}; //namespace Divide
+
+#endif //DVD_PLATFORM_FILE_MEMORY_MAPPED_FILE_H_
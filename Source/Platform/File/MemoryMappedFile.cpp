@@ -0,0 +1,222 @@
+
+
+#include "Headers/MemoryMappedFile.h"
+#include "Headers/ResourcePath.h"
+
+#if !defined(IS_WINDOWS_BUILD)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif //!IS_WINDOWS_BUILD
+
+namespace Divide {
+
+namespace
+{
+    /// Expand [offset, offset + length) outwards to whole pages and clamp it to the mapped range
+    [[nodiscard]] bool PageRange(const size_t fileSize, const size_t offset, const size_t length, size_t& startOut, size_t& lengthOut) noexcept
+    {
+        if (offset >= fileSize || length == 0u)
+        {
+            return false;
+        }
+
+        const size_t pageSize = MemoryMappedFile::PageSize();
+        const size_t end = std::min(fileSize, offset + length);
+        startOut = offset - (offset % pageSize);
+        lengthOut = end - startOut;
+        return true;
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    : _data(other._data)
+    , _size(other._size)
+{
+    other._data = nullptr;
+    other._size = 0u;
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+
+    return *this;
+}
+
+#if defined(IS_WINDOWS_BUILD)
+
+size_t MemoryMappedFile::PageSize() noexcept
+{
+    static const size_t s_pageSize = []()
+    {
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+        return to_size(info.dwPageSize);
+    }();
+
+    return s_pageSize;
+}
+
+FileError MemoryMappedFile::open(const ResourcePath& filePath, const std::string_view fileName)
+{
+    close();
+
+    if (!fileExists(filePath, fileName))
+    {
+        return FileError::FILE_NOT_FOUND;
+    }
+
+    const HANDLE file = CreateFileW((filePath / fileName).fileSystemPath().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return FileError::FILE_OPEN_ERROR;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return FileError::FILE_EMPTY;
+    }
+
+    // The view keeps the mapping (and the file) alive, so both handles can be released as soon as it exists
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        return FileError::FILE_READ_ERROR;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr)
+    {
+        return FileError::FILE_READ_ERROR;
+    }
+
+    _data = static_cast<const Byte*>(view);
+    _size = to_size(fileSize.QuadPart);
+    return FileError::NONE;
+}
+
+void MemoryMappedFile::close() noexcept
+{
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+        _size = 0u;
+    }
+}
+
+void MemoryMappedFile::prefetch(const size_t offset, const size_t length) const noexcept
+{
+    size_t start = 0u, rangeLength = 0u;
+    if (PageRange(_size, offset, length, start, rangeLength))
+    {
+        WIN32_MEMORY_RANGE_ENTRY range{};
+        range.VirtualAddress = const_cast<Byte*>(_data + start);
+        range.NumberOfBytes = rangeLength;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+}
+
+void MemoryMappedFile::evict(const size_t offset, const size_t length) const noexcept
+{
+    size_t start = 0u, rangeLength = 0u;
+    if (PageRange(_size, offset, length, start, rangeLength))
+    {
+        // Unlocking pages that were never locked removes them from the working set
+        VirtualUnlock(const_cast<Byte*>(_data + start), rangeLength);
+    }
+}
+
+#else //IS_WINDOWS_BUILD
+
+size_t MemoryMappedFile::PageSize() noexcept
+{
+    static const size_t s_pageSize = to_size(sysconf(_SC_PAGESIZE));
+    return s_pageSize;
+}
+
+FileError MemoryMappedFile::open(const ResourcePath& filePath, const std::string_view fileName)
+{
+    close();
+
+    if (!fileExists(filePath, fileName))
+    {
+        return FileError::FILE_NOT_FOUND;
+    }
+
+    const int fd = ::open((filePath / fileName).fileSystemPath().c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return FileError::FILE_OPEN_ERROR;
+    }
+
+    struct stat fileInfo{};
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0)
+    {
+        ::close(fd);
+        return FileError::FILE_EMPTY;
+    }
+
+    // The mapping holds its own reference to the file, so the descriptor is not needed past this point
+    void* view = mmap(nullptr, to_size(fileInfo.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        return FileError::FILE_READ_ERROR;
+    }
+
+    madvise(view, to_size(fileInfo.st_size), MADV_RANDOM);
+
+    _data = static_cast<const Byte*>(view);
+    _size = to_size(fileInfo.st_size);
+    return FileError::NONE;
+}
+
+void MemoryMappedFile::close() noexcept
+{
+    if (_data != nullptr)
+    {
+        munmap(const_cast<Byte*>(_data), _size);
+        _data = nullptr;
+        _size = 0u;
+    }
+}
+
+void MemoryMappedFile::prefetch(const size_t offset, const size_t length) const noexcept
+{
+    size_t start = 0u, rangeLength = 0u;
+    if (PageRange(_size, offset, length, start, rangeLength))
+    {
+        madvise(const_cast<Byte*>(_data + start), rangeLength, MADV_WILLNEED);
+    }
+}
+
+void MemoryMappedFile::evict(const size_t offset, const size_t length) const noexcept
+{
+    size_t start = 0u, rangeLength = 0u;
+    if (PageRange(_size, offset, length, start, rangeLength))
+    {
+        // Read-only shared file mapping: dropped pages are simply re-read from the file on the next access
+        madvise(const_cast<Byte*>(_data + start), rangeLength, MADV_DONTNEED);
+    }
+}
+
+#endif //IS_WINDOWS_BUILD
+
+}; //namespace Divide
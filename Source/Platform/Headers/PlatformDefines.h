@@ -197,6 +197,25 @@ constexpr U64 prime_64_const = 0x100000001b3;
     return _ID_VIEW(str, len);
 }
 
+namespace Util
+{
+    /// FNV-1a over a whole buffer (file contents, shader source, etc). _ID() is meant for short, compile-time strings
+    [[nodiscard]] constexpr U64 ContentHash(const std::span<const Byte> content, U64 value = val_64_const) noexcept
+    {
+        for (const Byte b : content)
+        {
+            value = (value ^ static_cast<U64>(b)) * prime_64_const;
+        }
+
+        return value;
+    }
+
+    [[nodiscard]] inline U64 ContentHash(const std::string_view content, const U64 value = val_64_const) noexcept
+    {
+        return ContentHash(std::as_bytes(std::span<const char>(content.data(), content.size())), value);
+    }
+} //namespace Util
+
 struct SysInfo
 {
     size_t _availableRamInBytes{0u};
@@ -44,6 +44,7 @@ namespace GFX {
 } //namespace GFX
 
 class ByteBuffer;
+class TaskPool;
 /// Vertex Buffer interface class to allow API-independent implementation of data
 /// This class does NOT represent an API-level VB, such as: GL_ARRAY_BUFFER / D3DVERTEXBUFFER
 /// It is only a "buffer" for "vertex info" abstract of implementation. (e.g.: OGL uses a vertex array object for this)
@@ -88,6 +89,9 @@ class VertexBuffer final : public GUIDWrapper, public GraphicsResource
 
     [[nodiscard]] const vector<Vertex>& getVertices() const noexcept;
 
+    /// Replaces all of the vertex data in one go. usedAttributes flags the members of Vertex that were filled in
+    void setVertices(vector<Vertex>&& vertices, const AttributeFlags& usedAttributes);
+
     [[nodiscard]] const float3& getPosition(const U32 index) const;
 
     [[nodiscard]]  float2       getTexCoord(const U32 index) const;
@@ -134,10 +138,16 @@ class VertexBuffer final : public GUIDWrapper, public GraphicsResource
 
     void modifyNormalValue(const U32 index, const F32 x, const F32 y, const F32 z);
 
+    /// Stores a normal that was already packed via Util::PACK_VEC3
+    void modifyPackedNormalValue(const U32 index, const F32 packedValue);
+
     void modifyTangentValue(const U32 index, const float3& newValue);
 
     void modifyTangentValue(const U32 index, const F32 x, const F32 y, const F32 z);
 
+    /// Stores a tangent that was already packed via Util::PACK_VEC3
+    void modifyPackedTangentValue(const U32 index, const F32 packedValue);
+
     void modifyTexCoordValue(const U32 index, float2 newValue);
 
     void modifyTexCoordValue(const U32 index, const F32 s, const F32 t);
@@ -166,6 +176,10 @@ class VertexBuffer final : public GUIDWrapper, public GraphicsResource
     bool deserialize(ByteBuffer& dataIn);
     bool serialize(ByteBuffer& dataOut) const;
 
+    /// The index and vertex part of the serialized data (block compressed). Needs no device, so tools and tests can use it directly
+    static void SerializeGeometry(TaskPool& pool, const vector<Vertex>& vertices, const vector<U32>& indices, ByteBuffer& dataOut);
+    [[nodiscard]] static bool DeserializeGeometry(TaskPool& pool, ByteBuffer& dataIn, vector<Vertex>& verticesOut, vector<U32>& indicesOut);
+
     void computeNormals();
     void computeTangents();
 
@@ -3,14 +3,18 @@
 #include "Headers/VertexBuffer.h"
 
 #include "Core/Headers/ByteBuffer.h"
+#include "Core/Headers/PlatformContext.h"
 #include "Platform/Headers/PlatformRuntime.h"
 #include "Platform/Video/Headers/GFXDevice.h"
 #include "Platform/Video/Headers/LockManager.h"
 #include "Utility/Headers/Localization.h"
 
+#include <meshoptimizer.h>
+#include <zlib.h>
+
 namespace Divide {
 
-constexpr U16 BYTE_BUFFER_VERSION = 2u;
+constexpr U16 BYTE_BUFFER_VERSION = 4u;
 
 namespace {
 // Once vertex buffers reach a certain size, the for loop grows really really fast up to millions of iterations.
@@ -122,6 +126,241 @@ void FillSmallData(const vector<VertexBuffer::Vertex>& dataIn, Byte* dataOut, co
     }
 }
 
+// The cache stores vertices and indices with meshoptimizer's codecs, split in fixed size blocks that can be encoded/decoded independently.
+// The codecs' output is meant to be followed by a general purpose compressor, so each block is also deflated (fastest setting) when that makes it smaller.
+// Layout: element count, block count, stored and encoded size of every block, then all of the stored payloads back to back.
+// A block whose stored size is smaller than its encoded size is deflated
+constexpr U32 VERTEX_CODEC_BLOCK_SIZE = 1u << 16u;
+constexpr U32 INDEX_CODEC_BLOCK_SIZE = 1u << 18u;
+
+static_assert(sizeof(VertexBuffer::Vertex) % 4 == 0u && sizeof(VertexBuffer::Vertex) <= 256u, "meshopt vertex codec requirement");
+
+[[nodiscard]] U32 CodecBlockCount(const size_t elementCount, const U32 blockSize)
+{
+    return to_U32((elementCount + blockSize - 1u) / blockSize);
+}
+
+/// Replaces the encoded block with its deflated version if that is smaller. Returns the encoded size
+U32 DeflateBlock(vector<Byte>& block)
+{
+    const U32 encodedSize = to_U32(block.size());
+
+    uLongf deflatedSize = compressBound(encodedSize);
+    vector<Byte> deflated(deflatedSize);
+    if (compress2(reinterpret_cast<Bytef*>(deflated.data()), &deflatedSize, reinterpret_cast<const Bytef*>(block.data()), encodedSize, Z_BEST_SPEED) == Z_OK && deflatedSize < encodedSize)
+    {
+        deflated.resize(deflatedSize);
+        block = MOV(deflated);
+    }
+
+    return encodedSize;
+}
+
+/// Returns the codec input for a stored block, inflating it into scratch first if it was deflated. Returns nullptr on corrupt data
+[[nodiscard]] const unsigned char* InflateBlock(const Byte* stored, const size_t storedSize, const U32 encodedSize, vector<Byte>& scratch)
+{
+    if (storedSize == encodedSize)
+    {
+        return reinterpret_cast<const unsigned char*>(stored);
+    }
+
+    scratch.resize(encodedSize);
+    uLongf inflatedSize = encodedSize;
+    if (storedSize > encodedSize ||
+        uncompress(reinterpret_cast<Bytef*>(scratch.data()), &inflatedSize, reinterpret_cast<const Bytef*>(stored), to_U32(storedSize)) != Z_OK ||
+        inflatedSize != encodedSize)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const unsigned char*>(scratch.data());
+}
+
+void WriteCodecBlocks(const size_t elementCount, const vector<vector<Byte>>& blocks, const vector<U32>& encodedSizes, ByteBuffer& dataOut)
+{
+    dataOut << to_U32(elementCount);
+    dataOut << to_U32(blocks.size());
+    for (size_t i = 0u; i < blocks.size(); ++i)
+    {
+        dataOut << to_U32(blocks[i].size());
+        dataOut << encodedSizes[i];
+    }
+    for (const vector<Byte>& block : blocks)
+    {
+        dataOut.append(block.data(), block.size());
+    }
+}
+
+/// Reads the block table and returns the start of the payloads. blockOffsetsOut[i] is the offset of stored block i (with an extra entry for the end)
+[[nodiscard]] const Byte* ReadCodecBlocks(ByteBuffer& dataIn, U32& elementCountOut, vector<size_t>& blockOffsetsOut, vector<U32>& encodedSizesOut)
+{
+    U32 blockCount = 0u;
+    dataIn >> elementCountOut;
+    dataIn >> blockCount;
+
+    blockOffsetsOut.resize(blockCount + 1u, 0u);
+    encodedSizesOut.resize(blockCount, 0u);
+    for (U32 i = 0u; i < blockCount; ++i)
+    {
+        U32 blockSize = 0u;
+        dataIn >> blockSize;
+        dataIn >> encodedSizesOut[i];
+        blockOffsetsOut[i + 1u] = blockOffsetsOut[i] + blockSize;
+    }
+
+    if (dataIn.bufferSize() - dataIn.rpos() < blockOffsetsOut.back())
+    {
+        return nullptr;
+    }
+
+    const Byte* payload = dataIn.contents() + dataIn.rpos();
+    dataIn.readSkip(blockOffsetsOut.back());
+    return payload;
+}
+
+void EncodeVertices(TaskPool& pool, const vector<VertexBuffer::Vertex>& vertices, ByteBuffer& dataOut)
+{
+    vector<vector<Byte>> blocks(CodecBlockCount(vertices.size(), VERTEX_CODEC_BLOCK_SIZE));
+    vector<U32> encodedSizes(blocks.size(), 0u);
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = to_U32(blocks.size());
+    descriptor._partitionSize = 1u;
+
+    Parallel_For(pool, descriptor, [&](const Task*, const U32 start, const U32 end)
+    {
+        for (U32 i = start; i < end; ++i)
+        {
+            const size_t first = to_size(i) * VERTEX_CODEC_BLOCK_SIZE;
+            const size_t count = std::min(to_size(VERTEX_CODEC_BLOCK_SIZE), vertices.size() - first);
+
+            vector<Byte>& block = blocks[i];
+            block.resize(meshopt_encodeVertexBufferBound(count, sizeof(VertexBuffer::Vertex)));
+            block.resize(meshopt_encodeVertexBuffer(reinterpret_cast<unsigned char*>(block.data()), block.size(), &vertices[first], count, sizeof(VertexBuffer::Vertex)));
+            encodedSizes[i] = DeflateBlock(block);
+        }
+    });
+
+    WriteCodecBlocks(vertices.size(), blocks, encodedSizes, dataOut);
+}
+
+[[nodiscard]] bool DecodeVertices(TaskPool& pool, ByteBuffer& dataIn, vector<VertexBuffer::Vertex>& verticesOut)
+{
+    U32 vertexCount = 0u;
+    vector<size_t> offsets;
+    vector<U32> encodedSizes;
+    const Byte* payload = ReadCodecBlocks(dataIn, vertexCount, offsets, encodedSizes);
+    if (payload == nullptr || offsets.size() - 1u != CodecBlockCount(vertexCount, VERTEX_CODEC_BLOCK_SIZE))
+    {
+        return false;
+    }
+
+    verticesOut.resize(vertexCount);
+
+    std::atomic_bool success{ true };
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = to_U32(offsets.size() - 1u);
+    descriptor._partitionSize = 1u;
+
+    Parallel_For(pool, descriptor, [&](const Task*, const U32 start, const U32 end)
+    {
+        for (U32 i = start; i < end; ++i)
+        {
+            const size_t first = to_size(i) * VERTEX_CODEC_BLOCK_SIZE;
+            const size_t count = std::min(to_size(VERTEX_CODEC_BLOCK_SIZE), verticesOut.size() - first);
+
+            vector<Byte> scratch;
+            const unsigned char* encoded = InflateBlock(payload + offsets[i], offsets[i + 1u] - offsets[i], encodedSizes[i], scratch);
+            if (encoded == nullptr || meshopt_decodeVertexBuffer(&verticesOut[first], count, sizeof(VertexBuffer::Vertex), encoded, encodedSizes[i]) != 0)
+            {
+                success.store(false);
+            }
+        }
+    });
+
+    return success.load();
+}
+
+/// Uses the index sequence codec: the buffer doesn't know its topology (strips, lines and primitive restarts are all valid here) and the
+/// triangle codec may rotate triangles, while this one gives back the exact same indices. Returns false (and writes nothing) if the indices can't be encoded
+[[nodiscard]] bool EncodeIndices(TaskPool& pool, const vector<U32>& indices, ByteBuffer& dataOut)
+{
+    vector<vector<Byte>> blocks(CodecBlockCount(indices.size(), INDEX_CODEC_BLOCK_SIZE));
+    vector<U32> encodedSizes(blocks.size(), 0u);
+    std::atomic_bool success{ true };
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = to_U32(blocks.size());
+    descriptor._partitionSize = 1u;
+
+    Parallel_For(pool, descriptor, [&](const Task*, const U32 start, const U32 end)
+    {
+        for (U32 i = start; i < end; ++i)
+        {
+            const size_t first = to_size(i) * INDEX_CODEC_BLOCK_SIZE;
+            const size_t count = std::min(to_size(INDEX_CODEC_BLOCK_SIZE), indices.size() - first);
+            const U32 maxIndex = *std::max_element(begin(indices) + first, begin(indices) + first + count);
+
+            vector<Byte>& block = blocks[i];
+            block.resize(meshopt_encodeIndexSequenceBound(count, to_size(maxIndex) + 1u));
+            block.resize(meshopt_encodeIndexSequence(reinterpret_cast<unsigned char*>(block.data()), block.size(), &indices[first], count));
+            if (block.empty())
+            {
+                success.store(false);
+                continue;
+            }
+            encodedSizes[i] = DeflateBlock(block);
+        }
+    });
+
+    if (!success.load())
+    {
+        return false;
+    }
+
+    WriteCodecBlocks(indices.size(), blocks, encodedSizes, dataOut);
+    return true;
+}
+
+[[nodiscard]] bool DecodeIndices(TaskPool& pool, ByteBuffer& dataIn, vector<U32>& indicesOut)
+{
+    U32 indexCount = 0u;
+    vector<size_t> offsets;
+    vector<U32> encodedSizes;
+    const Byte* payload = ReadCodecBlocks(dataIn, indexCount, offsets, encodedSizes);
+    if (payload == nullptr || offsets.size() - 1u != CodecBlockCount(indexCount, INDEX_CODEC_BLOCK_SIZE))
+    {
+        return false;
+    }
+
+    indicesOut.resize(indexCount);
+
+    std::atomic_bool success{ true };
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = to_U32(offsets.size() - 1u);
+    descriptor._partitionSize = 1u;
+
+    Parallel_For(pool, descriptor, [&](const Task*, const U32 start, const U32 end)
+    {
+        for (U32 i = start; i < end; ++i)
+        {
+            const size_t first = to_size(i) * INDEX_CODEC_BLOCK_SIZE;
+            const size_t count = std::min(to_size(INDEX_CODEC_BLOCK_SIZE), indicesOut.size() - first);
+
+            vector<Byte> scratch;
+            const unsigned char* encoded = InflateBlock(payload + offsets[i], offsets[i + 1u] - offsets[i], encodedSizes[i], scratch);
+            if (encoded == nullptr || meshopt_decodeIndexSequence(&indicesOut[first], count, sizeof(U32), encoded, encodedSizes[i]) != 0)
+            {
+                success.store(false);
+            }
+        }
+    });
+
+    return success.load();
+}
+
 } //namespace
 
 VertexBuffer::VertexBuffer(GFXDevice& context, const Descriptor& descriptor )
@@ -150,6 +389,19 @@ const vector<VertexBuffer::Vertex>& VertexBuffer::getVertices() const noexcept
     return _data;
 }
 
+void VertexBuffer::setVertices(vector<Vertex>&& vertices, const AttributeFlags& usedAttributes)
+{
+    DIVIDE_ASSERT( _refreshQueued || _descriptor._allowDynamicUpdates || _data.empty(), "VertexBuffer error: Modifying static buffers after creation is not allowed!" );
+
+    _data = MOV(vertices);
+    for (U8 i = 0u; i < to_base(AttribLocation::COUNT); ++i)
+    {
+        _useAttribute[i] = _useAttribute[i] || usedAttributes[i];
+    }
+    _dataLayoutChanged = true;
+    _refreshQueued = true;
+}
+
 void VertexBuffer::reserveIndexCount(const size_t size)
 {
     _indices.reserve(size);
@@ -323,6 +575,17 @@ void VertexBuffer::modifyNormalValue(const U32 index, const F32 x, const F32 y,
     _refreshQueued = true;
 }
 
+void VertexBuffer::modifyPackedNormalValue(const U32 index, const F32 packedValue)
+{
+    DIVIDE_ASSERT(index < _data.size());
+    DIVIDE_ASSERT( _refreshQueued || _descriptor._allowDynamicUpdates || _data.empty(), "VertexBuffer error: Modifying static buffers after creation is not allowed!");
+
+    _data[index]._normal = packedValue;
+    _dataLayoutChanged = _dataLayoutChanged || !_useAttribute[to_base(AttribLocation::NORMAL)];
+    _useAttribute[to_base(AttribLocation::NORMAL)] = true;
+    _refreshQueued = true;
+}
+
 void VertexBuffer::modifyTangentValue(const U32 index, const float3& newValue)
 {
     modifyTangentValue(index, newValue.x, newValue.y, newValue.z);
@@ -339,6 +602,17 @@ void VertexBuffer::modifyTangentValue(const U32 index, const F32 x, const F32 y,
     _refreshQueued = true;
 }
 
+void VertexBuffer::modifyPackedTangentValue(const U32 index, const F32 packedValue)
+{
+    DIVIDE_ASSERT(index < _data.size());
+    DIVIDE_ASSERT( _refreshQueued || _descriptor._allowDynamicUpdates || _data.empty(), "VertexBuffer error: Modifying static buffers after creation is not allowed!");
+
+    _data[index]._tangent = packedValue;
+    _dataLayoutChanged = _dataLayoutChanged || !_useAttribute[to_base(AttribLocation::TANGENT)];
+    _useAttribute[to_base(AttribLocation::TANGENT)] = true;
+    _refreshQueued = true;
+}
+
 void VertexBuffer::modifyTexCoordValue(const U32 index, const float2 newValue)
 {
     modifyTexCoordValue(index, newValue.s, newValue.t);
@@ -770,9 +1044,13 @@ bool VertexBuffer::deserialize(ByteBuffer& dataIn)
             dataIn >> _descriptor._keepCPUData;
             dataIn >> _descriptor._smallIndices;
             dataIn >> _partitions;
-            dataIn >> _indices;
-            dataIn >> _data;
             dataIn >> _useAttribute;
+
+            if (!DeserializeGeometry(_context.context().taskPool(TaskPoolType::HIGH_PRIORITY), dataIn, _data, _indices))
+            {
+                return false;
+            }
+
             _refreshQueued = _indicesChanged = _dataLayoutChanged = true;
             
             return true;
@@ -795,13 +1073,49 @@ bool VertexBuffer::serialize(ByteBuffer& dataOut) const
     dataOut << _descriptor._keepCPUData;
     dataOut << _descriptor._smallIndices;
     dataOut << _partitions;
-    dataOut << _indices;
-    dataOut << _data;
     dataOut << _useAttribute;
 
+    SerializeGeometry(_context.context().taskPool(TaskPoolType::HIGH_PRIORITY), _data, _indices, dataOut);
+
     return true;
 }
 
+void VertexBuffer::SerializeGeometry(TaskPool& pool, const vector<Vertex>& vertices, const vector<U32>& indices, ByteBuffer& dataOut)
+{
+    ByteBuffer encodedIndices;
+    if (EncodeIndices(pool, indices, encodedIndices))
+    {
+        dataOut << true;
+        dataOut << encodedIndices;
+    }
+    else
+    {
+        dataOut << false;
+        dataOut << indices;
+    }
+
+    EncodeVertices(pool, vertices, dataOut);
+}
+
+bool VertexBuffer::DeserializeGeometry(TaskPool& pool, ByteBuffer& dataIn, vector<Vertex>& verticesOut, vector<U32>& indicesOut)
+{
+    bool encodedIndices = false;
+    dataIn >> encodedIndices;
+    if (encodedIndices)
+    {
+        if (!DecodeIndices(pool, dataIn, indicesOut))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        dataIn >> indicesOut;
+    }
+
+    return DecodeVertices(pool, dataIn, verticesOut);
+}
+
 size_t VertexBuffer::GetTotalDataSize( const AttributeFlags& usedAttributes )
 {
     size_t ret = sizeof( float3 );
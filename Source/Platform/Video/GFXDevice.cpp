@@ -1419,6 +1419,7 @@ namespace Divide
         }
 
         ShaderProgram::OnBeginFrame( *this );
+        Texture::OnBeginFrame( *this );
 
         if ( _api->frameStarted() )
         {
@@ -69,6 +69,7 @@ namespace Divide {
 
         void loadDataInternal([[maybe_unused]] const ImageTools::ImageData& imageData, [[maybe_unused]] const PixelAlignment& pixelUnpackAlignment ) override { }
         void loadDataInternal([[maybe_unused]] const std::span<const Byte> data, [[maybe_unused]] const vec3<U16>& offset, [[maybe_unused]] const vec3<U16>& dimensions, [[maybe_unused]] const PixelAlignment& pixelUnpackAlignment ) override {}
+        void updateMipsInternal([[maybe_unused]] const ImageTools::ImageData& imageData ) override {}
     };
 
     class noShaderProgram final : public ShaderProgram {
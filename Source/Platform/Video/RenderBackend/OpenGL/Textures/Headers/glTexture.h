@@ -62,6 +62,7 @@ class glTexture final : public Texture {
     void loadDataInternal(const ImageTools::ImageData& imageData, const PixelAlignment& pixelUnpackAlignment ) override;
     void loadDataInternal( const std::span<const Byte> data, const vec3<U16>& offset, const vec3<U16>& dimensions, const PixelAlignment& pixelUnpackAlignment ) override;
     void loadDataInternal( const std::span<const Byte> data, U8 targetMip, const vec3<U16>& offset, const vec3<U16>& dimensions, const PixelAlignment& pixelUnpackAlignment );
+    void updateMipsInternal( const ImageTools::ImageData& imageData ) override;
     ImageUsage prepareTextureData(const vec3<U16>& dimensions, U16 layers, bool makeImmutable) override;
     void submitTextureData(ImageUsage& crtUsageInOut) override;
 
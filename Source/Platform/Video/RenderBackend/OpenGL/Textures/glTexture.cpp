@@ -20,6 +20,8 @@ glTexture::~glTexture()
 
 bool glTexture::unload()
 {
+    unregisterFromStreaming();
+
     if ( _textureHandle > 0u && _textureHandle != GL_NULL_HANDLE )
     {
         if (GL_API::GetStateTracker().unbindTexture(_descriptor._texType, _textureHandle))
@@ -210,11 +212,17 @@ void glTexture::loadDataInternal(const ImageTools::ImageData& imageData, const P
             const ImageTools::LayerData* mip = layer.getMip( m );
             assert( mip->_size > 0u );
 
-            loadDataInternal( {(const Byte*)mip->data(), mip->_size}, m, vec3<U16>{0u, 0u, l}, mip->_dimensions, pixelUnpackAlignment);
+            loadDataInternal( {(const Byte*)mip->data(), mip->_size}, imageData.firstMip() + m, vec3<U16>{0u, 0u, l}, mip->_dimensions, pixelUnpackAlignment);
         }
     }
 }
 
+void glTexture::updateMipsInternal( const ImageTools::ImageData& imageData )
+{
+    // Same upload path. The target levels come from imageData.firstMip()
+    loadDataInternal( imageData, {} );
+}
+
 void glTexture::loadDataInternal( const std::span<const Byte> data, const vec3<U16>& offset, const vec3<U16>& dimensions, const PixelAlignment& pixelUnpackAlignment )
 {
     loadDataInternal(data, 0u, offset, dimensions, pixelUnpackAlignment);
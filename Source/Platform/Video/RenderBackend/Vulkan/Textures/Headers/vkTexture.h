@@ -196,6 +196,7 @@ namespace Divide
     private:
         void loadDataInternal( const ImageTools::ImageData& imageData, const PixelAlignment& pixelUnpackAlignment ) override;
         void loadDataInternal( const std::span<const Byte> data, const vec3<U16>& offset, const vec3<U16>& dimensions, const PixelAlignment& pixelUnpackAlignment ) override;
+        void updateMipsInternal( const ImageTools::ImageData& imageData ) override;
         ImageUsage prepareTextureData( const vec3<U16>& dimensions, U16 layers, bool makeImmutable ) override;
         void clearDataInternal( const UColour4& clearColour, U8 level, bool clearRect, const int4& rectToClear, int2 depthRange ) const;
         void clearImageViewCache();
@@ -205,6 +205,7 @@ namespace Divide
 
     vkTexture::~vkTexture()
     {
+        unregisterFromStreaming();
         clearImageViewCache();
     }
 
@@ -225,6 +226,7 @@ namespace Divide
 
     bool vkTexture::unload()
     {
+        unregisterFromStreaming();
         clearImageViewCache();
         return Texture::unload();
     }
@@ -859,7 +861,7 @@ namespace Divide
                     copyRegion.bufferRowLength = to_U32(pixelUnpackAlignment._rowLength);
                     copyRegion.bufferImageHeight = 0;
                     copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                    copyRegion.imageSubresource.mipLevel = m;
+                    copyRegion.imageSubresource.mipLevel = imageData.firstMip() + m;
                     copyRegion.imageSubresource.baseArrayLayer = l;
                     copyRegion.imageSubresource.layerCount = 1;
                     copyRegion.imageOffset.x = 0u;
@@ -889,6 +891,84 @@ namespace Divide
         }, "vkTexture::loadDataInternal");
     }
 
+    void vkTexture::updateMipsInternal( const ImageTools::ImageData& imageData )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Graphics );
+
+        const U16 numLayers = imageData.layerCount();
+        const U8 numMips = imageData.mipCount();
+        const U8 firstMip = imageData.firstMip();
+
+        DIVIDE_GPU_ASSERT( numMips > 0u && firstMip + numMips <= mipCount() );
+
+        size_t totalSize = 0u;
+        for ( U32 l = 0u; l < numLayers; ++l )
+        {
+            for ( U8 m = 0u; m < numMips; ++m )
+            {
+                totalSize += imageData.imageLayers()[l].getMip( m )->_size;
+            }
+        }
+
+        // Streaming threads use their own staging memory so they never race with regular uploads
+        VMABuffer_uptr stagingBuffer = VKUtil::createStagingBuffer( totalSize, resourceName().c_str(), false );
+        Byte* target = (Byte*)stagingBuffer->_allocInfo.pMappedData;
+
+        size_t dataOffset = 0u;
+        for ( U32 l = 0u; l < numLayers; ++l )
+        {
+            for ( U8 m = 0u; m < numMips; ++m )
+            {
+                const ImageTools::LayerData* mip = imageData.imageLayers()[l].getMip( m );
+                memcpy( &target[dataOffset], mip->data(), mip->_size );
+                dataOffset += mip->_size;
+            }
+        }
+
+        VK_API::GetStateTracker().IMCmdContext( QueueType::GRAPHICS )->flushCommandBuffer( [&]( VkCommandBuffer cmdBuffer, [[maybe_unused]] const QueueType queue, [[maybe_unused]] const bool isDedicatedQueue )
+        {
+            PROFILE_VK_EVENT_AUTO_AND_CONTEXT( cmdBuffer );
+
+            const NamedVKImage namedImage{ image()->_image, resourceName().c_str(), false };
+
+            // Only the target mips change layout. The rest of the image may be in use
+            const VkImageSubresourceRange mipRange
+            {
+                .aspectMask = GetAspectFlags( _descriptor ),
+                .baseMipLevel = firstMip,
+                .levelCount = numMips,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS
+            };
+
+            FlushPipelineBarrier( cmdBuffer, TransitionType::SHADER_READ_TO_COPY_WRITE, mipRange, namedImage );
+
+            size_t bufferOffset = 0u;
+            for ( U32 l = 0u; l < numLayers; ++l )
+            {
+                for ( U8 m = 0u; m < numMips; ++m )
+                {
+                    const ImageTools::LayerData* mip = imageData.imageLayers()[l].getMip( m );
+
+                    VkBufferImageCopy copyRegion = {};
+                    copyRegion.bufferOffset = bufferOffset;
+                    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    copyRegion.imageSubresource.mipLevel = firstMip + m;
+                    copyRegion.imageSubresource.baseArrayLayer = l;
+                    copyRegion.imageSubresource.layerCount = 1;
+                    copyRegion.imageExtent.width = mip->_dimensions.width;
+                    copyRegion.imageExtent.height = mip->_dimensions.height;
+                    copyRegion.imageExtent.depth = mip->_dimensions.depth;
+
+                    VK_PROFILE( vkCmdCopyBufferToImage, cmdBuffer, stagingBuffer->_buffer, _image->_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion );
+                    bufferOffset += mip->_size;
+                }
+            }
+
+            FlushPipelineBarrier( cmdBuffer, TransitionType::COPY_WRITE_TO_SHADER_READ, mipRange, namedImage );
+        }, "vkTexture::updateMipsInternal", true );
+    }
+
     void vkTexture::submitTextureData(ImageUsage& crtUsageInOut)
     {
         ImageUsage targetUsage = ImageUsage::SHADER_READ;
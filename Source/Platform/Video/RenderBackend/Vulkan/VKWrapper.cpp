@@ -1670,6 +1670,8 @@ namespace Divide
                             descriptor._format = vkTex->vkFormat();
                             descriptor._type = TargetType( imageSampler._image );
                             descriptor._subRange = imageSampler._image._subRange;
+                            // Streamed textures may not have their finest mips uploaded (yet)
+                            descriptor._subRange._mipLevels = vkTex->residentMipRange( descriptor._subRange._mipLevels );
 
                             const VkImageLayout targetLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL;
 
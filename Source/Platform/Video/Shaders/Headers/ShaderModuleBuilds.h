@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_SHADER_MODULE_BUILDS_H_
+#define DVD_SHADER_MODULE_BUILDS_H_
+
+#include "Platform/Video/Shaders/Headers/ShaderDataUploader.h"
+
+namespace Divide {
+
+enum class ShaderType : U8;
+
+/// Deduplicates concurrent GLSL -> SPIRV + reflection builds of the same module. The first caller for a given stage and source runs the build,
+/// anyone asking for the exact same module while it is in flight waits for it and gets a copy of the result.
+/// Finished builds are not kept around: later loads are expected to go through the shader cache instead.
+class ShaderModuleBuilds final : NonCopyable
+{
+  public:
+    using SpvWord = U32;
+
+    struct Module
+    {
+        std::vector<SpvWord> _sourceCodeSpirV;
+        Reflection::Data _reflectionData{};
+    };
+
+    /// Fills in the module and returns true on success. Called without any lock held
+    using BuildFunction = DELEGATE<bool, Module&>;
+
+    /// moduleHash is only used to find in-flight builds. A build is shared only if its stage and source match too, so a hash collision costs a second build, not a wrong module.
+    /// If the build we waited on failed, we try again ourselves so that every caller reports its own errors
+    [[nodiscard]] bool getOrBuild(U64 moduleHash, ShaderType type, const string& sourceCodeGLSL, const BuildFunction& build, Module& moduleOut);
+
+  private:
+    struct Build
+    {
+        Mutex _lock;
+        Module _module;
+        string _sourceCodeGLSL;
+        ShaderType _type{};
+        bool _valid{ false };
+    };
+
+    Mutex _lock;
+    /// Only holds builds that are still in flight
+    hashMap<U64, std::shared_ptr<Build>> _builds;
+};
+
+}; //namespace Divide
+
+#endif //DVD_SHADER_MODULE_BUILDS_H_
@@ -150,7 +150,10 @@ namespace Divide
             ShaderType _type{ ShaderType::COUNT };
             string _uniformBlock{};
             Reflection::Data _reflectionData{};
+            eastl::set<U64> _atomIDs{};
             bool _compiled{ false };
+            bool _needsCompilation{ false }; ///< No usable SPIRV yet. Built from _sourceCodeGLSL by compileSourceCode
+            bool _needsReflection{ false };  ///< No usable reflection data yet. Built from _sourceCodeSpirV by compileSourceCode
         };
 
         struct ShaderQueueEntry
@@ -280,6 +283,9 @@ namespace Divide
                              Reflection::UniformsSet& previousUniformsInOut,
                              U8& blockIndexInOut );
 
+        /// Converts the stage's GLSL to SPIRV and/or builds its reflection data as flagged by loadSourceCode. Safe to call from any thread
+        bool compileSourceCode( LoadData& loadDataInOut ) const;
+
         void loadAndParseGLSL( const ModuleDefines& defines,
                                LoadData& loadDataInOut,
                                Reflection::UniformsSet& previousUniformsInOut,
@@ -0,0 +1,65 @@
+
+
+#include "Headers/ShaderModuleBuilds.h"
+
+namespace Divide
+{
+
+bool ShaderModuleBuilds::getOrBuild(const U64 moduleHash, const ShaderType type, const string& sourceCodeGLSL, const BuildFunction& build, Module& moduleOut)
+{
+    std::shared_ptr<Build> job;
+    bool ownsJob = false;
+    {
+        LockGuard<Mutex> w_lock(_lock);
+
+        std::shared_ptr<Build>& entry = _builds[moduleHash];
+        if (entry == nullptr)
+        {
+            // Locked before anyone else can see it, so waiters block until the result is in
+            entry = std::make_shared<Build>();
+            entry->_type = type;
+            entry->_sourceCodeGLSL = sourceCodeGLSL;
+            entry->_lock.lock();
+            job = entry;
+            ownsJob = true;
+        }
+        else if (entry->_type == type && entry->_sourceCodeGLSL == sourceCodeGLSL)
+        {
+            job = entry;
+        }
+    }
+
+    if (job == nullptr)
+    {
+        // Same hash, different module. Rare enough that we don't bother tracking it
+        return build(moduleOut);
+    }
+
+    if (!ownsJob)
+    {
+        LockGuard<Mutex> r_lock(job->_lock);
+        if (job->_valid)
+        {
+            moduleOut = job->_module;
+            return true;
+        }
+
+        return build(moduleOut);
+    }
+
+    job->_valid = build(moduleOut);
+    if (job->_valid)
+    {
+        job->_module = moduleOut;
+    }
+
+    {
+        LockGuard<Mutex> w_lock(_lock);
+        _builds.erase(moduleHash);
+    }
+
+    job->_lock.unlock();
+    return job->_valid;
+}
+
+}; //namespace Divide
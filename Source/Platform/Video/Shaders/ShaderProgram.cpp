@@ -2,6 +2,7 @@
 
 #include "Headers/ShaderProgram.h"
 #include "Headers/GLSLToSPIRV.h"
+#include "Headers/ShaderModuleBuilds.h"
 
 #include "Managers/Headers/ProjectManager.h"
 
@@ -10,6 +11,7 @@
 #include "Scenes/Headers/SceneShaderData.h"
 #include "Scenes/Headers/SceneEnvironmentProbePool.h"
 
+#include "Core/Headers/ByteBuffer.h"
 #include "Core/Headers/Configuration.h"
 #include "Core/Headers/PlatformContext.h"
 #include "Core/Resources/Headers/ResourceCache.h"
@@ -255,7 +257,27 @@ namespace Divide
 
     namespace
     {
-        U64 s_newestShaderAtomWriteTime = 0u; ///< Used to detect modified shader atoms to validate/invalidate shader cache
+        constexpr U16 CACHE_MANIFEST_VERSION = 1u;
+        constexpr const char* CACHE_MANIFEST_EXTENSION = "deps";
+
+        struct AtomLocation
+        {
+            ResourcePath _path;
+            string _name;
+        };
+
+        /// Every cache entry (GLSL, SPIRV, reflection) of a shader stage is described by one of these.
+        /// The entries are valid for as long as every file in _dependencies hashes to the same value.
+        struct CacheManifest
+        {
+            size_t _definesHash{ 0u };
+            U64 _sourceHash{ 0u }; ///< Fully preprocessed GLSL. Unchanged output means the compiled entries are still good
+            vector<std::pair<U64, U64>> _dependencies; ///< Atom name hash, content hash when the entry was written
+        };
+
+        NO_DESTROY Mutex s_atomContentLock;
+        NO_DESTROY hashMap<U64, AtomLocation> s_atomLocations; ///< Atom name hash -> file on disk
+        NO_DESTROY hashMap<U64, U64> s_atomContentHashes;      ///< Atom name hash -> content hash. Dropped when the atom changes
         bool s_useShaderCache = true;
         bool s_targetOpenGL = false;
 
@@ -314,45 +336,133 @@ namespace Divide
             return ResourcePath { fileName + "." + Paths::Shaders::g_ReflectionExt.c_str() };
         }
 
-        [[nodiscard]] bool ValidateCacheLocked( const ShaderProgram::LoadData::ShaderCacheType type, const Str<256>& sourceFileName, const Str<256>& fileName )
+        NO_DESTROY ShaderModuleBuilds s_moduleBuilds; ///< Shares GLSL -> SPIRV builds between concurrent loads of the same module
+
+        [[nodiscard]] ResourcePath ManifestTargetName( const Str<256>& fileName )
+        {
+            return ResourcePath{ fileName + "." + CACHE_MANIFEST_EXTENSION };
+        }
+
+        void RegisterAtomLocation( const U64 atomID, const ResourcePath& path, const std::string_view name, const bool overwrite )
         {
-            if ( !s_useShaderCache )
+            LockGuard<Mutex> w_lock( s_atomContentLock );
+            AtomLocation& location = s_atomLocations[atomID];
+            if ( overwrite || location._name.empty() )
             {
-                return false;
+                location._path = path;
+                location._name = name;
+            }
+        }
+
+        void ForgetAtomContentHash( const U64 atomID )
+        {
+            LockGuard<Mutex> w_lock( s_atomContentLock );
+            s_atomContentHashes.erase( atomID );
+        }
+
+        /// Hash of the atom file's current content (computed once and kept until the atom changes). 0 if the file can't be read
+        [[nodiscard]] U64 AtomContentHash( const U64 atomID )
+        {
+            AtomLocation location{};
+            {
+                LockGuard<Mutex> r_lock( s_atomContentLock );
+                if ( const auto it = s_atomContentHashes.find( atomID ); it != std::cend( s_atomContentHashes ) )
+                {
+                    return it->second;
+                }
+
+                const auto it = s_atomLocations.find( atomID );
+                if ( it == std::cend( s_atomLocations ) )
+                {
+                    return 0u;
+                }
+                location = it->second;
+            }
+
+            string content;
+            if ( readFile( location._path, location._name.c_str(), FileType::TEXT, content ) != FileError::NONE )
+            {
+                return 0u;
             }
 
-            //"There are only two hard things in Computer Science: cache invalidation and naming things" - Phil Karlton
-            //"There are two hard things in computer science: cache invalidation, naming things, and off-by-one errors." - Leon Bambrick
+            std::erase( content, '\r' );
+            const U64 hash = Util::ContentHash( content );
+
+            LockGuard<Mutex> w_lock( s_atomContentLock );
+            s_atomContentHashes[atomID] = hash;
+            return hash;
+        }
+
+        [[nodiscard]] U64 CompiledModuleHash( const ShaderType type, const string& sourceCodeGLSL ) noexcept
+        {
+            size_t hash = Util::ContentHash( sourceCodeGLSL );
+            Util::Hash_combine( hash, to_base( type ), s_targetOpenGL );
+            return hash;
+        }
 
-            // Get our source file's "last written" timestamp. Every cache file that's older than this is automatically out-of-date
-            U64 lastWriteTime = 0u, lastWriteTimeCache = 0u;
-            const ResourcePath sourceShaderFullPath = Paths::Shaders::GLSL::g_GLSLShaderLoc / sourceFileName;
-            if ( fileLastWriteTime( sourceShaderFullPath, lastWriteTime ) != FileError::NONE )
+        [[nodiscard]] bool DependenciesUnchanged( const CacheManifest& manifest )
+        {
+            if ( manifest._dependencies.empty() )
             {
                 return false;
             }
 
-            ResourcePath filePath;
-            switch ( type )
+            for ( const auto& [atomID, contentHash] : manifest._dependencies )
             {
-                case ShaderProgram::LoadData::ShaderCacheType::REFLECTION: filePath = ReflCacheLocation() / ReflTargetName( fileName ); break;
-                case ShaderProgram::LoadData::ShaderCacheType::GLSL: filePath = TxtCacheLocation() / fileName; break;
-                case ShaderProgram::LoadData::ShaderCacheType::SPIRV: filePath = SpvCacheLocation() / SpvTargetName( fileName ); break;
+                if ( contentHash == 0u || AtomContentHash( atomID ) != contentHash )
+                {
+                    return false;
+                }
+            }
 
-                default:
-                case ShaderProgram::LoadData::ShaderCacheType::COUNT: return false;
+            return true;
+        }
+
+        [[nodiscard]] bool LoadManifestLocked( const Str<256>& fileName, CacheManifest& manifestOut )
+        {
+            ByteBuffer buffer;
+            if ( !buffer.loadFromFile( ReflCacheLocation(), ManifestTargetName( fileName ).string() ) )
+            {
+                return false;
             }
 
-            if ( fileLastWriteTime( filePath, lastWriteTimeCache ) != FileError::NONE ||
-                 lastWriteTimeCache < lastWriteTime ||
-                 lastWriteTimeCache < s_newestShaderAtomWriteTime )
+            auto tempVer = decltype(CACHE_MANIFEST_VERSION){0};
+            buffer >> tempVer;
+            if ( tempVer != CACHE_MANIFEST_VERSION )
             {
                 return false;
             }
 
+            size_t dependencyCount = 0u;
+            buffer >> manifestOut._definesHash;
+            buffer >> manifestOut._sourceHash;
+            buffer >> dependencyCount;
+            manifestOut._dependencies.resize( dependencyCount );
+            for ( auto& [atomID, contentHash] : manifestOut._dependencies )
+            {
+                buffer >> atomID;
+                buffer >> contentHash;
+            }
+
             return true;
         }
 
+        [[nodiscard]] bool SaveManifestLocked( const Str<256>& fileName, const CacheManifest& manifest )
+        {
+            ByteBuffer buffer;
+            buffer << CACHE_MANIFEST_VERSION;
+            buffer << manifest._definesHash;
+            buffer << manifest._sourceHash;
+            buffer << manifest._dependencies.size();
+            for ( const auto& [atomID, contentHash] : manifest._dependencies )
+            {
+                buffer << atomID;
+                buffer << contentHash;
+            }
+
+            return buffer.dumpToFile( ReflCacheLocation(), ManifestTargetName( fileName ).string() );
+        }
+
         [[nodiscard]] bool DeleteCacheLocked( const ShaderProgram::LoadData::ShaderCacheType type, const Str<256>& fileName )
         {
             FileError err = FileError::NONE;
@@ -378,6 +488,9 @@ namespace Divide
                 ret = DeleteCacheLocked( ShaderProgram::LoadData::ShaderCacheType::REFLECTION, fileName ) || ret;
                 ret = DeleteCacheLocked( ShaderProgram::LoadData::ShaderCacheType::GLSL, fileName ) || ret;
                 ret = DeleteCacheLocked( ShaderProgram::LoadData::ShaderCacheType::SPIRV, fileName ) || ret;
+
+                const FileError err = deleteFile( ReflCacheLocation(), ManifestTargetName( fileName ).string() );
+                ret = (err == FileError::NONE || err == FileError::FILE_NOT_FOUND) || ret;
                 return ret;
 
             }
@@ -1103,6 +1216,8 @@ namespace Divide
         FileList list{};
         if ( s_useShaderCache )
         {
+            // Cache validation hashes the content of every atom a cache entry depends on, so we need to know where they live
+            // even if nothing ends up getting parsed this run. Atoms actually read later on overwrite these with their exact path.
             for ( U8 i = 0u; i < to_base( ShaderType::COUNT ) + 1; ++i )
             {
                 const ResourcePath& atomLocation = shaderAtomLocationPrefix[i];
@@ -1110,7 +1225,8 @@ namespace Divide
                 {
                     for ( const FileEntry& it : list )
                     {
-                        s_newestShaderAtomWriteTime = std::max( s_newestShaderAtomWriteTime, it._lastWriteTime );
+                        const string atomName = it._name.string();
+                        RegisterAtomLocation( _ID( atomName.c_str() ), atomLocation, atomName, false );
                     }
                 }
                 list.resize( 0 );
@@ -1150,6 +1266,11 @@ namespace Divide
         s_shaderCount = 0u;
         s_atoms.clear();
         s_atomIncludes.clear();
+        {
+            LockGuard<Mutex> w_lock( s_atomContentLock );
+            s_atomLocations.clear();
+            s_atomContentHashes.clear();
+        }
 
         k_commandBufferID = U8_MAX - MAX_BINDINGS_PER_DESCRIPTOR_SET;
 
@@ -1489,6 +1610,8 @@ namespace Divide
         // If we forgot to specify an atom location, we have nothing to return
         assert( !filePath.empty() );
 
+        RegisterAtomLocation( atomNameHash, filePath, atomName, true );
+
         // Open the atom file and add the code to the atom cache for future reference
         string& output = s_atoms[atomNameHash];
         output.clear();
@@ -1591,17 +1714,10 @@ namespace Divide
             return false;
         }
 
+        // Validity is decided by the caller against the entry's dependency manifest. All we do here is read it back
         LockGuard<Mutex> rw_lock( g_cacheLock );
-        if ( !ValidateCacheLocked( cache, dataInOut._sourceFile, dataInOut._shaderName ) )
-        {
-            if ( !DeleteCacheLocked( cache, dataInOut._shaderName ) )
-            {
-                NOP();
-            }
-
-            return false;
-        }
 
+        bool ret = false;
         FileError err = FileError::FILE_EMPTY;
         switch ( cache )
         {
@@ -1611,8 +1727,8 @@ namespace Divide
                                 dataInOut._shaderName.c_str(),
                                 FileType::TEXT,
                                 dataInOut._sourceCodeGLSL );
-                return err == FileError::NONE;
-            }
+                ret = err == FileError::NONE;
+            } break;
             case LoadData::ShaderCacheType::SPIRV:
             {
                 std::ifstream tempData;
@@ -1629,6 +1745,7 @@ namespace Divide
                     dataInOut._sourceCodeSpirV.reserve( tempData.tellg() / sizeof( SpvWord ) );
                     tempData.seekg(0);
 
+                    ret = true;
                     while (!tempData.eof())
                     {
                         SpvWord inWord;
@@ -1638,25 +1755,31 @@ namespace Divide
                             dataInOut._sourceCodeSpirV.push_back(inWord);
                             if (tempData.fail())
                             {
-                                return false;
+                                dataInOut._sourceCodeSpirV.clear();
+                                ret = false;
+                                break;
                             }
                         }
                     }
-                    
-                    return true;
                 }
-
-                return false;
-            }
+            } break;
             case LoadData::ShaderCacheType::REFLECTION:
             {
-                return Reflection::LoadReflectionData( ReflCacheLocation(), ReflTargetName( dataInOut._shaderName ), dataInOut._reflectionData, atomIDsOut );
-            }
+                ret = Reflection::LoadReflectionData( ReflCacheLocation(), ReflTargetName( dataInOut._shaderName ), dataInOut._reflectionData, atomIDsOut );
+            } break;
             default:
             case LoadData::ShaderCacheType::COUNT: break;
         }
 
-        return false;
+        if ( !ret )
+        {
+            if ( !DeleteCacheLocked( cache, dataInOut._shaderName ) )
+            {
+                NOP();
+            }
+        }
+
+        return ret;
     }
 
     bool ShaderProgram::loadInternal( hashMap<U64, PerFileShaderData>& fileData, const bool overwrite )
@@ -1677,11 +1800,13 @@ namespace Divide
             ShaderModuleDescriptor& newDescriptor = fileData[fileHash]._modules.back();
             newDescriptor._defines.insert( end( newDescriptor._defines ), begin( _descriptor._globalDefines ), end( _descriptor._globalDefines ) );
             _usedAtomIDs.insert( _ID( shaderDescriptor._sourceFile.c_str() ) );
+            RegisterAtomLocation( fileHash, Paths::Shaders::GLSL::g_GLSLShaderLoc, shaderDescriptor._sourceFile.c_str(), true );
         }
 
         U8 blockOffset = 0u;
 
         Reflection::UniformsSet previousUniforms;
+        vector<LoadData*> pendingStages;
 
         _uniformBlockBuffers.clear();
         _setUsage.fill( false );
@@ -1719,13 +1844,49 @@ namespace Divide
                     return false;
                 }
 
+                if ( stageData._needsCompilation || stageData._needsReflection )
+                {
+                    pendingStages.push_back( &stageData );
+                }
+
                 if ( !loadDataPerFile._programName.empty() )
                 {
                     loadDataPerFile._programName.append( "-" );
                 }
                 loadDataPerFile._programName.append( stageData._shaderName.c_str() );
             }
+        }
+
+        // Preprocessing stays on this thread (GLSW contexts are per thread and stages share uniform block offsets),
+        // but SPIRV conversion and reflection are independent per stage so spread them across the pool
+        if ( !pendingStages.empty() )
+        {
+            std::atomic_bool compileFailed{ false };
+
+            ParallelForDescriptor descriptor = {};
+            descriptor._iterCount = to_U32( pendingStages.size() );
+            descriptor._partitionSize = 1u;
+            descriptor._useCurrentThread = true;
+
+            Parallel_For( context().context().taskPool( TaskPoolType::HIGH_PRIORITY ), descriptor, [&]( const Task*, const U32 start, const U32 end )
+            {
+                for ( U32 i = start; i < end; ++i )
+                {
+                    if ( !compileSourceCode( *pendingStages[i] ) )
+                    {
+                        compileFailed.store( true );
+                    }
+                }
+            });
+
+            if ( compileFailed.load() )
+            {
+                return false;
+            }
+        }
 
+        for ( auto& [fileHash, loadDataPerFile] : fileData )
+        {
             initUniformUploader( loadDataPerFile );
             initDrawDescriptorSetLayout( loadDataPerFile );
         }
@@ -1863,20 +2024,37 @@ namespace Divide
         // Clear existing code
         loadDataInOut._sourceCodeGLSL.resize( 0 );
         loadDataInOut._sourceCodeSpirV.resize( 0 );
+        loadDataInOut._needsCompilation = false;
+        loadDataInOut._needsReflection = false;
 
         eastl::set<U64> atomIDs;
 
+        // Every cache entry of this stage is tracked by a manifest listing the content hash of each file that went into it.
+        // Hot reloading always re-parses the GLSL source, but we still want the manifest to see if the output actually changed
+        CacheManifest manifest{};
+        bool manifestLoaded = false;
+        bool cacheValid = false;
+        if ( useShaderCache() )
+        {
+            LockGuard<Mutex> rw_lock( g_cacheLock );
+            manifestLoaded = LoadManifestLocked( loadDataInOut._shaderName, manifest ) && manifest._definesHash == loadDataInOut._definesHash;
+            cacheValid = !reloadExisting && manifestLoaded && DependenciesUnchanged( manifest );
+        }
+
+        // Compiled entries (SPIRV and reflection) are usable if none of our dependencies changed or if they did, but the preprocessed GLSL came out the same
+        bool compiledCacheValid = cacheValid;
+
         bool needGLSL = s_targetOpenGL;
-        if ( reloadExisting )
+        if ( cacheValid )
         {
-            // Hot reloading will always reparse GLSL source files so the best way to achieve that is to delete cache files
-            needGLSL = true;
-            // We should have cached the existing shader, so a failure here is NOT expected
-            DIVIDE_EXPECTED_CALL( DeleteCache( LoadData::ShaderCacheType::COUNT, loadDataInOut._shaderName ) );
+            for ( const auto& [atomID, contentHash] : manifest._dependencies )
+            {
+                atomIDs.insert( atomID );
+            }
         }
 
         // Load SPIRV code from cache (if needed)
-        if ( reloadExisting || !useShaderCache()  || !LoadFromCache(LoadData::ShaderCacheType::SPIRV, loadDataInOut, atomIDs) )
+        if ( !cacheValid || !LoadFromCache( LoadData::ShaderCacheType::SPIRV, loadDataInOut, atomIDs ) )
         {
             needGLSL = true;
         }
@@ -1885,72 +2063,149 @@ namespace Divide
         if ( needGLSL )
         {
             // Try and load GLSL code from cache (if needed)
-            if ( reloadExisting || !useShaderCache() || !LoadFromCache( LoadData::ShaderCacheType::GLSL, loadDataInOut, atomIDs ) )
+            if ( !cacheValid || !LoadFromCache( LoadData::ShaderCacheType::GLSL, loadDataInOut, atomIDs ) )
             {
                 // That failed, so re-parse the code
+                atomIDs.clear();
                 loadAndParseGLSL( defines, loadDataInOut, previousUniformsInOut, blockIndexInOut, atomIDs );
                 if ( loadDataInOut._sourceCodeGLSL.empty() )
                 {
                     // That failed so we have no choice but to bail
                     return false;
                 }
-                else
+                else if ( useShaderCache() )
                 {
+                    const U64 sourceHash = Util::ContentHash( loadDataInOut._sourceCodeGLSL );
+
+                    // If the final GLSL did not change (e.g. an included atom was modified in a section we don't use), what we compiled last time is still good
+                    compiledCacheValid = manifestLoaded && manifest._sourceHash == sourceHash;
+                    if ( !compiledCacheValid )
+                    {
+                        loadDataInOut._sourceCodeSpirV.resize( 0 );
+                        if ( !DeleteCache( LoadData::ShaderCacheType::SPIRV, loadDataInOut._shaderName ) ||
+                             !DeleteCache( LoadData::ShaderCacheType::REFLECTION, loadDataInOut._shaderName ) )
+                        {
+                            NOP();
+                        }
+                    }
+                    else if ( loadDataInOut._sourceCodeSpirV.empty() && !LoadFromCache( LoadData::ShaderCacheType::SPIRV, loadDataInOut, atomIDs ) )
+                    {
+                        compiledCacheValid = false;
+                    }
+
                     // That succeeded so save the new cache file for future use
                     SaveToCache( LoadData::ShaderCacheType::GLSL, loadDataInOut, atomIDs );
+
+                    CacheManifest newManifest{};
+                    newManifest._definesHash = loadDataInOut._definesHash;
+                    newManifest._sourceHash = sourceHash;
+                    newManifest._dependencies.reserve( atomIDs.size() + 1u );
+                    newManifest._dependencies.emplace_back( _ID( loadDataInOut._sourceFile.c_str() ), AtomContentHash( _ID( loadDataInOut._sourceFile.c_str() ) ) );
+                    for ( const U64 atomID : atomIDs )
+                    {
+                        newManifest._dependencies.emplace_back( atomID, AtomContentHash( atomID ) );
+                    }
+
+                    LockGuard<Mutex> rw_lock( g_cacheLock );
+                    if ( !SaveManifestLocked( loadDataInOut._shaderName, newManifest ) )
+                    {
+                        NOP();
+                    }
                 }
             }
 
             // We MUST have GLSL code at this point so now we have too options.
-            // We already have SPIRV code and can proceed or we failed loading SPIRV from cache so we must convert GLSL -> SPIRV
+            // We already have SPIRV code and can proceed or we failed loading SPIRV from cache so we must convert GLSL -> SPIRV.
+            // The conversion itself is deferred to compileSourceCode so that all of the program's stages can be built in parallel
             if ( loadDataInOut._sourceCodeSpirV.empty() )
             {
-                // We are in situation B: we need SPIRV code, so convert our GLSL code over
                 DIVIDE_GPU_ASSERT( !loadDataInOut._sourceCodeGLSL.empty() );
-                if ( !SpirvHelper::GLSLtoSPV( loadDataInOut._type, loadDataInOut._sourceCodeGLSL.c_str(), loadDataInOut._sourceCodeSpirV, s_targetOpenGL ) )
-                {
-                    Console::errorfn( LOCALE_STR( "ERROR_SHADER_CONVERSION_SPIRV_FAILED" ), loadDataInOut._shaderName.c_str() );
-                    // We may fail here for WHATEVER reason so bail
-                    if ( !DeleteCache( LoadData::ShaderCacheType::GLSL, loadDataInOut._shaderName ) )
-                    {
-                        NOP();
-                    }
-                    return false;
-                }
-                else
+                loadDataInOut._needsCompilation = true;
+                compiledCacheValid = false;
+            }
+        }
+
+        // Time to see if we have any cached reflection data. If not, it gets built from the SPIRV code later on
+        if ( !compiledCacheValid || !LoadFromCache( LoadData::ShaderCacheType::REFLECTION, loadDataInOut, atomIDs ) )
+        {
+            loadDataInOut._needsReflection = true;
+        }
+        else if ( loadDataInOut._reflectionData._uniformBlockBindingIndex != Reflection::INVALID_BINDING_INDEX )
+        {
+            blockIndexInOut = loadDataInOut._reflectionData._uniformBlockBindingIndex - s_uniformsStartOffset;
+        }
+
+        _usedAtomIDs.insert( begin( atomIDs ), end( atomIDs ) );
+        loadDataInOut._atomIDs = MOV( atomIDs );
+
+        return !loadDataInOut._sourceCodeGLSL.empty() || !loadDataInOut._sourceCodeSpirV.empty();
+    }
+
+    bool ShaderProgram::compileSourceCode( LoadData& loadDataInOut ) const
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Streaming );
+
+        if ( loadDataInOut._needsCompilation )
+        {
+            // Identical GLSL for the same stage produces identical SPIRV, so if another program is already building it, wait for that instead
+            const U64 moduleHash = CompiledModuleHash( loadDataInOut._type, loadDataInOut._sourceCodeGLSL );
+
+            ShaderModuleBuilds::Module module{};
+            const bool built = s_moduleBuilds.getOrBuild( moduleHash, loadDataInOut._type, loadDataInOut._sourceCodeGLSL, [&loadDataInOut]( ShaderModuleBuilds::Module& moduleOut )
+            {
+                // We are in situation B: we need SPIRV code, so convert our GLSL code over
+                return SpirvHelper::GLSLtoSPV( loadDataInOut._type, loadDataInOut._sourceCodeGLSL.c_str(), moduleOut._sourceCodeSpirV, s_targetOpenGL ) &&
+                       SpirvHelper::BuildReflectionData( loadDataInOut._type, moduleOut._sourceCodeSpirV, s_targetOpenGL, moduleOut._reflectionData );
+            }, module );
+
+            if ( built )
+            {
+                loadDataInOut._sourceCodeSpirV = MOV( module._sourceCodeSpirV );
+                loadDataInOut._reflectionData = MOV( module._reflectionData );
+                loadDataInOut._needsReflection = false;
+            }
+
+            if ( loadDataInOut._sourceCodeSpirV.empty() )
+            {
+                Console::errorfn( LOCALE_STR( "ERROR_SHADER_CONVERSION_SPIRV_FAILED" ), loadDataInOut._shaderName.c_str() );
+                // We may fail here for WHATEVER reason so bail
+                if ( !DeleteCache( LoadData::ShaderCacheType::COUNT, loadDataInOut._shaderName ) )
                 {
-                    // We managed to generate good SPIRV so save it to the cache for future use
-                    SaveToCache( LoadData::ShaderCacheType::SPIRV, loadDataInOut, atomIDs );
+                    NOP();
                 }
+                return false;
+            }
+
+            // We managed to generate good SPIRV so save it to the cache for future use
+            if ( useShaderCache() )
+            {
+                SaveToCache( LoadData::ShaderCacheType::SPIRV, loadDataInOut, loadDataInOut._atomIDs );
             }
+
+            loadDataInOut._needsCompilation = false;
         }
 
         // Whatever the process to get here was, we need SPIRV to proceed
         DIVIDE_GPU_ASSERT( !loadDataInOut._sourceCodeSpirV.empty() );
-        // Time to see if we have any cached reflection data, and, if not, build it
-        if ( reloadExisting || !useShaderCache() || !LoadFromCache( LoadData::ShaderCacheType::REFLECTION, loadDataInOut, atomIDs ) )
+
+        if ( loadDataInOut._needsReflection )
         {
-            // Well, we failed. Time to build our reflection data again
+            // Time to build our reflection data again
             if ( !SpirvHelper::BuildReflectionData( loadDataInOut._type, loadDataInOut._sourceCodeSpirV, s_targetOpenGL, loadDataInOut._reflectionData ) )
             {
                 Console::errorfn( LOCALE_STR( "ERROR_SHADER_REFLECTION_SPIRV_FAILED" ), loadDataInOut._shaderName.c_str() );
                 return false;
             }
-            // Save reflection data to cache for future use
-            SaveToCache( LoadData::ShaderCacheType::REFLECTION, loadDataInOut, atomIDs );
-        }
-        else if ( loadDataInOut._reflectionData._uniformBlockBindingIndex != Reflection::INVALID_BINDING_INDEX )
-        {
-            blockIndexInOut = loadDataInOut._reflectionData._uniformBlockBindingIndex - s_uniformsStartOffset;
+            loadDataInOut._needsReflection = false;
         }
 
-        if ( !loadDataInOut._sourceCodeGLSL.empty() || !loadDataInOut._sourceCodeSpirV.empty() )
+        // Save reflection data to cache for future use
+        if ( useShaderCache() )
         {
-            _usedAtomIDs.insert( begin( atomIDs ), end( atomIDs ) );
-            return true;
+            SaveToCache( LoadData::ShaderCacheType::REFLECTION, loadDataInOut, loadDataInOut._atomIDs );
         }
 
-        return false;
+        return true;
     }
 
     void ShaderProgram::loadAndParseGLSL( const ModuleDefines& defines,
@@ -2092,6 +2347,7 @@ namespace Divide
         fixed_vector<U64, 128, true> queuedDeletion;
 
         s_atoms.erase( atomHash );
+        ForgetAtomContentHash( atomHash );
 
         for ( auto it = s_atomIncludes.cbegin(); it != s_atomIncludes.cend(); )
         {
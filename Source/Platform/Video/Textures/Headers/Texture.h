@@ -47,6 +47,7 @@ namespace Divide
 
 class Kernel;
 class ResourceCache;
+class TextureStreamer;
 
 namespace Attorney
 {
@@ -94,6 +95,8 @@ NOINITVTABLE_CLASS(Texture) : public CachedResource, public GraphicsResource
 
         static void OnStartup( GFXDevice& gfx );
         static void OnShutdown() noexcept;
+        /// Pushes the requested mips gathered last frame to the texture streamer and kicks off the resulting mip loads
+        static void OnBeginFrame( GFXDevice& gfx );
         [[nodiscard]] static bool UseTextureDDSCache() noexcept;
         [[nodiscard]] static Handle<Texture> DefaultTexture2D() noexcept;
         [[nodiscard]] static Handle<Texture> DefaultTexture2DArray() noexcept;
@@ -136,6 +139,13 @@ NOINITVTABLE_CLASS(Texture) : public CachedResource, public GraphicsResource
         PROPERTY_R( bool, loadedFromFile, false );
         [[nodiscard]] U8 numChannels() const noexcept;
 
+        /// The finest mip level that can be sampled. Non-zero only for streamed textures that haven't (yet) loaded their full mip chain
+        [[nodiscard]] U8 residentMip() const noexcept;
+        /// Streaming feedback: the finest mip this texture needs to be drawn with. Requests are merged (finest wins) until the next frame starts
+        void requestMip( U8 mip ) noexcept;
+        /// Clamps the specified mip range to the resident mips
+        [[nodiscard]] SubRange residentMipRange( SubRange mipRange ) const noexcept;
+
         bool load( PlatformContext& context ) override;
         bool postLoad() override;
      protected:
@@ -151,9 +161,31 @@ NOINITVTABLE_CLASS(Texture) : public CachedResource, public GraphicsResource
         virtual void loadDataInternal( std::span<const Byte> data, const vec3<U16>& offset, const vec3<U16>& dimensions, const PixelAlignment& pixelUnpackAlignment ) = 0;
         virtual ImageUsage prepareTextureData( const vec3<U16>& dimensions, U16 layers, bool makeImmutable );
         virtual void submitTextureData(ImageUsage& crtUsageInOut);
+        /// Uploads the mips in imageData to levels [imageData.firstMip(), imageData.firstMip() + imageData.mipCount()) of the existing image. Called from streaming threads
+        virtual void updateMipsInternal( const ImageTools::ImageData& imageData ) = 0;
+
+        /// Stops issuing mip loads and waits for the one in flight, if any. Backends must call this before releasing their image,
+        /// as the load calls updateMipsInternal (and ~Texture runs too late for that)
+        void unregisterFromStreaming();
+
+    private:
+        void registerForStreaming( const ImageTools::ImageData& imageData );
+        void streamMip( U8 mip );
+        /// Reports a finished mip load to the streamer. Main thread only, so the streamer never hands out a load while the previous one still runs
+        void completeMipLoad();
+
+    private:
+        struct StreamingData;
+        std::unique_ptr<StreamingData> _streamingData;
+        std::atomic<U8> _residentMip{ 0u };
+        std::atomic<U8> _requestedMip{ U8_MAX };
 
     protected:
         static bool s_useDDSCache;
+        static size_t s_streamingInFlightBudget;
+        static std::unique_ptr<TextureStreamer> s_textureStreamer;
+        static vector<Texture*> s_streamedTextures;
+        static Mutex s_streamedTexturesLock;
         static SamplerDescriptor s_defaultSampler;
         static Handle<Texture> s_defaultTexture2D;
         static Handle<Texture> s_defaultTexture2DArray;
@@ -170,6 +202,11 @@ namespace Attorney
             Texture::s_useDDSCache = state;
         }
 
+        static void TextureStreamingInFlightBudget( const size_t budgetInBytes ) noexcept
+        {
+            Texture::s_streamingInFlightBudget = budgetInBytes;
+        }
+
         friend class Divide::Kernel;
     };
 }
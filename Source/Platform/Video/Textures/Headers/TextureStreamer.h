@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2018 DIVIDE-Studio
+Copyright (c) 2009 Ionut Cava
+
+This file is part of DIVIDE Framework.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software
+and associated documentation files (the "Software"), to deal in the Software
+without restriction,
+including without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#pragma once
+#ifndef DVD_TEXTURE_STREAMER_H_
+#define DVD_TEXTURE_STREAMER_H_
+
+namespace Divide {
+
+/// CPU side scheduling of mip loads for streamed textures. Mip 0 is the full resolution level.
+/// The mip tail ([tailMip, mipCount)) of a registered texture is loaded upfront. Finer mips are loaded one level at a time,
+/// driven by per-texture requested-mip feedback, most recently used textures first.
+/// Streamed images are allocated with their whole mip chain, so this does not bound video memory: the budget caps how many bytes
+/// of mip data are being read and uploaded at any one time, which keeps streaming from flooding IO and the transfer queues.
+/// Loaded mips are never dropped.
+/// Holds no GPU or file state so it can run (and be tested) headless.
+class TextureStreamer final : NonCopyable
+{
+  public:
+    using EntryID = U32;
+    static constexpr EntryID INVALID_ENTRY = U32_MAX;
+    static constexpr U8 NO_MIP = U8_MAX;
+
+    struct MipLoad
+    {
+        EntryID _id{ INVALID_ENTRY };
+        U8 _mip{ NO_MIP };
+    };
+
+    struct UpdateResult
+    {
+        vector<MipLoad> _loads;
+    };
+
+    explicit TextureStreamer(size_t inFlightBudgetInBytes, U8 maxLoadsPerUpdate = 4u);
+
+    /// mipSizes[i] is the size in bytes of mip i across all layers. Mips [tailMip, mipSizes.size()) are resident from the start
+    [[nodiscard]] EntryID registerTexture(const vector<size_t>& mipSizes, U8 tailMip);
+    void unregisterTexture(EntryID id);
+
+    /// The finest mip the texture currently needs. Also marks the texture as used in the specified frame
+    void requestMip(EntryID id, U8 mip, U64 frameIndex);
+    /// Completes a load returned by update(). On failure the mip may be requested again
+    void onMipLoaded(EntryID id, U8 mip, bool success);
+
+    /// Schedules loads (to be completed via onMipLoaded) based on the current feedback, as long as they fit in the in-flight budget.
+    /// A single load is always allowed if nothing else is in flight, so mips larger than the budget still make it through
+    [[nodiscard]] UpdateResult update();
+
+    [[nodiscard]] U8 residentMip(EntryID id) const;
+    [[nodiscard]] U8 requestedMip(EntryID id) const;
+    /// Bytes of mip data scheduled by update() but not yet completed
+    [[nodiscard]] size_t inFlightBytes() const;
+    [[nodiscard]] size_t budget() const;
+    void budget(size_t inFlightBudgetInBytes);
+
+  private:
+    struct Entry
+    {
+        vector<size_t> _mipSizes;
+        U64 _lastUsedFrame{ 0u };
+        U8 _tailMip{ 0u };
+        U8 _residentMip{ 0u };
+        U8 _requestedMip{ 0u };
+        U8 _loadingMip{ NO_MIP };
+        bool _valid{ false };
+    };
+
+  private:
+    mutable Mutex _lock;
+    vector<Entry> _entries;
+    vector<EntryID> _freeEntries;
+    size_t _budget{ 0u };
+    size_t _inFlightBytes{ 0u };
+    U8 _maxLoadsPerUpdate{ 4u };
+};
+
+} //namespace Divide
+
+#endif //DVD_TEXTURE_STREAMER_H_
@@ -1,13 +1,16 @@
 
 
 #include "Headers/Texture.h"
+#include "Headers/TextureStreamer.h"
 
 #include "Core/Headers/ByteBuffer.h"
 #include "Core/Headers/DisplayManager.h"
 #include "Core/Headers/Kernel.h"
 #include "Core/Headers/PlatformContext.h"
+#include "Core/Headers/TaskPool.h"
 #include "Core/Resources/Headers/ResourceCache.h"
 #include "Platform/File/Headers/FileManagement.h"
+#include "Platform/File/Headers/MemoryMappedFile.h"
 #include "Platform/Video/Headers/GFXDevice.h"
 #include "Utility/Headers/Localization.h"
 
@@ -16,6 +19,29 @@ namespace Divide
 
     constexpr U16 BYTE_BUFFER_VERSION = 1u;
 
+    namespace
+    {
+        void WriteTransparencyCache( const ResourcePath& cachePath, const std::string_view cacheName, const bool hasTransparency, const bool hasTranslucency )
+        {
+            ByteBuffer metadataCache;
+            metadataCache << BYTE_BUFFER_VERSION;
+            metadataCache << hasTransparency;
+            metadataCache << hasTranslucency;
+            DIVIDE_EXPECTED_CALL( metadataCache.dumpToFile( cachePath, cacheName ) );
+        }
+    };
+
+    struct Texture::StreamingData
+    {
+        MemoryMappedFile _file;
+        ImageTools::DDSLayout _layout;
+        TextureStreamer::EntryID _id{ TextureStreamer::INVALID_ENTRY };
+        Task* _loadTask{ nullptr };
+        /// Written by the load task, read once it finished
+        U8 _loadMip{ U8_MAX };
+        bool _loadSucceeded{ false };
+    };
+
     [[nodiscard]] bool IsEmpty( const TextureLayoutChanges& changes ) noexcept
     {
         for ( const TextureLayoutChange& it : changes )
@@ -37,6 +63,10 @@ namespace Divide
     Handle<Texture> Texture::s_defaultTexture2D = INVALID_HANDLE<Texture>;
     Handle<Texture> Texture::s_defaultTexture2DArray = INVALID_HANDLE<Texture>;
     bool Texture::s_useDDSCache = true;
+    size_t Texture::s_streamingInFlightBudget = 0u;
+    std::unique_ptr<TextureStreamer> Texture::s_textureStreamer = nullptr;
+    vector<Texture*> Texture::s_streamedTextures;
+    Mutex Texture::s_streamedTexturesLock;
 
     void Texture::OnStartup( GFXDevice& gfx )
     {
@@ -71,15 +101,64 @@ namespace Divide
         s_defaultSampler._magFilter = TextureFilter::NEAREST;
         s_defaultSampler._mipSampling = TextureMipSampling::NONE;
         s_defaultSampler._anisotropyLevel = 0u;
+
+        // Mip data is read straight from DDS files, so we can't stream if the API needs it flipped on load
+        if ( s_streamingInFlightBudget > 0u && ImageTools::UseUpperLeftOrigin() )
+        {
+            s_textureStreamer = std::make_unique<TextureStreamer>( s_streamingInFlightBudget );
+        }
     }
 
     void Texture::OnShutdown() noexcept
     {
         DestroyResource(s_defaultTexture2D);
         DestroyResource(s_defaultTexture2DArray);
+
+        DIVIDE_ASSERT( eastl::all_of( s_streamedTextures.begin(), s_streamedTextures.end(), []( const Texture* tex ) { return tex == nullptr; } ) );
+        s_streamedTextures.clear();
+        s_textureStreamer.reset();
+
         ImageTools::OnShutdown();
     }
 
+    void Texture::OnBeginFrame( GFXDevice& gfx )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Streaming );
+
+        DIVIDE_UNUSED( gfx );
+
+        if ( s_textureStreamer == nullptr )
+        {
+            return;
+        }
+
+        const U64 frameIndex = GFXDevice::FrameCount();
+
+        LockGuard<Mutex> w_lock( s_streamedTexturesLock );
+        for ( TextureStreamer::EntryID id = 0u; id < s_streamedTextures.size(); ++id )
+        {
+            Texture* tex = s_streamedTextures[id];
+            if ( tex == nullptr )
+            {
+                continue;
+            }
+
+            tex->completeMipLoad();
+
+            const U8 requestedMip = tex->_requestedMip.exchange( U8_MAX );
+            if ( requestedMip != U8_MAX )
+            {
+                s_textureStreamer->requestMip( id, requestedMip, frameIndex );
+            }
+        }
+
+        const TextureStreamer::UpdateResult result = s_textureStreamer->update();
+        for ( const TextureStreamer::MipLoad& load : result._loads )
+        {
+            s_streamedTextures[load._id]->streamMip( load._mip );
+        }
+    }
+
     bool Texture::UseTextureDDSCache() noexcept
     {
         return s_useDDSCache;
@@ -190,6 +269,7 @@ namespace Divide
 
     Texture::~Texture()
     {
+        unregisterFromStreaming();
     }
 
     bool Texture::load( PlatformContext& context )
@@ -235,6 +315,17 @@ namespace Divide
             // We loop over every texture in the above list and store it in this temporary string
             const ResourcePath currentTextureFullPath = assetLocation().empty() ? Paths::g_texturesLocation : assetLocation();
 
+            // Streamed textures only load their mip tail here. We need the transparency info cached first as we can't compute it from the tail
+            if ( s_textureStreamer != nullptr && !IsArrayTexture( _descriptor._texType ) )
+            {
+                const string textureFiles = assetName().c_str();
+                if ( textureFiles.find( ',' ) == string::npos )
+                {
+                    dataStorage.loadMipTailOnly( !_descriptor._textureOptions._alphaChannelTransparency ||
+                                                 fileExists( Paths::Textures::g_metadataLocation / currentTextureFullPath, Util::Trim( textureFiles ) + ".cache" ) );
+                }
+            }
+
             string currentTextureFile;
             while ( Util::GetLine( textureFileList, currentTextureFile, ',' ) )
             {
@@ -265,6 +356,11 @@ namespace Divide
                     DIVIDE_UNEXPECTED_CALL();
                 }
 
+                if ( dataStorage.firstMip() > 0u )
+                {
+                    registerForStreaming( dataStorage );
+                }
+
                 if ( IsCubeTexture( _descriptor._texType ) && dataStorage.layerCount() % 6 != 0  )
                 {
                     Console::errorfn( LOCALE_STR( "ERROR_TEXTURE_LOADER_CUBMAP_INIT_COUNT" ), resourceName().c_str() );
@@ -293,6 +389,144 @@ namespace Divide
         return 0u;
     }
 
+    U8 Texture::residentMip() const noexcept
+    {
+        return _residentMip.load( std::memory_order_acquire );
+    }
+
+    void Texture::requestMip( const U8 mip ) noexcept
+    {
+        if ( _streamingData == nullptr )
+        {
+            return;
+        }
+
+        U8 crtRequest = _requestedMip.load( std::memory_order_relaxed );
+        // Finest request wins. On failure, crtRequest is refreshed and we check again
+        while ( mip < crtRequest && !_requestedMip.compare_exchange_weak( crtRequest, mip, std::memory_order_relaxed ) )
+        {
+        }
+    }
+
+    SubRange Texture::residentMipRange( const SubRange mipRange ) const noexcept
+    {
+        const U16 firstResident = residentMip();
+        if ( mipRange._offset >= firstResident )
+        {
+            return mipRange;
+        }
+
+        if ( mipRange._count == SubRange::COUNT_MAX )
+        {
+            return { firstResident, SubRange::COUNT_MAX };
+        }
+
+        const U16 rangeEnd = mipRange._offset + mipRange._count;
+        // If none of the requested levels are resident, fall back to the finest one that is
+        return { firstResident, rangeEnd > firstResident ? to_U16( rangeEnd - firstResident ) : U16_ONE };
+    }
+
+    void Texture::registerForStreaming( const ImageTools::ImageData& imageData )
+    {
+        PROFILE_SCOPE_AUTO( Profiler::Category::Streaming );
+
+        DIVIDE_ASSERT( s_textureStreamer != nullptr && _streamingData == nullptr );
+
+        const FileNameAndPath mipSource = splitPathToNameAndLocation( imageData.mipSource() );
+
+        auto streamingData = std::make_unique<StreamingData>();
+        if ( streamingData->_file.open( mipSource._path, mipSource._fileName ) != FileError::NONE ||
+             !ImageTools::GetDDSLayout( { streamingData->_file.data(), streamingData->_file.size() }, streamingData->_layout ) ||
+             streamingData->_layout._mips.size() != mipCount() )
+        {
+            // Keep sampling the mip tail. Better than nothing
+            _residentMip.store( imageData.firstMip() );
+            return;
+        }
+
+        vector<size_t> mipSizes( streamingData->_layout._mips.size() );
+        for ( size_t m = 0u; m < mipSizes.size(); ++m )
+        {
+            mipSizes[m] = streamingData->_layout._mips[m]._size;
+        }
+
+        _residentMip.store( imageData.firstMip() );
+        _streamingData = std::move( streamingData );
+
+        LockGuard<Mutex> w_lock( s_streamedTexturesLock );
+        _streamingData->_id = s_textureStreamer->registerTexture( mipSizes, imageData.firstMip() );
+        if ( _streamingData->_id >= s_streamedTextures.size() )
+        {
+            s_streamedTextures.resize( _streamingData->_id + 1u, nullptr );
+        }
+        s_streamedTextures[_streamingData->_id] = this;
+    }
+
+    void Texture::unregisterFromStreaming()
+    {
+        if ( _streamingData == nullptr )
+        {
+            return;
+        }
+
+        // Leave the list and the streamer together, so OnBeginFrame never gets results for a slot we already cleared.
+        // The completion of a load still in flight is simply dropped (and ignored by the streamer if the slot gets reused)
+        {
+            LockGuard<Mutex> w_lock( s_streamedTexturesLock );
+            s_streamedTextures[_streamingData->_id] = nullptr;
+            s_textureStreamer->unregisterTexture( _streamingData->_id );
+        }
+
+        if ( _streamingData->_loadTask != nullptr && !Finished( *_streamingData->_loadTask ) )
+        {
+            _context.context().taskPool( TaskPoolType::ASSET_LOADER ).wait( *_streamingData->_loadTask );
+        }
+
+        _streamingData.reset();
+    }
+
+    void Texture::streamMip( const U8 mip )
+    {
+        DIVIDE_ASSERT( _streamingData != nullptr && _streamingData->_loadTask == nullptr );
+
+        _streamingData->_loadMip = mip;
+        _streamingData->_loadSucceeded = false;
+        _streamingData->_loadTask = CreateTask( [this, mip]( const Task& )
+        {
+            PROFILE_SCOPE( "Texture::streamMip", Profiler::Category::Streaming );
+
+            StreamingData& streamingData = *_streamingData;
+            const ImageTools::DDSLayout::Mip& mipLayout = streamingData._layout._mips[mip];
+
+            ImageTools::ImageData mipData{};
+            streamingData._loadSucceeded = mipData.loadDDSMips( { streamingData._file.data(), streamingData._file.size() }, streamingData._layout, mip, 1u );
+            if ( streamingData._loadSucceeded )
+            {
+                updateMipsInternal( mipData );
+                // Loaded mips are never dropped, so we won't read these pages again
+                streamingData._file.evict( mipLayout._offset, mipLayout._size );
+            }
+        });
+
+        _context.context().taskPool( TaskPoolType::ASSET_LOADER ).enqueue( *_streamingData->_loadTask, TaskPriority::DONT_CARE );
+    }
+
+    void Texture::completeMipLoad()
+    {
+        StreamingData& streamingData = *_streamingData;
+        if ( streamingData._loadTask == nullptr || !Finished( *streamingData._loadTask ) )
+        {
+            return;
+        }
+
+        streamingData._loadTask = nullptr;
+        s_textureStreamer->onMipLoaded( streamingData._id, streamingData._loadMip, streamingData._loadSucceeded );
+        if ( streamingData._loadSucceeded )
+        {
+            _residentMip.store( s_textureStreamer->residentMip( streamingData._id ), std::memory_order_release );
+        }
+    }
+
     bool Texture::loadFile( const ResourcePath& path, const std::string_view name, ImageTools::ImageData& fileData )
     {
         const bool srgb = _descriptor._packing == GFXImagePacking::NORMALIZED_SRGB;
@@ -309,7 +543,7 @@ namespace Divide
             // missing_texture.jpg must be something that really stands out
             DIVIDE_EXPECTED_CALL( fileData.loadFromFile( _context.context(), srgb, _width, _height, Paths::g_texturesLocation, s_missingTextureFileName ) );
         }
-        else if ( !fileData.hasDummyAlphaChannel() )
+        else
         {
             return checkTransparency( path, name, fileData );
         }
@@ -339,7 +573,8 @@ namespace Divide
     {
         PROFILE_SCOPE_AUTO(Profiler::Category::Graphics);
 
-        ImageUsage ret = prepareTextureData(imageData.dimensions(0u, 0u), imageData.layerCount(), true);
+        // Streamed textures may skip their finest mips on load, but the image is still created for the full mip chain
+        ImageUsage ret = prepareTextureData(imageData.sourceDimensions(), imageData.layerCount(), true);
         DIVIDE_UNUSED(ret);
 
         if ( !IsRenderTargetAttachment(descriptor()) )
@@ -410,10 +645,19 @@ namespace Divide
     {
         PROFILE_SCOPE_AUTO( Profiler::Category::Graphics );
 
+        const ResourcePath cachePath = Paths::Textures::g_metadataLocation / path;
+        const string cacheName = string(name) + ".cache";
+
         if ( fileData.ignoreAlphaChannelTransparency() || fileData.hasDummyAlphaChannel() )
         {
             _hasTransparency = false;
             _hasTranslucency = false;
+
+            // The file has no usable alpha, regardless of texture options, so cache that. Texture streaming needs it to skip full loads
+            if ( fileData.hasDummyAlphaChannel() && !fileExists( cachePath, cacheName ) )
+            {
+                WriteTransparencyCache( cachePath, cacheName, false, false );
+            }
             return true;
         }
 
@@ -424,9 +668,6 @@ namespace Divide
         const U16 height = fileData.dimensions( layer, 0u ).height;
         // If we have an alpha channel, we must check for translucency/transparency
 
-        const ResourcePath cachePath = Paths::Textures::g_metadataLocation / path;
-        const string cacheName = string(name) + ".cache";
-
         ByteBuffer metadataCache;
         bool skip = false;
         if ( metadataCache.loadFromFile( cachePath, cacheName ) )
@@ -445,7 +686,12 @@ namespace Divide
             }
         }
 
-        if ( !skip )
+        if ( !skip && fileData.firstMip() > 0u )
+        {
+            // Mip tail only (stale cache). We don't have decompressed pixels to look at so assume opaque until the cache is rebuilt
+            _hasTransparency = _hasTranslucency = false;
+        }
+        else if ( !skip )
         {
             if ( HasAlphaChannel( fileData.format() ) )
             {
@@ -503,12 +749,9 @@ namespace Divide
                     // All the alpha values are 0, so this channel is useless.
                     _hasTransparency = _hasTranslucency = false;
                 }
-
-                metadataCache << BYTE_BUFFER_VERSION;
-                metadataCache << _hasTransparency;
-                metadataCache << _hasTranslucency;
-                DIVIDE_EXPECTED_CALL( metadataCache.dumpToFile( cachePath, cacheName ) );
             }
+
+            WriteTransparencyCache( cachePath, cacheName, _hasTransparency, _hasTranslucency );
         }
 
         Console::printfn( LOCALE_STR( "TEXTURE_HAS_TRANSPARENCY_TRANSLUCENCY" ),
@@ -0,0 +1,198 @@
+
+
+#include "Headers/TextureStreamer.h"
+
+namespace Divide
+{
+
+TextureStreamer::TextureStreamer(const size_t inFlightBudgetInBytes, const U8 maxLoadsPerUpdate)
+    : _budget(inFlightBudgetInBytes)
+    , _maxLoadsPerUpdate(std::max(maxLoadsPerUpdate, U8_ONE))
+{
+}
+
+TextureStreamer::EntryID TextureStreamer::registerTexture(const vector<size_t>& mipSizes, const U8 tailMip)
+{
+    DIVIDE_ASSERT(!mipSizes.empty() && tailMip < mipSizes.size());
+
+    LockGuard<Mutex> w_lock(_lock);
+
+    EntryID id = INVALID_ENTRY;
+    if (!_freeEntries.empty())
+    {
+        id = _freeEntries.back();
+        _freeEntries.pop_back();
+    }
+    else
+    {
+        id = to_U32(_entries.size());
+        _entries.emplace_back();
+    }
+
+    Entry& entry = _entries[id];
+    entry._mipSizes = mipSizes;
+    entry._lastUsedFrame = 0u;
+    entry._tailMip = tailMip;
+    entry._residentMip = tailMip;
+    // Without any feedback, aim for full resolution and let the budget sort things out
+    entry._requestedMip = 0u;
+    entry._loadingMip = NO_MIP;
+    entry._valid = true;
+
+    return id;
+}
+
+void TextureStreamer::unregisterTexture(const EntryID id)
+{
+    LockGuard<Mutex> w_lock(_lock);
+
+    if (id >= _entries.size() || !_entries[id]._valid)
+    {
+        return;
+    }
+
+    Entry& entry = _entries[id];
+    if (entry._loadingMip != NO_MIP)
+    {
+        // Whatever the owner does with the load now, it no longer counts against the budget
+        _inFlightBytes -= entry._mipSizes[entry._loadingMip];
+    }
+
+    entry = {};
+    _freeEntries.push_back(id);
+}
+
+void TextureStreamer::requestMip(const EntryID id, const U8 mip, const U64 frameIndex)
+{
+    LockGuard<Mutex> w_lock(_lock);
+
+    if (id >= _entries.size() || !_entries[id]._valid)
+    {
+        return;
+    }
+
+    Entry& entry = _entries[id];
+    entry._requestedMip = std::min(mip, entry._tailMip);
+    entry._lastUsedFrame = std::max(entry._lastUsedFrame, frameIndex);
+}
+
+void TextureStreamer::onMipLoaded(const EntryID id, const U8 mip, const bool success)
+{
+    LockGuard<Mutex> w_lock(_lock);
+
+    if (id >= _entries.size() || !_entries[id]._valid)
+    {
+        return;
+    }
+
+    Entry& entry = _entries[id];
+    if (entry._loadingMip != mip)
+    {
+        // Stale completion for a previous user of this slot
+        return;
+    }
+
+    if (success)
+    {
+        entry._residentMip = mip;
+    }
+
+    _inFlightBytes -= entry._mipSizes[mip];
+    entry._loadingMip = NO_MIP;
+}
+
+TextureStreamer::UpdateResult TextureStreamer::update()
+{
+    LockGuard<Mutex> w_lock(_lock);
+
+    UpdateResult result{};
+
+    vector<EntryID> candidates;
+    for (EntryID id = 0u; id < _entries.size(); ++id)
+    {
+        const Entry& entry = _entries[id];
+        if (entry._valid && entry._loadingMip == NO_MIP && entry._requestedMip < entry._residentMip)
+        {
+            candidates.push_back(id);
+        }
+    }
+
+    // Most recently used first. For equally recent textures, favour the blurriest ones as their next mip is also the cheapest
+    eastl::sort(begin(candidates), end(candidates), [&](const EntryID lhs, const EntryID rhs)
+    {
+        const Entry& a = _entries[lhs];
+        const Entry& b = _entries[rhs];
+        if (a._lastUsedFrame != b._lastUsedFrame)
+        {
+            return a._lastUsedFrame > b._lastUsedFrame;
+        }
+        if (a._residentMip != b._residentMip)
+        {
+            return a._residentMip > b._residentMip;
+        }
+        return lhs < rhs;
+    });
+
+    U8 scheduledLoads = 0u;
+    for (const EntryID id : candidates)
+    {
+        if (scheduledLoads == _maxLoadsPerUpdate)
+        {
+            break;
+        }
+
+        Entry& entry = _entries[id];
+        const U8 nextMip = entry._residentMip - 1u;
+        const size_t cost = entry._mipSizes[nextMip];
+
+        // A cheaper (blurrier) mip further down the list may still fit
+        if (_inFlightBytes > 0u && _inFlightBytes + cost > _budget)
+        {
+            continue;
+        }
+
+        _inFlightBytes += cost;
+        entry._loadingMip = nextMip;
+        result._loads.push_back({ id, nextMip });
+        ++scheduledLoads;
+    }
+
+    return result;
+}
+
+U8 TextureStreamer::residentMip(const EntryID id) const
+{
+    LockGuard<Mutex> r_lock(_lock);
+
+    return id < _entries.size() && _entries[id]._valid ? _entries[id]._residentMip : NO_MIP;
+}
+
+U8 TextureStreamer::requestedMip(const EntryID id) const
+{
+    LockGuard<Mutex> r_lock(_lock);
+
+    return id < _entries.size() && _entries[id]._valid ? _entries[id]._requestedMip : NO_MIP;
+}
+
+size_t TextureStreamer::inFlightBytes() const
+{
+    LockGuard<Mutex> r_lock(_lock);
+
+    return _inFlightBytes;
+}
+
+size_t TextureStreamer::budget() const
+{
+    LockGuard<Mutex> r_lock(_lock);
+
+    return _budget;
+}
+
+void TextureStreamer::budget(const size_t inFlightBudgetInBytes)
+{
+    LockGuard<Mutex> w_lock(_lock);
+
+    _budget = inFlightBudgetInBytes;
+}
+
+} //namespace Divide
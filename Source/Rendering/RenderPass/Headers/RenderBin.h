@@ -110,6 +110,8 @@ using RenderQueuePackages = fixed_vector<RenderQueuePackage, Config::MAX_VISIBLE
 
 /// This class contains a list of "RenderBinItem"'s and stores them sorted depending on designation
 class RenderBin {
+    friend struct RenderBinBenchmarkAccessor;
+
    public:
     using RenderBinStack = eastl::array<RenderBinItem, Config::MAX_VISIBLE_NODES>;
     using SortedQueue = fixed_vector<RenderingComponent*, Config::MAX_VISIBLE_NODES>;
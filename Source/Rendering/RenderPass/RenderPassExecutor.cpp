@@ -377,15 +377,9 @@ namespace Divide
 
         if ( node->HasComponents( ComponentType::ANIMATION ) )
         {
-            AnimEvaluator::FrameIndex frameIndex{};
             const AnimationComponent* animComp = node->get<AnimationComponent>();
-            const U8 boneCount = animComp->boneCount();
-            if ( animComp->playAnimations() )
-            {
-                frameIndex = animComp->frameIndex();
-            }
-            transformOut._data.x = to_F32(std::max(frameIndex._curr, 0));
-            transformOut._data.y = to_F32(boneCount);
+            transformOut._data.x = to_F32(animComp->boneBufferFrame());
+            transformOut._data.y = to_F32(animComp->boneCount());
         }
 
         transformOut._data.z = rComp->getLoDLevel(RenderStage::DISPLAY);
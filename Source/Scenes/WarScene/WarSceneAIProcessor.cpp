@@ -894,11 +894,11 @@ string WarSceneAIProcessor::toString( [[maybe_unused]] bool state) const
         "       Team count - Own Team: [ {} ] Enemy Team: [ {} ]\n",
         _globalWorkingMemory._teamAliveCount[ownTeamID].value(),
         _globalWorkingMemory._teamAliveCount[enemyTeamID].value()));
-    for (const auto&[fact, value] : worldState().vars_) {
+    worldState().forEachVariable([&ret](const GOAPFact fact, const GOAPValue value) {
         ret.append(Util::StringFormat("        World state fact [ {} ] : [ {} ]\n",
                                   WarSceneFactName(fact).c_str(),
                                   value ? "true" : "false"));
-    }
+    });
     ret.append("--------------- Working memory state END ----------------------------\n");
 
     if (getActiveGoal()) {
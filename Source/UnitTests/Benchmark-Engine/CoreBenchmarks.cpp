@@ -0,0 +1,212 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/TaskPool.h"
+#include "Core/Headers/ByteBuffer.h"
+
+namespace Divide
+{
+
+namespace
+{
+    // Fixed seed and sizes so that every run measures the exact same work
+    constexpr U32 g_benchmarkSeed = 0xD1F1DEu;
+    constexpr U32 g_elementCount = 1u << 14;
+
+    [[nodiscard]] vector<mat4<F32>> GenerateMatrices(const size_t count)
+    {
+        vector<mat4<F32>> ret(count);
+        for (mat4<F32>& mat : ret)
+        {
+            for (U8 i = 0u; i < 16u; ++i)
+            {
+                mat.mat[i] = Random(-10.f, 10.f);
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] vector<float3> GenerateVectors(const size_t count)
+    {
+        vector<float3> ret(count);
+        for (float3& vec : ret)
+        {
+            vec.set(Random(-10.f, 10.f), Random(-10.f, 10.f), Random(-10.f, 10.f));
+        }
+        return ret;
+    }
+} //namespace
+
+TEST_CASE( "TaskPool Benchmarks", "[benchmark][threading]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "BENCHMARK_POOL" );
+    REQUIRE( pool.init( std::thread::hardware_concurrency() ) );
+
+    BENCHMARK( "Enqueue and wait 256 child tasks" )
+    {
+        Task* parent = CreateTask( TASK_NOP );
+        for ( U32 i = 0u; i < 256u; ++i )
+        {
+            pool.enqueue( *CreateTask( parent, TASK_NOP ) );
+        }
+        pool.enqueue( *parent );
+        pool.wait( *parent );
+        return Finished( *parent );
+    };
+
+    vector<F32> values( g_elementCount * 16u, 2.f );
+    const auto work = [&values]( [[maybe_unused]] const Task* parentTask, const U32 start, const U32 end )
+    {
+        for ( U32 i = start; i < end; ++i )
+        {
+            values[i] = Sqrt( values[i] * values[i] + 1.f );
+        }
+    };
+
+    ParallelForDescriptor descriptor = {};
+    descriptor._iterCount = to_U32( values.size() );
+    descriptor._partitionSize = 4096u;
+
+    BENCHMARK( "Parallel_For 256k elements" )
+    {
+        Parallel_For( pool, descriptor, work );
+        return values[0];
+    };
+
+    descriptor._useCurrentThread = false;
+    BENCHMARK( "Parallel_For 256k elements (no current thread)" )
+    {
+        Parallel_For( pool, descriptor, work );
+        return values[0];
+    };
+
+    pool.shutdown();
+}
+
+TEST_CASE( "ByteBuffer Benchmarks", "[benchmark][byte_buffer]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    SeedRandom( g_benchmarkSeed );
+
+    vector<U32> values( g_elementCount );
+    for ( U32& value : values )
+    {
+        value = Random( U32_MAX );
+    }
+
+    const string text = "ByteBuffer benchmark string payload";
+
+    ByteBuffer buffer;
+    buffer.reserve( g_elementCount * sizeof( U32 ) * 2u );
+
+    BENCHMARK( "Write 16k PODs" )
+    {
+        buffer.clear();
+        for ( const U32 value : values )
+        {
+            buffer << value;
+        }
+        return buffer.wpos();
+    };
+
+    BENCHMARK( "Write and read 16k PODs" )
+    {
+        buffer.clear();
+        for ( const U32 value : values )
+        {
+            buffer << value;
+        }
+
+        U32 sum = 0u, value = 0u;
+        while ( !buffer.bufferEmpty() )
+        {
+            buffer >> value;
+            sum += value;
+        }
+        return sum;
+    };
+
+    BENCHMARK( "Write and read 1k strings" )
+    {
+        buffer.clear();
+        for ( U32 i = 0u; i < 1024u; ++i )
+        {
+            buffer << text;
+        }
+
+        size_t length = 0u;
+        string value;
+        for ( U32 i = 0u; i < 1024u; ++i )
+        {
+            buffer >> value;
+            length += value.length();
+        }
+        return length;
+    };
+
+    BENCHMARK( "Write and read 16k element vector" )
+    {
+        buffer.clear();
+        buffer << values;
+
+        vector<U32> output;
+        buffer >> output;
+        return output.size();
+    };
+}
+
+TEST_CASE( "Math Benchmarks", "[benchmark][math]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    SeedRandom( g_benchmarkSeed );
+
+    const vector<mat4<F32>> matricesA = GenerateMatrices( g_elementCount );
+    const vector<mat4<F32>> matricesB = GenerateMatrices( g_elementCount );
+    const vector<float3> vectors = GenerateVectors( g_elementCount );
+
+    vector<mat4<F32>> matricesOut( g_elementCount );
+    vector<float4> vectorsOut( g_elementCount );
+
+    BENCHMARK( "mat4 * mat4 (16k)" )
+    {
+        for ( U32 i = 0u; i < g_elementCount; ++i )
+        {
+            mat4<F32>::Multiply( matricesA[i], matricesB[i], matricesOut[i] );
+        }
+        return matricesOut[0].mat[0];
+    };
+
+    BENCHMARK( "mat4 * vec4 (16k)" )
+    {
+        for ( U32 i = 0u; i < g_elementCount; ++i )
+        {
+            vectorsOut[i] = matricesA[i] * float4( vectors[i], 1.f );
+        }
+        return vectorsOut[0].x;
+    };
+
+    BENCHMARK( "mat4 inverse (16k)" )
+    {
+        for ( U32 i = 0u; i < g_elementCount; ++i )
+        {
+            matricesOut[i] = matricesA[i].getInverse();
+        }
+        return matricesOut[0].mat[0];
+    };
+
+    BENCHMARK( "vec3 normalize, dot and cross (16k)" )
+    {
+        F32 sum = 0.f;
+        for ( U32 i = 1u; i < g_elementCount; ++i )
+        {
+            const float3 normal = Normalized( Cross( vectors[i - 1], vectors[i] ) );
+            sum += Dot( normal, vectors[i] );
+        }
+        return sum;
+    };
+}
+
+} //namespace Divide
@@ -0,0 +1,161 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Geometry/Importer/Headers/DVDConverter.h"
+#include "Geometry/Importer/Headers/MeshImporter.h"
+#include "Geometry/Importer/Headers/MeshletData.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+#include "Core/Headers/ByteBuffer.h"
+#include "Core/Headers/TaskPool.h"
+#include "Platform/Video/Buffers/VertexBuffer/Headers/VertexBuffer.h"
+
+#include <assimp/mesh.h>
+
+namespace Divide
+{
+
+namespace
+{
+    // 128 x 128 quads = 32k triangles. Big enough for meshoptimizer and LoD generation to show up, small enough to run quickly.
+    constexpr U32 g_gridSize = 128u;
+
+    [[nodiscard]] F32 GridHeight( const F32 x, const F32 y )
+    {
+        // Gentle waves so that simplification has something to preserve
+        return 0.05f * std::sin( x * 12.f ) * std::cos( y * 9.f );
+    }
+
+    /// A (gridSize x gridSize) heightfield on the XY plane, facing +Z, laid out like assimp hands triangulated meshes to the importer
+    void BuildGridMesh( aiMesh& meshOut )
+    {
+        const U32 vertexCount = (g_gridSize + 1u) * (g_gridSize + 1u);
+
+        meshOut.mNumVertices = vertexCount;
+        meshOut.mVertices = new aiVector3D[vertexCount];
+        meshOut.mNormals = new aiVector3D[vertexCount];
+        meshOut.mTangents = new aiVector3D[vertexCount];
+        meshOut.mBitangents = new aiVector3D[vertexCount];
+        meshOut.mTextureCoords[0] = new aiVector3D[vertexCount];
+        meshOut.mNumUVComponents[0] = 2u;
+
+        for ( U32 y = 0u, v = 0u; y <= g_gridSize; ++y )
+        {
+            for ( U32 x = 0u; x <= g_gridSize; ++x, ++v )
+            {
+                const F32 u = to_F32( x ) / g_gridSize;
+                const F32 w = to_F32( y ) / g_gridSize;
+                meshOut.mVertices[v] = aiVector3D( u - 0.5f, w - 0.5f, 0.5f + GridHeight( u, w ) );
+                meshOut.mNormals[v] = aiVector3D( 0.f, 0.f, 1.f );
+                meshOut.mTangents[v] = aiVector3D( 1.f, 0.f, 0.f );
+                meshOut.mBitangents[v] = aiVector3D( 0.f, 1.f, 0.f );
+                meshOut.mTextureCoords[0][v] = aiVector3D( u, w, 0.f );
+            }
+        }
+
+        const auto vertex = []( const U32 x, const U32 y ) { return y * (g_gridSize + 1u) + x; };
+
+        meshOut.mNumFaces = g_gridSize * g_gridSize * 2u;
+        meshOut.mFaces = new aiFace[meshOut.mNumFaces];
+        const auto setFace = [&meshOut]( const U32 face, const U32 a, const U32 b, const U32 c )
+        {
+            meshOut.mFaces[face].mNumIndices = 3u;
+            meshOut.mFaces[face].mIndices = new unsigned int[3]{ a, b, c };
+        };
+
+        for ( U32 y = 0u, f = 0u; y < g_gridSize; ++y )
+        {
+            for ( U32 x = 0u; x < g_gridSize; ++x )
+            {
+                setFace( f++, vertex( x, y ), vertex( x + 1, y ), vertex( x + 1, y + 1 ) );
+                setFace( f++, vertex( x, y ), vertex( x + 1, y + 1 ), vertex( x, y + 1 ) );
+            }
+        }
+
+        meshOut.mAABB = aiAABB( aiVector3D( -0.5f, -0.5f, 0.45f ), aiVector3D( 0.5f, 0.5f, 0.55f ) );
+    }
+} //namespace
+
+TEST_CASE( "Mesh Import Benchmarks", "[benchmark][mesh_import]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    aiMesh mesh;
+    BuildGridMesh( mesh );
+
+    const Import::ImportData importData( ResourcePath( "Benchmark" ), "Benchmark" );
+
+    BENCHMARK( "Import 32k triangle submesh geometry" )
+    {
+        Import::SubMeshData subMeshData{};
+        DVDConverter::detail::LoadSubMeshGeometry( &mesh, subMeshData, importData );
+        return subMeshData._lodCount;
+    };
+
+    Import::SubMeshData subMeshData{};
+    DVDConverter::detail::LoadSubMeshGeometry( &mesh, subMeshData, importData );
+    const vector<U32>& indices = subMeshData._indices[0];
+    const vector<float3>& positions = subMeshData._vertices._positions;
+    REQUIRE_FALSE( indices.empty() );
+
+    BENCHMARK( "Build meshlets for 32k triangles" )
+    {
+        MeshletData data;
+        BuildMeshlets( indices, &positions[0].x, positions.size(), sizeof( float3 ), data );
+        return data._meshlets.size();
+    };
+
+    TaskPool pool( "BENCHMARK_POOL" );
+    REQUIRE( pool.init( std::thread::hardware_concurrency() ) );
+
+    vector<VertexBuffer::Vertex> vertices;
+    vector<U32> bufferIndices;
+    DVDConverter::detail::PackSubMeshGeometry( subMeshData, 0u, vertices, bufferIndices );
+    REQUIRE_FALSE( subMeshData._triangles[0].empty() );
+
+    // The vertex and index data cached with every geometry file
+    BENCHMARK( "Serialize and deserialize vertex buffer geometry" )
+    {
+        ByteBuffer buffer;
+        VertexBuffer::SerializeGeometry( pool, vertices, bufferIndices, buffer );
+
+        vector<VertexBuffer::Vertex> loadedVertices;
+        vector<U32> loadedIndices;
+        DIVIDE_UNUSED( VertexBuffer::DeserializeGeometry( pool, buffer, loadedVertices, loadedIndices ) );
+        return loadedVertices.size() + loadedIndices.size();
+    };
+
+    // Per submesh data: LoD triangle lists, meshlets and material
+    BENCHMARK( "Serialize and deserialize submesh" )
+    {
+        ByteBuffer buffer;
+        DIVIDE_UNUSED( subMeshData.serialize( buffer ) );
+
+        Import::SubMeshData loaded{};
+        DIVIDE_UNUSED( loaded.deserialize( buffer ) );
+        return loaded._triangles[0].size();
+    };
+
+    pool.shutdown();
+
+    // An identity view-projection gives us the [-1, 1] cube as the frustum. The grid sits inside it, facing the camera
+    Frustum frustum;
+    frustum.computePlanes( MAT4_IDENTITY );
+
+    vector<U32> visibleMeshlets;
+    visibleMeshlets.reserve( subMeshData._meshlets._meshlets.size() );
+
+    BENCHMARK( "Cull meshlets (front facing)" )
+    {
+        visibleMeshlets.clear();
+        CullMeshlets( subMeshData._meshlets, frustum, float3{ 0.f, 0.f, 5.f }, visibleMeshlets );
+        return visibleMeshlets.size();
+    };
+
+    BENCHMARK( "Cull meshlets (back facing)" )
+    {
+        visibleMeshlets.clear();
+        CullMeshlets( subMeshData._meshlets, frustum, float3{ 0.f, 0.f, -5.f }, visibleMeshlets );
+        return visibleMeshlets.size();
+    };
+}
+
+} //namespace Divide
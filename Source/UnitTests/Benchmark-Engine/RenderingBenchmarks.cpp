@@ -0,0 +1,379 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Rendering/Camera/Headers/Camera.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+#include "Rendering/RenderPass/Headers/RenderBin.h"
+#include "Core/Math/Headers/TransformInterface.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+#include "Platform/Video/Headers/CommandBufferPool.h"
+#include "Environment/Terrain/Quadtree/Headers/Quadtree.h"
+
+namespace Divide
+{
+
+struct RenderBinBenchmarkAccessor
+{
+    static void Fill( RenderBin& bin, const RenderBinItem* items, const U16 count )
+    {
+        eastl::copy( items, items + count, begin( bin._renderBinStack ) );
+        bin._renderBinIndex.store( count );
+    }
+};
+
+namespace
+{
+    // Fixed seed and sizes so that every run measures the exact same work
+    constexpr U32 g_benchmarkSeed = 0xD1F1DEu;
+    constexpr U32 g_nodeCount = 4096u;
+    // Each node has 4 children, giving us a reasonably deep (~6 levels) scene graph
+    constexpr U32 g_hierarchyFanout = 4u;
+
+    const float3 g_eyePosition{ 0.f, 0.f, 5.f };
+
+    struct BenchmarkNode
+    {
+        TransformValues _localA;
+        TransformValues _localB;
+        BoundingBox _localBounds;
+        U32 _parent{ U32_MAX };
+    };
+
+    [[nodiscard]] vector<BenchmarkNode> GenerateNodes()
+    {
+        SeedRandom( g_benchmarkSeed );
+
+        vector<BenchmarkNode> ret( g_nodeCount );
+        for ( U32 i = 0u; i < g_nodeCount; ++i )
+        {
+            BenchmarkNode& node = ret[i];
+            node._parent = i == 0u ? U32_MAX : (i - 1u) / g_hierarchyFanout;
+            for ( TransformValues* values : { &node._localA, &node._localB } )
+            {
+                values->_translation.set( Random( -1.f, 1.f ), Random( -1.f, 1.f ), Random( -1.f, 1.f ) );
+                values->_orientation = quatf( Angle::to_RADIANS( vec3<Angle::DEGREES_F>( Random( -45.f, 45.f ), Random( -180.f, 180.f ), 0.f ) ) );
+                values->_scale.set( Random( 0.8f, 1.2f ) );
+            }
+            const float3 halfExtent{ Random( 0.05f, 0.25f ), Random( 0.05f, 0.25f ), Random( 0.05f, 0.25f ) };
+            node._localBounds.set( -halfExtent, halfExtent );
+        }
+        return ret;
+    }
+
+    [[nodiscard]] vector<RenderBinItem> GenerateRenderBinItems( const U16 count )
+    {
+        SeedRandom( g_benchmarkSeed );
+
+        vector<RenderBinItem> ret( count );
+        for ( RenderBinItem& item : ret )
+        {
+            // Few shaders, more states and lots of textures, roughly what a real scene looks like
+            item._shaderKey = Random( 0, 16 );
+            item._stateHash = to_size( Random( 0, 64 ) );
+            item._textureKey = Random( 0, 512 );
+            item._distanceToCameraSq = Random( 0.f, 1000.f );
+            item._hasTransparency = Random( 0, 8 ) == 0;
+        }
+        return ret;
+    }
+
+    /// Parents always come before their children, so a single linear pass updates the whole hierarchy
+    void UpdateWorldMatrices( const vector<BenchmarkNode>& nodes, const F32 interpolationFactor, vector<mat4<F32>>& worldMatricesOut )
+    {
+        for ( size_t i = 0u; i < nodes.size(); ++i )
+        {
+            const BenchmarkNode& node = nodes[i];
+            const mat4<F32> local = GetMatrix( Lerp( node._localA, node._localB, interpolationFactor ) );
+            worldMatricesOut[i] = node._parent == U32_MAX ? local : worldMatricesOut[node._parent] * local;
+        }
+    }
+
+    void BuildDrawCommands( GFX::CommandBuffer& bufferInOut, const U32 drawCount )
+    {
+        bufferInOut.clear();
+
+        auto scope = GFX::EnqueueCommand<GFX::BeginDebugScopeCommand>( bufferInOut );
+        scope->_scopeName = "Benchmark Pass";
+
+        GFX::EnqueueCommand<GFX::SetViewportCommand>( bufferInOut )->_viewport.set( 0, 0, 1920, 1080 );
+
+        for ( U32 i = 0u; i < drawCount; ++i )
+        {
+            GenericDrawCommand drawCmd{};
+            drawCmd._cmd.indexCount = 36u;
+            drawCmd._commandOffset = i;
+            GFX::EnqueueCommand<GFX::DrawCommand>( bufferInOut )->_drawCommands.emplace_back( drawCmd );
+        }
+
+        GFX::EnqueueCommand<GFX::EndDebugScopeCommand>( bufferInOut );
+    }
+
+    /// Node layout of the quadtree before it was flattened: one heap allocation per node, AoS bounds, recursive traversal
+    struct PointerQuadtreeNode
+    {
+        BoundingBox _bounds;
+        std::array<std::unique_ptr<PointerQuadtreeNode>, 4> _children;
+        U32 _node{ 0u };
+        U8 _LoD{ 0u };
+    };
+
+    [[nodiscard]] std::unique_ptr<PointerQuadtreeNode> BuildPointerQuadtree( const Quadtree& tree, const U32 node, const U8 level )
+    {
+        std::unique_ptr<PointerQuadtreeNode> ret = std::make_unique<PointerQuadtreeNode>();
+        ret->_bounds = tree.nodeBounds( node );
+        ret->_node = node;
+        ret->_LoD = to_U8( tree.getLeafLevel() - level );
+        if ( level < tree.getLeafLevel() )
+        {
+            const U32 firstChild = Quadtree::LevelOffset( level + 1u ) + (node - Quadtree::LevelOffset( level )) * 4u;
+            for ( U32 c = 0u; c < 4u; ++c )
+            {
+                ret->_children[c] = BuildPointerQuadtree( tree, firstChild + c, level + 1u );
+            }
+        }
+        return ret;
+    }
+
+    void SelectPointerQuadtree( const PointerQuadtreeNode& node, const float3& eye, const Frustum& frustum, const F32 lodThreshold, vector<Quadtree::Selection>& selectionOut )
+    {
+        if ( frustum.ContainsBoundingBox( node._bounds ) == FrustumCollision::FRUSTUM_OUT )
+        {
+            return;
+        }
+
+        const BoundingBox& bb = node._bounds;
+        const float3 closest{ CLAMPED( eye.x, bb._min.x, bb._max.x ), CLAMPED( eye.y, bb._min.y, bb._max.y ), CLAMPED( eye.z, bb._min.z, bb._max.z ) };
+        const F32 extent = std::max( bb._max.x - bb._min.x, bb._max.z - bb._min.z );
+        if ( node._children[0] == nullptr || extent < lodThreshold * closest.distance( eye ) )
+        {
+            selectionOut.push_back( { node._node, node._LoD } );
+            return;
+        }
+
+        for ( const std::unique_ptr<PointerQuadtreeNode>& child : node._children )
+        {
+            SelectPointerQuadtree( *child, eye, frustum, lodThreshold, selectionOut );
+        }
+    }
+} //namespace
+
+TEST_CASE( "Culling Benchmarks", "[benchmark][culling]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // An identity view-projection gives us the [-1, 1] cube as the frustum. The nodes spread well past it.
+    Frustum frustum;
+    frustum.computePlanes( MAT4_IDENTITY );
+
+    SeedRandom( g_benchmarkSeed );
+
+    vector<BoundingBox> boxes( g_nodeCount );
+    for ( BoundingBox& box : boxes )
+    {
+        const float3 center{ Random( -3.f, 3.f ), Random( -3.f, 3.f ), Random( -3.f, 3.f ) };
+        const float3 halfExtent{ Random( 0.05f, 0.5f ), Random( 0.05f, 0.5f ), Random( 0.05f, 0.5f ) };
+        box.set( center - halfExtent, center + halfExtent );
+    }
+
+    BENCHMARK( "Frustum vs 4k AABBs" )
+    {
+        U32 visibleCount = 0u;
+        for ( const BoundingBox& box : boxes )
+        {
+            if ( frustum.ContainsBoundingBox( box ) != FrustumCollision::FRUSTUM_OUT )
+            {
+                ++visibleCount;
+            }
+        }
+        return visibleCount;
+    };
+
+    BENCHMARK( "Frustum vs 4k spheres" )
+    {
+        U32 visibleCount = 0u;
+        for ( const BoundingBox& box : boxes )
+        {
+            if ( frustum.ContainsSphere( box.getCenter(), box.getHalfExtent().length() ) != FrustumCollision::FRUSTUM_OUT )
+            {
+                ++visibleCount;
+            }
+        }
+        return visibleCount;
+    };
+}
+
+TEST_CASE( "Terrain Quadtree Benchmarks", "[benchmark][terrain_quadtree]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // 4k x 4k heightmap: 5 levels of splits, 1k leaves. Flat bounds, no chunks, so only the traversal is measured
+    Quadtree tree;
+    tree.build( BoundingBox( float3{ -2048.f, 0.f, -2048.f }, float3{ 2048.f, 200.f, 2048.f } ), vec2<U16>{ 4096u, 4096u }, nullptr );
+    const std::unique_ptr<PointerQuadtreeNode> pointerTree = BuildPointerQuadtree( tree, 0u, 0u );
+
+    // A fixed walk over the terrain, looking towards its centre
+    SeedRandom( g_benchmarkSeed );
+    constexpr U32 viewCount = 64u;
+    vector<float3> eyes( viewCount );
+    vector<Frustum> frusta( viewCount );
+    for ( U32 i = 0u; i < viewCount; ++i )
+    {
+        eyes[i].set( Random( -2000.f, 2000.f ), Random( 50.f, 400.f ), Random( -2000.f, 2000.f ) );
+        mat4<F32> viewProjection;
+        mat4<F32>::Multiply( Camera::Perspective( Angle::DEGREES_F( 60.f ), 16.f / 9.f, 0.1f, 5000.f ), Camera::LookAt( eyes[i], VECTOR3_ZERO, WORLD_Y_AXIS ), viewProjection );
+        frusta[i].computePlanes( viewProjection );
+    }
+
+    constexpr F32 lodThreshold = 1.f;
+    vector<Quadtree::Selection> selection;
+
+    BENCHMARK( "Select terrain LoD, 64 views (implicit tree)" )
+    {
+        size_t selected = 0u;
+        for ( U32 i = 0u; i < viewCount; ++i )
+        {
+            tree.selectLoD( eyes[i], frusta[i].planes(), lodThreshold, selection );
+            selected += selection.size();
+        }
+        return selected;
+    };
+
+    BENCHMARK( "Select terrain LoD, 64 views (pointer tree)" )
+    {
+        size_t selected = 0u;
+        for ( U32 i = 0u; i < viewCount; ++i )
+        {
+            selection.clear();
+            SelectPointerQuadtree( *pointerTree, eyes[i], frusta[i], lodThreshold, selection );
+            selected += selection.size();
+        }
+        return selected;
+    };
+}
+
+TEST_CASE( "RenderBin Sort Benchmarks", "[benchmark][render_bin]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const vector<RenderBinItem> items = GenerateRenderBinItems( Config::MAX_VISIBLE_NODES );
+    // The render bin stack is too large to comfortably live on the stack
+    std::unique_ptr<RenderBin> bin = std::make_unique<RenderBin>();
+
+    for ( const U16 count : { U16{ 16u }, U16{ 1024u }, Config::MAX_VISIBLE_NODES } )
+    {
+        for ( const RenderingOrder order : { RenderingOrder::FRONT_TO_BACK, RenderingOrder::FRONT_TO_BACK_ALPHA_LAST, RenderingOrder::BY_STATE } )
+        {
+            const string name = Util::StringFormat( "Fill and sort {} items ({})", count, order == RenderingOrder::BY_STATE ? "BY_STATE" : order == RenderingOrder::FRONT_TO_BACK ? "FRONT_TO_BACK" : "FRONT_TO_BACK_ALPHA_LAST" );
+            BENCHMARK( name )
+            {
+                RenderBinBenchmarkAccessor::Fill( *bin, items.data(), count );
+                bin->sort( RenderBinType::OPAQUE, order );
+                return bin->getItem( 0u )._distanceToCameraSq;
+            };
+        }
+    }
+}
+
+TEST_CASE( "Transform Update Benchmarks", "[benchmark][transforms]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const vector<BenchmarkNode> nodes = GenerateNodes();
+    vector<mat4<F32>> worldMatrices( nodes.size() );
+    vector<BoundingBox> worldBounds( nodes.size() );
+
+    BENCHMARK( "Interpolate and update 4k node hierarchy" )
+    {
+        UpdateWorldMatrices( nodes, 0.5f, worldMatrices );
+        return worldMatrices.back().mat[0];
+    };
+
+    BENCHMARK( "Transform 4k bounding boxes" )
+    {
+        for ( size_t i = 0u; i < nodes.size(); ++i )
+        {
+            worldBounds[i].transform( nodes[i]._localBounds, worldMatrices[i] );
+        }
+        return worldBounds.back().getCenter().x;
+    };
+}
+
+TEST_CASE( "Command Buffer Benchmarks", "[benchmark][command_buffer]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    Handle<GFX::CommandBuffer> handle = GFX::AllocateCommandBuffer( "Benchmark Command Buffer" );
+    GFX::CommandBuffer& buffer = *GFX::Get( handle );
+
+    BENCHMARK( "Build 1k draw commands" )
+    {
+        BuildDrawCommands( buffer, 1024u );
+        return buffer.commands().size();
+    };
+
+    BENCHMARK( "Build and batch 1k draw commands" )
+    {
+        BuildDrawCommands( buffer, 1024u );
+        buffer.batch();
+        return buffer.commands().size();
+    };
+
+    BENCHMARK( "Allocate and release command buffer" )
+    {
+        Handle<GFX::CommandBuffer> tempHandle = GFX::AllocateCommandBuffer( "Benchmark Temp Command Buffer" );
+        GFX::DeallocateCommandBuffer( tempHandle );
+        return tempHandle;
+    };
+
+    GFX::DeallocateCommandBuffer( handle );
+}
+
+TEST_CASE( "Frame Benchmarks", "[benchmark][frame]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    // A CPU-only approximation of a single render pass: update transforms, cull, sort the survivors and record their draws
+    const vector<BenchmarkNode> nodes = GenerateNodes();
+    vector<mat4<F32>> worldMatrices( nodes.size() );
+    vector<RenderBinItem> visibleItems;
+    visibleItems.reserve( nodes.size() );
+
+    Frustum frustum;
+    frustum.computePlanes( MAT4_IDENTITY );
+
+    std::unique_ptr<RenderBin> bin = std::make_unique<RenderBin>();
+
+    Handle<GFX::CommandBuffer> handle = GFX::AllocateCommandBuffer( "Benchmark Frame Command Buffer" );
+    GFX::CommandBuffer& buffer = *GFX::Get( handle );
+
+    BENCHMARK( "Update, cull, sort and record 4k nodes" )
+    {
+        UpdateWorldMatrices( nodes, 0.5f, worldMatrices );
+
+        visibleItems.clear();
+        BoundingBox worldBounds;
+        for ( size_t i = 0u; i < nodes.size(); ++i )
+        {
+            worldBounds.transform( nodes[i]._localBounds, worldMatrices[i] );
+            if ( frustum.ContainsBoundingBox( worldBounds ) != FrustumCollision::FRUSTUM_OUT )
+            {
+                RenderBinItem& item = visibleItems.emplace_back();
+                item._shaderKey = to_I64( i % 16u );
+                item._stateHash = i % 64u;
+                item._textureKey = to_I64( i % 512u );
+                item._distanceToCameraSq = worldBounds.getCenter().distanceSquared( g_eyePosition );
+            }
+        }
+
+        const U16 visibleCount = to_U16( visibleItems.size() );
+        RenderBinBenchmarkAccessor::Fill( *bin, visibleItems.data(), visibleCount );
+        bin->sort( RenderBinType::OPAQUE, RenderingOrder::BY_STATE );
+
+        BuildDrawCommands( buffer, visibleCount );
+        buffer.batch();
+        return buffer.commands().size();
+    };
+
+    GFX::DeallocateCommandBuffer( handle );
+}
+
+} //namespace Divide
@@ -0,0 +1,220 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Geometry/Animations/Headers/AnimationBlendTree.h"
+#include "Geometry/Animations/Headers/SceneAnimator.h"
+
+#include <assimp/anim.h>
+
+namespace Divide
+{
+namespace
+{
+    constexpr F32 g_tolerance = 1e-4f;
+
+    // 10 ticks at 10 ticks per second = 1 second long clip that moves the "child" bone from start to end
+    std::unique_ptr<AnimEvaluator> MakeTranslationClip(const char* name, const aiVector3D& start, const aiVector3D& end)
+    {
+        aiAnimation animation;
+        animation.mName = name;
+        animation.mDuration = 10.0;
+        animation.mTicksPerSecond = 10.0;
+        animation.mNumChannels = 1u;
+        animation.mChannels = new aiNodeAnim*[1];
+
+        aiNodeAnim* channel = new aiNodeAnim();
+        channel->mNodeName = "child";
+        channel->mNumPositionKeys = 2u;
+        channel->mPositionKeys = new aiVectorKey[2]{ aiVectorKey(0.0, start), aiVectorKey(10.0, end) };
+        channel->mNumRotationKeys = 1u;
+        channel->mRotationKeys = new aiQuatKey[1]{ aiQuatKey(0.0, aiQuaternion()) };
+        animation.mChannels[0] = channel;
+
+        return std::make_unique<AnimEvaluator>(&animation, 0u);
+    }
+
+    // root -> child, both skinned with identity offsets and bind poses
+    SkeletonLayout MakeLayout(const size_t animationCount)
+    {
+        SkeletonLayout layout;
+        layout._parents = { -1, 0 };
+        layout._boneIDs = { 0u, 1u };
+        layout._nameHashes = { _ID("root"), _ID("child") };
+        layout._offsetMatrices = { MAT4_IDENTITY, MAT4_IDENTITY };
+        layout._bindPose.resize(2u);
+        layout._channelBones.resize(animationCount, vector<I16>{ 1 });
+        return layout;
+    }
+
+    struct BlendTreeTestData
+    {
+        AnimationList _animations;
+        SkeletonLayout _layout;
+        BoneMatrices _skinning;
+
+        BlendTreeTestData()
+        {
+            _animations.emplace_back(MakeTranslationClip("idle", aiVector3D(0.f, 0.f, 0.f), aiVector3D(0.f, 0.f, 0.f)));
+            _animations.emplace_back(MakeTranslationClip("run",  aiVector3D(2.f, 0.f, 0.f), aiVector3D(2.f, 0.f, 0.f)));
+            _animations.emplace_back(MakeTranslationClip("lean", aiVector3D(0.f, 0.f, 0.f), aiVector3D(1.f, 0.f, 0.f)));
+            _layout = MakeLayout(_animations.size());
+            _skinning.resize(2u, MAT4_IDENTITY);
+        }
+
+        void update(AnimationBlendState& state, const D64 dt)
+        {
+            state.update(_layout, _animations, dt, std::span<mat4<F32>>(_skinning.data(), _skinning.size()));
+        }
+
+        [[nodiscard]] F32 childX(const AnimationBlendState& state) const
+        {
+            return state.localPose()[1]._translation.x;
+        }
+    };
+} //namespace
+
+TEST_CASE( "Blend Tree Single Clip", "[animation_blend_tree]" )
+{
+    BlendTreeTestData data;
+
+    const AnimationBlendTree_ptr tree = std::make_shared<AnimationBlendTree>();
+    tree->addClip(2u);
+
+    AnimationBlendState state(tree);
+    data.update(state, 0.25);
+
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 0.25f, g_tolerance);
+    // Skinning matrices use the engine's row-vector layout: translation lives in the last row
+    CHECK_COMPARE_TOLERANCE(data._skinning[1].getRow(3).x, 0.25f, g_tolerance);
+    CHECK_COMPARE_TOLERANCE(data._skinning[0].getRow(3).x, 0.f, g_tolerance);
+}
+
+TEST_CASE( "Blend Tree 1D Blend Space", "[animation_blend_tree]" )
+{
+    BlendTreeTestData data;
+
+    const AnimationBlendTree_ptr tree = std::make_shared<AnimationBlendTree>();
+    const U8 speed = tree->addParameter("speed");
+    const U32 idle = tree->addClip(0u);
+    const U32 run = tree->addClip(1u);
+    tree->addBlend1D(speed, { { 1.f, run }, { 0.f, idle } });
+
+    AnimationBlendState state(tree);
+
+    state.parameter(speed, 0.f);
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 0.f, g_tolerance);
+
+    state.parameter(speed, 0.5f);
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 1.f, g_tolerance);
+
+    CHECK_TRUE(state.parameter("speed", 5.f));
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 2.f, g_tolerance);
+
+    CHECK_FALSE(state.parameter("missing", 1.f));
+}
+
+TEST_CASE( "Blend Tree 2D Blend Space", "[animation_blend_tree]" )
+{
+    BlendTreeTestData data;
+
+    const AnimationBlendTree_ptr tree = std::make_shared<AnimationBlendTree>();
+    const U8 x = tree->addParameter("x");
+    const U8 y = tree->addParameter("y");
+    const U32 idle = tree->addClip(0u);
+    const U32 run = tree->addClip(1u);
+    tree->addBlend2D(x, y, { { float2(0.f, 0.f), idle }, { float2(1.f, 0.f), run } });
+
+    AnimationBlendState state(tree);
+
+    state.parameter(x, 1.f);
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 2.f, g_tolerance);
+
+    // Equidistant from both samples
+    state.parameter(x, 0.5f);
+    state.parameter(y, 0.5f);
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 1.f, g_tolerance);
+}
+
+TEST_CASE( "Blend Tree Crossfade", "[animation_blend_tree]" )
+{
+    BlendTreeTestData data;
+
+    const AnimationBlendTree_ptr tree = std::make_shared<AnimationBlendTree>();
+    tree->addClip(0u);
+    const U32 run = tree->addClip(1u);
+
+    AnimationBlendState state(tree);
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 0.f, g_tolerance);
+
+    state.crossFadeTo(run, 1.f);
+    CHECK_TRUE(state.crossFading());
+
+    data.update(state, 0.5);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 1.f, g_tolerance);
+
+    data.update(state, 0.5);
+    CHECK_FALSE(state.crossFading());
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 2.f, g_tolerance);
+}
+
+TEST_CASE( "Blend Tree Layers And Masks", "[animation_blend_tree]" )
+{
+    BlendTreeTestData data;
+
+    const AnimationBlendTree_ptr tree = std::make_shared<AnimationBlendTree>();
+    tree->addClip(0u);
+    const U32 run = tree->addClip(1u);
+    const U32 lean = tree->addClip(2u);
+    tree->rootNode(0u);
+
+    SECTION( "Override layer respects the bone mask" )
+    {
+        AnimationBlendState state(tree);
+        state.addLayer(run, BoneMask{ 1.f, 0.5f }, 1.f, false);
+        data.update(state, 0.1);
+        CHECK_COMPARE_TOLERANCE(data.childX(state), 1.f, g_tolerance);
+
+        state.layer(0u)._mask = { 1.f, 0.f };
+        data.update(state, 0.1);
+        CHECK_COMPARE_TOLERANCE(data.childX(state), 0.f, g_tolerance);
+    }
+
+    SECTION( "Additive layer applies the delta from its first frame" )
+    {
+        AnimationBlendState state(tree);
+        state.crossFadeTo(run, 0.f);
+        state.addLayer(lean, {}, 1.f, true);
+        data.update(state, 0.5);
+        CHECK_COMPARE_TOLERANCE(data.childX(state), 2.5f, g_tolerance);
+
+        state.layer(0u)._weight = 0.5f;
+        data.update(state, 0.25);
+        CHECK_COMPARE_TOLERANCE(data.childX(state), 2.375f, g_tolerance);
+    }
+}
+
+TEST_CASE( "Blend Tree Additive Node", "[animation_blend_tree]" )
+{
+    BlendTreeTestData data;
+
+    const AnimationBlendTree_ptr tree = std::make_shared<AnimationBlendTree>();
+    const U8 weight = tree->addParameter("lean", 1.f);
+    const U32 run = tree->addClip(1u);
+    const U32 lean = tree->addClip(2u);
+    tree->addAdditive(run, lean, weight);
+
+    AnimationBlendState state(tree);
+    data.update(state, 0.5);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 2.5f, g_tolerance);
+
+    state.parameter(weight, 0.f);
+    data.update(state, 0.1);
+    CHECK_COMPARE_TOLERANCE(data.childX(state), 2.f, g_tolerance);
+}
+
+} //namespace Divide
@@ -1,6 +1,7 @@
 #include "UnitTests/unitTestCommon.h"
 
 #include "Core/Headers/ByteBuffer.h"
+#include "Platform/File/Headers/FileManagement.h"
 
 namespace Divide{
 
@@ -318,4 +319,52 @@ TEST_CASE( "ByteBuffer RW Mixed Data", "[byte_buffer]" )
 
 }
 
+TEST_CASE( "ByteBuffer Mapped File View", "[byte_buffer]" )
+{
+    const ResourcePath path{ std::filesystem::temp_directory_path().string() };
+    constexpr const char* fileName = "ByteBufferMappedFileView.test";
+
+    constexpr U32 inputU32 = 123456u;
+    constexpr F32 inputF32 = -7.25f;
+    const string inputStr = "mapped";
+    const vector<I32> inputVector = { 1, -2, 3, -4 };
+
+    {
+        ByteBuffer test;
+        test << inputU32;
+        test << inputStr;
+        test << inputVector;
+        test << inputF32;
+        REQUIRE(test.dumpToFile(path, fileName));
+    }
+
+    ByteBuffer view;
+    REQUIRE(view.mapFromFile(path, fileName));
+    CHECK_TRUE(view.isView());
+
+    U32 outputU32 = 0u;
+    F32 outputF32 = 0.f;
+    string outputStr;
+    vector<I32> outputVector;
+    view >> outputU32;
+    view >> outputStr;
+    view >> outputVector;
+    view >> outputF32;
+
+    CHECK_EQUAL(outputU32, inputU32);
+    CHECK_EQUAL(outputStr, inputStr);
+    CHECK_TRUE(compareVectors(outputVector, inputVector));
+    CHECK_TRUE(COMPARE(outputF32, inputF32));
+
+    ByteBuffer wrongVersion;
+    CHECK_FALSE(wrongVersion.mapFromFile(path, fileName, ByteBuffer::BUFFER_FORMAT_VERSION + 1u));
+    CHECK_FALSE(wrongVersion.isView());
+
+    view.clear();
+    CHECK_FALSE(view.isView());
+    CHECK_TRUE(view.storageEmpty());
+
+    CHECK_TRUE(deleteFile(path, fileName) == FileError::NONE);
+}
+
 }//namespace Divide
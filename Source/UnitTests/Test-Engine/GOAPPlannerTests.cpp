@@ -0,0 +1,265 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "AI/ActionInterface/CustomGOAP/Planner.h"
+
+namespace Divide
+{
+using namespace goap;
+
+namespace
+{
+    enum Facts : I32
+    {
+        FACT_X = 0,
+        FACT_Y = 1,
+        FACT_HIGH = WorldState::MAX_FACTS - 1
+    };
+
+    /// The planner as it was before the indexed heap: a sorted open vector, linear open/closed scans and ID based parent links.
+    /// Ties after a re-sort go to the newest node, as in the planner (the old unstable sort left their order unspecified), and the
+    /// replay follows parent links updated by a cheaper route, where the old one read per-node snapshots.
+    [[nodiscard]] vector<const Action*> ReferencePlan( const WorldState& start, const WorldState& goal, const vector<const Action*>& actions )
+    {
+        struct ReferenceNode
+        {
+            WorldState _ws;
+            I32 _parent = -1;
+            I32 _g = 0;
+            I32 _h = 0;
+            const Action* _action = nullptr;
+        };
+
+        if ( start.meetsGoal( goal ) )
+        {
+            return {};
+        }
+
+        // Node IDs are indices into known
+        vector<ReferenceNode> known;
+        vector<I32> open, closed;
+
+        const auto before = [&known]( const I32 lhs, const I32 rhs )
+        {
+            const I32 lhsF = known[lhs]._g + known[lhs]._h;
+            const I32 rhsF = known[rhs]._g + known[rhs]._h;
+            return lhsF != rhsF ? lhsF < rhsF : lhs > rhs;
+        };
+        const auto stateIs = [&known]( const WorldState& ws )
+        {
+            return [&known, &ws]( const I32 id ) { return known[id]._ws == ws; };
+        };
+
+        known.push_back( { start, -1, 0, start.distanceTo( goal ), nullptr } );
+        open.push_back( 0 );
+
+        while ( !open.empty() )
+        {
+            const I32 current = open.front();
+            open.erase( begin( open ) );
+            closed.push_back( current );
+
+            if ( known[current]._ws.meetsGoal( goal ) )
+            {
+                vector<const Action*> plan;
+                for ( I32 id = current; known[id]._parent != -1; id = known[id]._parent )
+                {
+                    plan.push_back( known[id]._action );
+                }
+                return plan;
+            }
+
+            for ( const Action* action : actions )
+            {
+                if ( !action->eligibleFor( known[current]._ws ) )
+                {
+                    continue;
+                }
+
+                const WorldState possibility = action->actOn( known[current]._ws );
+                const I32 g = known[current]._g + action->cost();
+
+                if ( eastl::find_if( begin( closed ), end( closed ), stateIs( possibility ) ) != end( closed ) )
+                {
+                    continue;
+                }
+
+                const auto needle = eastl::find_if( begin( open ), end( open ), stateIs( possibility ) );
+                if ( needle == end( open ) )
+                {
+                    const I32 id = to_I32( known.size() );
+                    known.push_back( { possibility, current, g, possibility.distanceTo( goal ), action } );
+                    open.insert( eastl::lower_bound( begin( open ), end( open ), id, before ), id );
+                }
+                else if ( g < known[*needle]._g )
+                {
+                    known[*needle]._parent = current;
+                    known[*needle]._g = g;
+                    eastl::sort( begin( open ), end( open ), before );
+                }
+            }
+        }
+
+        return {};
+    }
+
+    /// Small deterministic LCG, so the generated worlds are the same everywhere
+    [[nodiscard]] U32 NextRandom( U32& state ) noexcept
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8u;
+    }
+}
+
+TEST_CASE("GOAP WorldState Bitmask Semantics", "[goap]")
+{
+    WorldState state;
+    CHECK_TRUE(state.empty());
+
+    state.setVariable(FACT_X, false);
+    state.setVariable(FACT_HIGH, true);
+    CHECK_FALSE(state.empty());
+    CHECK_TRUE(state.hasVariable(FACT_X));
+    CHECK_FALSE(state.hasVariable(FACT_Y));
+    CHECK_FALSE(state.getVariable(FACT_X));
+    CHECK_TRUE(state.getVariable(FACT_HIGH));
+
+    WorldState goal;
+    goal.setVariable(FACT_X, true);
+    goal.setVariable(FACT_Y, false);
+
+    // X differs and Y is missing entirely
+    CHECK_EQUAL(state.distanceTo(goal), 2);
+    CHECK_FALSE(state.meetsGoal(goal));
+
+    state.setVariable(FACT_X, true);
+    state.setVariable(FACT_Y, false);
+    CHECK_EQUAL(state.distanceTo(goal), 0);
+    CHECK_TRUE(state.meetsGoal(goal));
+
+    // An unset variable is not the same as a variable set to false
+    WorldState lhs, rhs;
+    lhs.setVariable(FACT_X, false);
+    CHECK_FALSE(lhs == rhs);
+    rhs.setVariable(FACT_X, false);
+    CHECK_TRUE(lhs == rhs);
+    CHECK_EQUAL(lhs.hash(), rhs.hash());
+}
+
+TEST_CASE("GOAP Planner Picks Cheapest Plan", "[goap]")
+{
+    WorldState start;
+    start.setVariable(FACT_X, false);
+    start.setVariable(FACT_Y, false);
+
+    WorldState goal;
+    goal.setVariable(FACT_X, true);
+
+    // Reaches the goal state straight away, but at a high cost
+    Action expensive("expensive", 5);
+    expensive.setEffect(FACT_X, true);
+    expensive.setEffect(FACT_Y, true);
+
+    // Reaches the same state in two cheap steps, found after the expensive route is already on the open list
+    Action cheapFirst("cheapFirst", 1);
+    cheapFirst.setEffect(FACT_Y, true);
+
+    Action cheapSecond("cheapSecond", 1);
+    cheapSecond.setPrecondition(FACT_Y, true);
+    cheapSecond.setEffect(FACT_X, true);
+
+    const vector<const Action*> actions{ &expensive, &cheapFirst, &cheapSecond };
+
+    Planner planner;
+    const vector<const Action*> plan = planner.plan(start, goal, actions);
+    REQUIRE(plan.size() == 2u);
+    // Plans come back in reverse order
+    CHECK_TRUE(plan[0] == &cheapSecond);
+    CHECK_TRUE(plan[1] == &cheapFirst);
+
+    // Re-planning with the same planner gives the same result
+    CHECK_TRUE(planner.plan(start, goal, actions) == plan);
+}
+
+TEST_CASE("GOAP Planner Matches Reference Planner", "[goap]")
+{
+    constexpr U32 FACT_COUNT = 10u;
+    constexpr U32 ACTION_COUNT = 16u;
+    constexpr U32 WORLD_COUNT = 200u;
+
+    U32 seed = 1234u;
+    U32 plansFound = 0u;
+
+    Planner planner;
+    for (U32 world = 0u; world < WORLD_COUNT; ++world)
+    {
+        // Few facts and cheap, overlapping actions: lots of equal F scores and better routes to already open states
+        vector<Action> actionPool;
+        actionPool.reserve(ACTION_COUNT);
+        for (U32 i = 0u; i < ACTION_COUNT; ++i)
+        {
+            const I32 cost = to_I32(1u + NextRandom(seed) % 4u);
+            Action& action = actionPool.emplace_back(Util::StringFormat("action_{}", i), cost);
+            for (U32 p = NextRandom(seed) % 3u; p > 0u; --p)
+            {
+                const I32 fact = to_I32(NextRandom(seed) % FACT_COUNT);
+                action.setPrecondition(fact, NextRandom(seed) % 2u == 0u);
+            }
+            for (U32 e = 1u + NextRandom(seed) % 3u; e > 0u; --e)
+            {
+                const I32 fact = to_I32(NextRandom(seed) % FACT_COUNT);
+                action.setEffect(fact, NextRandom(seed) % 2u == 0u);
+            }
+        }
+
+        vector<const Action*> actions;
+        for (const Action& action : actionPool)
+        {
+            actions.push_back(&action);
+        }
+
+        WorldState start;
+        for (U32 f = 0u; f < FACT_COUNT; ++f)
+        {
+            start.setVariable(to_I32(f), NextRandom(seed) % 2u == 0u);
+        }
+
+        WorldState goal;
+        for (U32 g = 1u + NextRandom(seed) % 3u; g > 0u; --g)
+        {
+            const I32 fact = to_I32(NextRandom(seed) % FACT_COUNT);
+            goal.setVariable(fact, NextRandom(seed) % 2u == 0u);
+        }
+
+        const vector<const Action*> expected = ReferencePlan(start, goal, actions);
+        const vector<const Action*> plan = planner.plan(start, goal, actions);
+        CHECK_TRUE(plan == expected);
+
+        if (!expected.empty())
+        {
+            ++plansFound;
+        }
+    }
+
+    // Make sure the worlds above actually exercised the search
+    CHECK_TRUE(plansFound > WORLD_COUNT / 4u);
+}
+
+TEST_CASE("GOAP Planner No Plan", "[goap]")
+{
+    WorldState start;
+    start.setVariable(FACT_X, false);
+
+    WorldState goal;
+    goal.setVariable(FACT_X, true);
+
+    Action unrelated("unrelated", 1);
+    unrelated.setPrecondition(FACT_Y, true);
+    unrelated.setEffect(FACT_X, true);
+
+    Planner planner;
+    CHECK_TRUE(planner.plan(start, goal, { &unrelated }).empty());
+    // Already at the goal
+    CHECK_TRUE(planner.plan(goal, goal, { &unrelated }).empty());
+}
+
+} //namespace Divide
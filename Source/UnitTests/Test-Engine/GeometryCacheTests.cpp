@@ -0,0 +1,184 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Core/Headers/ByteBuffer.h"
+#include "Core/Headers/TaskPool.h"
+#include "Geometry/Importer/Headers/MeshImporter.h"
+#include "Platform/Video/Buffers/VertexBuffer/Headers/VertexBuffer.h"
+
+namespace Divide
+{
+
+namespace
+{
+    // 301 x 301 vertices: more than one 64K vertex codec block, and enough indices for more than one index block as well
+    constexpr U32 g_gridSize = 300u;
+
+    [[nodiscard]] U32 GridVertex( const U32 x, const U32 y ) noexcept
+    {
+        return y * (g_gridSize + 1u) + x;
+    }
+
+    [[nodiscard]] vector<VertexBuffer::Vertex> GridVertices()
+    {
+        vector<VertexBuffer::Vertex> vertices;
+        vertices.reserve( to_size( g_gridSize + 1u ) * (g_gridSize + 1u) );
+
+        for ( U32 y = 0u; y <= g_gridSize; ++y )
+        {
+            for ( U32 x = 0u; x <= g_gridSize; ++x )
+            {
+                const F32 u = to_F32( x ) / g_gridSize;
+                const F32 v = to_F32( y ) / g_gridSize;
+
+                VertexBuffer::Vertex& vertex = vertices.emplace_back();
+                vertex._position.set( u * 100.f, std::sin( u * 17.f ) * std::cos( v * 13.f ), v * 100.f );
+                vertex._texcoord.set( u, v );
+                vertex._normal = Util::PACK_VEC3( 0.f, 1.f, 0.f );
+                vertex._tangent = Util::PACK_VEC3( 1.f, 0.f, 0.f );
+                vertex._colour.set( to_U8( x ), to_U8( y ), to_U8( x ^ y ), to_U8( 255u ) );
+                vertex._weights.set( to_U8( 255u ), to_U8( 0u ), to_U8( 0u ), to_U8( 0u ) );
+                vertex._indices.set( to_U8( x % 4u ), to_U8( 0u ), to_U8( 0u ), to_U8( 0u ) );
+            }
+        }
+
+        return vertices;
+    }
+
+    /// One strip per row, separated by primitive restarts. Every row adds 2 * 301 + 1 indices, which is a multiple of 3, so it can't be told apart from a triangle list by its size
+    [[nodiscard]] vector<U32> GridStrips()
+    {
+        vector<U32> indices;
+        for ( U32 y = 0u; y < g_gridSize; ++y )
+        {
+            for ( U32 x = 0u; x <= g_gridSize; ++x )
+            {
+                indices.push_back( GridVertex( x, y ) );
+                indices.push_back( GridVertex( x, y + 1u ) );
+            }
+            indices.push_back( VertexBuffer::PRIMITIVE_RESTART_INDEX_L );
+        }
+
+        return indices;
+    }
+
+    [[nodiscard]] vector<uint3> GridTriangles()
+    {
+        vector<uint3> triangles;
+        for ( U32 y = 0u; y < g_gridSize; ++y )
+        {
+            for ( U32 x = 0u; x < g_gridSize; ++x )
+            {
+                triangles.emplace_back( GridVertex( x, y ), GridVertex( x + 1u, y ), GridVertex( x + 1u, y + 1u ) );
+                triangles.emplace_back( GridVertex( x, y ), GridVertex( x + 1u, y + 1u ), GridVertex( x, y + 1u ) );
+            }
+        }
+
+        return triangles;
+    }
+
+    /// The same triangle, allowing for a rotation of its vertices (which keeps the winding)
+    [[nodiscard]] bool SameTriangle( const uint3& lhs, const uint3& rhs ) noexcept
+    {
+        return (lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z) ||
+               (lhs.x == rhs.y && lhs.y == rhs.z && lhs.z == rhs.x) ||
+               (lhs.x == rhs.z && lhs.y == rhs.x && lhs.z == rhs.y);
+    }
+
+    [[nodiscard]] bool SameBytes( const ByteBuffer& lhs, const ByteBuffer& rhs )
+    {
+        return lhs.wpos() == rhs.wpos() && std::memcmp( lhs.contents(), rhs.contents(), lhs.wpos() ) == 0;
+    }
+
+    void CheckGeometryRoundTrip( TaskPool& pool, const vector<VertexBuffer::Vertex>& vertices, const vector<U32>& indices )
+    {
+        ByteBuffer buffer;
+        VertexBuffer::SerializeGeometry( pool, vertices, indices, buffer );
+
+        vector<VertexBuffer::Vertex> verticesOut;
+        vector<U32> indicesOut;
+        REQUIRE( VertexBuffer::DeserializeGeometry( pool, buffer, verticesOut, indicesOut ) );
+        CHECK_EQUAL( buffer.rpos(), buffer.wpos() );
+
+        REQUIRE( verticesOut.size() == vertices.size() );
+        CHECK_TRUE( std::memcmp( verticesOut.data(), vertices.data(), vertices.size() * sizeof( VertexBuffer::Vertex ) ) == 0 );
+        CHECK_TRUE( indicesOut == indices );
+
+        // Encoding is deterministic, so saving what we loaded gives back the same cache
+        ByteBuffer resaved;
+        VertexBuffer::SerializeGeometry( pool, verticesOut, indicesOut, resaved );
+        CHECK_TRUE( SameBytes( buffer, resaved ) );
+
+        // Blocks are compressed: the cache should be well below the size of the raw data
+        CHECK_TRUE( buffer.wpos() < vertices.size() * sizeof( VertexBuffer::Vertex ) + indices.size() * sizeof( U32 ) );
+    }
+} //namespace
+
+TEST_CASE( "Geometry Cache Vertex Buffer Round Trip", "[geometry_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    TaskPool pool( "GEOMETRY_CACHE_TEST" );
+    REQUIRE( pool.init( std::max( std::thread::hardware_concurrency(), 2u ) ) );
+
+    const vector<VertexBuffer::Vertex> vertices = GridVertices();
+    REQUIRE( vertices.size() > (1u << 16u) );
+
+    vector<U32> triangleList;
+    for ( const uint3& triangle : GridTriangles() )
+    {
+        triangleList.insert( end( triangleList ), { triangle.x, triangle.y, triangle.z } );
+    }
+
+    const vector<U32> strips = GridStrips();
+    REQUIRE( strips.size() % 3u == 0u );
+
+    // Not a multiple of 3: a line list with a dangling index
+    vector<U32> lines( begin( strips ), begin( strips ) + 1001 );
+
+    CheckGeometryRoundTrip( pool, vertices, triangleList );
+    CheckGeometryRoundTrip( pool, vertices, strips );
+    CheckGeometryRoundTrip( pool, vertices, lines );
+
+    pool.shutdown();
+}
+
+TEST_CASE( "Geometry Cache Sub Mesh Round Trip", "[geometry_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    Import::SubMeshData subMesh{};
+    subMesh.name( "GeometryCacheTest" );
+    subMesh._lodCount = 2u;
+    subMesh._triangles[0] = GridTriangles();
+    subMesh._triangles[1].assign( begin( subMesh._triangles[0] ), begin( subMesh._triangles[0] ) + 1000 );
+    subMesh._minPos.set( 0.f, -1.f, 0.f );
+    subMesh._maxPos.set( 100.f, 1.f, 100.f );
+
+    ByteBuffer buffer;
+    REQUIRE( subMesh.serialize( buffer ) );
+
+    Import::SubMeshData loaded{};
+    REQUIRE( loaded.deserialize( buffer ) );
+    CHECK_EQUAL( buffer.rpos(), buffer.wpos() );
+
+    CHECK_TRUE( loaded.name() == subMesh.name() );
+    CHECK_EQUAL( loaded._lodCount, subMesh._lodCount );
+    CHECK_TRUE( loaded._minPos == subMesh._minPos );
+    CHECK_TRUE( loaded._maxPos == subMesh._maxPos );
+
+    for ( U8 lod = 0u; lod < Import::MAX_LOD_LEVELS; ++lod )
+    {
+        const vector<uint3>& expected = subMesh._triangles[lod];
+        const vector<uint3>& triangles = loaded._triangles[lod];
+        REQUIRE( triangles.size() == expected.size() );
+
+        bool sameTriangles = true;
+        for ( size_t i = 0u; i < expected.size(); ++i )
+        {
+            sameTriangles = sameTriangles && SameTriangle( triangles[i], expected[i] );
+        }
+        CHECK_TRUE( sameTriangles );
+    }
+}
+
+} //namespace Divide
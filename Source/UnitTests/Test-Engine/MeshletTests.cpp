@@ -0,0 +1,122 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Geometry/Importer/Headers/MeshletData.h"
+#include "Rendering/Camera/Headers/Frustum.h"
+#include "Core/Headers/ByteBuffer.h"
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr U32 g_gridSize = 32u;
+
+    // A flat (gridSize x gridSize) quad grid on the XY plane, facing +Z
+    void BuildGrid(vector<float3>& positions, vector<U32>& indices)
+    {
+        positions.clear();
+        indices.clear();
+
+        for (U32 y = 0u; y <= g_gridSize; ++y)
+        {
+            for (U32 x = 0u; x <= g_gridSize; ++x)
+            {
+                positions.emplace_back(to_F32(x) / g_gridSize - 0.5f, to_F32(y) / g_gridSize - 0.5f, 0.5f);
+            }
+        }
+
+        const auto vertex = [](const U32 x, const U32 y) { return y * (g_gridSize + 1u) + x; };
+        for (U32 y = 0u; y < g_gridSize; ++y)
+        {
+            for (U32 x = 0u; x < g_gridSize; ++x)
+            {
+                indices.insert(indices.end(), { vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1) });
+                indices.insert(indices.end(), { vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1) });
+            }
+        }
+    }
+} //namespace
+
+TEST_CASE( "Meshlet Build Covers All Triangles", "[meshlets]" )
+{
+    vector<float3> positions;
+    vector<U32> indices;
+    BuildGrid(positions, indices);
+
+    MeshletData data;
+    BuildMeshlets(indices, &positions[0].x, positions.size(), sizeof(float3), data);
+
+    REQUIRE_FALSE(data.empty());
+    CHECK_EQUAL(data._meshlets.size(), data._bounds.size());
+
+    size_t triangleCount = 0u;
+    for (const Meshlet& meshlet : data._meshlets)
+    {
+        CHECK_TRUE(meshlet._vertexCount <= MeshletData::MAX_VERTICES);
+        CHECK_TRUE(meshlet._triangleCount <= MeshletData::MAX_TRIANGLES);
+        triangleCount += meshlet._triangleCount;
+
+        for (U32 i = 0u; i < meshlet._triangleCount * 3u; ++i)
+        {
+            const U32 localIndex = data._triangles[meshlet._triangleOffset + i];
+            REQUIRE(localIndex < meshlet._vertexCount);
+            CHECK_TRUE(data._vertices[meshlet._vertexOffset + localIndex] < positions.size());
+        }
+    }
+    CHECK_EQUAL(triangleCount, indices.size() / 3u);
+
+    ByteBuffer buffer;
+    CHECK_TRUE(data.serialize(buffer));
+
+    MeshletData loaded;
+    REQUIRE(loaded.deserialize(buffer));
+    CHECK_EQUAL(loaded._meshlets.size(), data._meshlets.size());
+    CHECK_TRUE(loaded._vertices == data._vertices);
+    CHECK_TRUE(loaded._triangles == data._triangles);
+}
+
+TEST_CASE( "Meshlet Frustum And Backface Culling", "[meshlets]" )
+{
+    // An identity view-projection gives us the [-1, 1] cube as the frustum
+    Frustum frustum;
+    frustum.computePlanes(MAT4_IDENTITY);
+
+    MeshletBounds bounds{};
+    bounds._center = { 0.f, 0.f, 0.5f };
+    bounds._radius = 0.1f;
+    bounds._coneApex = bounds._center;
+    bounds._coneAxis = { 0.f, 0.f, 1.f };
+    bounds._coneCutoff = 0.5f;
+
+    // In front of the cluster: visible
+    CHECK_FALSE(IsMeshletCulled(bounds, frustum, float3{ 0.f, 0.f, 5.f }));
+    // Behind the cluster, looking at the back of every triangle: culled
+    CHECK_TRUE(IsMeshletCulled(bounds, frustum, float3{ 0.f, 0.f, -5.f }));
+
+    // A degenerate cone never backface culls
+    MeshletBounds noCone = bounds;
+    noCone._coneCutoff = 1.f;
+    CHECK_FALSE(IsMeshletCulled(noCone, frustum, float3{ 0.f, 0.f, -5.f }));
+
+    // Outside of the frustum
+    MeshletBounds outside = noCone;
+    outside._center = { 5.f, 0.f, 0.5f };
+    CHECK_TRUE(IsMeshletCulled(outside, frustum, float3{ 0.f, 0.f, 5.f }));
+
+    vector<float3> positions;
+    vector<U32> indices;
+    BuildGrid(positions, indices);
+
+    MeshletData data;
+    BuildMeshlets(indices, &positions[0].x, positions.size(), sizeof(float3), data);
+
+    vector<U32> visible;
+    CullMeshlets(data, frustum, float3{ 0.f, 0.f, 5.f }, visible);
+    CHECK_EQUAL(visible.size(), data._meshlets.size());
+
+    visible.clear();
+    CullMeshlets(data, frustum, float3{ 0.f, 0.f, -5.f }, visible);
+    CHECK_TRUE(visible.empty());
+}
+
+} //namespace Divide
@@ -0,0 +1,251 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "AI/PathFinding/Headers/PathQueryService.h"
+#include "AI/PathFinding/NavMeshes/Headers/NavMeshLoader.h"
+#include "AI/PathFinding/NavMeshes/DetourTileCache/Headers/DivideTileCache.h"
+
+namespace Divide
+{
+using namespace AI::Navigation;
+
+namespace
+{
+    constexpr F32 g_tolerance = 0.1f;
+    constexpr U64 g_unlimitedBudgetUS = 1000u * 1000u;
+    const float3 g_extents{ 2.f, 2.f, 2.f };
+
+    void AddQuad(NavModelData& data, const float3& a, const float3& b, const float3& c, const float3& d)
+    {
+        const U32 offset = data.getVertCount();
+        NavigationMeshLoader::AddVertex(&data, a);
+        NavigationMeshLoader::AddVertex(&data, b);
+        NavigationMeshLoader::AddVertex(&data, c);
+        NavigationMeshLoader::AddVertex(&data, d);
+        NavigationMeshLoader::AddTriangle(&data, uint3(0u, 1u, 3u), offset);
+        NavigationMeshLoader::AddTriangle(&data, uint3(1u, 2u, 3u), offset);
+    }
+
+    // A 40x40 floor split by a low wall at x = [19, 21], z = [0, 30]. Agents can't fit under or climb onto the wall, so
+    // anything crossing it has to walk around its far end.
+    struct GeneratedNavMesh
+    {
+        TaskPool _pool{ "PATH_QUERY_TEST" };
+        NavigationMeshConfig _config;
+        DivideTileCache _tileCache{ _config };
+        dtNavMesh* _navMesh = nullptr;
+
+        GeneratedNavMesh()
+        {
+            platformInitRunListener::PlatformInit();
+            Console::ToggleFlag(Console::Flags::ENABLE_ERROR_STREAM, false);
+
+            CHECK_TRUE(_pool.init(std::max(std::thread::hardware_concurrency(), 2u)));
+
+            NavModelData data;
+            AddQuad(data, float3(0.f, 0.f, 0.f), float3(0.f, 0.f, 40.f), float3(40.f, 0.f, 40.f), float3(40.f, 0.f, 0.f));
+            AddQuad(data, float3(19.f, 1.5f, 0.f), float3(19.f, 1.5f, 30.f), float3(21.f, 1.5f, 30.f), float3(21.f, 1.5f, 0.f));
+
+            CHECK_TRUE(_tileCache.build(data, _pool, _navMesh));
+        }
+
+        ~GeneratedNavMesh()
+        {
+            dtFreeNavMesh(_navMesh);
+            _pool.shutdown();
+        }
+    };
+} //namespace
+
+TEST_CASE("Path Query Generated NavMesh Is Tiled", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    CHECK_TRUE(world._tileCache.tileCountX() > 1);
+    CHECK_TRUE(world._tileCache.tileCountY() > 1);
+    CHECK_TRUE(world._tileCache.compressedSize() > 0u);
+}
+
+TEST_CASE("Path Query Closest Point", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    PathQueryService service(world._pool);
+    const PathQueryHandle handle = service.requestClosestPoint(*world._navMesh, float3(10.f, 0.5f, 10.f), g_extents);
+    CHECK_TRUE(handle != INVALID_PATH_QUERY);
+
+    PathQueryResult result;
+    CHECK_FALSE(service.poll(handle, result));
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), 1u);
+    REQUIRE(service.poll(handle, result));
+
+    CHECK_TRUE(result._success);
+    REQUIRE(result._points.size() == 1u);
+    CHECK_TRUE(COMPARE_TOLERANCE(result._points[0].x, 10.f, g_tolerance));
+    CHECK_TRUE(COMPARE_TOLERANCE(result._points[0].z, 10.f, g_tolerance));
+    CHECK_TRUE(std::abs(result._points[0].y) < 0.5f);
+}
+
+TEST_CASE("Path Query Path Around Wall", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    PathQueryService service(world._pool);
+    const PathQueryHandle handle = service.requestPath(*world._navMesh, float3(5.f, 0.f, 5.f), float3(35.f, 0.f, 5.f), g_extents);
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), 1u);
+
+    PathQueryResult result;
+    REQUIRE(service.poll(handle, result));
+    CHECK_TRUE(result._success);
+    REQUIRE(result._points.size() > 2u);
+    CHECK_TRUE(COMPARE_TOLERANCE(result._points.front().x, 5.f, g_tolerance));
+    CHECK_TRUE(COMPARE_TOLERANCE(result._points.back().x, 35.f, g_tolerance));
+
+    bool wentAround = false;
+    for (const float3& point : result._points)
+    {
+        wentAround = wentAround || point.z > 30.f;
+    }
+    CHECK_TRUE(wentAround);
+}
+
+TEST_CASE("Path Query Raycast Hits Wall", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    PathQueryService service(world._pool);
+    const PathQueryHandle blocked = service.requestRaycast(*world._navMesh, float3(5.f, 0.f, 5.f), float3(35.f, 0.f, 5.f), g_extents);
+    const PathQueryHandle clear = service.requestRaycast(*world._navMesh, float3(5.f, 0.f, 35.f), float3(35.f, 0.f, 35.f), g_extents);
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), 2u);
+
+    PathQueryResult result;
+    REQUIRE(service.poll(blocked, result));
+    CHECK_TRUE(result._success);
+    CHECK_TRUE(result._hitT < 1.f);
+    REQUIRE(result._points.size() == 2u);
+    CHECK_TRUE(result._points[1].x < 19.f);
+
+    REQUIRE(service.poll(clear, result));
+    CHECK_TRUE(result._success);
+    CHECK_TRUE(result._hitT >= 1.f);
+}
+
+TEST_CASE("Path Query Dedup And Cancel", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    PathQueryService service(world._pool);
+    const PathQueryHandle first = service.requestClosestPoint(*world._navMesh, float3(10.f, 0.f, 10.f), g_extents);
+    const PathQueryHandle second = service.requestClosestPoint(*world._navMesh, float3(10.f, 0.f, 10.f), g_extents);
+    const PathQueryHandle other = service.requestClosestPoint(*world._navMesh, float3(12.f, 0.f, 10.f), g_extents);
+    CHECK_TRUE(first == second);
+    CHECK_TRUE(first != other);
+    CHECK_EQUAL(service.pendingCount(), 2u);
+
+    // Cancelled queries never run
+    service.cancel(other);
+    CHECK_EQUAL(service.pendingCount(), 1u);
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), 1u);
+
+    // Both requesters get the shared result exactly once
+    PathQueryResult result;
+    CHECK_TRUE(service.poll(first, result));
+    CHECK_TRUE(service.poll(second, result));
+    CHECK_FALSE(service.poll(first, result));
+    CHECK_FALSE(service.poll(other, result));
+}
+
+TEST_CASE("Path Query Budget", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    PathQueryService service(world._pool);
+
+    // Two waves worth of distinct queries, so none of them get merged
+    const U32 queryCount = to_U32(world._pool.threads().size() + 1u) * 16u * 2u;
+    vector<PathQueryHandle> handles;
+    for (U32 i = 0u; i < queryCount; ++i)
+    {
+        handles.push_back(service.requestClosestPoint(*world._navMesh, float3(1.f + to_F32(i % 38u), 0.f, 1.f + to_F32(i / 38u) * 0.1f), g_extents));
+    }
+    REQUIRE(service.pendingCount() == queryCount);
+
+    // An exhausted budget still lets the first query through, but nothing else starts
+    CHECK_EQUAL(service.update(0u), 1u);
+    CHECK_EQUAL(service.pendingCount(), queryCount - 1u);
+
+    // Unstarted queries kept their place in the queue
+    PathQueryResult result;
+    CHECK_TRUE(service.poll(handles.front(), result));
+    CHECK_FALSE(service.poll(handles[1], result));
+
+    CHECK_EQUAL(service.update(0u), 1u);
+    CHECK_TRUE(service.poll(handles[1], result));
+
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), queryCount - 2u);
+    CHECK_EQUAL(service.pendingCount(), 0u);
+    for (U32 i = 2u; i < queryCount; ++i)
+    {
+        CHECK_TRUE(service.poll(handles[i], result));
+    }
+}
+
+TEST_CASE("Path Query Purge", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    PathQueryService service(world._pool);
+    const PathQueryHandle handle = service.requestClosestPoint(*world._navMesh, float3(10.f, 0.f, 10.f), g_extents);
+    service.purge(*world._navMesh);
+    CHECK_EQUAL(service.pendingCount(), 0u);
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), 0u);
+
+    PathQueryResult result;
+    CHECK_FALSE(service.poll(handle, result));
+}
+
+TEST_CASE("Path Query Tile Cache Save And Load", "[path_query]")
+{
+    GeneratedNavMesh world;
+    REQUIRE(world._navMesh != nullptr);
+
+    FILE* fp = std::tmpfile();
+    REQUIRE(fp != nullptr);
+    CHECK_TRUE(world._tileCache.save(fp));
+    std::rewind(fp);
+
+    // Same as NavigationMesh::load: the navmesh is rebuilt from the restored layers
+    DivideTileCache loadedCache{ world._config };
+    dtNavMesh* loadedMesh = nullptr;
+    const bool loaded = loadedCache.load(fp, *world._navMesh->getParams(), loadedMesh);
+    std::fclose(fp);
+    REQUIRE(loaded);
+    REQUIRE(loadedMesh != nullptr);
+
+    CHECK_EQUAL(loadedCache.tileCountX(), world._tileCache.tileCountX());
+    CHECK_EQUAL(loadedCache.tileCountY(), world._tileCache.tileCountY());
+    CHECK_EQUAL(loadedCache.compressedSize(), world._tileCache.compressedSize());
+
+    // Obstacles need the tile cache, which meshes loaded from disk used to be missing
+    CHECK_TRUE(loadedCache.addObstacle(float3(10.f, 0.f, 10.f), 1.f, 2.f) != 0u);
+
+    PathQueryService service(world._pool);
+    const PathQueryHandle handle = service.requestPath(*loadedMesh, float3(5.f, 0.f, 5.f), float3(35.f, 0.f, 5.f), g_extents);
+    CHECK_EQUAL(service.update(g_unlimitedBudgetUS), 1u);
+
+    PathQueryResult result;
+    REQUIRE(service.poll(handle, result));
+    CHECK_TRUE(result._success);
+    REQUIRE_FALSE(result._points.empty());
+    CHECK_TRUE(COMPARE_TOLERANCE(result._points.back().x, 35.f, g_tolerance));
+
+    dtFreeNavMesh(loadedMesh);
+}
+
+} //namespace Divide
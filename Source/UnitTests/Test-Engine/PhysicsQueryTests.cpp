@@ -0,0 +1,171 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Physics/Jolt/Headers/JoltQueries.h"
+
+#include "Core/Math/Headers/Ray.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingBox.h"
+#include "Core/Math/BoundingVolumes/Headers/BoundingSphere.h"
+
+#include <Jolt/RegisterTypes.h>
+#include <Jolt/Core/Factory.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+
+namespace Divide
+{
+namespace
+{
+    constexpr F32 g_tolerance = 1e-3f;
+
+    // Every body lives in a single layer that collides with everything
+    class SingleBroadPhaseLayer final : public JPH::BroadPhaseLayerInterface
+    {
+    public:
+        JPH::uint GetNumBroadPhaseLayers() const override { return 1u; }
+        JPH::BroadPhaseLayer GetBroadPhaseLayer([[maybe_unused]] JPH::ObjectLayer inLayer) const override { return JPH::BroadPhaseLayer(0); }
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+        const char* GetBroadPhaseLayerName([[maybe_unused]] JPH::BroadPhaseLayer inLayer) const override { return "ALL"; }
+#endif
+    };
+
+    class AcceptAllObjectVsBroadPhase final : public JPH::ObjectVsBroadPhaseLayerFilter
+    {
+    public:
+        bool ShouldCollide([[maybe_unused]] JPH::ObjectLayer inLayer1, [[maybe_unused]] JPH::BroadPhaseLayer inLayer2) const override { return true; }
+    };
+
+    class AcceptAllObjectPairs final : public JPH::ObjectLayerPairFilter
+    {
+    public:
+        bool ShouldCollide([[maybe_unused]] JPH::ObjectLayer inObject1, [[maybe_unused]] JPH::ObjectLayer inObject2) const override { return true; }
+    };
+
+    // Three static unit cubes centred at x = 5, 10 and 15
+    struct SyntheticWorld
+    {
+        std::unique_ptr<JPH::Factory> _factory;
+        SingleBroadPhaseLayer _broadPhaseLayers;
+        AcceptAllObjectVsBroadPhase _objectVsBroadPhase;
+        AcceptAllObjectPairs _objectPairs;
+        JPH::PhysicsSystem _system;
+        vector<JPH::BodyID> _bodies;
+
+        SyntheticWorld()
+        {
+            JPH::RegisterDefaultAllocator();
+            _factory = std::make_unique<JPH::Factory>();
+            JPH::Factory::sInstance = _factory.get();
+            JPH::RegisterTypes();
+
+            _system.Init(64u, 0u, 64u, 64u, _broadPhaseLayers, _objectVsBroadPhase, _objectPairs);
+
+            JPH::BodyInterface& bodyInterface = _system.GetBodyInterface();
+            for (const F32 x : { 5.f, 10.f, 15.f })
+            {
+                const JPH::BodyCreationSettings settings(new JPH::BoxShape(JPH::Vec3::sReplicate(0.5f)), JPH::RVec3(x, 0.f, 0.f), JPH::Quat::sIdentity(), JPH::EMotionType::Static, 0);
+                _bodies.push_back(bodyInterface.CreateAndAddBody(settings, JPH::EActivation::DontActivate));
+            }
+            _system.OptimizeBroadPhase();
+        }
+
+        ~SyntheticWorld()
+        {
+            JPH::BodyInterface& bodyInterface = _system.GetBodyInterface();
+            for (const JPH::BodyID& bodyID : _bodies)
+            {
+                bodyInterface.RemoveBody(bodyID);
+                bodyInterface.DestroyBody(bodyID);
+            }
+
+            JPH::UnregisterTypes();
+            JPH::Factory::sInstance = nullptr;
+        }
+    };
+
+    Ray MakeRay(const float3& origin, const float3& direction)
+    {
+        Ray ray{};
+        ray._origin = { origin.x, origin.y, origin.z, 1.f };
+        ray._direction = { direction.x, direction.y, direction.z, 0.f };
+        return ray;
+    }
+} //namespace
+
+TEST_CASE("Physics Query Ray Hits Sorted", "[physics_query]")
+{
+    SyntheticWorld world;
+    vector<JoltQueries::QueryHit> hits;
+
+    CHECK_TRUE(JoltQueries::CastRay(world._system, MakeRay(VECTOR3_ZERO, WORLD_X_AXIS), { 0.f, 100.f }, hits));
+    REQUIRE(hits.size() == 3u);
+    CHECK_TRUE(hits[0]._bodyID == world._bodies[0]);
+    CHECK_TRUE(hits[1]._bodyID == world._bodies[1]);
+    CHECK_TRUE(hits[2]._bodyID == world._bodies[2]);
+    CHECK_TRUE(COMPARE_TOLERANCE(hits[0]._distance, 4.5f, g_tolerance));
+    CHECK_TRUE(COMPARE_TOLERANCE(hits[1]._distance, 9.5f, g_tolerance));
+    CHECK_TRUE(COMPARE_TOLERANCE(hits[2]._distance, 14.5f, g_tolerance));
+    CHECK_FALSE(hits[0]._inside);
+}
+
+TEST_CASE("Physics Query Ray Range", "[physics_query]")
+{
+    SyntheticWorld world;
+    vector<JoltQueries::QueryHit> hits;
+
+    CHECK_TRUE(JoltQueries::CastRay(world._system, MakeRay(VECTOR3_ZERO, WORLD_X_AXIS), { 0.f, 12.f }, hits));
+    CHECK_EQUAL(hits.size(), 2u);
+
+    // Distances are still measured from the ray's origin, not from the start of the range
+    CHECK_TRUE(JoltQueries::CastRay(world._system, MakeRay(VECTOR3_ZERO, WORLD_X_AXIS), { 7.f, 100.f }, hits));
+    REQUIRE(hits.size() == 2u);
+    CHECK_TRUE(hits[0]._bodyID == world._bodies[1]);
+    CHECK_TRUE(COMPARE_TOLERANCE(hits[0]._distance, 9.5f, g_tolerance));
+
+    CHECK_FALSE(JoltQueries::CastRay(world._system, MakeRay(VECTOR3_ZERO, WORLD_Y_AXIS), { 0.f, 100.f }, hits));
+    CHECK_TRUE(hits.empty());
+}
+
+TEST_CASE("Physics Query Ray Inside", "[physics_query]")
+{
+    SyntheticWorld world;
+    vector<JoltQueries::QueryHit> hits;
+
+    CHECK_TRUE(JoltQueries::CastRay(world._system, MakeRay(float3(5.f, 0.f, 0.f), WORLD_X_AXIS), { 0.f, 100.f }, hits));
+    REQUIRE(hits.size() == 3u);
+    CHECK_TRUE(hits[0]._inside);
+    CHECK_TRUE(COMPARE_TOLERANCE(hits[0]._distance, 0.f, g_tolerance));
+}
+
+TEST_CASE("Physics Query Sphere Overlap", "[physics_query]")
+{
+    SyntheticWorld world;
+    vector<JoltQueries::QueryHit> hits;
+
+    CHECK_FALSE(JoltQueries::OverlapSphere(world._system, BoundingSphere(float3(7.5f, 0.f, 0.f), 1.f), hits));
+
+    CHECK_TRUE(JoltQueries::OverlapSphere(world._system, BoundingSphere(float3(6.f, 0.f, 0.f), 1.f), hits));
+    REQUIRE(hits.size() == 1u);
+    CHECK_TRUE(hits[0]._bodyID == world._bodies[0]);
+    CHECK_FALSE(hits[0]._inside);
+    CHECK_TRUE(COMPARE_TOLERANCE(hits[0]._distance, 0.5f, g_tolerance));
+
+    CHECK_TRUE(JoltQueries::OverlapSphere(world._system, BoundingSphere(float3(10.f, 0.f, 0.f), 1.f), hits));
+    REQUIRE(hits.size() == 1u);
+    CHECK_TRUE(hits[0]._bodyID == world._bodies[1]);
+    CHECK_TRUE(hits[0]._inside);
+}
+
+TEST_CASE("Physics Query Box Overlap", "[physics_query]")
+{
+    SyntheticWorld world;
+    vector<JoltQueries::QueryHit> hits;
+
+    CHECK_TRUE(JoltQueries::OverlapBox(world._system, BoundingBox(float3(4.f, -1.f, -1.f), float3(11.f, 1.f, 1.f)), hits));
+    CHECK_EQUAL(hits.size(), 2u);
+
+    CHECK_FALSE(JoltQueries::OverlapBox(world._system, BoundingBox(float3(6.f, 2.f, -1.f), float3(9.f, 3.f, 1.f)), hits));
+    CHECK_TRUE(hits.empty());
+}
+
+} //namespace Divide
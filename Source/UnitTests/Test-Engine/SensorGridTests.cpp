@@ -0,0 +1,139 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "AI/Sensors/Headers/SensorGrid.h"
+
+namespace Divide
+{
+using namespace AI;
+
+namespace
+{
+    constexpr U32 g_entryCount = 500u;
+
+    // Deterministic scatter over a 400x400 area, with a few far outliers
+    void FillGrid(SensorGrid& grid, vector<float3>& positions)
+    {
+        U32 seed = 12345u;
+        const auto next = [&seed]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return to_F32(seed >> 8) / to_F32(1u << 24);
+        };
+
+        grid.clear();
+        positions.clear();
+        for (U32 i = 0u; i < g_entryCount; ++i)
+        {
+            float3 position{ next() * 400.f - 200.f, next() * 10.f, next() * 400.f - 200.f };
+            if (i % 100u == 0u)
+            {
+                position *= 25.f;
+            }
+            positions.push_back(position);
+            grid.insert(to_I64(i + 1u), nullptr, position);
+        }
+        grid.build();
+    }
+
+    vector<I64> BruteForce(const SensorQuery& query, const vector<float3>& positions)
+    {
+        vector<I64> ret;
+        for (U32 i = 0u; i < positions.size(); ++i)
+        {
+            F32 distanceSq = 0.f;
+            if (to_I64(i + 1u) != query._ignoreGUID && SensorGrid::Matches(query, positions[i], distanceSq))
+            {
+                ret.push_back(to_I64(i + 1u));
+            }
+        }
+        eastl::sort(begin(ret), end(ret));
+        return ret;
+    }
+}
+
+TEST_CASE("Sensor Grid Radius And Cone Queries", "[sensor_grid]")
+{
+    SensorGrid grid(16.f);
+    vector<float3> positions;
+    FillGrid(grid, positions);
+    CHECK_EQUAL(grid.size(), g_entryCount);
+
+    vector<SensorQuery> queries;
+    for (U32 i = 0u; i < 20u; ++i)
+    {
+        SensorQuery& query = queries.emplace_back();
+        query._origin = positions[i * 7u];
+        query._ignoreGUID = to_I64(i * 7u + 1u);
+        query._maxRange = 10.f + 5.f * i;
+        if (i % 2u == 1u)
+        {
+            query._direction = Normalized(float3{ 1.f, 0.f, to_F32(i) * 0.1f });
+            query._cosHalfFOV = std::cos(to_F32(M_PI_DIV_4));
+        }
+    }
+    // Unlimited range, every direction
+    queries.emplace_back()._origin = float3{ 0.f };
+
+    vector<SensorHit> hits;
+    vector<U32> offsets;
+    grid.query(queries, hits, offsets);
+    REQUIRE(offsets.size() == queries.size() + 1u);
+    CHECK_EQUAL(offsets.back(), to_U32(hits.size()));
+    CHECK_EQUAL(offsets.back() - offsets[queries.size() - 1u], g_entryCount);
+
+    for (size_t q = 0u; q < queries.size(); ++q)
+    {
+        vector<I64> found;
+        for (U32 h = offsets[q]; h < offsets[q + 1u]; ++h)
+        {
+            found.push_back(hits[h]._guid);
+            // Closest first
+            if (h > offsets[q])
+            {
+                CHECK_TRUE(hits[h - 1u]._distanceSq <= hits[h]._distanceSq);
+            }
+        }
+        eastl::sort(begin(found), end(found));
+        CHECK_TRUE(found == BruteForce(queries[q], positions));
+    }
+}
+
+TEST_CASE("Sensor Grid Closest Node", "[sensor_grid]")
+{
+    SensorGrid grid(16.f);
+    vector<float3> positions;
+    FillGrid(grid, positions);
+
+    const float3 origins[] = { float3{ 0.f }, positions[42], float3{ 9000.f, 0.f, -9000.f } };
+    for (const float3& origin : origins)
+    {
+        // Only even GUIDs are "followed"
+        const auto filter = [](const I64 guid) { return guid % 2 == 0; };
+
+        I64 expected = -1;
+        F32 expectedDistanceSq = F32_MAX;
+        for (U32 i = 0u; i < positions.size(); ++i)
+        {
+            const F32 distanceSq = origin.distanceSquared(positions[i]);
+            if (filter(to_I64(i + 1u)) && distanceSq < expectedDistanceSq)
+            {
+                expectedDistanceSq = distanceSq;
+                expected = to_I64(i + 1u);
+            }
+        }
+
+        SensorHit hit;
+        REQUIRE(grid.findClosest(origin, F32_MAX, filter, hit));
+        CHECK_EQUAL(hit._guid, expected);
+    }
+
+    SensorHit hit;
+    CHECK_FALSE(grid.findClosest(float3{ 9000.f, 0.f, -9000.f }, 1.f, {}, hit));
+
+    float3 position;
+    CHECK_TRUE(grid.getPosition(43, position));
+    CHECK_TRUE(position == positions[42]);
+    CHECK_FALSE(grid.contains(to_I64(g_entryCount + 1u)));
+}
+
+} //namespace Divide
@@ -0,0 +1,169 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Platform/Video/Headers/RenderAPIEnums.h"
+#include "Platform/Video/Shaders/Headers/ShaderModuleBuilds.h"
+
+namespace Divide
+{
+
+namespace
+{
+    constexpr U64 g_moduleHash = 0xABCDu;
+
+    /// Stand-in for the GLSL -> SPIRV conversion: the "SPIRV" is just the source bytes, so different sources give different modules
+    struct FakeCompiler
+    {
+        std::atomic_uint _buildCount{ 0u };
+        std::atomic_bool _buildStarted{ false };
+
+        [[nodiscard]] ShaderModuleBuilds::BuildFunction builder( const string& source )
+        {
+            return [this, source]( ShaderModuleBuilds::Module& moduleOut )
+            {
+                _buildCount.fetch_add( 1u );
+                _buildStarted.store( true );
+
+                // Long enough for everyone else to queue up behind us
+                std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+                moduleOut._sourceCodeSpirV.assign( begin( source ), end( source ) );
+                moduleOut._reflectionData._uniformBlockBindingIndex = to_U8( source.size() );
+                return true;
+            };
+        }
+    };
+
+    [[nodiscard]] bool SameModule( const ShaderModuleBuilds::Module& lhs, const ShaderModuleBuilds::Module& rhs )
+    {
+        return lhs._sourceCodeSpirV == rhs._sourceCodeSpirV &&
+               lhs._reflectionData._uniformBlockBindingIndex == rhs._reflectionData._uniformBlockBindingIndex;
+    }
+} //namespace
+
+TEST_CASE( "Shader Module Builds Share Concurrent Compiles", "[shader_module_builds]" )
+{
+    ShaderModuleBuilds builds;
+    FakeCompiler compiler;
+
+    const string source = "void main() {}";
+
+    ShaderModuleBuilds::Module first{}, second{};
+    bool firstBuilt = false, secondBuilt = false;
+
+    std::thread firstThread( [&]()
+    {
+        firstBuilt = builds.getOrBuild( g_moduleHash, ShaderType::VERTEX, source, compiler.builder( source ), first );
+    });
+
+    while ( !compiler._buildStarted.load() )
+    {
+        std::this_thread::yield();
+    }
+
+    std::thread secondThread( [&]()
+    {
+        secondBuilt = builds.getOrBuild( g_moduleHash, ShaderType::VERTEX, source, compiler.builder( source ), second );
+    });
+
+    firstThread.join();
+    secondThread.join();
+
+    CHECK_TRUE( firstBuilt );
+    CHECK_TRUE( secondBuilt );
+    CHECK_EQUAL( compiler._buildCount.load(), 1u );
+    CHECK_FALSE( first._sourceCodeSpirV.empty() );
+    CHECK_TRUE( SameModule( first, second ) );
+
+    // Nothing is kept once the build is done
+    ShaderModuleBuilds::Module third{};
+    CHECK_TRUE( builds.getOrBuild( g_moduleHash, ShaderType::VERTEX, source, compiler.builder( source ), third ) );
+    CHECK_EQUAL( compiler._buildCount.load(), 2u );
+    CHECK_TRUE( SameModule( first, third ) );
+}
+
+TEST_CASE( "Shader Module Builds Verify Source On Hash Hit", "[shader_module_builds]" )
+{
+    ShaderModuleBuilds builds;
+    FakeCompiler compiler;
+
+    const string sourceA = "void main() { a(); }";
+    const string sourceB = "void main() { bb(); }";
+
+    ShaderModuleBuilds::Module moduleA{}, moduleB{}, moduleC{};
+    bool builtA = false, builtB = false, builtC = false;
+
+    std::thread threadA( [&]()
+    {
+        builtA = builds.getOrBuild( g_moduleHash, ShaderType::VERTEX, sourceA, compiler.builder( sourceA ), moduleA );
+    });
+
+    while ( !compiler._buildStarted.load() )
+    {
+        std::this_thread::yield();
+    }
+
+    // Same hash as the build in flight, but a different source or stage. Neither may get A's module
+    std::thread threadB( [&]()
+    {
+        builtB = builds.getOrBuild( g_moduleHash, ShaderType::VERTEX, sourceB, compiler.builder( sourceB ), moduleB );
+    });
+    std::thread threadC( [&]()
+    {
+        builtC = builds.getOrBuild( g_moduleHash, ShaderType::FRAGMENT, sourceA, compiler.builder( sourceA ), moduleC );
+    });
+
+    threadA.join();
+    threadB.join();
+    threadC.join();
+
+    CHECK_TRUE( builtA );
+    CHECK_TRUE( builtB );
+    CHECK_TRUE( builtC );
+    CHECK_EQUAL( compiler._buildCount.load(), 3u );
+    CHECK_FALSE( SameModule( moduleA, moduleB ) );
+    CHECK_TRUE( moduleB._sourceCodeSpirV == std::vector<U32>( begin( sourceB ), end( sourceB ) ) );
+}
+
+TEST_CASE( "Shader Module Builds Retry After A Failed Build", "[shader_module_builds]" )
+{
+    ShaderModuleBuilds builds;
+    FakeCompiler compiler;
+
+    const string source = "void main() {}";
+
+    std::atomic_bool failedBuildStarted{ false };
+    const ShaderModuleBuilds::BuildFunction failingBuild = [&failedBuildStarted]( ShaderModuleBuilds::Module& )
+    {
+        failedBuildStarted.store( true );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        return false;
+    };
+
+    ShaderModuleBuilds::Module failed{}, retried{};
+    bool failedBuilt = true, retriedBuilt = false;
+
+    std::thread failingThread( [&]()
+    {
+        failedBuilt = builds.getOrBuild( g_moduleHash, ShaderType::COMPUTE, source, failingBuild, failed );
+    });
+
+    while ( !failedBuildStarted.load() )
+    {
+        std::this_thread::yield();
+    }
+
+    std::thread waitingThread( [&]()
+    {
+        retriedBuilt = builds.getOrBuild( g_moduleHash, ShaderType::COMPUTE, source, compiler.builder( source ), retried );
+    });
+
+    failingThread.join();
+    waitingThread.join();
+
+    CHECK_FALSE( failedBuilt );
+    CHECK_TRUE( retriedBuilt );
+    CHECK_EQUAL( compiler._buildCount.load(), 1u );
+    CHECK_FALSE( retried._sourceCodeSpirV.empty() );
+}
+
+} //namespace Divide
@@ -0,0 +1,179 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Environment/Terrain/Quadtree/Headers/Quadtree.h"
+
+namespace Divide
+{
+
+namespace
+{
+    // 1024 x 1024 heightmap: 3 levels of splits, 64 leaves
+    const vec2<U16> g_heightmapSize{ 1024u, 1024u };
+    const BoundingBox g_terrainBounds( float3{ -512.f, 0.f, -512.f }, float3{ 512.f, 100.f, 512.f } );
+
+    /// Inward facing planes of an axis aligned region. Anything with a corner inside of it is visible
+    [[nodiscard]] PlaneList<6> RegionPlanes( const float3& min, const float3& max )
+    {
+        return PlaneList<6>
+        {
+            Plane<F32>( WORLD_X_AXIS, -min.x ), Plane<F32>( WORLD_X_NEG_AXIS, max.x ),
+            Plane<F32>( WORLD_Y_AXIS, -min.y ), Plane<F32>( WORLD_Y_NEG_AXIS, max.y ),
+            Plane<F32>( WORLD_Z_AXIS, -min.z ), Plane<F32>( WORLD_Z_NEG_AXIS, max.z )
+        };
+    }
+
+    /// Straightforward recursive selection, as the pointer based tree used to do it, on top of the implicit tree's node bounds
+    void ReferenceSelection( const Quadtree& tree, const U32 node, const U8 level, const float3& eye, const PlaneList<6>& planes, const F32 lodThreshold, vector<Quadtree::Selection>& selectionOut )
+    {
+        const BoundingBox bb = tree.nodeBounds( node );
+        for ( const Plane<F32>& plane : planes )
+        {
+            const float3 positive{ plane._normal.x >= 0.f ? bb._max.x : bb._min.x,
+                                   plane._normal.y >= 0.f ? bb._max.y : bb._min.y,
+                                   plane._normal.z >= 0.f ? bb._max.z : bb._min.z };
+            if ( Dot( plane._normal, positive ) + plane._distance < 0.f )
+            {
+                return;
+            }
+        }
+
+        const float3 closest{ CLAMPED( eye.x, bb._min.x, bb._max.x ), CLAMPED( eye.y, bb._min.y, bb._max.y ), CLAMPED( eye.z, bb._min.z, bb._max.z ) };
+        const F32 extent = std::max( bb._max.x - bb._min.x, bb._max.z - bb._min.z );
+        if ( level == tree.getLeafLevel() || extent < lodThreshold * closest.distance( eye ) )
+        {
+            selectionOut.push_back( { node, to_U8( tree.getLeafLevel() - level ) } );
+            return;
+        }
+
+        const U32 firstChild = Quadtree::LevelOffset( level + 1u ) + (node - Quadtree::LevelOffset( level )) * 4u;
+        for ( U32 c = 0u; c < 4u; ++c )
+        {
+            ReferenceSelection( tree, firstChild + c, level + 1u, eye, planes, lodThreshold, selectionOut );
+        }
+    }
+
+    [[nodiscard]] bool SameSelection( const vector<Quadtree::Selection>& lhs, const vector<Quadtree::Selection>& rhs )
+    {
+        if ( lhs.size() != rhs.size() )
+        {
+            return false;
+        }
+
+        for ( size_t i = 0u; i < lhs.size(); ++i )
+        {
+            if ( lhs[i]._node != rhs[i]._node || lhs[i]._LoD != rhs[i]._LoD )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} //namespace
+
+TEST_CASE( "Terrain Quadtree Layout", "[terrain_quadtree]" )
+{
+    Quadtree tree;
+    tree.build( g_terrainBounds, g_heightmapSize, nullptr );
+
+    REQUIRE( tree.getLeafLevel() == 3u );
+    CHECK_EQUAL( tree.getNodeCount(), Quadtree::LevelOffset( 4u ) );
+    CHECK_EQUAL( tree.getChunkCount(), 0u );
+
+    // The children of any node are adjacent, cover their parent exactly and own consecutive leaf ranges
+    U32 expectedFirstLeaf = 0u;
+    for ( U32 c = 0u; c < 4u; ++c )
+    {
+        const Quadtree::Selection child{ Quadtree::LevelOffset( 1u ) + c, to_U8( tree.getLeafLevel() - 1u ) };
+        const auto [first, last] = tree.leafRange( child );
+        CHECK_EQUAL( first, expectedFirstLeaf );
+        CHECK_EQUAL( last - first, 16u );
+        expectedFirstLeaf = last;
+
+        const BoundingBox bb = tree.nodeBounds( child._node );
+        CHECK_COMPARE( bb._max.x - bb._min.x, 512.f );
+        CHECK_COMPARE( bb._max.z - bb._min.z, 512.f );
+    }
+    CHECK_EQUAL( expectedFirstLeaf, 64u );
+
+    const BoundingBox root = tree.computeBoundingBox();
+    CHECK_TRUE( root._min == g_terrainBounds._min );
+    CHECK_TRUE( root._max == g_terrainBounds._max );
+}
+
+TEST_CASE( "Terrain Quadtree Selection Edge Cases", "[terrain_quadtree]" )
+{
+    Quadtree tree;
+    tree.build( g_terrainBounds, g_heightmapSize, nullptr );
+
+    const PlaneList<6> everything = RegionPlanes( float3{ -1e5f, -1e5f, -1e5f }, float3{ 1e5f, 1e5f, 1e5f } );
+    const float3 eye{ 0.f, 50.f, 0.f };
+
+    vector<Quadtree::Selection> selection;
+
+    // Nothing is ever coarse enough: every leaf, in Morton order
+    tree.selectLoD( eye, everything, 0.f, selection );
+    REQUIRE( selection.size() == 64u );
+    for ( U32 i = 0u; i < 64u; ++i )
+    {
+        CHECK_EQUAL( selection[i]._LoD, 0u );
+        CHECK_EQUAL( tree.leafRange( selection[i] ).first, i );
+    }
+
+    // Everything is coarse enough: just the root. The eye has to be outside of it, or its distance to it is 0
+    tree.selectLoD( float3{ 0.f, 5000.f, 0.f }, everything, 1e6f, selection );
+    REQUIRE( selection.size() == 1u );
+    CHECK_EQUAL( selection[0]._node, 0u );
+    CHECK_EQUAL( selection[0]._LoD, tree.getLeafLevel() );
+
+    // Frustum away from the terrain
+    tree.selectLoD( eye, RegionPlanes( float3{ 2000.f, 0.f, 2000.f }, float3{ 3000.f, 100.f, 3000.f } ), 1.f, selection );
+    CHECK_TRUE( selection.empty() );
+}
+
+TEST_CASE( "Terrain Quadtree Selection Matches Reference", "[terrain_quadtree]" )
+{
+    Quadtree tree;
+    tree.build( g_terrainBounds, g_heightmapSize, nullptr );
+
+    const PlaneList<6> regions[] =
+    {
+        RegionPlanes( float3{ -1e5f, -1e5f, -1e5f }, float3{ 1e5f, 1e5f, 1e5f } ),
+        RegionPlanes( float3{ -100.f, -10.f, -300.f }, float3{ 400.f, 200.f, 50.f } ),
+        RegionPlanes( float3{ -512.f, 0.f, -512.f }, float3{ -200.f, 100.f, -200.f } ),
+    };
+    const float3 eyes[] =
+    {
+        { 0.f, 50.f, 0.f },
+        { -450.f, 120.f, 480.f },
+        { 900.f, 10.f, -900.f },
+    };
+
+    vector<Quadtree::Selection> selection, reference;
+    for ( const PlaneList<6>& planes : regions )
+    {
+        for ( const float3& eye : eyes )
+        {
+            for ( const F32 threshold : { 0.25f, 1.f, 4.f } )
+            {
+                tree.selectLoD( eye, planes, threshold, selection );
+
+                reference.clear();
+                ReferenceSelection( tree, 0u, 0u, eye, planes, threshold, reference );
+
+                CHECK_TRUE( SameSelection( selection, reference ) );
+
+                // Selected nodes never overlap
+                U32 previousLast = 0u;
+                for ( const Quadtree::Selection& entry : selection )
+                {
+                    const auto [first, last] = tree.leafRange( entry );
+                    CHECK_TRUE( first >= previousLast );
+                    previousLast = last;
+                }
+            }
+        }
+    }
+}
+
+} //namespace Divide
@@ -0,0 +1,139 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Environment/Terrain/Headers/TerrainTileCache.h"
+#include "Platform/File/Headers/FileManagement.h"
+
+namespace Divide
+{
+
+namespace
+{
+    // Neither dimension is a multiple of the tile size, so the last row and column of tiles are partially filled
+    constexpr U32 g_cacheWidth = 2u * TerrainTileCache::TILE_SIZE + 3u;
+    constexpr U32 g_cacheHeight = TerrainTileCache::TILE_SIZE + 7u;
+    constexpr size_t g_inputHash = 0xC0FFEEu;
+
+    constexpr const char* g_cacheFileName = "TerrainTileCacheTest.tiles";
+
+    [[nodiscard]] TerrainTileCache::Vertex ExpectedVertex( const U32 x, const U32 y ) noexcept
+    {
+        TerrainTileCache::Vertex ret{};
+        ret._position.set( to_F32( x ), to_F32( x * 31u + y * 17u ), to_F32( y ) );
+        ret._normal = to_F32( x + y );
+        ret._tangent = -to_F32( x );
+        return ret;
+    }
+
+    [[nodiscard]] bool SameVertex( const TerrainTileCache::Vertex& lhs, const TerrainTileCache::Vertex& rhs ) noexcept
+    {
+        return lhs._position == rhs._position && lhs._normal == rhs._normal && lhs._tangent == rhs._tangent;
+    }
+
+    [[nodiscard]] bool AllVerticesMatch( const TerrainTileCache& cache )
+    {
+        for ( U32 y = 0u; y < cache.height(); ++y )
+        {
+            for ( U32 x = 0u; x < cache.width(); ++x )
+            {
+                if ( !SameVertex( cache.vertex( x, y ), ExpectedVertex( x, y ) ) )
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+} //namespace
+
+TEST_CASE( "Terrain Tile Cache Round Trip", "[terrain_tile_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const ResourcePath path{ std::filesystem::temp_directory_path().string() };
+
+    {
+        TerrainTileCache cache;
+        cache.create( g_cacheWidth, g_cacheHeight, g_inputHash );
+        REQUIRE_FALSE( cache.empty() );
+        CHECK_FALSE( cache.isMapped() );
+
+        for ( U32 y = 0u; y < g_cacheHeight; ++y )
+        {
+            for ( U32 x = 0u; x < g_cacheWidth; ++x )
+            {
+                cache.vertex( x, y ) = ExpectedVertex( x, y );
+            }
+        }
+
+        REQUIRE( cache.save( path, g_cacheFileName ) );
+        CHECK_TRUE( cache.isMapped() );
+        CHECK_TRUE( AllVerticesMatch( cache ) );
+    }
+
+    TerrainTileCache cache;
+    REQUIRE( cache.load( path, g_cacheFileName, g_cacheWidth, g_cacheHeight, g_inputHash ) );
+    CHECK_TRUE( cache.isMapped() );
+    CHECK_EQUAL( cache.width(), g_cacheWidth );
+    CHECK_EQUAL( cache.height(), g_cacheHeight );
+    CHECK_EQUAL( cache.inputHash(), g_inputHash );
+    CHECK_TRUE( AllVerticesMatch( cache ) );
+
+    // Neighbours on either side of a tile border live in different tiles, but should still read back what was written
+    constexpr U32 border = TerrainTileCache::TILE_SIZE;
+    const TerrainTileCache& constCache = cache;
+    CHECK_TRUE( SameVertex( constCache.vertex( border - 1u, border - 1u ), ExpectedVertex( border - 1u, border - 1u ) ) );
+    CHECK_TRUE( SameVertex( constCache.vertex( border, border - 1u ), ExpectedVertex( border, border - 1u ) ) );
+    CHECK_TRUE( SameVertex( constCache.vertex( border - 1u, border ), ExpectedVertex( border - 1u, border ) ) );
+    CHECK_TRUE( SameVertex( constCache.vertex( border, border ), ExpectedVertex( border, border ) ) );
+    CHECK_TRUE( SameVertex( constCache.vertex( g_cacheWidth - 1u, g_cacheHeight - 1u ), ExpectedVertex( g_cacheWidth - 1u, g_cacheHeight - 1u ) ) );
+
+    // Moving the active region around only changes residency, never the contents
+    cache.setActiveRegion( uint2{ 0u, 0u }, uint2{ 0u, 0u }, 0u );
+    cache.setActiveRegion( uint2{ g_cacheWidth - 1u, 0u }, uint2{ g_cacheWidth - 1u, g_cacheHeight - 1u }, 1u );
+    CHECK_TRUE( AllVerticesMatch( constCache ) );
+    cache.clear();
+    CHECK_TRUE( cache.empty() );
+}
+
+TEST_CASE( "Terrain Tile Cache Rejects Stale Files", "[terrain_tile_cache]" )
+{
+    platformInitRunListener::PlatformInit();
+
+    const ResourcePath path{ std::filesystem::temp_directory_path().string() };
+
+    {
+        TerrainTileCache cache;
+        cache.create( g_cacheWidth, g_cacheHeight, g_inputHash );
+        cache.vertex( 0u, 0u ) = ExpectedVertex( 0u, 0u );
+        REQUIRE( cache.save( path, g_cacheFileName ) );
+    }
+
+    TerrainTileCache cache;
+    CHECK_FALSE( cache.load( path, g_cacheFileName, g_cacheWidth, g_cacheHeight, g_inputHash + 1u ) );
+    CHECK_TRUE( cache.empty() );
+    CHECK_FALSE( cache.load( path, g_cacheFileName, g_cacheWidth + 1u, g_cacheHeight, g_inputHash ) );
+    CHECK_TRUE( cache.empty() );
+    CHECK_FALSE( cache.load( path, g_cacheFileName, g_cacheWidth, g_cacheHeight - 1u, g_inputHash ) );
+    CHECK_TRUE( cache.empty() );
+    CHECK_FALSE( cache.load( path, "TerrainTileCacheTest.missing", g_cacheWidth, g_cacheHeight, g_inputHash ) );
+
+    REQUIRE( cache.load( path, g_cacheFileName, g_cacheWidth, g_cacheHeight, g_inputHash ) );
+    cache.clear();
+
+    // Lose the last tile, as if the process died half way through writing the file
+    const std::filesystem::path filePath = (path / g_cacheFileName).fileSystemPath();
+    const auto fileSize = std::filesystem::file_size( filePath );
+    std::filesystem::resize_file( filePath, fileSize - TerrainTileCache::PAGE_ALIGNMENT );
+    CHECK_FALSE( cache.load( path, g_cacheFileName, g_cacheWidth, g_cacheHeight, g_inputHash ) );
+    CHECK_TRUE( cache.empty() );
+
+    // Only the header survived
+    std::filesystem::resize_file( filePath, TerrainTileCache::PAGE_ALIGNMENT / 2u );
+    CHECK_FALSE( cache.load( path, g_cacheFileName, g_cacheWidth, g_cacheHeight, g_inputHash ) );
+    CHECK_TRUE( cache.empty() );
+
+    CHECK_TRUE( deleteFile( path, g_cacheFileName ) == FileError::NONE );
+}
+
+} //namespace Divide
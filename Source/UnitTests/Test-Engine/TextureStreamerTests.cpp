@@ -0,0 +1,115 @@
+#include "UnitTests/unitTestCommon.h"
+
+#include "Platform/Video/Textures/Headers/TextureStreamer.h"
+
+namespace Divide
+{
+
+namespace
+{
+    // 4 mips, the last two of which make up the always resident tail
+    const vector<size_t> g_mipSizes = { 400u, 100u, 25u, 5u };
+    constexpr U8 g_tailMip = 2u;
+
+    void CompleteLoads( TextureStreamer& streamer, const TextureStreamer::UpdateResult& result )
+    {
+        for ( const TextureStreamer::MipLoad& load : result._loads )
+        {
+            streamer.onMipLoaded( load._id, load._mip, true );
+        }
+    }
+} //namespace
+
+TEST_CASE( "Texture Streamer Loads Requested Mips Within Budget", "[texture_streaming]" )
+{
+    TextureStreamer streamer( 450u );
+
+    const TextureStreamer::EntryID texA = streamer.registerTexture( g_mipSizes, g_tailMip );
+    const TextureStreamer::EntryID texB = streamer.registerTexture( g_mipSizes, g_tailMip );
+    // The tail is loaded with the texture. Nothing is in flight yet
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 0u } );
+    CHECK_EQUAL( streamer.residentMip( texA ), g_tailMip );
+
+    streamer.requestMip( texA, 0u, 1u );
+    streamer.requestMip( texB, 0u, 1u );
+
+    // One mip per texture per update, finest resident mip first
+    TextureStreamer::UpdateResult result = streamer.update();
+    CHECK_EQUAL( result._loads.size(), size_t{ 2u } );
+    for ( const TextureStreamer::MipLoad& load : result._loads )
+    {
+        CHECK_EQUAL( load._mip, U8{ 1u } );
+    }
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 200u } );
+
+    // Nothing new while both loads are in flight
+    CHECK_TRUE( streamer.update()._loads.empty() );
+    CompleteLoads( streamer, result );
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 0u } );
+    CHECK_EQUAL( streamer.residentMip( texA ), U8{ 1u } );
+
+    // Only one of the two full resolution mips fits in flight at once. The most recently used texture goes first
+    streamer.requestMip( texB, 0u, 2u );
+    result = streamer.update();
+    REQUIRE( result._loads.size() == 1u );
+    CHECK_EQUAL( result._loads[0]._id, texB );
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 400u } );
+    CompleteLoads( streamer, result );
+
+    result = streamer.update();
+    REQUIRE( result._loads.size() == 1u );
+    CHECK_EQUAL( result._loads[0]._id, texA );
+    CompleteLoads( streamer, result );
+
+    // Loaded mips stay loaded, even once they are no longer requested
+    streamer.requestMip( texA, g_tailMip, 3u );
+    CHECK_TRUE( streamer.update()._loads.empty() );
+    CHECK_EQUAL( streamer.residentMip( texA ), U8{ 0u } );
+    CHECK_EQUAL( streamer.residentMip( texB ), U8{ 0u } );
+}
+
+TEST_CASE( "Texture Streamer Throttles In Flight Loads", "[texture_streaming]" )
+{
+    // Smaller than the finest mip
+    TextureStreamer streamer( 150u );
+
+    const TextureStreamer::EntryID tex = streamer.registerTexture( g_mipSizes, g_tailMip );
+    const TextureStreamer::EntryID other = streamer.registerTexture( g_mipSizes, g_tailMip );
+    streamer.requestMip( tex, 0u, 1u );
+    streamer.requestMip( other, 0u, 1u );
+
+    TextureStreamer::UpdateResult result = streamer.update();
+    CHECK_EQUAL( result._loads.size(), size_t{ 1u } );
+    CompleteLoads( streamer, result );
+    result = streamer.update();
+    CHECK_EQUAL( result._loads.size(), size_t{ 1u } );
+    CompleteLoads( streamer, result );
+
+    // A mip larger than the whole budget still loads, as long as it's the only thing in flight
+    result = streamer.update();
+    REQUIRE( result._loads.size() == 1u );
+    CHECK_EQUAL( result._loads[0]._mip, U8{ 0u } );
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 400u } );
+    CHECK_TRUE( streamer.update()._loads.empty() );
+
+    // A failed load frees its share of the budget and gets scheduled again
+    streamer.onMipLoaded( result._loads[0]._id, result._loads[0]._mip, false );
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 0u } );
+    CHECK_EQUAL( streamer.residentMip( result._loads[0]._id ), U8{ 1u } );
+    result = streamer.update();
+    REQUIRE( result._loads.size() == 1u );
+
+    // Unregistering with a load in flight releases it too, and the late completion is ignored
+    streamer.unregisterTexture( result._loads[0]._id );
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 0u } );
+    streamer.onMipLoaded( result._loads[0]._id, result._loads[0]._mip, true );
+    CHECK_EQUAL( streamer.inFlightBytes(), size_t{ 0u } );
+
+    // Feedback is clamped to the tail
+    const TextureStreamer::EntryID remaining = result._loads[0]._id == tex ? other : tex;
+    streamer.requestMip( remaining, U8_MAX, 2u );
+    CHECK_EQUAL( streamer.requestedMip( remaining ), g_tailMip );
+    streamer.unregisterTexture( remaining );
+}
+
+} //namespace Divide
@@ -4,7 +4,27 @@
 
 CATCH_REGISTER_LISTENER( platformInitRunListener )
 
+#if defined( ENGINE_BENCHMARKS )
+CATCH_REGISTER_LISTENER( benchmarkResultsListener )
+#endif //ENGINE_BENCHMARKS
+
 int main( int argc, char* argv[] )
 {
+#if defined( ENGINE_BENCHMARKS )
+    Catch::Session session;
+
+    std::string jsonOutputPath = benchmarkResultsListener::OUTPUT_PATH;
+    session.cli( session.cli() | Catch::Clara::Opt( jsonOutputPath, "path" )["--json-output"]( "file the benchmark results are written to (JSON)" ) );
+
+    const int ret = session.applyCommandLine( argc, argv );
+    if ( ret != 0 )
+    {
+        return ret;
+    }
+
+    benchmarkResultsListener::OUTPUT_PATH = jsonOutputPath;
+    return session.run();
+#else
     return Catch::Session().run( argc, argv );
+#endif //ENGINE_BENCHMARKS
 }
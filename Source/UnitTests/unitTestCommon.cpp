@@ -7,6 +7,12 @@
 #include "Scripting/Headers/Script.h"
 #endif //ENGINE_TESTS
 
+#if defined( ENGINE_BENCHMARKS )
+#include "Platform/Video/Headers/CommandBufferPool.h"
+
+#include <fstream>
+#endif //ENGINE_BENCHMARKS
+
 #include <iostream>
 
 namespace
@@ -15,6 +21,29 @@ namespace
     const char* TARGET_NAME_STR = "Platform";
 #elif defined(ENGINE_TESTS)
     const char* TARGET_NAME_STR = "Engine";
+#elif defined(ENGINE_BENCHMARKS)
+    const char* TARGET_NAME_STR = "Engine Benchmarks";
+
+    // Bump this if the layout of the results file changes so that regression tracking tools can tell the formats apart
+    constexpr int BENCHMARK_RESULTS_VERSION = 1;
+
+    [[nodiscard]] std::string EscapeJSON( const std::string& input )
+    {
+        std::string ret;
+        ret.reserve( input.size() );
+        for ( const char c : input )
+        {
+            switch ( c )
+            {
+                case '"' : ret += "\\\""; break;
+                case '\\': ret += "\\\\"; break;
+                case '\n': ret += "\\n"; break;
+                case '\t': ret += "\\t"; break;
+                default  : if ( static_cast<unsigned char>(c) >= 0x20u ) { ret += c; } break;
+            }
+        }
+        return ret;
+    }
 #else
 #error "Unknow UT build target!";
 #endif
@@ -41,6 +70,11 @@ void platformInitRunListener::PlatformInit()
         Script::OnStartup();
 #endif //ENGINE_TESTS
 
+#if defined( ENGINE_BENCHMARKS )
+        // Command buffers are built without a window or a render API, so we only need the pools
+        GFX::InitPools( 64u );
+#endif //ENGINE_BENCHMARKS
+
         PLATFORM_INIT = true;
     }
 }
@@ -75,6 +109,13 @@ void platformInitRunListener::testRunEnded( Catch::TestRunStats const& )
     Script::OnShutdown();
 #endif //ENGINE_TESTS
 
+#if defined( ENGINE_BENCHMARKS )
+    if ( PLATFORM_INIT )
+    {
+        GFX::DestroyPools();
+    }
+#endif //ENGINE_BENCHMARKS
+
     if ( PLATFORM_INIT && !PlatformClose() )
     {
         std::cout << Util::StringFormat( "[ {} ]: Platform close error!\n", TARGET_NAME_STR );
@@ -83,3 +124,68 @@ void platformInitRunListener::testRunEnded( Catch::TestRunStats const& )
 
     std::cout << Util::StringFormat( "[ {} ]: Shuting down ...\n", TARGET_NAME_STR );
 }
+
+#if defined( ENGINE_BENCHMARKS )
+std::string benchmarkResultsListener::OUTPUT_PATH = "benchmark_results.json";
+
+void benchmarkResultsListener::testCaseStarting( Catch::TestCaseInfo const& testInfo )
+{
+    _currentTestCase = testInfo.name;
+}
+
+void benchmarkResultsListener::benchmarkEnded( Catch::BenchmarkStats const& benchmarkStats )
+{
+    Result& result = _results.emplace_back();
+    result._testCase = _currentTestCase;
+    result._name = benchmarkStats.info.name;
+    result._meanNs = benchmarkStats.mean.point.count();
+    result._meanLowNs = benchmarkStats.mean.lower_bound.count();
+    result._meanHighNs = benchmarkStats.mean.upper_bound.count();
+    result._stdDevNs = benchmarkStats.standardDeviation.point.count();
+    result._samples = benchmarkStats.info.samples;
+    result._iterations = benchmarkStats.info.iterations;
+}
+
+void benchmarkResultsListener::testRunEnded( Catch::TestRunStats const& )
+{
+    using namespace Divide;
+
+    // Sort the results so that the file only changes when the timings do, regardless of test order (e.g. --order rand)
+    std::sort( std::begin( _results ), std::end( _results ), []( const Result& lhs, const Result& rhs )
+    {
+        return lhs._testCase != rhs._testCase ? lhs._testCase < rhs._testCase : lhs._name < rhs._name;
+    });
+
+    std::ofstream output( OUTPUT_PATH, std::ios::out | std::ios::trunc );
+    if ( !output.is_open() )
+    {
+        std::cout << Util::StringFormat( "[ {} ]: Failed to open benchmark results file [ {} ]!\n", TARGET_NAME_STR, OUTPUT_PATH );
+        return;
+    }
+
+    output << "{\n";
+    output << Util::StringFormat( "    \"version\": {},\n", BENCHMARK_RESULTS_VERSION );
+    output << Util::StringFormat( "    \"target\": \"{}\",\n", EscapeJSON( TARGET_NAME_STR ) );
+    output << "    \"unit\": \"ns\",\n";
+    output << "    \"results\": [";
+    for ( size_t i = 0u; i < _results.size(); ++i )
+    {
+        const Result& result = _results[i];
+        output << (i == 0u ? "\n" : ",\n");
+        output << "        {\n";
+        output << Util::StringFormat( "            \"test_case\": \"{}\",\n", EscapeJSON( result._testCase ) );
+        output << Util::StringFormat( "            \"name\": \"{}\",\n", EscapeJSON( result._name ) );
+        output << Util::StringFormat( "            \"mean\": {:.3f},\n", result._meanNs );
+        output << Util::StringFormat( "            \"mean_lower_bound\": {:.3f},\n", result._meanLowNs );
+        output << Util::StringFormat( "            \"mean_upper_bound\": {:.3f},\n", result._meanHighNs );
+        output << Util::StringFormat( "            \"std_dev\": {:.3f},\n", result._stdDevNs );
+        output << Util::StringFormat( "            \"samples\": {},\n", result._samples );
+        output << Util::StringFormat( "            \"iterations\": {}\n", result._iterations );
+        output << "        }";
+    }
+    output << (_results.empty() ? "]\n" : "\n    ]\n");
+    output << "}\n";
+
+    std::cout << Util::StringFormat( "[ {} ]: Wrote [ {} ] benchmark results to [ {} ]\n", TARGET_NAME_STR, _results.size(), OUTPUT_PATH );
+}
+#endif //ENGINE_BENCHMARKS
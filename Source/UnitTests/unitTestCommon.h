@@ -55,6 +55,37 @@ class platformInitRunListener : public Catch::EventListenerBase
      Divide::Time::ProfileTimer* _testTimer = nullptr;
 };
 
+#if defined( ENGINE_BENCHMARKS )
+/// Collects every BENCHMARK result and writes them, sorted by name, to a JSON file at the end of the run
+class benchmarkResultsListener : public Catch::EventListenerBase
+{
+  public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    static std::string OUTPUT_PATH;
+
+    void testCaseStarting( Catch::TestCaseInfo const& testInfo ) override;
+    void benchmarkEnded( Catch::BenchmarkStats const& benchmarkStats ) override;
+    void testRunEnded( Catch::TestRunStats const& ) override;
+
+  private:
+    struct Result
+    {
+        std::string _testCase;
+        std::string _name;
+        double _meanNs{ 0.0 };
+        double _meanLowNs{ 0.0 };
+        double _meanHighNs{ 0.0 };
+        double _stdDevNs{ 0.0 };
+        unsigned int _samples{ 0u };
+        int _iterations{ 0 };
+    };
+
+    std::vector<Result> _results;
+    std::string _currentTestCase;
+};
+#endif //ENGINE_BENCHMARKS
+
 #ifndef CHECK_TRUE
 #define CHECK_TRUE( ... ) CHECK( __VA_ARGS__ )
 #endif //CHECK_TRUE
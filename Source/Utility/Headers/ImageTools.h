@@ -115,8 +115,30 @@ private:
     vector<LayerData_uptr> _mips;
 };
 
+/// Location of every mip of a DDS file on disk. Only single layer, block compressed (DXT1/3/5) files can be described
+struct DDSLayout
+{
+    struct Mip
+    {
+        size_t _offset{ 0u };
+        size_t _size{ 0u };
+        vec3<U16> _dimensions{ 0u, 0u, 1u };
+    };
+
+    vector<Mip> _mips;
+    GFXImageFormat _format{ GFXImageFormat::COUNT };
+    /// DXT1 data flagged as using 1 bit alpha
+    bool _hasAlpha{ false };
+};
+
+/// Parses the header of a DDS file held in memory (or mapped). Returns false for anything we can't read piecewise
+[[nodiscard]] bool GetDDSLayout( std::span<const Byte> fileData, DDSLayout& layoutOut );
+
 struct ImageData final : NonCopyable
 {
+    /// DDS files loaded via loadMipTailOnly skip every mip larger than this (in either dimension)
+    static constexpr U16 MIP_TAIL_MAX_DIMENSION = 128u;
+
     /// image origin information
     void requestedFormat(const GFXDataFormat format) noexcept { _requestedDataFormat = format; }
 
@@ -146,6 +168,8 @@ struct ImageData final : NonCopyable
         return _layers[layer].getMip(mipLevel)->_dimensions;
     }
 
+    /// image width, height and depth of the source image's full resolution mip (even if firstMip() is not 0)
+    [[nodiscard]] vec3<U16> sourceDimensions() const;
     /// get the number of pre-loaded mip maps (same number for each layer)
     [[nodiscard]] U8 mipCount() const { return _layers.empty() ? 0u : _layers.front().mipCount(); }
     /// get the total number of image layers
@@ -173,6 +197,9 @@ struct ImageData final : NonCopyable
     [[nodiscard]] bool loadFromFile(PlatformContext& context, bool srgb, U16 refWidth, U16 refHeight, const ResourcePath& path, std::string_view name);
     [[nodiscard]] bool loadFromFile( PlatformContext& context, bool srgb, U16 refWidth, U16 refHeight, const ResourcePath& path, std::string_view name, ImportOptions& options, bool isRetry = false);
 
+    /// Loads mips [firstMip, firstMip + mipCount) of a DDS file straight from their offsets in fileData. Only valid on an empty ImageData
+    [[nodiscard]] bool loadDDSMips( std::span<const Byte> fileData, const DDSLayout& layout, U8 firstMip, U8 mipCount );
+
     [[nodiscard]] FORCE_INLINE ResourcePath fullPath() const noexcept { return _path / _name; }
 
     /// If true, then the source image's alpha channel is used for data and not opacity (so skip mip-filtering for example)
@@ -181,11 +208,18 @@ struct ImageData final : NonCopyable
     PROPERTY_R(bool, hasDummyAlphaChannel, false);
     /// If true, the initial passed in data was either null or the size was 0
     PROPERTY_R(bool, hasDummyData, false);
+    /// If true, block compressed DDS files only load the mips that fit in MIP_TAIL_MAX_DIMENSION. The rest are meant to be streamed in
+    PROPERTY_RW(bool, loadMipTailOnly, false);
+    /// Index of our first mip in the source image's mip chain. Non-zero if only the mip tail got loaded
+    PROPERTY_R(U8, firstMip, 0u);
+    /// The DDS file the remaining mips can be streamed from if firstMip() is not 0
+    PROPERTY_R(ResourcePath, mipSource);
 
   protected:
     friend class ImageDataInterface;
     [[nodiscard]] bool loadDDS_NVTT(bool srgb, U16 refWidth, U16 refHeight, const ResourcePath& path, std::string_view name);
     [[nodiscard]] bool loadDDS_IL(bool srgb, U16 refWidth, U16 refHeight, const ResourcePath& path, std::string_view name);
+    [[nodiscard]] bool loadDDS_MipTail(U16 refWidth, U16 refHeight, const ResourcePath& path, std::string_view name);
 
    private:
     struct LoadingData
@@ -199,6 +233,8 @@ struct ImageData final : NonCopyable
     vector<ImageLayer> _layers{};
     vector<U8> _decompressedData{};
     LoadingData _loadingData{};
+    /// mip 0 dimensions of the source image
+    vec3<U16> _sourceDimensions{ 0u, 0u, 1u };
     /// the image path
     ResourcePath _path{};
     /// the actual image filename
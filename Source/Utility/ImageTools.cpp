@@ -2,9 +2,12 @@
 
 #include "Utility/Headers/Localization.h"
 #include "Platform/File/Headers/FileManagement.h"
+#include "Platform/File/Headers/MemoryMappedFile.h"
 #include "Platform/Video/Textures/Headers/Texture.h"
 
+#include "Core/Headers/ByteBuffer.h"
 #include "Core/Headers/PlatformContext.h"
+#include "Core/Headers/TaskPool.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_FAILURE_USERMSG
@@ -155,8 +158,362 @@ namespace nvttHelpers
 
         return nvtt::MipmapFilter_Box;
     }
+
+    /// Appends everything nvtt outputs (header or compressed blocks) to a memory buffer
+    struct MemoryOutputHandler final : public nvtt::OutputHandler
+    {
+        vector<Byte> _data;
+
+        void beginImage(const int size, [[maybe_unused]] int width, [[maybe_unused]] int height, [[maybe_unused]] int depth, [[maybe_unused]] int face, [[maybe_unused]] int miplevel) override
+        {
+            _data.reserve(_data.size() + to_size(size));
+        }
+
+        void endImage() override
+        {
+        }
+
+        bool writeData(const void* data, const int size) override
+        {
+            const Byte* bytes = static_cast<const Byte*>(data);
+            _data.insert(_data.end(), bytes, bytes + size);
+            return true;
+        }
+    };
+
+    void SetupOutputOptions(nvtt::OutputOptions& outputOptions, nvtt::OutputHandler* outputHandler, nvtt::ErrorHandler* errorHandler, const nvtt::Container container, const bool srgb)
+    {
+        outputOptions.setOutputHandler(outputHandler);
+        outputOptions.setErrorHandler(errorHandler);
+        outputOptions.setContainer(container);
+        outputOptions.setSrgbFlag(srgb);
+    }
 }; // namespace nvttHelpers
 
+namespace
+{
+    /// Bump this if the conversion code changes in a way that affects its output
+    constexpr U16 DDS_CACHE_VERSION = 2u;
+    constexpr U16 SOURCE_HASH_VERSION = 1u;
+    /// Without CUDA, mips taller than this are split into horizontal strips (of whole block rows) that get compressed in parallel
+    constexpr I32 DDS_CONVERSION_STRIP_HEIGHT = 256;
+
+    [[nodiscard]] U64 ConversionSettingsHash(const ImportOptions& options) noexcept
+    {
+        size_t seed = 0u;
+        Util::Hash_combine(seed,
+                           options._skipMipMaps,
+                           options._isNormalMap,
+                           options._fastCompression,
+                           options._outputSRGB,
+                           options._alphaChannelTransparency,
+                           to_base(options._mipFilter),
+                           to_base(options._outputFormat),
+                           g_KeepDevILDDSCompatibility,
+                           Config::ALPHA_DISCARD_THRESHOLD);
+        return seed;
+    }
+
+    /// Unique per thread and call, so concurrent writers (threads or processes) never share a temp file
+    [[nodiscard]] string TempCacheFileName(const std::string_view fileName)
+    {
+        size_t seed = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        Util::Hash_combine(seed, std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        return Util::StringFormat("{}.{:x}.tmp", fileName, seed);
+    }
+
+    /// Renames a fully written temp file to its final name, so readers only ever see complete cache files
+    [[nodiscard]] bool CommitCacheFile(const ResourcePath& cachePath, const std::string_view tempFileName, const std::string_view fileName)
+    {
+        if (moveFile(cachePath, tempFileName, cachePath, fileName) == FileError::NONE)
+        {
+            return true;
+        }
+
+        // Someone else finished converting the same content first. Theirs is just as good
+        DIVIDE_UNUSED(deleteFile(cachePath, tempFileName));
+        return fileExists(cachePath, fileName);
+    }
+
+    [[nodiscard]] bool WriteCacheFile(const ResourcePath& cachePath, const std::string_view fileName, const std::span<const Byte> data)
+    {
+        const string tempFileName = TempCacheFileName(fileName);
+        if (writeFile(cachePath, tempFileName, reinterpret_cast<const char*>(data.data()), data.size(), FileType::BINARY) != FileError::NONE)
+        {
+            DIVIDE_UNUSED(deleteFile(cachePath, tempFileName));
+            return false;
+        }
+
+        return CommitCacheFile(cachePath, tempFileName, fileName);
+    }
+
+    /// Deletes every "<prefix><content key>.dds" file but keepFileName. Those are conversions of older versions of the same source with the same settings, which can never be looked up again
+    void DeleteSupersededCacheFiles(const ResourcePath& cachePath, const std::string_view prefix, const std::string_view keepFileName)
+    {
+        constexpr size_t contentKeyLength = 16u;
+
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(cachePath.fileSystemPath(), ec))
+        {
+            const std::string fileName = entry.path().filename().string();
+            if (!entry.is_regular_file(ec) ||
+                fileName == keepFileName ||
+                fileName.size() != prefix.size() + contentKeyLength + 1u + Paths::Textures::g_ddsExtension.size() ||
+                !fileName.starts_with(prefix) ||
+                !hasExtension(fileName, Paths::Textures::g_ddsExtension))
+            {
+                continue;
+            }
+
+            // Still in use (e.g. mapped by a texture that hasn't reloaded yet) on some platforms. It will be picked up by the next conversion
+            DIVIDE_UNUSED(deleteFile(cachePath, fileName));
+        }
+    }
+
+    /// Content hash of a source image. Stored in the cache folder and only recomputed if the source's size or write time change
+    [[nodiscard]] U64 SourceContentHash(const ResourcePath& sourcePath, const std::string_view sourceName, const ResourcePath& cachePath)
+    {
+        PROFILE_SCOPE_AUTO(Profiler::Category::Streaming);
+
+        U64 lastWriteTime = 0u;
+        DIVIDE_UNUSED(fileLastWriteTime(sourcePath, sourceName, lastWriteTime));
+
+        std::error_code ec;
+        const U64 fileSize = to_U64(std::filesystem::file_size((sourcePath / sourceName).fileSystemPath(), ec));
+
+        const string hashFileName = Util::StringFormat("{}.srchash", sourceName);
+
+        ByteBuffer hashCache;
+        if (hashCache.loadFromFile(cachePath, hashFileName))
+        {
+            auto tempVer = decltype(SOURCE_HASH_VERSION){0};
+            hashCache >> tempVer;
+            if (tempVer == SOURCE_HASH_VERSION)
+            {
+                U64 cachedSize = 0u, cachedWriteTime = 0u, cachedHash = 0u;
+                hashCache >> cachedSize;
+                hashCache >> cachedWriteTime;
+                hashCache >> cachedHash;
+                if (cachedSize == fileSize && cachedWriteTime == lastWriteTime)
+                {
+                    return cachedHash;
+                }
+            }
+        }
+
+        MemoryMappedFile sourceFile;
+        if (sourceFile.open(sourcePath, sourceName) != FileError::NONE)
+        {
+            // Can't hash what we can't read. The conversion will fail on its own
+            return 0u;
+        }
+
+        const U64 contentHash = Util::ContentHash({ sourceFile.data(), sourceFile.size() });
+
+        hashCache.clear();
+        hashCache << SOURCE_HASH_VERSION;
+        hashCache << fileSize;
+        hashCache << lastWriteTime;
+        hashCache << contentHash;
+
+        // Failing here just means we hash the file again next time
+        const string tempFileName = TempCacheFileName(hashFileName);
+        if (!hashCache.dumpToFile(cachePath, tempFileName) || !CommitCacheFile(cachePath, tempFileName, hashFileName))
+        {
+            DIVIDE_UNUSED(deleteFile(cachePath, tempFileName));
+        }
+
+        return contentHash;
+    }
+
+    /// Compresses the source image to DDS, on the GPU if CUDA is available and otherwise with mips (and strips of large mips) compressed in parallel. The result is written atomically
+    [[nodiscard]] bool ConvertToDDS(TaskPool& pool, const string& sourceFile, const ResourcePath& cachePath, const std::string_view cacheFileName, const ImportOptions& options)
+    {
+        PROFILE_SCOPE_AUTO(Profiler::Category::Streaming);
+
+        nvtt::Surface image;
+        bool hasAlpha = false;
+        if (!image.load(sourceFile.c_str(), &hasAlpha))
+        {
+            return false;
+        }
+
+        image.setNormalMap(options._isNormalMap);
+
+        constexpr bool isGreyScale = false;
+        const nvtt::Format outputFormat = nvttHelpers::getNVTTFormat(options._outputFormat, options._isNormalMap, hasAlpha, isGreyScale);
+
+        // Setup compression options.
+        nvtt::CompressionOptions compressionOptions;
+        compressionOptions.setFormat(outputFormat);
+        compressionOptions.setQuality(options._fastCompression ? nvtt::Quality::Quality_Fastest : nvtt::Quality::Quality_Normal);
+        if (nvttHelpers::isBC1n(outputFormat, options._isNormalMap))
+        {
+            compressionOptions.setColorWeights(1, 1, 0);
+        }
+
+        nvtt::Container container = nvtt::Container_DDS;
+        switch (outputFormat)
+        {
+            case nvtt::Format_BC6:
+                compressionOptions.setPixelType(nvtt::PixelType_UnsignedFloat);
+                container = nvtt::Container_DDS10;
+                break;
+            case nvtt::Format_BC7:
+                container = nvtt::Container_DDS10;
+                break;
+            case nvtt::Format_BC2:
+                compressionOptions.setQuantization(/*color dithering*/false, /*alpha dithering*/true, /*binary alpha*/false); // Dither alpha when using BC2.
+                break;
+            case nvtt::Format_BC1a:
+                compressionOptions.setQuantization(/*color dithering*/false, /*alpha dithering*/true, /*binary alpha*/true, 127); // Binary alpha when using BC1a.
+                break;
+            default:
+                break;
+        }
+
+        F32 coverage = 0.f;
+        if (options._isNormalMap)
+        {
+            image.normalizeNormalMap();
+        }
+        else if (hasAlpha && options._alphaChannelTransparency)
+        {
+            coverage = image.alphaTestCoverage(Config::ALPHA_DISCARD_THRESHOLD);
+            image.setAlphaMode(nvtt::AlphaMode::AlphaMode_Transparency);
+        }
+
+        // Mip generation is cheap compared to compression, so build the whole chain upfront
+        vector<nvtt::Surface> mips;
+        mips.push_back(image);
+        if (!options._skipMipMaps)
+        {
+            const nvtt::MipmapFilter mipFilter = nvttHelpers::getNVTTMipFilter(options._mipFilter);
+
+            nvtt::Surface mip = image;
+            while (mip.buildNextMipmap(mipFilter))
+            {
+                if (options._isNormalMap)
+                {
+                    mip.normalizeNormalMap();
+                }
+                else if (hasAlpha && options._alphaChannelTransparency)
+                {
+                    mip.scaleAlphaToCoverage(coverage, Config::ALPHA_DISCARD_THRESHOLD);
+                }
+                mips.push_back(mip);
+            }
+        }
+
+        // A CUDA context already spreads each mip over the GPU, and every context sets up its own device state, so that path uses a single
+        // context for all of the mips. Otherwise the mips are split into strips that are compressed on the CPU in parallel.
+        nvtt::Context context;
+        context.enableCudaAcceleration(true);
+        const bool useCuda = context.isCudaAccelerationEnabled();
+
+        // Block compression works on independent 4x4 blocks, so strips made of whole block rows compress to the exact same data as the full mip.
+        // Alpha dithering (BC2 and BC1a) diffuses the quantization error across block boundaries though, so those formats compress whole mips
+        const bool ditheredAlpha = outputFormat == nvtt::Format_BC2 || outputFormat == nvtt::Format_BC1a;
+        const I32 stripHeight = useCuda || ditheredAlpha ? I32_MAX : DDS_CONVERSION_STRIP_HEIGHT;
+        struct ConversionJob
+        {
+            nvttHelpers::MemoryOutputHandler _output;
+            I32 _mip{0};
+            I32 _firstRow{0};
+            I32 _lastRow{0};
+        };
+
+        vector<ConversionJob> jobs;
+        for (I32 m = 0; m < to_I32(mips.size()); ++m)
+        {
+            const I32 height = mips[m].height();
+            for (I32 row = 0; row < height; row += stripHeight)
+            {
+                ConversionJob& job = jobs.emplace_back();
+                job._mip = m;
+                job._firstRow = row;
+                job._lastRow = (height - row > stripHeight ? row + stripHeight : height) - 1;
+            }
+        }
+
+        nvttHelpers::ErrorHandler errorHandler;
+
+        const auto compressJob = [&](nvtt::Context& jobContext, ConversionJob& job)
+        {
+            const nvtt::Surface& mip = mips[job._mip];
+            const bool fullMip = job._firstRow == 0 && job._lastRow == mip.height() - 1;
+
+            nvtt::OutputOptions outputOptions;
+            nvttHelpers::SetupOutputOptions(outputOptions, &job._output, &errorHandler, container, options._outputSRGB);
+
+            return fullMip ? jobContext.compress(mip, 0, job._mip, compressionOptions, outputOptions)
+                           : jobContext.compress(mip.createSubImage(0, mip.width() - 1, job._firstRow, job._lastRow, 0, 0), 0, job._mip, compressionOptions, outputOptions);
+        };
+
+        if (useCuda)
+        {
+            for (ConversionJob& job : jobs)
+            {
+                if (!compressJob(context, job))
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            std::atomic_bool compressed = true;
+
+            Parallel_For
+            (
+                pool,
+                ParallelForDescriptor
+                {
+                    ._iterCount = to_U32(jobs.size()),
+                    ._partitionSize = 1u,
+                    ._useCurrentThread = true
+                },
+                [&](const Task* /*parent*/, const U32 start, const U32 end)
+                {
+                    // nvtt contexts aren't thread safe. CPU only, so they are cheap to create
+                    nvtt::Context stripContext;
+                    stripContext.enableCudaAcceleration(false);
+
+                    for (U32 i = start; i < end; ++i)
+                    {
+                        if (!compressJob(stripContext, jobs[i]))
+                        {
+                            compressed = false;
+                        }
+                    }
+                }
+            );
+
+            if (!compressed)
+            {
+                return false;
+            }
+        }
+
+        nvttHelpers::MemoryOutputHandler fileData;
+        {
+            nvtt::OutputOptions outputOptions;
+            nvttHelpers::SetupOutputOptions(outputOptions, &fileData, &errorHandler, container, options._outputSRGB);
+            if (!context.outputHeader(image, to_I32(mips.size()), compressionOptions, outputOptions))
+            {
+                return false;
+            }
+        }
+
+        for (const ConversionJob& job : jobs)
+        {
+            fileData._data.insert(fileData._data.end(), job._output._data.begin(), job._output._data.end());
+        }
+
+        return WriteCacheFile(cachePath, cacheFileName, fileData._data);
+    }
+} //namespace
+
 #endif //!IS_MACOS_BUILD
 
 namespace
@@ -167,6 +524,38 @@ namespace
 
     static eastl::set<U64> s_fileLoadingHashes;
 
+    // ref: https://learn.microsoft.com/en-us/windows/win32/direct3ddds/dds-header
+    namespace DDS
+    {
+        constexpr U32 MAGIC = 0x20534444u; // "DDS "
+        constexpr size_t HEADER_SIZE = 128u; // magic + DDS_HEADER
+        constexpr size_t OFFSET_FLAGS = 8u;
+        constexpr size_t OFFSET_HEIGHT = 12u;
+        constexpr size_t OFFSET_WIDTH = 16u;
+        constexpr size_t OFFSET_MIP_COUNT = 28u;
+        constexpr size_t OFFSET_PF_FLAGS = 80u;
+        constexpr size_t OFFSET_PF_FOURCC = 84u;
+        constexpr size_t OFFSET_CAPS2 = 112u;
+
+        constexpr U32 DDSD_MIPMAPCOUNT = 0x20000u;
+        constexpr U32 DDPF_ALPHAPIXELS = 0x1u;
+        constexpr U32 DDPF_FOURCC = 0x4u;
+        constexpr U32 DDSCAPS2_CUBEMAP = 0x200u;
+        constexpr U32 DDSCAPS2_VOLUME = 0x200000u;
+
+        [[nodiscard]] constexpr U32 FourCC( const char a, const char b, const char c, const char d ) noexcept
+        {
+            return to_U32( a ) | (to_U32( b ) << 8) | (to_U32( c ) << 16) | (to_U32( d ) << 24);
+        }
+
+        [[nodiscard]] FORCE_INLINE U32 Read( const std::span<const Byte> data, const size_t offset ) noexcept
+        {
+            U32 ret = 0u;
+            std::memcpy( &ret, data.data() + offset, sizeof( U32 ) );
+            return ret;
+        }
+    } //namespace DDS
+
     //ref: https://github.com/nvpro-pipeline/pipeline/blob/master/dp/sg/io/IL/Loader/ILTexLoader.cpp
     FORCE_INLINE I32 determineFace(const I32 i, const bool isDDS, const bool isCube) noexcept
     {
@@ -233,6 +622,119 @@ bool UseUpperLeftOrigin() noexcept
     return s_useUpperLeftOrigin;
 }
 
+bool GetDDSLayout( const std::span<const Byte> fileData, DDSLayout& layoutOut )
+{
+    layoutOut = {};
+
+    if ( fileData.size() < DDS::HEADER_SIZE || DDS::Read( fileData, 0u ) != DDS::MAGIC )
+    {
+        return false;
+    }
+
+    // Cube maps, volumes and DX10 extended headers (arrays, BC4+ formats) are left to the regular loader
+    if ( (DDS::Read( fileData, DDS::OFFSET_CAPS2 ) & (DDS::DDSCAPS2_CUBEMAP | DDS::DDSCAPS2_VOLUME)) != 0u )
+    {
+        return false;
+    }
+
+    const U32 pixelFlags = DDS::Read( fileData, DDS::OFFSET_PF_FLAGS );
+    if ( (pixelFlags & DDS::DDPF_FOURCC) == 0u )
+    {
+        return false;
+    }
+
+    size_t blockSize = 16u;
+    switch ( DDS::Read( fileData, DDS::OFFSET_PF_FOURCC ) )
+    {
+        case DDS::FourCC( 'D', 'X', 'T', '1' ):
+        {
+            layoutOut._format = GFXImageFormat::DXT1_RGBA;
+            layoutOut._hasAlpha = (pixelFlags & DDS::DDPF_ALPHAPIXELS) != 0u;
+            blockSize = 8u;
+        } break;
+        case DDS::FourCC( 'D', 'X', 'T', '3' ): layoutOut._format = GFXImageFormat::DXT3_RGBA; layoutOut._hasAlpha = true; break;
+        case DDS::FourCC( 'D', 'X', 'T', '5' ): layoutOut._format = GFXImageFormat::DXT5_RGBA; layoutOut._hasAlpha = true; break;
+        default: return false;
+    }
+
+    const U32 width = DDS::Read( fileData, DDS::OFFSET_WIDTH );
+    const U32 height = DDS::Read( fileData, DDS::OFFSET_HEIGHT );
+    if ( width == 0u || height == 0u || width > U16_MAX || height > U16_MAX )
+    {
+        return false;
+    }
+
+    const U32 mipCount = (DDS::Read( fileData, DDS::OFFSET_FLAGS ) & DDS::DDSD_MIPMAPCOUNT) != 0u
+                                                                    ? std::max( DDS::Read( fileData, DDS::OFFSET_MIP_COUNT ), 1u )
+                                                                    : 1u;
+    if ( mipCount >= U8_MAX )
+    {
+        return false;
+    }
+
+    size_t offset = DDS::HEADER_SIZE;
+    layoutOut._mips.resize( mipCount );
+    for ( U32 m = 0u; m < mipCount; ++m )
+    {
+        const U32 mipWidth = std::max( width >> m, 1u );
+        const U32 mipHeight = std::max( height >> m, 1u );
+
+        DDSLayout::Mip& mip = layoutOut._mips[m];
+        mip._offset = offset;
+        mip._size = std::max( (mipWidth + 3u) / 4u, 1u ) * std::max( (mipHeight + 3u) / 4u, 1u ) * blockSize;
+        mip._dimensions.set( to_U16( mipWidth ), to_U16( mipHeight ), 1u );
+        offset += mip._size;
+    }
+
+    if ( offset > fileData.size() )
+    {
+        // Truncated file
+        layoutOut = {};
+        return false;
+    }
+
+    return true;
+}
+
+vec3<U16> ImageData::sourceDimensions() const
+{
+    return _firstMip > 0u ? _sourceDimensions : dimensions( 0u, 0u );
+}
+
+bool ImageData::loadDDSMips( const std::span<const Byte> fileData, const DDSLayout& layout, const U8 firstMip, const U8 mipCount )
+{
+    DIVIDE_ASSERT( _layers.empty() );
+
+    if ( mipCount == 0u || to_size( firstMip ) + mipCount > layout._mips.size() )
+    {
+        return false;
+    }
+
+    _format = layout._format;
+    _dataType = GFXDataFormat::UNSIGNED_BYTE;
+    _sourceDataType = SourceDataType::BYTE;
+    _bpp = 32u;
+    _firstMip = firstMip;
+    _sourceDimensions = layout._mips.front()._dimensions;
+    if ( !layout._hasAlpha )
+    {
+        // Matches what we do for DevIL's IL_DXT1
+        _hasDummyAlphaChannel = true;
+        _ignoreAlphaChannelTransparency = true;
+    }
+
+    ImageLayer& layer = _layers.emplace_back();
+    for ( U8 m = firstMip; m < firstMip + mipCount; ++m )
+    {
+        const DDSLayout::Mip& mip = layout._mips[m];
+        // A component count of 0 means the specified size is always used (same as compressed DevIL data)
+        Byte* data = layer.allocateMip<Byte>( fileData.data() + mip._offset, mip._size, mip._dimensions.width, mip._dimensions.height, mip._dimensions.depth, 0u );
+        DIVIDE_UNUSED( data );
+    }
+
+    return true;
+}
+
 bool ImageData::loadFromMemory( std::span<const Byte> data, const vec3<U16>& dimensions, const U16 layerCount, const U8 numComponents)
 {
     _hasDummyData = data.empty();
@@ -613,14 +1115,22 @@ bool ImageData::loadFromFile(PlatformContext& context, const bool srgb, const U1
         // Try and save regular images to DDS for better compression next time
         DIVIDE_EXPECTED_CALL( createDirectory(cachePath) == FileError::NONE );
 
-        const string cacheFileName = Util::StringFormat("{}.{}", _name, Paths::Textures::g_ddsExtension);
+        // Cached conversions are named after the conversion settings and keyed by source content (and converter version). Editing either one produces a new cache file
+        // instead of reusing a stale one. The same source can be used with different settings, but only the newest content for a given set of settings is kept around
+        size_t contentKey = SourceContentHash(_path, _name, cachePath);
+        Util::Hash_combine(contentKey, DDS_CACHE_VERSION);
+
+        const string cacheFilePrefix = Util::StringFormat("{}.{:016x}.", _name, ConversionSettingsHash(options));
+        const string cacheFileName = Util::StringFormat("{}{:016x}.{}", cacheFilePrefix, contentKey, Paths::Textures::g_ddsExtension);
 
         const ResourcePath cacheFilePath = cachePath / cacheFileName;
 
         Task* ddsConversionTask = nullptr;
         if ( !fileExists(ResourcePath{ cacheFilePath }) )
         {
-            ddsConversionTask = CreateTask( [fullPath, cacheFilePath, cachePath, cacheFileName, options]( const Task& )
+            TaskPool* pool = &context.taskPool(TaskPoolType::HIGH_PRIORITY);
+
+            ddsConversionTask = CreateTask( [pool, fullPath, cacheFilePath, cachePath, cacheFilePrefix, cacheFileName, options]( const Task& )
             {
                 const size_t cacheFilePathHash = _ID(cacheFilePath.string());
                 do
@@ -636,115 +1146,28 @@ bool ImageData::loadFromFile(PlatformContext& context, const bool srgb, const U1
                     std::this_thread::yield();
                 } while (true);
 
-                bool success = false;
-
-                const string cacheFileNameTemp = cacheFileName + ".tmp";
-
                 SCOPE_EXIT
                 {
-                    DIVIDE_EXPECTED_CALL(success && moveFile(cachePath, cacheFileNameTemp, cachePath, cacheFileName) == FileError::NONE);
-
                     UniqueLock<Mutex> lock(s_imageCompressionMutex);
                     DIVIDE_EXPECTED_CALL(s_fileLoadingHashes.erase(cacheFilePathHash) > 0u);
                 };
 
+                // Check if the file was created between the check and the task actually starting
+                if (fileExists(ResourcePath{ cacheFilePath }))
                 {
-                    // Check if the file was created between the check and the task actually starting
-                    if (fileExists(ResourcePath{ cacheFilePath }))
-                    {
-                        return;
-                    }
+                    return;
                 }
 
-                nvtt::Context context;
-                context.enableCudaAcceleration(true);
-
-                nvtt::Surface image;
-                bool hasAlpha = false;
-                if (image.load(fullPath.c_str(), &hasAlpha))
+                if (!ConvertToDDS(*pool, fullPath, cachePath, cacheFileName, options))
                 {
-                    image.setNormalMap(options._isNormalMap);
-
-                    constexpr bool isGreyScale = false;
-                    const nvtt::Format outputFormat = nvttHelpers::getNVTTFormat(options._outputFormat, options._isNormalMap, hasAlpha, isGreyScale);
-
-                    // Setup compression options.
-                    nvtt::CompressionOptions compressionOptions;
-                    compressionOptions.setFormat(outputFormat);
-                    compressionOptions.setQuality(options._fastCompression ? nvtt::Quality::Quality_Fastest : nvtt::Quality::Quality_Normal);
-                    if (nvttHelpers::isBC1n(outputFormat, options._isNormalMap))
-                    {
-                        compressionOptions.setColorWeights(1, 1, 0);
-                    }
-
-                    const ResourcePath cacheFilePathTemp = cachePath / cacheFileNameTemp;
-
-                    nvttHelpers::ErrorHandler errorHandler;
-                    nvtt::OutputOptions outputOptions;
-                    outputOptions.setFileName(cacheFilePathTemp.string().c_str());
-                    outputOptions.setErrorHandler(&errorHandler);
-                    outputOptions.setContainer(nvtt::Container_DDS);
-                    outputOptions.setSrgbFlag(options._outputSRGB);
-
-                    switch (outputFormat)
-                    {
-                        case nvtt::Format_BC6:
-                            compressionOptions.setPixelType(nvtt::PixelType_UnsignedFloat);
-                            outputOptions.setContainer(nvtt::Container_DDS10);
-                            break;
-                        case nvtt::Format_BC7:
-                            outputOptions.setContainer(nvtt::Container_DDS10);
-                            break;
-                        case nvtt::Format_BC2:
-                            compressionOptions.setQuantization(/*color dithering*/false, /*alpha dithering*/true, /*binary alpha*/false); // Dither alpha when using BC2.
-                            break;
-                        case nvtt::Format_BC1a:
-                            compressionOptions.setQuantization(/*color dithering*/false, /*alpha dithering*/true, /*binary alpha*/true, 127); // Binary alpha when using BC1a.
-                            break;
-                        default:
-                            break;
-                    }
-
-                    DIVIDE_EXPECTED_CALL( context.outputHeader(image, image.countMipmaps(), compressionOptions, outputOptions) );
-                    
-                    F32 coverage = 0.f;
-                    if (options._isNormalMap)
-                    {
-                        image.normalizeNormalMap();
-                    }
-                    else if (hasAlpha && options._alphaChannelTransparency)
-                    {
-                        coverage = image.alphaTestCoverage(Config::ALPHA_DISCARD_THRESHOLD);
-                        image.setAlphaMode(nvtt::AlphaMode::AlphaMode_Transparency);
-                    }
-
-                    DIVIDE_EXPECTED_CALL( context.compress(image, 0, 0, compressionOptions, outputOptions) );
-
-                    // Build and output mipmaps.
-                    if (!options._skipMipMaps)
-                    {
-                        I32 m = 1;
-                        while (image.buildNextMipmap(nvttHelpers::getNVTTMipFilter(options._mipFilter)))
-                        {
-                            if (options._isNormalMap)
-                            {
-                                image.normalizeNormalMap();
-                            }
-                            else if (hasAlpha && options._alphaChannelTransparency)
-                            {
-                                image.scaleAlphaToCoverage(coverage, Config::ALPHA_DISCARD_THRESHOLD);
-                            }
-
-                            DIVIDE_EXPECTED_CALL( context.compress(image, 0, m, compressionOptions, outputOptions) );
-
-                            m++;
-                        }
-                    }
-                    success = true;
+                    Console::errorfn(LOCALE_STR("ERROR_IMAGE_TOOLS_DDS_CONVERSION"), fullPath);
+                    return;
                 }
+
+                DeleteSupersededCacheFiles(cachePath, cacheFilePrefix, cacheFileName);
             });
 
-            context.taskPool(TaskPoolType::HIGH_PRIORITY).enqueue
+            pool->enqueue
             (
                 *ddsConversionTask,
                 options._waitForDDSConversion ? TaskPriority::REALTIME
@@ -1071,10 +1494,69 @@ bool ImageData::loadFromFile(PlatformContext& context, const bool srgb, const U1
 
 bool ImageData::loadDDS_NVTT([[maybe_unused]] const bool srgb, const U16 refWidth, const U16 refHeight, const ResourcePath& path, const std::string_view name)
 {
+    if ( loadMipTailOnly() && loadDDS_MipTail( refWidth, refHeight, path, name ) )
+    {
+        return true;
+    }
+
     //ToDo: Use a better DDS loader
     return loadDDS_IL(srgb, refWidth, refHeight, path, name);
 }
 
+bool ImageData::loadDDS_MipTail( const U16 refWidth, const U16 refHeight, const ResourcePath& path, const std::string_view name )
+{
+    PROFILE_SCOPE_AUTO( Profiler::Category::Streaming );
+
+    // Raw DDS data is stored top to bottom, so we can only skip DevIL if we don't need to flip it. Arrays and cube maps need every layer loaded
+    if ( !s_useUpperLeftOrigin || !_layers.empty() )
+    {
+        return false;
+    }
+
+    MemoryMappedFile file;
+    if ( file.open( path, name ) != FileError::NONE )
+    {
+        return false;
+    }
+
+    const std::span<const Byte> fileData{ file.data(), file.size() };
+
+    DDSLayout layout{};
+    if ( !GetDDSLayout( fileData, layout ) )
+    {
+        return false;
+    }
+
+    const vec3<U16>& baseDimensions = layout._mips.front()._dimensions;
+    if ( refWidth != 0u && refHeight != 0u && (baseDimensions.width != refWidth || baseDimensions.height != refHeight) )
+    {
+        // Needs rescaling
+        return false;
+    }
+
+    U8 tailMip = 0u;
+    while ( tailMip < layout._mips.size() &&
+            std::max( layout._mips[tailMip]._dimensions.width, layout._mips[tailMip]._dimensions.height ) > MIP_TAIL_MAX_DIMENSION )
+    {
+        ++tailMip;
+    }
+
+    // Nothing to stream (small image) or an incomplete mip chain (the texture always allocates the full chain)
+    if ( tailMip == 0u || layout._mips.size() != to_size( MipCount( baseDimensions.width, baseDimensions.height ) ) )
+    {
+        return false;
+    }
+
+    file.prefetch( layout._mips[tailMip]._offset, layout._mips.back()._offset + layout._mips.back()._size - layout._mips[tailMip]._offset );
+    if ( !loadDDSMips( fileData, layout, tailMip, to_U8( layout._mips.size() - tailMip ) ) )
+    {
+        return false;
+    }
+
+    _mipSource = path / name;
+    return true;
+}
+
 bool ImageData::loadDDS_IL([[maybe_unused]] const bool srgb, const U16 refWidth, const U16 refHeight, const ResourcePath& path, const std::string_view name)
 {
 